@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Generate single-file distribution of LwMEM.
+
+Produces lwmem_single.h (all public headers) and lwmem_single.c (all
+translation units in one), so integration needs no build-system wiring and
+non-LTO toolchains can inline the internal helpers into the public entry
+points.
+
+Usage:
+    python3 dev/amalgamate.py [output_dir]
+"""
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+INC = os.path.join(ROOT, "lwmem", "src", "include")
+SRC = os.path.join(ROOT, "lwmem", "src", "lwmem")
+
+HEADERS = [
+    "lwmem/lwmem_opt.h",
+    "lwmem/lwmem.h",
+    "lwmem/lwmem_pool.h",
+    "lwmem/lwmem_arena.h",
+    "lwmem/lwmem_shard.h",
+]
+SOURCES = [
+    "lwmem.c",
+    "lwmem_pool.c",
+    "lwmem_arena.c",
+    "lwmem_shard.c",
+]
+
+LOCAL_INCLUDE = re.compile(r'^\s*#include\s+"(lwmem/[^"]+|system/[^"]+)"')
+
+
+def strip_local_includes(text):
+    out = []
+    for line in text.splitlines():
+        if LOCAL_INCLUDE.match(line):
+            out.append("/* amalgamated: %s */" % line.strip())
+        else:
+            out.append(line)
+    return "\n".join(out) + "\n"
+
+
+def main():
+    out_dir = sys.argv[1] if len(sys.argv) > 1 else os.getcwd()
+    os.makedirs(out_dir, exist_ok=True)
+
+    with open(os.path.join(out_dir, "lwmem_single.h"), "w") as out:
+        out.write("/* Amalgamated LwMEM distribution header, generated by dev/amalgamate.py */\n")
+        out.write("#ifndef LWMEM_SINGLE_HDR_H\n#define LWMEM_SINGLE_HDR_H\n\n")
+        for header in HEADERS:
+            with open(os.path.join(INC, header)) as src:
+                out.write("/* ==== %s ==== */\n" % header)
+                out.write(strip_local_includes(src.read()))
+                out.write("\n")
+        out.write("#endif /* LWMEM_SINGLE_HDR_H */\n")
+
+    with open(os.path.join(out_dir, "lwmem_single.c"), "w") as out:
+        out.write("/* Amalgamated LwMEM distribution source, generated by dev/amalgamate.py */\n")
+        out.write('#include "lwmem_single.h"\n\n')
+        for source in SOURCES:
+            with open(os.path.join(SRC, source)) as src:
+                out.write("/* ==== %s ==== */\n" % source)
+                out.write(strip_local_includes(src.read()))
+                out.write("\n")
+
+    print("wrote %s/lwmem_single.{h,c}" % out_dir)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
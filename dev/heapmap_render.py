@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Render lwmem_heapmap CSV output as an HTML block-map timeline.
+
+Usage:
+    lwmem_heapmap > dump.csv
+    python3 dev/heapmap_render.py dump.csv heapmap.html
+
+Each CSV frame becomes one horizontal bar; allocated blocks are drawn dark,
+free blocks light, so fragmentation evolution is visible at a glance.
+"""
+import csv
+import sys
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+    src, dst = sys.argv[1], sys.argv[2]
+
+    frames = {}
+    heap_size = 0
+    with open(src, newline="") as f:
+        for row in csv.DictReader(f):
+            frame = int(row["frame"])
+            offset, size = int(row["offset"]), int(row["size"])
+            frames.setdefault(frame, []).append((offset, size, row["state"]))
+            heap_size = max(heap_size, offset + size)
+
+    with open(dst, "w") as out:
+        out.write("<!DOCTYPE html><html><head><meta charset='utf-8'>"
+                  "<title>lwmem heap map</title><style>"
+                  ".bar{position:relative;height:14px;margin:1px 0;background:#eee}"
+                  ".blk{position:absolute;top:0;height:100%}"
+                  ".used{background:#38506e}.free{background:#b8d0a8}"
+                  "body{font:12px monospace;margin:16px}"
+                  "</style></head><body>\n")
+        out.write(f"<p>heap size {heap_size} bytes, {len(frames)} frames "
+                  "(top = first frame; dark = allocated, light = free)</p>\n")
+        for frame in sorted(frames):
+            out.write("<div class='bar'>")
+            for offset, size, state in frames[frame]:
+                left = 100.0 * offset / heap_size
+                width = max(100.0 * size / heap_size, 0.05)
+                out.write(f"<div class='blk {state}' style='left:{left:.3f}%;width:{width:.3f}%'></div>")
+            out.write("</div>\n")
+        out.write("</body></html>\n")
+    print(f"wrote {dst}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,112 @@
+"""GDB helpers for LwMEM heap inspection.
+
+Load with:  (gdb) source dev/lwmem_gdb.py
+Commands:   lwmem-walk [instance]    - block table of an instance (default: lwmem_default)
+            lwmem-frag [instance]    - fragmentation summary
+
+The script reads the versioned `lwmem_debug_anchor` structure, so it keeps
+working across configuration changes (alignment, alloc-bit placement).
+"""
+import gdb
+
+
+def _anchor():
+    a = gdb.parse_and_eval("lwmem_debug_anchor")
+    return {
+        "version": int(a["version"]),
+        "meta": int(a["meta_size"]),
+        "low_bit": int(a["alloc_bit_low"]),
+        "mark": int(a["alloc_mark"]),
+    }
+
+
+def _alloc_bit(anchor):
+    if anchor["low_bit"]:
+        return 1
+    bits = 8 * int(gdb.lookup_type("size_t").sizeof)
+    return 1 << (bits - 1)
+
+
+def _instance(arg):
+    return gdb.parse_and_eval(arg if arg else "lwmem_default")
+
+
+def _regions(inst):
+    regions = inst["regions_list"]
+    out = []
+    if int(regions) == 0:
+        return out
+    idx = 0
+    while True:
+        region = regions[idx]
+        if int(region["size"]) == 0 or int(region["start_addr"]) == 0:
+            break
+        out.append((int(region["start_addr"]), int(region["size"])))
+        idx += 1
+    return out
+
+
+def _walk_blocks(inst):
+    anchor = _anchor()
+    bit = _alloc_bit(anchor)
+    block_t = gdb.lookup_type("lwmem_block_t").pointer()
+    for start, length in _regions(inst):
+        addr = start
+        end = start + length
+        while addr < end:
+            block = gdb.Value(addr).cast(block_t)
+            raw = int(block["size"])
+            size = raw & ~bit
+            if size == 0:
+                break
+            used = bool(raw & bit)
+            corrupt = used and int(block["next"]) != anchor["mark"]
+            if size % 4 != 0 or addr + size > end:
+                yield (addr, size, used, True)
+                break
+            yield (addr, size, used, corrupt)
+            addr += size
+
+
+class LwmemWalk(gdb.Command):
+    """Print block table of a lwmem_t instance: lwmem-walk [expr]"""
+
+    def __init__(self):
+        super(LwmemWalk, self).__init__("lwmem-walk", gdb.COMMAND_DATA)
+
+    def invoke(self, arg, from_tty):
+        inst = _instance(arg.strip())
+        print("%-18s %10s %-6s %s" % ("address", "size", "state", "flags"))
+        for addr, size, used, corrupt in _walk_blocks(inst):
+            print("%-18s %10d %-6s %s"
+                  % (hex(addr), size, "used" if used else "free", "CORRUPT" if corrupt else ""))
+
+
+class LwmemFrag(gdb.Command):
+    """Summarize fragmentation of a lwmem_t instance: lwmem-frag [expr]"""
+
+    def __init__(self):
+        super(LwmemFrag, self).__init__("lwmem-frag", gdb.COMMAND_DATA)
+
+    def invoke(self, arg, from_tty):
+        inst = _instance(arg.strip())
+        free_cnt = used_cnt = free_bytes = used_bytes = largest = corrupt = 0
+        for addr, size, used, bad in _walk_blocks(inst):
+            corrupt += bad
+            if used:
+                used_cnt += 1
+                used_bytes += size
+            else:
+                free_cnt += 1
+                free_bytes += size
+                largest = max(largest, size)
+        frag = 0 if free_bytes == 0 else 100 - 100 * largest // free_bytes
+        print("used: %d blocks / %d bytes" % (used_cnt, used_bytes))
+        print("free: %d blocks / %d bytes, largest %d, fragmentation %d%%"
+              % (free_cnt, free_bytes, largest, frag))
+        if corrupt:
+            print("WARNING: %d corrupt block(s) detected" % corrupt)
+
+
+LwmemWalk()
+LwmemFrag()
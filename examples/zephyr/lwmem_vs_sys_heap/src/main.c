@@ -0,0 +1,112 @@
+#include <zephyr/kernel.h>
+#include <zephyr/sys/sys_heap.h>
+#include <zephyr/timing/timing.h>
+#include "lwmem/lwmem.h"
+
+#define HEAP_SIZE  (32 * 1024)
+#define OPS_COUNT  10000
+#define SLOT_COUNT 32
+
+static uint8_t lwmem_mem[HEAP_SIZE];
+static lwmem_region_t lwmem_regions[] = {
+    {lwmem_mem, sizeof(lwmem_mem)},
+    {NULL, 0},
+};
+
+static uint8_t sysheap_mem[HEAP_SIZE];
+static struct sys_heap sysheap;
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t
+prv_rand(void) {
+    /* xorshift32, deterministic workload on every run */
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+struct bench_result {
+    uint64_t min_cycles;
+    uint64_t max_cycles;
+    uint64_t total_cycles;
+    uint32_t ops;
+};
+
+static void
+prv_bench(const char* name, void* (*alloc_fn)(size_t), void (*free_fn)(void*)) {
+    static void* slots[SLOT_COUNT];
+    struct bench_result res = {.min_cycles = UINT64_MAX};
+    timing_t start, end;
+
+    rng_state = 0x12345678;
+    memset(slots, 0, sizeof(slots));
+
+    for (uint32_t op = 0; op < OPS_COUNT; ++op) {
+        uint32_t idx = prv_rand() % SLOT_COUNT;
+        uint64_t cycles;
+
+        timing_start();
+        if (slots[idx] == NULL) {
+            size_t size = 16 + (prv_rand() % 497);
+
+            start = timing_counter_get();
+            slots[idx] = alloc_fn(size);
+            end = timing_counter_get();
+        } else {
+            start = timing_counter_get();
+            free_fn(slots[idx]);
+            end = timing_counter_get();
+            slots[idx] = NULL;
+        }
+        timing_stop();
+
+        cycles = timing_cycles_get(&start, &end);
+        res.total_cycles += cycles;
+        res.min_cycles = MIN(res.min_cycles, cycles);
+        res.max_cycles = MAX(res.max_cycles, cycles);
+        ++res.ops;
+    }
+    for (uint32_t idx = 0; idx < SLOT_COUNT; ++idx) {
+        if (slots[idx] != NULL) {
+            free_fn(slots[idx]);
+        }
+    }
+
+    printk("%-10s min %8llu avg %8llu max %8llu cycles (%u ops)\n", name, res.min_cycles,
+           res.total_cycles / res.ops, res.max_cycles, res.ops);
+}
+
+static void*
+prv_lwmem_alloc(size_t size) {
+    return lwmem_malloc(size);
+}
+
+static void
+prv_lwmem_free(void* ptr) {
+    lwmem_free(ptr);
+}
+
+static void*
+prv_sysheap_alloc(size_t size) {
+    return sys_heap_alloc(&sysheap, size);
+}
+
+static void
+prv_sysheap_free(void* ptr) {
+    sys_heap_free(&sysheap, ptr);
+}
+
+int
+main(void) {
+    timing_init();
+
+    lwmem_assignmem(lwmem_regions);
+    sys_heap_init(&sysheap, sysheap_mem, sizeof(sysheap_mem));
+
+    printk("Allocation latency, %u random malloc/free operations:\n", (unsigned)OPS_COUNT);
+    prv_bench("lwmem", prv_lwmem_alloc, prv_lwmem_free);
+    prv_bench("sys_heap", prv_sysheap_alloc, prv_sysheap_free);
+    return 0;
+}
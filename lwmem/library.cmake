@@ -18,6 +18,17 @@ set(LWMEM_CUSTOM_INC_DIR ${CMAKE_CURRENT_BINARY_DIR}/lib_inc)
 # Library core sources
 set(lwmem_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_pool.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_arena.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_bitmap.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_shard.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_stack.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_ring.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_scratch.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_handle.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_intern.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_amp.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_cli.c
 )
 
 # C++ extension
@@ -25,12 +36,28 @@ set(lwmem_core_cpp_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem.cpp
 )
 
+# Optional global operator new/delete override routed to the default LwMEM instance
+option(LWMEM_OPERATOR_NEW "Route global C++ operator new/delete to LwMEM" OFF)
+if(LWMEM_OPERATOR_NEW)
+    set(lwmem_core_cpp_SRCS ${lwmem_core_cpp_SRCS}
+        ${CMAKE_CURRENT_LIST_DIR}/src/lwmem/lwmem_new.cpp
+    )
+endif()
+
 # Setup include directories
 set(lwmem_include_DIRS
     ${CMAKE_CURRENT_LIST_DIR}/src/include
     ${LWMEM_CUSTOM_INC_DIR}
 )
 
+# Optional newlib/picolibc malloc retargeting onto the default instance
+option(LWMEM_NEWLIB_RETARGET "Route newlib/picolibc malloc onto LwMEM" OFF)
+if(LWMEM_NEWLIB_RETARGET)
+    set(lwmem_core_SRCS ${lwmem_core_SRCS}
+        ${CMAKE_CURRENT_LIST_DIR}/src/system/lwmem_newlib.c
+    )
+endif()
+
 # Add system port
 if(DEFINED LWMEM_SYS_PORT)
     set(lwmem_core_SRCS ${lwmem_core_SRCS}
@@ -38,6 +65,18 @@ if(DEFINED LWMEM_SYS_PORT)
     )
 endif()
 
+# Curated performance profile for the library target.
+# Product teams declare intent instead of rediscovering option interactions
+set(LWMEM_PROFILE "balanced" CACHE STRING "LwMEM tuning profile: speed, size or balanced")
+if(LWMEM_PROFILE STREQUAL "speed")
+    list(APPEND LWMEM_COMPILE_OPTIONS -O3)
+    list(APPEND LWMEM_COMPILE_DEFINITIONS LWMEM_CFG_PREFETCH=1)
+elseif(LWMEM_PROFILE STREQUAL "size")
+    list(APPEND LWMEM_COMPILE_OPTIONS -Os)
+elseif(NOT LWMEM_PROFILE STREQUAL "balanced")
+    message(FATAL_ERROR "Unknown LWMEM_PROFILE '${LWMEM_PROFILE}', use speed, size or balanced")
+endif()
+
 # Register core library
 add_library(lwmem)
 target_sources(lwmem PRIVATE ${lwmem_core_SRCS})
@@ -39,6 +39,25 @@
 #include <stdint.h>
 #include "lwmem/lwmem_opt.h"
 
+#if (!LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC) || LWMEM_CFG_FREE_FROM_ISR || LWMEM_CFG_ENABLE_STATS_ATOMIC
+#ifndef __cplusplus
+#include <stdatomic.h>
+#endif /* !__cplusplus */
+#endif /* (!LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC) || LWMEM_CFG_FREE_FROM_ISR
+          || LWMEM_CFG_ENABLE_STATS_ATOMIC */
+
+/**
+ * \brief           Statistics counter type
+ *
+ * Counters are plain 32-bit values by default,
+ * or C11 atomics when \ref LWMEM_CFG_ENABLE_STATS_ATOMIC is enabled
+ */
+#if LWMEM_CFG_ENABLE_STATS_ATOMIC && !defined(__cplusplus)
+#define LWMEM_STATS_CNT_T _Atomic(uint32_t)
+#else
+#define LWMEM_STATS_CNT_T uint32_t
+#endif /* LWMEM_CFG_ENABLE_STATS_ATOMIC && !defined(__cplusplus) */
+
 #ifdef __cplusplus
 extern "C" {
 #endif /* __cplusplus */
@@ -65,39 +84,384 @@ typedef struct lwmem_block {
     size_t size;              /*!< Size of block, including metadata part.
                                     MSB bit is set to `1` when block is allocated and in use,
                                     or `0` when block is considered free */
+#if LWMEM_CFG_ALLOC_TAGS || __DOXYGEN__
+    const char* tag;          /*!< Allocation site tag of allocated block, `NULL` for untagged blocks */
+#endif /* LWMEM_CFG_ALLOC_TAGS || __DOXYGEN__ */
+#if LWMEM_CFG_TASK_OWNERSHIP || __DOXYGEN__
+    void* owner;              /*!< Task owning the allocated block */
+#endif /* LWMEM_CFG_TASK_OWNERSHIP || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_AGE || __DOXYGEN__
+    uint32_t birth_tick;      /*!< Tick of the allocation, for stale-block reporting */
+#endif /* LWMEM_CFG_BLOCK_AGE || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_PINNING || __DOXYGEN__
+    uint16_t pin_cnt; /*!< Nesting pin counter, block must not move while non-zero */
+#endif /* LWMEM_CFG_BLOCK_PINNING || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_UDATA || __DOXYGEN__
+    size_t udata; /*!< Application metadata word, see \ref lwmem_set_udata_ex */
+#endif /* LWMEM_CFG_BLOCK_UDATA || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_GENERATION || __DOXYGEN__
+    uint32_t gen; /*!< Generation counter, bumped on every free of this block */
+#endif /* LWMEM_CFG_BLOCK_GENERATION || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_CHECKSUM || __DOXYGEN__
+    size_t chk;         /*!< Checksum over `next` and `size` fields */
+    size_t next_shadow; /*!< Complement copy of `next`, repair source for corrupted links */
+#endif /* LWMEM_CFG_BLOCK_CHECKSUM || __DOXYGEN__ */
 } lwmem_block_t;
 
 /**
  * \brief           Statistics structure
  */
 typedef struct {
-    uint32_t mem_size_bytes;                   /*!< Total memory size of all regions combined */
-    uint32_t mem_available_bytes;              /*!< Free memory available for allocation */
-    uint32_t minimum_ever_mem_available_bytes; /*!< Minimum amount of total free memory there has been
+    LWMEM_STATS_CNT_T mem_size_bytes;                   /*!< Total memory size of all regions combined */
+    LWMEM_STATS_CNT_T mem_available_bytes;              /*!< Free memory available for allocation */
+    LWMEM_STATS_CNT_T minimum_ever_mem_available_bytes; /*!< Minimum amount of total free memory there has been
                                                         in the heap since the system booted. */
-    uint32_t nr_alloc;                         /*!< Number of all allocated blocks in single instance  */
-    uint32_t nr_free;                          /*!< Number of frees in the LwMEM instance */
+    LWMEM_STATS_CNT_T nr_alloc;                         /*!< Number of all allocated blocks in single instance  */
+    LWMEM_STATS_CNT_T nr_free;                          /*!< Number of frees in the LwMEM instance */
+    LWMEM_STATS_CNT_T free_block_count;                 /*!< Number of blocks on the free list */
+    LWMEM_STATS_CNT_T largest_free_block_bytes;         /*!< Size of largest free block, including metadata */
+    LWMEM_STATS_CNT_T fragmentation_pct;                /*!< External fragmentation in percents:
+                                                        `100 - 100 * largest_free / total_free` */
 } lwmem_stats_t;
 
+/* Forward declaration, callbacks take instance they are registered on */
+struct lwmem;
+
+#if LWMEM_CFG_OOM_HANDLER || __DOXYGEN__
+
+/**
+ * \brief           Out-of-memory handler prototype
+ *
+ * Called outside the instance lock when allocation cannot be satisfied
+ *
+ * \param[in]       lwobj: LwMEM instance the failed allocation belongs to
+ * \param[in]       size: Application requested size that could not be served
+ * \return          `1` to retry the allocation (after handler released some memory),
+ *                      `0` to give up and return `NULL` to the caller
+ */
+typedef uint8_t (*lwmem_oom_handler_fn)(struct lwmem* lwobj, size_t size);
+
+#endif /* LWMEM_CFG_OOM_HANDLER || __DOXYGEN__ */
+
+#if LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__
+
+/**
+ * \brief           Allocation event types passed to event hook
+ */
+typedef enum {
+    LWMEM_EVT_ALLOC = 0x00,  /*!< Memory has been allocated, `ptr` is the new block */
+    LWMEM_EVT_FREE,          /*!< Memory has been freed, `ptr` is no longer valid */
+    LWMEM_EVT_REALLOC,       /*!< Memory has been reallocated, `ptr` is new location */
+    LWMEM_EVT_ALLOC_FAIL,    /*!< Allocation could not be satisfied, `ptr` is `NULL` */
+} lwmem_evt_type_t;
+
+/**
+ * \brief           Allocation event hook prototype
+ *
+ * Called outside the instance lock. Must not allocate or free memory
+ *
+ * \param[in]       lwobj: LwMEM instance the event belongs to
+ * \param[in]       evt_type: Event type
+ * \param[in]       ptr: Affected memory, semantics depend on event type
+ * \param[in]       size: Application requested size, `0` for free events
+ */
+typedef void (*lwmem_event_fn)(struct lwmem* lwobj, lwmem_evt_type_t evt_type, void* ptr, size_t size);
+
+#endif /* LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__ */
+
+#if LWMEM_CFG_PROFILING || __DOXYGEN__
+
+/**
+ * \brief           Latency profile of a single operation type
+ */
+typedef struct {
+    uint32_t min_cycles; /*!< Shortest observed operation, in cycles */
+    uint32_t max_cycles; /*!< Longest observed operation, in cycles */
+    uint32_t avg_cycles; /*!< Exponentially weighted moving average, in cycles */
+    uint32_t count;      /*!< Number of recorded operations */
+} lwmem_op_profile_t;
+
+/**
+ * \brief           Latency profiles of allocator operations
+ */
+typedef struct {
+    lwmem_op_profile_t alloc;      /*!< Allocation operations */
+    lwmem_op_profile_t free_op;    /*!< Free operations */
+    lwmem_op_profile_t realloc_op; /*!< Reallocation operations */
+} lwmem_profile_t;
+
+#endif /* LWMEM_CFG_PROFILING || __DOXYGEN__ */
+
+#if LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__
+
+/**
+ * \brief           Watermark callback prototype
+ *
+ * Called inside the instance lock; must be short and must not allocate
+ *
+ * \param[in]       lwobj: LwMEM instance the event belongs to
+ * \param[in]       above: Set to `0` when memory dropped below low threshold,
+ *                      `1` when it recovered above high threshold
+ * \param[in]       available: Current available bytes
+ */
+typedef void (*lwmem_watermark_fn)(struct lwmem* lwobj, uint8_t above, size_t available);
+
+#endif /* LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__ */
+
+#if LWMEM_CFG_EVICTABLE || __DOXYGEN__
+
+/**
+ * \brief           Eviction notification prototype
+ *
+ * Called under the instance lock right before the allocator frees the
+ * discardable block; owner must drop its reference. Must be short
+ * and must not allocate or free memory
+ *
+ * \param[in]       ptr: Block being evicted
+ * \param[in]       user: User argument of the registration
+ */
+typedef void (*lwmem_evict_fn)(void* ptr, void* user);
+
+#endif /* LWMEM_CFG_EVICTABLE || __DOXYGEN__ */
+
+#if LWMEM_CFG_RUNTIME_POLICY || __DOXYGEN__
+
+/**
+ * \brief           Runtime fit modes, see \ref lwmem_set_policy_ex
+ */
+typedef enum {
+    LWMEM_FIT_FIRST = 0x00, /*!< First fitting block is taken (default) */
+    LWMEM_FIT_BEST,         /*!< Block with least waste is taken */
+    LWMEM_FIT_NEXT,         /*!< Search resumes at most recent allocation point */
+} lwmem_fit_t;
+
+/**
+ * \brief           Runtime allocation policy
+ */
+typedef struct {
+    uint8_t fit_mode;           /*!< Fit mode, \ref lwmem_fit_t value */
+    size_t min_split_remainder; /*!< Split threshold, honored with \ref LWMEM_CFG_CONFIGURABLE_SPLIT */
+    uint8_t defer_free;         /*!< Defer coalescing on free, honored with \ref LWMEM_CFG_DEFERRED_COALESCING */
+} lwmem_policy_t;
+
+#endif /* LWMEM_CFG_RUNTIME_POLICY || __DOXYGEN__ */
+
 /**
  * \brief           LwMEM main structure
  */
 typedef struct lwmem {
+    const struct lwmem_region* regions_list; /*!< Application regions list, as passed to assign function.
+                                                  Must stay valid for instance lifetime */
+#if !LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+    _Atomic(size_t) mem_available_bytes; /*!< Memory size available for allocation */
+#else
     size_t mem_available_bytes; /*!< Memory size available for allocation */
+#endif /* !LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC */
 #if LWMEM_CFG_FULL
     lwmem_block_t start_block; /*!< Holds beginning of memory allocation regions */
     lwmem_block_t* end_block;  /*!< Pointer to the last memory location in regions linked list */
     size_t mem_regions_count;  /*!< Number of regions used for allocation */
+#if (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_SEGREGATED) || __DOXYGEN__
+    struct lwmem_block* free_bins[LWMEM_CFG_SEGREGATED_BIN_COUNT]; /*!< Heads of segregated free lists,
+                                                                        one entry per size class */
+#elif LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_TLSF
+    struct lwmem_block* free_bins[LWMEM_CFG_TLSF_FL_COUNT << LWMEM_CFG_TLSF_SL_COUNT_LOG2]; /*!< Heads of free lists,
+                                                                        one entry per (first, second) level class */
+    uint32_t fl_bitmap;                             /*!< Bitmap of non-empty first-level classes */
+    uint32_t sl_bitmap[LWMEM_CFG_TLSF_FL_COUNT];    /*!< Bitmaps of non-empty second-level classes */
+#elif LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_NEXT_FIT
+    struct lwmem_block* next_fit_prev; /*!< Block preceding the point where next search resumes (roving pointer) */
+#elif LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BUDDY
+    uint8_t* buddy_base;                  /*!< Start address of buddy-managed memory */
+    size_t buddy_size;                    /*!< Power-of-two size of buddy-managed memory */
+    struct lwmem_block* buddy_lists[sizeof(size_t) * 8]; /*!< Heads of free lists, one entry per order */
+#endif /* LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BUDDY */
+#if LWMEM_CFG_COMPACT_HEADER || __DOXYGEN__
+    uint8_t* compact_base; /*!< Start address of memory managed with compact headers */
+#if LWMEM_CFG_COMPACT_HEADER_32
+    uint32_t compact_free_offs; /*!< Offset of first free block, all-ones value when list is empty */
+#else
+    uint16_t compact_free_offs; /*!< Offset of first free block, all-ones value when list is empty */
+#endif /* LWMEM_CFG_COMPACT_HEADER_32 */
+#endif /* LWMEM_CFG_COMPACT_HEADER || __DOXYGEN__ */
+#if LWMEM_CFG_SKIP_INDEX || __DOXYGEN__
+    struct lwmem_block* skip_head[LWMEM_CFG_SKIP_INDEX_LEVELS]; /*!< Heads of skip-list index levels */
+    size_t free_block_count;                                    /*!< Number of blocks in skip-list index */
+    uint32_t skip_counter;                                      /*!< Deterministic counter for tower level selection */
+#endif /* LWMEM_CFG_SKIP_INDEX || __DOXYGEN__ */
+#if (LWMEM_CFG_EMERGENCY_RESERVE_SIZE > 0) || __DOXYGEN__
+    uint8_t reserve_bypass; /*!< Set to `1` while critical allocation may use the emergency reserve */
+#endif /* (LWMEM_CFG_EMERGENCY_RESERVE_SIZE > 0) || __DOXYGEN__ */
+#if LWMEM_CFG_ZERO_TRACKING || __DOXYGEN__
+    uint8_t* alloc_watermark; /*!< Highest address ever handed out to the application.
+                                    Non-metadata memory above it is known to be untouched */
+#endif /* LWMEM_CFG_ZERO_TRACKING || __DOXYGEN__ */
+#if LWMEM_CFG_DEFERRED_COALESCING || __DOXYGEN__
+    struct lwmem_block* deferred_free; /*!< Head of deferred free blocks list, waiting for coalescing */
+#endif /* LWMEM_CFG_DEFERRED_COALESCING || __DOXYGEN__ */
+#if LWMEM_CFG_CLEAN_MEMORY_DEFERRED || __DOXYGEN__
+    struct lwmem_block* scrub_pending; /*!< Head of dirty freed blocks waiting for scrubbing */
+    size_t scrub_done;                 /*!< Number of already scrubbed bytes of the head pending block */
+#endif /* LWMEM_CFG_CLEAN_MEMORY_DEFERRED || __DOXYGEN__ */
+#if LWMEM_CFG_FREE_FROM_ISR || __DOXYGEN__
+#ifdef __cplusplus
+    void* isr_free_head; /*!< Head of lock-free queue with blocks freed from interrupt context */
+#else
+    _Atomic(void*) isr_free_head; /*!< Head of lock-free queue with blocks freed from interrupt context */
+#endif /* __cplusplus */
+#endif /* LWMEM_CFG_FREE_FROM_ISR || __DOXYGEN__ */
+#if LWMEM_CFG_SMALL_REGION_ROUTING || __DOXYGEN__
+    size_t small_threshold;   /*!< Allocations up to this size route to the designated region, `0` disables */
+    uint8_t small_region_idx; /*!< Index of the designated small-block region */
+#endif /* LWMEM_CFG_SMALL_REGION_ROUTING || __DOXYGEN__ */
+#if LWMEM_CFG_SIZE_ORDERED_LIST || __DOXYGEN__
+    struct lwmem_block* so_head; /*!< Head of size-ordered (ascending) free list */
+#endif /* LWMEM_CFG_SIZE_ORDERED_LIST || __DOXYGEN__ */
+#if LWMEM_CFG_OOB_METADATA || __DOXYGEN__
+    uint8_t* oob_base;     /*!< Start address of contiguous user data area */
+    size_t oob_data_size;  /*!< Size of user data area in units of bytes */
+    void* oob_table;       /*!< Side table with one entry per allocated block, offset sorted */
+    uint32_t oob_count;    /*!< Number of live entries in the side table */
+    uint32_t oob_capacity; /*!< Maximal number of entries the side table can hold */
+#endif /* LWMEM_CFG_OOB_METADATA || __DOXYGEN__ */
+#if LWMEM_CFG_PER_REGION_LISTS || __DOXYGEN__
+    struct {
+        struct lwmem_block* head; /*!< Stable free-list entry preceding first block of the region */
+        void* start_addr;         /*!< Aligned region start address */
+        size_t size;              /*!< Aligned region size in units of bytes */
+#if LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__
+        uint16_t attr;            /*!< Attribute flags copied from region descriptor */
+        uint8_t priority;         /*!< Allocation preference copied from region descriptor */
+#endif /* LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__ */
+#if LWMEM_CFG_PER_REGION_STATS || __DOXYGEN__
+        lwmem_stats_t stats;      /*!< Statistics of the region */
+#endif /* LWMEM_CFG_PER_REGION_STATS || __DOXYGEN__ */
+#if LWMEM_CFG_REGION_FALLBACK || __DOXYGEN__
+        uint8_t fallback_idx;     /*!< Region to overflow to when this one is full, `0xFF` for none */
+#endif /* LWMEM_CFG_REGION_FALLBACK || __DOXYGEN__ */
+#if LWMEM_CFG_WEAR_LEVELING || __DOXYGEN__
+        size_t wear_offs;         /*!< Rotating search start offset of wear-leveled placement */
+#endif /* LWMEM_CFG_WEAR_LEVELING || __DOXYGEN__ */
+    } region_heads[LWMEM_CFG_MAX_REGIONS]; /*!< Per-region free list anchors */
+#endif /* LWMEM_CFG_PER_REGION_LISTS || __DOXYGEN__ */
+#else
+#if LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+    _Atomic(uint8_t*) mem_next_available_ptr; /*!< Pointer for next allocation, advanced with CAS */
+    uint8_t* mem_end_ptr;                     /*!< First address after the managed region */
 #else
     uint8_t* mem_next_available_ptr; /*!< Pointer for next allocation */
+    size_t region_idx;               /*!< Index of region currently being allocated from */
+#endif /* LWMEM_CFG_ATOMIC_SIMPLE_ALLOC */
     uint8_t is_initialized;          /*!< Set to `1` when initialized */
 #endif
 
+#if LWMEM_CFG_OOM_HANDLER || __DOXYGEN__
+    lwmem_oom_handler_fn oom_handler; /*!< Optional handler called on failed allocations */
+#endif /* LWMEM_CFG_OOM_HANDLER || __DOXYGEN__ */
+#if LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__
+    lwmem_event_fn event_hook; /*!< Optional hook fired on allocation events */
+#endif /* LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__ */
+#if LWMEM_CFG_PROFILING || __DOXYGEN__
+    lwmem_profile_t profile; /*!< Latency profiles of operations */
+#endif /* LWMEM_CFG_PROFILING || __DOXYGEN__ */
+#if (LWMEM_CFG_REDZONE_SIZE > 0) || __DOXYGEN__
+    uint32_t redzone_violations; /*!< Number of detected guard zone violations */
+#endif /* (LWMEM_CFG_REDZONE_SIZE > 0) || __DOXYGEN__ */
+#if LWMEM_CFG_CONFIGURABLE_SPLIT || __DOXYGEN__
+    size_t min_split_remainder; /*!< Remainders below this size are not split off allocated blocks */
+#endif /* LWMEM_CFG_CONFIGURABLE_SPLIT || __DOXYGEN__ */
+#if LWMEM_CFG_REALLOC_GROWTH || __DOXYGEN__
+    uint16_t realloc_growth_pct; /*!< Relocating realloc reserves `size * pct / 100` capacity, `0` disables */
+#endif /* LWMEM_CFG_REALLOC_GROWTH || __DOXYGEN__ */
+#if LWMEM_CFG_OP_JOURNAL || __DOXYGEN__
+    struct lwmem_journal* journal; /*!< Attached noinit journal record, `NULL` when not used */
+#endif /* LWMEM_CFG_OP_JOURNAL || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_PINNING || __DOXYGEN__
+    uint8_t (*move_handler)(void* old_ptr, void* new_ptr, size_t size,
+                            void* user); /*!< Registered relocation fix-up handler */
+    void* move_handler_user;             /*!< User argument of registered relocation handler */
+#endif /* LWMEM_CFG_BLOCK_PINNING || __DOXYGEN__ */
+#if LWMEM_CFG_BOUNDED_LOCK || __DOXYGEN__
+    uint32_t bound_alloc_aborts; /*!< Number of allocations failed by the walk bound */
+#endif /* LWMEM_CFG_BOUNDED_LOCK || __DOXYGEN__ */
+#if LWMEM_CFG_BLOCK_CHECKSUM || __DOXYGEN__
+    uint32_t chk_detected; /*!< Number of unrecoverable header corruptions detected */
+    uint32_t chk_repaired; /*!< Number of headers repaired from shadow link copy */
+#endif /* LWMEM_CFG_BLOCK_CHECKSUM || __DOXYGEN__ */
+#if LWMEM_CFG_PERSIST || __DOXYGEN__
+    void* persist_hdr; /*!< Persistent region header of the instance, `NULL` when not persistent */
+#endif /* LWMEM_CFG_PERSIST || __DOXYGEN__ */
+#if LWMEM_CFG_RT_TIER || __DOXYGEN__
+    struct {
+        void* head;        /*!< Free stack of reserved blocks of this class */
+        size_t block_size; /*!< Uniform internal block size of the class, `0` for unused entry */
+        uint16_t total;    /*!< Guaranteed number of blocks */
+        uint16_t avail;    /*!< Blocks currently available for \ref lwmem_malloc_rt_ex */
+    } rt_classes[LWMEM_CFG_RT_TIER_CLASSES]; /*!< Guaranteed-latency tier seat map */
+#endif /* LWMEM_CFG_RT_TIER || __DOXYGEN__ */
+#if LWMEM_CFG_EXACT_CACHE || __DOXYGEN__
+    struct {
+        struct lwmem_block* block; /*!< Cached block, still carrying its allocation mark */
+        size_t size;               /*!< Block size the entry is keyed on */
+    } exact_cache[LWMEM_CFG_EXACT_CACHE_SIZE]; /*!< Direct-mapped cache of last-freed blocks */
+#endif /* LWMEM_CFG_EXACT_CACHE || __DOXYGEN__ */
+#if LWMEM_CFG_CONST_TIME_POOL || __DOXYGEN__
+    struct lwmem_pool* ct_pool; /*!< Attached constant-time pool, `NULL` when not used */
+    uint8_t* ct_base;           /*!< Start address of pool memory, for free routing */
+    size_t ct_range;            /*!< Length of pool memory range in bytes */
+    size_t ct_max_size;         /*!< Largest request size routed to the pool */
+#endif /* LWMEM_CFG_CONST_TIME_POOL || __DOXYGEN__ */
+#if LWMEM_CFG_AUDIT_REUSE || __DOXYGEN__
+    uint32_t audit_reuse_ewma;  /*!< Moving average of free-to-reuse latency, in ticks */
+    uint32_t audit_exact_hits;  /*!< Number of reuses at the exact freed size */
+    uint32_t audit_samples;     /*!< Number of audited reuses */
+#endif /* LWMEM_CFG_AUDIT_REUSE || __DOXYGEN__ */
+#if LWMEM_CFG_RUNTIME_POLICY || __DOXYGEN__
+    uint8_t policy_fit;               /*!< Active fit mode, \ref lwmem_fit_t value */
+    uint8_t policy_defer;             /*!< Active defer-free flag */
+    struct lwmem_block* policy_rover; /*!< Roving pointer of runtime next-fit mode */
+#endif /* LWMEM_CFG_RUNTIME_POLICY || __DOXYGEN__ */
+#if LWMEM_CFG_PER_INSTANCE_ALIGN || __DOXYGEN__
+    size_t instance_align; /*!< Instance specific alignment, `0` uses compile-time default.
+                                Must be configured before region assignment */
+#endif /* LWMEM_CFG_PER_INSTANCE_ALIGN || __DOXYGEN__ */
+#if LWMEM_CFG_FAULT_INJECT || __DOXYGEN__
+    uint32_t fi_countdown; /*!< Remaining allocations until injected failure, `0` disables */
+    size_t fi_above_size;  /*!< Allocations above this size fail, `0` disables */
+    uint16_t fi_permille;  /*!< Probability of failure in permille, `0` disables */
+    uint32_t fi_rng;       /*!< Deterministic PRNG state for probabilistic failures */
+#endif /* LWMEM_CFG_FAULT_INJECT || __DOXYGEN__ */
+#if LWMEM_CFG_EVICTABLE || __DOXYGEN__
+    struct {
+        void* ptr;          /*!< Registered discardable block, `NULL` for unused entries */
+        lwmem_evict_fn evict_cb; /*!< Owner notification callback */
+        void* user;         /*!< User argument of the callback */
+        uint32_t tick;      /*!< Last-touch tick for LRU ordering */
+    } evictable[LWMEM_CFG_EVICTABLE_MAX]; /*!< Registered discardable blocks */
+    uint32_t evict_tick;    /*!< Monotonic touch counter */
+#endif /* LWMEM_CFG_EVICTABLE || __DOXYGEN__ */
+#if LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__
+    lwmem_watermark_fn wm_callback; /*!< Optional watermark crossing callback */
+    size_t wm_low;                  /*!< Low threshold of available bytes */
+    size_t wm_high;                 /*!< Recovery threshold of available bytes */
+    uint8_t wm_below;               /*!< Set to `1` while below low threshold (fired already) */
+#endif /* LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__ */
+#if LWMEM_CFG_ALLOC_HISTOGRAM || __DOXYGEN__
+    uint32_t alloc_histogram[LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS]; /*!< Requested-size counters in log2 buckets */
+#endif /* LWMEM_CFG_ALLOC_HISTOGRAM || __DOXYGEN__ */
 #if LWMEM_CFG_OS || __DOXYGEN__
     LWMEM_CFG_OS_MUTEX_HANDLE mutex; /*!< System mutex for OS */
+#if LWMEM_CFG_PER_INSTANCE_LOCKING || __DOXYGEN__
+    uint8_t lock_disabled; /*!< Set to `1` before region assignment to skip locking for this instance */
+#endif /* LWMEM_CFG_PER_INSTANCE_LOCKING || __DOXYGEN__ */
 #endif                               /* LWMEM_CFG_OS || __DOXYGEN__ */
 #if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
     lwmem_stats_t stats; /*!< Statistics */
+#if LWMEM_CFG_WINDOWED_STATS || __DOXYGEN__
+    uint32_t win_min_avail;    /*!< Minimum available bytes within current window */
+    uint32_t win_alloc_snap;   /*!< Allocation counter snapshot at window start */
+    uint32_t win_free_snap;    /*!< Free counter snapshot at window start */
+#endif /* LWMEM_CFG_WINDOWED_STATS || __DOXYGEN__ */
 #endif                   /* LWMEM_CFG_ENABLE_STATS || __DOXYGEN__ */
 #if defined(LWMEM_DEV) && !__DOXYGEN__
     lwmem_block_t start_block_first_use; /*!< Value of start block for very first time.
@@ -105,41 +469,677 @@ typedef struct lwmem {
 #endif                                   /* defined(LWMEM_DEV) && !__DOXYGEN__ */
 } lwmem_t;
 
+#if LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__
+
+/**
+ * \brief           Region is in fast (low latency) memory
+ */
+#define LWMEM_REGION_ATTR_FAST ((uint16_t)0x0001U)
+
+/**
+ * \brief           Region is safe for DMA transfers
+ */
+#define LWMEM_REGION_ATTR_DMA  ((uint16_t)0x0002U)
+
+/**
+ * \brief           Region is in persistent memory with finite write endurance,
+ *                      see \ref LWMEM_CFG_WEAR_LEVELING
+ */
+#define LWMEM_REGION_ATTR_PERSISTENT ((uint16_t)0x0004U)
+
+#endif /* LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__ */
+
 /**
  * \brief           Memory region descriptor
  */
-typedef struct {
+typedef struct lwmem_region {
     void* start_addr; /*!< Region start address */
     size_t size;      /*!< Size of region in units of bytes */
+#if LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__
+    uint16_t attr;    /*!< Attribute flags of region memory, `LWMEM_REGION_ATTR_xxx` values or application bits */
+    uint8_t priority; /*!< Allocation preference, lower value is tried first on region-less allocation */
+#endif /* LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__ */
 } lwmem_region_t;
 
+/**
+ * \brief           Heap walk callback prototype
+ * \param[in]       lwobj: LwMEM instance being walked
+ * \param[in]       block_addr: Block start address (metadata header)
+ * \param[in]       block_size: Block size including metadata, in units of bytes
+ * \param[in]       is_free: Set to `1` for free blocks, `0` for allocated ones
+ * \param[in]       user: User argument passed to walk function
+ * \return          `1` to continue walking, `0` to stop
+ */
+typedef uint8_t (*lwmem_walk_fn)(struct lwmem* lwobj, void* block_addr, size_t block_size, uint8_t is_free,
+                                 void* user);
+
+#if (LWMEM_CFG_FULL && !LWMEM_CFG_OS && !LWMEM_CFG_COMPACT_HEADER && !LWMEM_CFG_OOB_METADATA                            \
+     && (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_FIRST_FIT                                                    \
+         || LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BEST_FIT))                                                \
+    || __DOXYGEN__
+
+/**
+ * \brief           Define fully initialized static heap with zero runtime setup cost
+ *
+ * Emits the backing buffer, the region table and a pre-validated instance,
+ * so the very first allocation works without any init call - removing init
+ * ordering hazards and the boot-time region validation walk. Use as
+ *
+ * \code{.c}
+LWMEM_DEFINE_STATIC_HEAP(my_heap, 8192);
+void* ptr = lwmem_malloc_ex(&my_heap, NULL, 128);
+\endcode
+ *
+ * \note            Only available in configurations whose instance state is
+ *                      fully expressible as a constant initializer: full manager with
+ *                      first-fit/best-fit strategy, no OS mutex. Requires designated
+ *                      initializers (C99, or C++20 for the C++ equivalent usage)
+ *
+ * \param           name: Name of the emitted `lwmem_t` instance
+ * \param           heap_size: Usable heap size in units of bytes, multiple of \ref LWMEM_CFG_ALIGN_NUM
+ */
+#define LWMEM_DEFINE_STATIC_HEAP(name, heap_size)                                                                      \
+    static struct {                                                                                                    \
+        lwmem_block_t first_block; /* Header of the single initial free block */                                       \
+        uint8_t data[(heap_size)]; /* Usable application memory */                                                     \
+        lwmem_block_t end_block;   /* End of region indicator */                                                       \
+    } name##_storage = {                                                                                               \
+        .first_block = {.next = &name##_storage.end_block, .size = sizeof(lwmem_block_t) + (heap_size)},               \
+        .end_block = {.next = NULL, .size = 0},                                                                        \
+    };                                                                                                                 \
+    static const lwmem_region_t name##_regions[] = {                                                                   \
+        {&name##_storage, sizeof(name##_storage)},                                                                     \
+        {NULL, 0},                                                                                                     \
+    };                                                                                                                 \
+    static lwmem_t name = {                                                                                            \
+        .regions_list = name##_regions,                                                                                \
+        .mem_available_bytes = sizeof(lwmem_block_t) + (heap_size),                                                    \
+        .start_block = {.next = &name##_storage.first_block, .size = 0},                                               \
+        .end_block = &name##_storage.end_block,                                                                        \
+        .mem_regions_count = 1,                                                                                        \
+    }
+
+#endif /* static heap configurations || __DOXYGEN__ */
+
+#if LWMEM_CFG_BUILTIN_MEMFN || __DOXYGEN__
+void* lwmem_builtin_memset(void* dst, int val, size_t len);
+void* lwmem_builtin_memcpy(void* dst, const void* src, size_t len);
+void* lwmem_builtin_memmove(void* dst, const void* src, size_t len);
+#endif /* LWMEM_CFG_BUILTIN_MEMFN || __DOXYGEN__ */
+
 size_t lwmem_assignmem_ex(lwmem_t* lwobj, const lwmem_region_t* regions);
+#if LWMEM_CFG_FULL || __DOXYGEN__
+size_t lwmem_walk_ex(lwmem_t* lwobj, lwmem_walk_fn callback, void* user);
+
+/**
+ * \brief           Snapshot stream writer prototype
+ * \param[in]       user: User argument passed to snapshot function
+ * \param[in]       data: Data chunk to write
+ * \param[in]       len: Number of bytes to write
+ * \return          `1` to continue streaming, `0` to abort
+ */
+typedef uint8_t (*lwmem_snapshot_write_fn)(void* user, const void* data, size_t len);
+
+uint8_t lwmem_snapshot_ex(lwmem_t* lwobj, lwmem_snapshot_write_fn write_fn, void* user);
+
+/**
+ * \brief           Snapshot difference callback prototype
+ * \param[in]       region_addr: Region base address of the new allocation
+ * \param[in]       offset: Block offset within the region
+ * \param[in]       size: Block size including metadata
+ * \param[in]       user: User argument
+ */
+typedef void (*lwmem_snapshot_diff_fn)(uintptr_t region_addr, uint32_t offset, uint32_t size, void* user);
+
+size_t lwmem_snapshot_diff(const void* snap_a, size_t len_a, const void* snap_b, size_t len_b,
+                           lwmem_snapshot_diff_fn report_fn, void* user);
+
+/**
+ * \brief           Heap validation fault codes returned by \ref lwmem_validate_ex
+ */
+typedef enum {
+    LWMEM_VALIDATE_OK = 0x00,    /*!< No corruption detected */
+    LWMEM_VALIDATE_ERR_SIZE,     /*!< Block size is zero-crossing, unaligned or out of region */
+    LWMEM_VALIDATE_ERR_MARK,     /*!< Allocated block carries an invalid allocation mark */
+    LWMEM_VALIDATE_ERR_CHAIN,    /*!< Physical chain does not terminate at end of region indicator */
+    LWMEM_VALIDATE_ERR_ORDER,    /*!< Free list is not strictly address ordered */
+    LWMEM_VALIDATE_ERR_FREE_BIT, /*!< Free list entry is marked as allocated */
+    LWMEM_VALIDATE_ERR_LIST_PTR, /*!< Free list link points outside of any region */
+} lwmem_validate_res_t;
+
+lwmem_validate_res_t lwmem_validate_ex(lwmem_t* lwobj, size_t max_blocks, void** fault_addr);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+lwmem_t* lwmem_create_in_region(const lwmem_region_t* region);
+#if LWMEM_CFG_FULL || __DOXYGEN__
+lwmem_t* lwmem_subheap_create_ex(lwmem_t* parent, size_t size);
+void lwmem_subheap_destroy_ex(lwmem_t* parent, lwmem_t* subheap);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+uint8_t lwmem_reset_ex(lwmem_t* lwobj);
+uint8_t lwmem_reset(void);
+#if LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__
+void lwmem_set_event_hook_ex(lwmem_t* lwobj, lwmem_event_fn hook);
+#endif /* LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__ */
+#if (LWMEM_CFG_EVENT_HOOKS && LWMEM_CFG_EVENT_STREAM) || __DOXYGEN__
+uint8_t lwmem_stream_attach_ex(lwmem_t* lwobj, uint8_t* ring, size_t len);
+size_t lwmem_stream_head(void);
+#endif /* (LWMEM_CFG_EVENT_HOOKS && LWMEM_CFG_EVENT_STREAM) || __DOXYGEN__ */
+#if LWMEM_CFG_PROFILING || __DOXYGEN__
+void lwmem_get_profile_ex(lwmem_t* lwobj, lwmem_profile_t* profile);
+#endif /* LWMEM_CFG_PROFILING || __DOXYGEN__ */
+#if LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__
+void lwmem_set_watermarks_ex(lwmem_t* lwobj, size_t low, size_t high, lwmem_watermark_fn callback);
+#endif /* LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__ */
+#if LWMEM_CFG_FAULT_INJECT || __DOXYGEN__
+void lwmem_fault_inject_ex(lwmem_t* lwobj, uint32_t fail_nth, size_t fail_above_size, uint16_t fail_permille);
+#endif /* LWMEM_CFG_FAULT_INJECT || __DOXYGEN__ */
+#if (LWMEM_CFG_REDZONE_SIZE > 0) || __DOXYGEN__
+size_t lwmem_redzone_check_ex(lwmem_t* lwobj, size_t max_blocks);
+uint32_t lwmem_redzone_violations_ex(lwmem_t* lwobj);
+#endif /* (LWMEM_CFG_REDZONE_SIZE > 0) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_ALLOC_TAGS) || __DOXYGEN__
+
+/**
+ * \brief           Allocation site report callback prototype
+ * \param[in]       tag: Site tag
+ * \param[in]       live_bytes: Currently allocated bytes of the site
+ * \param[in]       live_count: Currently allocated blocks of the site
+ * \param[in]       total_count: Number of allocations ever done by the site
+ * \param[in]       user: User argument
+ */
+typedef void (*lwmem_tag_report_fn)(const char* tag, size_t live_bytes, uint32_t live_count, uint32_t total_count,
+                                    void* user);
+
+void* lwmem_malloc_tagged_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t size, const char* tag);
+void lwmem_tag_report_ex(lwmem_t* lwobj, lwmem_tag_report_fn callback, void* user);
+
+/**
+ * \brief           Helper to stringify line numbers in \ref LWMEM_MALLOC_TAGGED
+ */
+#define LWMEM_TAG_STR2(x)        #x
+#define LWMEM_TAG_STR(x)         LWMEM_TAG_STR2(x)
+
+/**
+ * \brief           Allocate from default instance, tagged with current file and line
+ * \param[in]       size: Number of bytes to allocate
+ */
+#define LWMEM_MALLOC_TAGGED(size) lwmem_malloc_tagged_ex(NULL, NULL, (size), __FILE__ ":" LWMEM_TAG_STR(__LINE__))
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_ALLOC_TAGS) || __DOXYGEN__ */
+#if LWMEM_CFG_ALLOC_HISTOGRAM || __DOXYGEN__
+size_t lwmem_get_histogram_ex(lwmem_t* lwobj, uint32_t* buckets, size_t bucket_count);
+#endif /* LWMEM_CFG_ALLOC_HISTOGRAM || __DOXYGEN__ */
+#if LWMEM_CFG_INSTANCE_REGISTRY || __DOXYGEN__
+lwmem_t* lwmem_find_owner(void* ptr);
+#if LWMEM_CFG_FULL || __DOXYGEN__
+uint8_t lwmem_free_any(void* ptr);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#endif /* LWMEM_CFG_INSTANCE_REGISTRY || __DOXYGEN__ */
 void* lwmem_malloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size);
+#if LWMEM_CFG_OOM_HANDLER || __DOXYGEN__
+void lwmem_set_oom_handler_ex(lwmem_t* lwobj, lwmem_oom_handler_fn handler);
+#endif /* LWMEM_CFG_OOM_HANDLER || __DOXYGEN__ */
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT || __DOXYGEN__
+void* lwmem_malloc_try_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, uint32_t timeout_ms);
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT || __DOXYGEN__ */
 void* lwmem_calloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t nitems, const size_t size);
-#if LWMEM_CFG_FULL || __DOXYGEN__
+#if (LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC) || __DOXYGEN__
 void* lwmem_realloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, void* const ptr, const size_t size);
+void* lwmem_realloc_nopreserve_ex(lwmem_t* lwobj, const lwmem_region_t* region, void* const ptr,
+                                  const size_t size);
 int lwmem_realloc_s_ex(lwmem_t* lwobj, const lwmem_region_t* region, void** const ptr, const size_t size);
+void* lwmem_expand_ex(lwmem_t* lwobj, void* const ptr, const size_t size);
+#if LWMEM_CFG_REALLOC_GROWTH || __DOXYGEN__
+void lwmem_set_realloc_growth_ex(lwmem_t* lwobj, uint16_t growth_pct);
+#endif /* LWMEM_CFG_REALLOC_GROWTH || __DOXYGEN__ */
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC) || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+void* lwmem_shrink_ex(lwmem_t* lwobj, void* const ptr, const size_t size);
+void* lwmem_malloc_reserve_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, const size_t reserve);
+size_t lwmem_get_capacity_ex(lwmem_t* lwobj, void* ptr);
+uint8_t lwmem_malloc_many_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, void** out_ptrs,
+                             size_t count);
+#if (LWMEM_CFG_EMERGENCY_RESERVE_SIZE > 0) || __DOXYGEN__
+void* lwmem_malloc_critical_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size);
+#endif /* (LWMEM_CFG_EMERGENCY_RESERVE_SIZE > 0) || __DOXYGEN__ */
+#if LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__
+void* lwmem_malloc_attr_ex(lwmem_t* lwobj, uint16_t attr, const size_t size);
+void* lwmem_malloc_dma_ex(lwmem_t* lwobj, const size_t size);
+void lwmem_dma_cache_clean(void* ptr, size_t len);
+void lwmem_dma_cache_invalidate(void* ptr, size_t len);
+#endif /* LWMEM_CFG_REGION_ATTRIBUTES || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+void lwmem_dma_prepare_ex(lwmem_t* lwobj, void* ptr, size_t len);
+void lwmem_dma_complete_ex(lwmem_t* lwobj, void* ptr, size_t len);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+uint8_t lwmem_region_attach_ex(lwmem_t* lwobj, const lwmem_region_t* region);
+#if LWMEM_CFG_PER_REGION_STATS || __DOXYGEN__
+uint8_t lwmem_get_region_stats_ex(lwmem_t* lwobj, size_t region_idx, lwmem_stats_t* stats);
+#endif /* LWMEM_CFG_PER_REGION_STATS || __DOXYGEN__ */
+#if LWMEM_CFG_SMALL_REGION_ROUTING || __DOXYGEN__
+uint8_t lwmem_set_small_region_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t threshold);
+#endif /* LWMEM_CFG_SMALL_REGION_ROUTING || __DOXYGEN__ */
+#if LWMEM_CFG_REGION_FALLBACK || __DOXYGEN__
+uint8_t lwmem_set_region_fallback_ex(lwmem_t* lwobj, const lwmem_region_t* region,
+                                     const lwmem_region_t* fallback_region);
+#endif /* LWMEM_CFG_REGION_FALLBACK || __DOXYGEN__ */
+uint8_t lwmem_region_detach_ex(lwmem_t* lwobj, const lwmem_region_t* region);
+uint8_t lwmem_trim_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t min_keep, lwmem_region_t* recovered);
+void lwmem_free_many_ex(lwmem_t* lwobj, void** ptrs, size_t count);
+void* lwmem_malloc_aligned_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, const size_t align);
 void lwmem_free_ex(lwmem_t* lwobj, void* const ptr);
+uint8_t lwmem_free_checked_ex(lwmem_t* lwobj, void* const ptr);
+void lwmem_free_sized_ex(lwmem_t* lwobj, void* const ptr, const size_t size);
+#if LWMEM_CFG_RUNTIME_POLICY || __DOXYGEN__
+uint8_t lwmem_set_policy_ex(lwmem_t* lwobj, const lwmem_policy_t* policy);
+#endif /* LWMEM_CFG_RUNTIME_POLICY || __DOXYGEN__ */
+#if LWMEM_CFG_CONFIGURABLE_SPLIT || __DOXYGEN__
+void lwmem_set_split_threshold_ex(lwmem_t* lwobj, size_t min_remainder);
+#endif /* LWMEM_CFG_CONFIGURABLE_SPLIT || __DOXYGEN__ */
+#if LWMEM_CFG_PER_INSTANCE_ALIGN || __DOXYGEN__
+uint8_t lwmem_set_instance_align_ex(lwmem_t* lwobj, size_t align);
+#endif /* LWMEM_CFG_PER_INSTANCE_ALIGN || __DOXYGEN__ */
 void lwmem_free_s_ex(lwmem_t* lwobj, void** const ptr);
 size_t lwmem_get_size_ex(lwmem_t* lwobj, void* ptr);
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_DEFERRED_COALESCING) || __DOXYGEN__
+void lwmem_coalesce_ex(lwmem_t* lwobj);
+void lwmem_coalesce(void);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_DEFERRED_COALESCING) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_CLEAN_MEMORY_DEFERRED) || __DOXYGEN__
+size_t lwmem_scrub_step_ex(lwmem_t* lwobj, size_t max_bytes);
+size_t lwmem_scrub_step(size_t max_bytes);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_CLEAN_MEMORY_DEFERRED) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE) || __DOXYGEN__
+void lwmem_cpu_cache_flush(void);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE) || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+size_t lwmem_prewarm_ex(lwmem_t* lwobj, const size_t* sizes, const uint32_t* counts, size_t n);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_THREAD_CACHE) || __DOXYGEN__
+void lwmem_thread_cache_flush(void);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_THREAD_CACHE) || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Movable-block relocation callback prototype
+ *
+ * Called while instance lock is held, after content has been copied to the
+ * new location. Callback must fix up the owner's pointer and return `1` to
+ * accept the move, or `0` when the block must not move (it is then left intact)
+ *
+ * \param[in]       old_ptr: Current block address
+ * \param[in]       new_ptr: Proposed (lower) block address with content already in place
+ * \param[in]       size: Application size of the block
+ * \param[in]       user: User argument of the defragmentation call
+ * \return          `1` to accept relocation, `0` to reject it
+ */
+typedef uint8_t (*lwmem_move_fn)(void* old_ptr, void* new_ptr, size_t size, void* user);
+
+size_t lwmem_defrag_step_ex(lwmem_t* lwobj, size_t budget_bytes, lwmem_move_fn move_cb, void* user);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+uint8_t lwmem_migrate_ex(lwmem_t* src, lwmem_t* dst, void* ptr);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Single chunk of a scatter allocation
+ */
+typedef struct {
+    void* ptr;  /*!< Chunk memory */
+    size_t len; /*!< Chunk length in units of bytes */
+} lwmem_sg_chunk_t;
+
+/**
+ * \brief           Scatter allocation descriptor, iovec-style list of chunks
+ */
+typedef struct {
+    lwmem_sg_chunk_t chunks[LWMEM_CFG_SG_MAX_CHUNKS]; /*!< Allocated chunks in logical order */
+    size_t count;                                     /*!< Number of valid chunks */
+    size_t total;                                     /*!< Total allocation length in units of bytes */
+} lwmem_sg_t;
+
+uint8_t lwmem_sg_alloc_ex(lwmem_t* lwobj, lwmem_sg_t* sg, size_t size);
+void* lwmem_compound_alloc_ex(lwmem_t* lwobj, const size_t* sizes, const size_t* aligns, size_t count,
+                              lwmem_sg_chunk_t* parts);
+void lwmem_sg_free_ex(lwmem_t* lwobj, lwmem_sg_t* sg);
+size_t lwmem_sg_read(const lwmem_sg_t* sg, size_t offs, void* dst, size_t len);
+size_t lwmem_sg_write(const lwmem_sg_t* sg, size_t offs, const void* src, size_t len);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_PERSIST) || __DOXYGEN__
+uint8_t lwmem_persist_init_ex(lwmem_t* lwobj, lwmem_region_t* regions);
+uint8_t lwmem_attach_existing_ex(lwmem_t* lwobj, lwmem_region_t* regions);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_PERSIST) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BOUNDED_LOCK) || __DOXYGEN__
+uint32_t lwmem_bound_aborts_ex(lwmem_t* lwobj);
+size_t lwmem_coalesce_step_ex(lwmem_t* lwobj, size_t max_blocks);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BOUNDED_LOCK) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_RT_TIER) || __DOXYGEN__
+uint8_t lwmem_rt_reserve_ex(lwmem_t* lwobj, size_t size, size_t count);
+void* lwmem_malloc_rt_ex(lwmem_t* lwobj, size_t size);
+uint8_t lwmem_free_rt_ex(lwmem_t* lwobj, void* ptr);
+size_t lwmem_rt_avail_ex(lwmem_t* lwobj, size_t size);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_RT_TIER) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_GENERATION) || __DOXYGEN__
+
+/**
+ * \brief           Generation-validated block reference (fat pointer)
+ */
+typedef struct {
+    void* ptr;    /*!< Block address the reference was taken at */
+    uint32_t gen; /*!< Block generation the reference was taken at */
+} lwmem_ref_t;
+
+lwmem_ref_t lwmem_ref_make_ex(lwmem_t* lwobj, void* ptr);
+void* lwmem_ref_resolve_ex(lwmem_t* lwobj, lwmem_ref_t ref);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_GENERATION) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_UDATA) || __DOXYGEN__
+uint8_t lwmem_set_udata_ex(lwmem_t* lwobj, void* ptr, size_t udata);
+size_t lwmem_get_udata_ex(lwmem_t* lwobj, void* ptr);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_UDATA) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_PINNING) || __DOXYGEN__
+uint8_t lwmem_pin_ex(lwmem_t* lwobj, void* ptr);
+uint8_t lwmem_unpin_ex(lwmem_t* lwobj, void* ptr);
+uint8_t lwmem_is_pinned_ex(lwmem_t* lwobj, void* ptr);
+void lwmem_set_move_handler_ex(lwmem_t* lwobj, lwmem_move_fn move_cb, void* user);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_PINNING) || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Deferred coalescing work is pending, see \ref lwmem_coalesce_ex
+ */
+#define LWMEM_MAINT_COALESCE  ((uint8_t)0x01U)
+
+/**
+ * \brief           Scrubbing work is pending, see \ref lwmem_scrub_step_ex
+ */
+#define LWMEM_MAINT_SCRUB     ((uint8_t)0x02U)
+
+/**
+ * \brief           Interrupt-freed blocks wait for draining, see \ref lwmem_free_from_isr_drain_ex
+ */
+#define LWMEM_MAINT_ISR_QUEUE ((uint8_t)0x04U)
+
+/**
+ * \brief           Pending heap maintenance summary
+ */
+typedef struct {
+    uint8_t pending;    /*!< Bitmask of `LWMEM_MAINT_xxx` values, `0` when nothing is pending */
+    size_t scrub_bytes; /*!< Outstanding scrub work in units of bytes */
+} lwmem_maint_info_t;
+
+void lwmem_maint_info_ex(lwmem_t* lwobj, lwmem_maint_info_t* info);
+uint8_t lwmem_maint_run_ex(lwmem_t* lwobj, size_t budget_bytes);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_TASK_OWNERSHIP) || __DOXYGEN__
+size_t lwmem_free_all_owned_by_ex(lwmem_t* lwobj, void* task);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_TASK_OWNERSHIP) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_CHECKSUM) || __DOXYGEN__
+void lwmem_chk_stats_ex(lwmem_t* lwobj, uint32_t* detected, uint32_t* repaired);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_CHECKSUM) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_CONST_TIME_POOL) || __DOXYGEN__
+struct lwmem_pool;
+uint8_t lwmem_ct_attach_ex(lwmem_t* lwobj, struct lwmem_pool* pool, const lwmem_region_t* region, size_t max_size);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_CONST_TIME_POOL) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_OP_JOURNAL) || __DOXYGEN__
+
+/**
+ * \brief           Journal operation codes
+ */
+typedef enum {
+    LWMEM_JOURNAL_OP_ALLOC = 0x00,      /*!< Successful allocation */
+    LWMEM_JOURNAL_OP_FREE = 0x01,       /*!< Free operation */
+    LWMEM_JOURNAL_OP_REALLOC = 0x02,    /*!< Successful reallocation */
+    LWMEM_JOURNAL_OP_ALLOC_FAIL = 0x03, /*!< Failed allocation or reallocation */
+} lwmem_journal_op_t;
+
+/**
+ * \brief           Single journal ring entry
+ */
+typedef struct {
+    uint32_t op_size; /*!< Operation code in top `2` bits, requested size in remaining bits */
+    uint32_t addr;    /*!< Address involved in the operation (lower `32` bits) */
+    uint32_t caller;  /*!< Return address of the caller (lower `32` bits), `0` when unavailable */
+} lwmem_journal_entry_t;
+
+/**
+ * \brief           Crash-safe operation journal record
+ *
+ * Place the instance in noinit RAM (memory startup code does not clear)
+ * and attach it with \ref lwmem_journal_attach_ex. Decode with
+ * \ref lwmem_journal_valid and \ref lwmem_journal_read after reboot,
+ * before the journal is attached (and reset) again
+ */
+typedef struct lwmem_journal {
+    uint32_t magic;           /*!< Validity marker, set on attach */
+    uint32_t depth;           /*!< Ring depth the writer was built with */
+    uint32_t head;            /*!< Total number of journaled operations */
+    uint32_t available_bytes; /*!< Free heap bytes after last operation */
+    lwmem_journal_entry_t entries[LWMEM_CFG_OP_JOURNAL_DEPTH]; /*!< Operation ring */
+} lwmem_journal_t;
+
+void lwmem_journal_attach_ex(lwmem_t* lwobj, lwmem_journal_t* journal);
+uint8_t lwmem_journal_valid(const lwmem_journal_t* journal);
+uint8_t lwmem_journal_read(const lwmem_journal_t* journal, uint32_t back_idx, lwmem_journal_entry_t* entry);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_OP_JOURNAL) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_AUDIT_REUSE) || __DOXYGEN__
+
+/**
+ * \brief           Free-to-reuse audit results
+ */
+typedef struct {
+    uint32_t reuse_ewma_ticks; /*!< Moving average latency between free and next reuse */
+    uint32_t exact_hits;       /*!< Reuses served at the exact freed size */
+    uint32_t samples;          /*!< Number of audited reuses */
+} lwmem_audit_t;
+
+void lwmem_audit_stats_ex(lwmem_t* lwobj, lwmem_audit_t* audit);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_AUDIT_REUSE) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_AGE) || __DOXYGEN__
+
+/**
+ * \brief           Stale block report callback prototype
+ * \param[in]       ptr: Application pointer of the stale block
+ * \param[in]       size: Application size of the block
+ * \param[in]       age: Block age in ticks
+ * \param[in]       tag: Allocation site tag (with \ref LWMEM_CFG_ALLOC_TAGS), `NULL` otherwise
+ * \param[in]       user: User argument
+ */
+typedef void (*lwmem_stale_report_fn)(void* ptr, size_t size, uint32_t age, const char* tag, void* user);
+
+size_t lwmem_report_stale_ex(lwmem_t* lwobj, uint32_t min_age, lwmem_stale_report_fn report_fn, void* user);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_AGE) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE) || __DOXYGEN__
+void* lwmem_malloc_evictable_ex(lwmem_t* lwobj, size_t size, lwmem_evict_fn evict_cb, void* user);
+void lwmem_evictable_touch_ex(lwmem_t* lwobj, void* ptr);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE) || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Allocation transaction, grouping allocations for commit or bulk rollback
+ */
+typedef struct {
+    lwmem_t* lwobj;                          /*!< Instance the transaction allocates from */
+    void* ptrs[LWMEM_CFG_TXN_MAX_ALLOCS];    /*!< Allocations belonging to the transaction */
+    size_t count;                            /*!< Number of live allocations in the transaction */
+} lwmem_txn_t;
+
+uint8_t lwmem_txn_begin_ex(lwmem_t* lwobj, lwmem_txn_t* txn);
+void* lwmem_txn_malloc(lwmem_txn_t* txn, size_t size);
+void lwmem_txn_commit(lwmem_txn_t* txn);
+void lwmem_txn_abort(lwmem_txn_t* txn);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_QUOTA_GROUPS) || __DOXYGEN__
+
+/**
+ * \brief           Quota group with byte budget, owned by the application
+ */
+typedef struct {
+    size_t limit; /*!< Byte budget of the group */
+    size_t used;  /*!< Bytes currently charged to the group */
+} lwmem_quota_t;
+
+void* lwmem_malloc_quota_ex(lwmem_t* lwobj, lwmem_quota_t* group, size_t size);
+void lwmem_free_quota_ex(lwmem_t* lwobj, lwmem_quota_t* group, void* ptr);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_QUOTA_GROUPS) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_REF_BUFFERS) || __DOXYGEN__
+void* lwmem_ref_alloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t size);
+void lwmem_ref_acquire_ex(lwmem_t* lwobj, void* ptr);
+void lwmem_ref_release_ex(lwmem_t* lwobj, void* ptr);
+void* lwmem_cow_clone_ex(lwmem_t* lwobj, void* ptr);
+void* lwmem_cow_make_unique_ex(lwmem_t* lwobj, void* ptr);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_REF_BUFFERS) || __DOXYGEN__ */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_FREE_FROM_ISR) || __DOXYGEN__
+void lwmem_free_from_isr_ex(lwmem_t* lwobj, void* const ptr);
+void lwmem_free_from_isr(void* const ptr);
+void lwmem_free_from_isr_drain_ex(lwmem_t* lwobj);
+void lwmem_free_from_isr_drain(void);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_FREE_FROM_ISR) || __DOXYGEN__ */
+#if (LWMEM_CFG_ENABLE_STATS && LWMEM_CFG_BATCHED_STATS) || __DOXYGEN__
+void lwmem_stats_flush(void);
+#endif /* (LWMEM_CFG_ENABLE_STATS && LWMEM_CFG_BATCHED_STATS) || __DOXYGEN__ */
 #if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
+uint8_t lwmem_health_ex(lwmem_t* lwobj);
+size_t lwmem_stats_export_cbor_ex(lwmem_t* lwobj, uint8_t* buf, size_t len);
+
+/**
+ * \brief           Advisor recommendation flags, see \ref lwmem_advise_ex
+ */
+#define LWMEM_ADVICE_BEST_FIT       ((uint16_t)0x0001U) /*!< High fragmentation: use best-fit or segregated strategy */
+#define LWMEM_ADVICE_ADD_POOL       ((uint16_t)0x0002U) /*!< One size class dominates: serve it from a pool */
+#define LWMEM_ADVICE_GROW_HEAP      ((uint16_t)0x0004U) /*!< Minimum-ever headroom critically low: grow the region */
+#define LWMEM_ADVICE_EXACT_CACHE    ((uint16_t)0x0008U) /*!< Freed sizes re-requested quickly: enable exact-fit cache */
+#define LWMEM_ADVICE_LOWER_ALIGN    ((uint16_t)0x0010U) /*!< Mostly tiny requests: smaller LWMEM_CFG_ALIGN_NUM saves memory */
+#define LWMEM_ADVICE_SPLIT_THRESH   ((uint16_t)0x0020U) /*!< Many tiny free fragments: raise minimal split remainder */
+
+/**
+ * \brief           Advisor report with concrete configuration recommendations
+ */
+typedef struct {
+    uint16_t flags;           /*!< Set of `LWMEM_ADVICE_xxx` recommendation bits */
+    uint32_t pool_block_size; /*!< Suggested pool block size when \ref LWMEM_ADVICE_ADD_POOL is set */
+    uint32_t pool_share_pct;  /*!< Share of allocations the suggested pool would absorb, in percents */
+    uint8_t health;           /*!< Composite health score the advice was derived from */
+} lwmem_advice_t;
+
+void lwmem_advise_ex(lwmem_t* lwobj, lwmem_advice_t* advice);
 void lwmem_get_stats_ex(lwmem_t* lwobj, lwmem_stats_t* stats);
-void lwmem_get_size(lwmem_stats_t* stats);
+#if LWMEM_CFG_WINDOWED_STATS || __DOXYGEN__
+void lwmem_stats_epoch_ex(lwmem_t* lwobj, lwmem_stats_t* window);
+#endif /* LWMEM_CFG_WINDOWED_STATS || __DOXYGEN__ */
+void lwmem_get_stats(lwmem_stats_t* stats);
 #endif /* LWMEM_CFG_ENABLE_STATS || __DOXYGEN__ */
 
 size_t lwmem_assignmem(const lwmem_region_t* regions);
 void* lwmem_malloc(size_t size);
 void* lwmem_calloc(size_t nitems, size_t size);
 
-#if LWMEM_CFG_FULL || __DOXYGEN__
+#if (LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC) || __DOXYGEN__
 void* lwmem_realloc(void* ptr, size_t size);
 int lwmem_realloc_s(void** ptr2ptr, size_t size);
+void* lwmem_expand(void* const ptr, const size_t size);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC) || __DOXYGEN__ */
+#if LWMEM_CFG_FULL || __DOXYGEN__
+void* lwmem_shrink(void* const ptr, const size_t size);
 void lwmem_free(void* ptr);
 void lwmem_free_s(void** ptr2ptr);
 size_t lwmem_get_size(void* ptr);
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
+#if (LWMEM_CFG_FULL && LWMEM_CFG_THREAD_CACHE) || __DOXYGEN__
+
+/**
+ * \brief           Number of size classes in per-thread cache, one per alignment step
+ */
+#define LWMEM_TCACHE_CLASSES (LWMEM_CFG_THREAD_CACHE_MAX_SIZE / LWMEM_CFG_ALIGN_NUM)
+
+/**
+ * \brief           Per-thread magazines with cached allocated blocks
+ */
+typedef struct {
+    void* heads[LWMEM_TCACHE_CLASSES];    /*!< Head of cached blocks stack, one per size class */
+    uint8_t counts[LWMEM_TCACHE_CLASSES]; /*!< Number of cached blocks per size class */
+} lwmem_tcache_t;
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_THREAD_CACHE) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_THREAD_CACHE && LWMEM_CFG_INLINE_FASTPATH) || __DOXYGEN__
+
+/* Thread cache storage, defined in lwmem.c, one copy per thread */
+extern LWMEM_CFG_THREAD_LOCAL lwmem_tcache_t lwmem_thread_cache;
+
+/**
+ * \brief           Allocate from default instance with inline thread-cache fast path
+ *
+ * Magazine hits compile fully inline at the call site,
+ * misses tail-call into \ref lwmem_malloc
+ *
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+static inline void*
+lwmem_malloc_fast(size_t size) {
+    const size_t aligned_size =
+        (size + (size_t)LWMEM_CFG_ALIGN_NUM - 1) & ~((size_t)LWMEM_CFG_ALIGN_NUM - 1);
+
+    if (size > 0 && aligned_size >= sizeof(void*) && aligned_size <= LWMEM_CFG_THREAD_CACHE_MAX_SIZE) {
+        const size_t idx = aligned_size / LWMEM_CFG_ALIGN_NUM - 1;
+        void* ptr = lwmem_thread_cache.heads[idx];
+
+        if (ptr != NULL) {
+            lwmem_thread_cache.heads[idx] = *(void**)ptr;
+            --lwmem_thread_cache.counts[idx];
+            return ptr;
+        }
+    }
+    return lwmem_malloc(size);
+}
+
+/**
+ * \brief           Free to default instance with inline thread-cache fast path
+ *
+ * Magazine pushes compile fully inline at the call site,
+ * full magazines (and special blocks) tail-call into \ref lwmem_free
+ *
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
+ */
+static inline void
+lwmem_free_fast(void* ptr) {
+    if (ptr != NULL) {
+        /* User size read from block header, mirrors internal block layout */
+        const lwmem_block_t* block = (const lwmem_block_t*)(void*)((uint8_t*)ptr
+                                                                   - ((sizeof(lwmem_block_t)
+                                                                       + (size_t)LWMEM_CFG_ALIGN_NUM - 1)
+                                                                      & ~((size_t)LWMEM_CFG_ALIGN_NUM - 1)));
+#if LWMEM_CFG_ALLOC_BIT_LOW
+        const size_t alloc_bit = (size_t)0x01;
+#else
+        const size_t alloc_bit = (size_t)1 << (sizeof(size_t) * 8 - 1);
+#endif /* !LWMEM_CFG_ALLOC_BIT_LOW */
+        const size_t user_size = (block->size & ~alloc_bit)
+                                 - ((sizeof(lwmem_block_t) + (size_t)LWMEM_CFG_ALIGN_NUM - 1)
+                                    & ~((size_t)LWMEM_CFG_ALIGN_NUM - 1));
+
+        if ((block->size & alloc_bit) > 0 && user_size >= sizeof(void*)
+            && user_size <= LWMEM_CFG_THREAD_CACHE_MAX_SIZE) {
+            const size_t idx = user_size / LWMEM_CFG_ALIGN_NUM - 1;
+
+            if (lwmem_thread_cache.counts[idx] < LWMEM_CFG_THREAD_CACHE_DEPTH) {
+                *(void**)ptr = lwmem_thread_cache.heads[idx];
+                lwmem_thread_cache.heads[idx] = ptr;
+                ++lwmem_thread_cache.counts[idx];
+                return;
+            }
+        }
+    }
+    lwmem_free(ptr);
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_THREAD_CACHE && LWMEM_CFG_INLINE_FASTPATH) || __DOXYGEN__ */
+
 #if defined(LWMEM_DEV) && !__DOXYGEN__
 unsigned char lwmem_debug_create_regions(lwmem_region_t** regs_out, size_t count, size_t size);
 void lwmem_debug_save_state(void);
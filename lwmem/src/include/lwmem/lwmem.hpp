@@ -35,6 +35,22 @@
 #define LWMEM_HDR_HPP
 
 #include "lwmem/lwmem.h"
+#include "lwmem/lwmem_arena.h"
+#include "lwmem/lwmem_pool.h"
+
+#include <memory>
+#include <new>
+#include <utility>
+
+#if defined(__cplusplus) && __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define LWMEM_HAS_PMR 1
+#endif /* __has_include(<memory_resource>) */
+#endif /* defined(__cplusplus) && __cplusplus >= 201703L && defined(__has_include) */
+#ifndef LWMEM_HAS_PMR
+#define LWMEM_HAS_PMR 0
+#endif /* LWMEM_HAS_PMR */
 
 /**
  * \ingroup         LWMEM
@@ -45,6 +61,15 @@
 
 namespace Lwmem {
 
+/**
+ * \brief           Locking policy for wrapper-managed heaps
+ */
+enum class Locking {
+    Default = 0, /*!< Follow global \ref LWMEM_CFG_OS configuration */
+    None,        /*!< Skip locking for this (single-owner) heap.
+                      Requires \ref LWMEM_CFG_PER_INSTANCE_LOCKING */
+};
+
 /**
  * \brief           LwMEM Light implementation with single memory region.
  * \tparam          LEN: Length of region in units of bytes 
@@ -61,13 +86,19 @@ void* ptr = mngr.malloc(...);
 mngr.free(ptr);
 \endcode
  */
-template <size_t LEN>
+template <size_t LEN, Locking LOCK = Locking::Default>
 class LwmemLight {
+#if !LWMEM_CFG_PER_INSTANCE_LOCKING
+    static_assert(LOCK == Locking::Default, "Locking::None requires LWMEM_CFG_PER_INSTANCE_LOCKING");
+#endif /* !LWMEM_CFG_PER_INSTANCE_LOCKING */
+
   public:
-    LwmemLight() {
-        /* Simple region descriptor with one region */
-        const lwmem_region_t regions[] = {{m_reg_data, sizeof(m_reg_data)}, {NULL, 0}};
-        lwmem_assignmem_ex(&m_lw, regions);
+    LwmemLight() : m_regions{{m_reg_data, sizeof(m_reg_data)}, {NULL, 0}} {
+#if LWMEM_CFG_OS && LWMEM_CFG_PER_INSTANCE_LOCKING
+        m_lw.lock_disabled = LOCK == Locking::None; /* Must be decided before region assignment */
+#endif /* LWMEM_CFG_OS && LWMEM_CFG_PER_INSTANCE_LOCKING */
+        /* Regions array must outlive the instance, library keeps a reference to it */
+        lwmem_assignmem_ex(&m_lw, m_regions);
     }
 
     /**
@@ -94,6 +125,7 @@ class LwmemLight {
     }
 
 #if LWMEM_CFG_FULL || __DOXYGEN__
+#if LWMEM_CFG_SUPPORT_REALLOC || __DOXYGEN__
     /**
      * \brief           Reallocate block of memory
      * \param           ptr: Pointer to previously allocated memory block
@@ -105,6 +137,7 @@ class LwmemLight {
     realloc(void* ptr, size_t size) {
         return lwmem_realloc_ex(&m_lw, nullptr, ptr, size);
     }
+#endif /* LWMEM_CFG_SUPPORT_REALLOC || __DOXYGEN__ */
 
     /**
      * \brief           Free memory block
@@ -117,6 +150,15 @@ class LwmemLight {
     }
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
+    /**
+     * \brief           Get underlying LwMEM instance, to use with `_ex` C functions
+     * \return          LwMEM instance handle
+     */
+    lwmem_t*
+    instance() {
+        return &m_lw;
+    }
+
   private:
     /* Delete unused constructors */
     LwmemLight(const LwmemLight& other) = delete;
@@ -126,8 +168,723 @@ class LwmemLight {
 
     lwmem_t m_lw;
     uint8_t m_reg_data[LEN];
+    lwmem_region_t m_regions[2];
 };
 
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Standard-allocator compatible adapter over a LwMEM instance
+ * \tparam          T: Element type the allocator serves
+ *
+ * Satisfies the C++ allocator requirements, so standard containers can live
+ * on a LwMEM heap instead of the toolchain default allocator:
+ *
+ * \code{.cpp}
+Lwmem::LwmemLight<16384> mngr;
+std::vector<int, Lwmem::Allocator<int>> vec{Lwmem::Allocator<int>(mngr.instance())};
+\endcode
+ */
+template <typename T>
+class Allocator {
+  public:
+    using value_type = T;
+
+    /**
+     * \brief           Construct allocator bound to LwMEM instance
+     * \param           lwobj: LwMEM instance, `NULL` for default one
+     */
+    explicit Allocator(lwmem_t* lwobj = nullptr) noexcept : m_lw(lwobj) {}
+
+    /**
+     * \brief           Rebinding copy constructor, required by allocator traits
+     */
+    template <typename U>
+    Allocator(const Allocator<U>& other) noexcept : m_lw(other.instance()) {}
+
+    /**
+     * \brief           Allocate storage for `n` elements
+     * \param           n: Number of elements
+     * \return          Pointer to storage, `NULL` when heap is exhausted
+     *                      and exceptions are not available
+     */
+    T*
+    allocate(size_t n) {
+        void* ptr = lwmem_malloc_ex(m_lw, nullptr, n * sizeof(T));
+
+#if defined(__cpp_exceptions)
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+#endif /* defined(__cpp_exceptions) */
+        return static_cast<T*>(ptr);
+    }
+
+    /**
+     * \brief           Release storage previously obtained from \ref allocate
+     * \param           ptr: Storage to release
+     */
+    void
+    deallocate(T* ptr, size_t) noexcept {
+        lwmem_free_ex(m_lw, ptr);
+    }
+
+    /**
+     * \brief           Get bound LwMEM instance
+     * \return          LwMEM instance handle, may be `NULL` for default one
+     */
+    lwmem_t*
+    instance() const noexcept {
+        return m_lw;
+    }
+
+  private:
+    lwmem_t* m_lw;
+};
+
+/**
+ * \brief           Allocators are equal when bound to the same instance
+ */
+template <typename T, typename U>
+bool
+operator==(const Allocator<T>& lhs, const Allocator<U>& rhs) noexcept {
+    return lhs.instance() == rhs.instance();
+}
+
+template <typename T, typename U>
+bool
+operator!=(const Allocator<T>& lhs, const Allocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+/**
+ * \brief           Compile-time region descriptor for \ref LwmemMulti
+ * \tparam          ADDR: Fixed region start address (memory map constant)
+ * \tparam          LEN: Region length in units of bytes
+ */
+template <uintptr_t ADDR, size_t LEN>
+struct Region {
+    static constexpr uintptr_t address = ADDR; /*!< Region start address */
+    static constexpr size_t size = LEN;        /*!< Region size in units of bytes */
+};
+
+namespace detail {
+
+/* Compile-time proof that regions are address ordered and do not overlap */
+template <typename TFirst>
+constexpr bool
+regions_ordered() {
+    return true;
+}
+
+template <typename TFirst, typename TSecond, typename... TRest>
+constexpr bool
+regions_ordered() {
+    return (TFirst::address + TFirst::size) <= TSecond::address && regions_ordered<TSecond, TRest...>();
+}
+
+} // namespace detail
+
+/**
+ * \brief           Multi-region heap manager with compile-time region layout
+ * \tparam          TRegions: List of \ref Region descriptors in increasing address order
+ *
+ * Region table is built at compile time from externally placed buffers
+ * (fast SRAM, SDRAM and similar memory map constants), with ordering and
+ * overlap proven by `static_assert` instead of runtime validation:
+ *
+ * \code{.cpp}
+Lwmem::LwmemMulti<Lwmem::Region<0x20000000, 0x8000>, Lwmem::Region<0xC0000000, 0x100000>> mngr;
+void* ptr = mngr.malloc(128);
+\endcode
+ */
+template <typename... TRegions>
+class LwmemMulti {
+    static_assert(sizeof...(TRegions) > 0, "At least one region is required");
+    static_assert(detail::regions_ordered<TRegions...>(),
+                  "Regions must be in increasing address order and must not overlap");
+
+  public:
+    LwmemMulti() : m_regions{{reinterpret_cast<void*>(TRegions::address), TRegions::size}..., {NULL, 0}} {
+        lwmem_assignmem_ex(&m_lw, m_regions);
+    }
+
+    /**
+     * \brief           Allocate block of memory with selected size
+     * \param           size: Block size to allocate in units of bytes
+     * \return          Allocated memory or `NULL` on failure
+     */
+    void*
+    malloc(size_t size) {
+        return lwmem_malloc_ex(&m_lw, nullptr, size);
+    }
+
+    /**
+     * \brief           Allocate zero-initialized block of memory
+     * \param[in]       nitems: Number of items to allocate
+     * \param           size: Size of each item in units of bytes
+     * \return          Allocated memory or `NULL` on failure
+     */
+    void*
+    calloc(size_t nitems, size_t size) {
+        return lwmem_calloc_ex(&m_lw, nullptr, nitems, size);
+    }
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+#if LWMEM_CFG_SUPPORT_REALLOC || __DOXYGEN__
+    /**
+     * \brief           Reallocate block of memory
+     * \param           ptr: Pointer to previously allocated memory block
+     * \param           size: Block size to allocate in units of bytes
+     * \return          Allocated memory or `NULL` on failure
+     */
+    void*
+    realloc(void* ptr, size_t size) {
+        return lwmem_realloc_ex(&m_lw, nullptr, ptr, size);
+    }
+#endif /* LWMEM_CFG_SUPPORT_REALLOC || __DOXYGEN__ */
+
+    /**
+     * \brief           Free memory block
+     * \param           ptr: Pointer to previously allocated memory block
+     */
+    void
+    free(void* ptr) {
+        lwmem_free_ex(&m_lw, ptr);
+    }
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+    /**
+     * \brief           Get underlying LwMEM instance, to use with `_ex` C functions
+     * \return          LwMEM instance handle
+     */
+    lwmem_t*
+    instance() {
+        return &m_lw;
+    }
+
+  private:
+    LwmemMulti(const LwmemMulti& other) = delete;
+    LwmemMulti& operator=(const LwmemMulti& other) = delete;
+
+    lwmem_t m_lw{};
+    lwmem_region_t m_regions[sizeof...(TRegions) + 1];
+};
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Stateful deleter destroying the object and returning memory to its LwMEM instance
+ * \tparam          T: Object type to delete
+ *
+ * Plain-function-pointer free deleter: no `std::function` storage or
+ * indirect call overhead, only the instance pointer is carried
+ */
+template <typename T>
+struct Deleter {
+    lwmem_t* lw = nullptr; /*!< Owning LwMEM instance, `NULL` for default one */
+
+    void
+    operator()(T* ptr) const noexcept {
+        if (ptr != nullptr) {
+            ptr->~T();
+            lwmem_free_ex(lw, ptr);
+        }
+    }
+};
+
+/**
+ * \brief           Unique pointer type owning memory of a LwMEM instance
+ */
+template <typename T>
+using UniquePtr = std::unique_ptr<T, Deleter<T>>;
+
+/**
+ * \brief           Construct object in place on a LwMEM instance and wrap it in a unique pointer
+ * \tparam          T: Object type to construct
+ * \param           lwobj: LwMEM instance to allocate from, `NULL` for default one
+ * \param           args: Arguments perfect-forwarded to the constructor
+ * \return          Owning unique pointer, empty when allocation failed
+ */
+template <typename T, typename... Args>
+UniquePtr<T>
+make_unique(lwmem_t* lwobj, Args&&... args) {
+    void* mem = lwmem_malloc_ex(lwobj, nullptr, sizeof(T));
+
+    if (mem == nullptr) {
+        return UniquePtr<T>(nullptr, Deleter<T>{lwobj});
+    }
+    return UniquePtr<T>(new (mem) T(std::forward<Args>(args)...), Deleter<T>{lwobj});
+}
+
+/**
+ * \brief           Construct object in place on a wrapper-managed heap
+ * \tparam          T: Object type to construct
+ * \param           mngr: Heap manager instance
+ * \param           args: Arguments perfect-forwarded to the constructor
+ * \return          Owning unique pointer, empty when allocation failed
+ */
+template <typename T, size_t LEN, Locking LOCK, typename... Args>
+UniquePtr<T>
+make_unique(LwmemLight<LEN, LOCK>& mngr, Args&&... args) {
+    return make_unique<T>(mngr.instance(), std::forward<Args>(args)...);
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+/**
+ * \brief           Typed object pool with constant time acquire and release
+ * \tparam          T: Object type served by the pool
+ * \tparam          N: Number of objects in the pool
+ *
+ * Storage lives inside the pool object and is managed by the C pool API,
+ * so type-safe O(1) allocation with in-place construction is available
+ * without going through the general heap path:
+ *
+ * \code{.cpp}
+Lwmem::Pool<Message, 32> pool;
+Message* msg = pool.acquire(arg1, arg2);
+pool.release(msg);
+\endcode
+ */
+template <typename T, size_t N>
+class Pool {
+    /* Block must hold the object or a free-stack link, at object and config alignment */
+    static constexpr size_t block_align =
+        alignof(T) > LWMEM_CFG_ALIGN_NUM ? alignof(T) : (size_t)LWMEM_CFG_ALIGN_NUM;
+    static constexpr size_t block_size =
+        ((sizeof(T) > sizeof(void*) ? sizeof(T) : sizeof(void*)) + block_align - 1) & ~(block_align - 1);
+
+  public:
+    Pool() {
+        const lwmem_region_t region = {m_storage, sizeof(m_storage)};
+
+        lwmem_pool_init(&m_pool, &region, block_size, N);
+    }
+
+    /**
+     * \brief           Acquire object from the pool and construct it in place
+     * \param           args: Arguments perfect-forwarded to the constructor
+     * \return          Constructed object, `NULL` when pool is exhausted
+     */
+    template <typename... Args>
+    T*
+    acquire(Args&&... args) {
+        void* mem = lwmem_pool_alloc(&m_pool);
+
+        return mem != nullptr ? new (mem) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    /**
+     * \brief           Destroy object and return its block to the pool
+     * \param           obj: Object previously acquired from this pool. `NULL` is valid input
+     */
+    void
+    release(T* obj) {
+        if (obj != nullptr) {
+            obj->~T();
+            lwmem_pool_free(&m_pool, obj);
+        }
+    }
+
+  private:
+    Pool(const Pool& other) = delete;
+    Pool& operator=(const Pool& other) = delete;
+
+    lwmem_pool_t m_pool;
+    alignas(T) unsigned char m_storage[N * block_size];
+};
+
+/**
+ * \brief           RAII guard marking an arena on construction and releasing on destruction
+ *
+ * All arena allocations made inside the guarded scope vanish in O(1) at
+ * scope exit, replacing per-object destructor-driven frees for temporary
+ * parsing or decoding data:
+ *
+ * \code{.cpp}
+void parse_frame(lwmem_arena_t* arena) {
+    Lwmem::ScopedArena scope(arena);
+    void* tmp = scope.alloc(128);
+    ...
+}   // everything allocated through the scope is gone here
+\endcode
+ */
+class ScopedArena {
+  public:
+    /**
+     * \brief           Mark current arena position
+     * \param           arena: Arena to guard
+     */
+    explicit ScopedArena(lwmem_arena_t* arena) : m_arena(arena), m_mark(lwmem_arena_mark(arena)) {}
+
+    ~ScopedArena() {
+        lwmem_arena_release(m_arena, m_mark);
+    }
+
+    /**
+     * \brief           Allocate temporary memory within the guarded scope
+     * \param           size: Number of bytes to allocate
+     * \return          Allocated memory, `NULL` when arena is full
+     */
+    void*
+    alloc(size_t size) {
+        return lwmem_arena_alloc(m_arena, size);
+    }
+
+    /**
+     * \brief           Get guarded arena, for use with allocator adapters
+     * \return          Arena handle
+     */
+    lwmem_arena_t*
+    arena() const noexcept {
+        return m_arena;
+    }
+
+  private:
+    ScopedArena(const ScopedArena& other) = delete;
+    ScopedArena& operator=(const ScopedArena& other) = delete;
+
+    lwmem_arena_t* m_arena;
+    size_t m_mark;
+};
+
+/**
+ * \brief           Standard-allocator adapter over an arena
+ * \tparam          T: Element type the allocator serves
+ *
+ * Deallocation is a no-op by design: memory of the whole container
+ * is reclaimed when the owning \ref ScopedArena leaves its scope
+ */
+template <typename T>
+class ArenaAllocator {
+  public:
+    using value_type = T;
+
+    /**
+     * \brief           Construct allocator bound to (scoped) arena
+     * \param           arena: Arena serving the allocations
+     */
+    explicit ArenaAllocator(lwmem_arena_t* arena) noexcept : m_arena(arena) {}
+
+    /**
+     * \brief           Bind allocator to a scope guard directly
+     */
+    explicit ArenaAllocator(const ScopedArena& scope) noexcept : m_arena(scope.arena()) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+    T*
+    allocate(size_t n) {
+        void* ptr = lwmem_arena_alloc(m_arena, n * sizeof(T));
+
+#if defined(__cpp_exceptions)
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+#endif /* defined(__cpp_exceptions) */
+        return static_cast<T*>(ptr);
+    }
+
+    void
+    deallocate(T*, size_t) noexcept {
+        /* Released in bulk by the scope guard */
+    }
+
+    lwmem_arena_t*
+    arena() const noexcept {
+        return m_arena;
+    }
+
+  private:
+    lwmem_arena_t* m_arena;
+};
+
+template <typename T, typename U>
+bool
+operator==(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+    return lhs.arena() == rhs.arena();
+}
+
+template <typename T, typename U>
+bool
+operator!=(const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+#if (LWMEM_CFG_FULL && defined(__cplusplus) && __cplusplus >= 201703L) || __DOXYGEN__
+
+/**
+ * \brief           Frame allocator base for C++20 coroutine promise types
+ *
+ * Promise types inherit from this class, so every coroutine frame
+ * (`operator new` called by the compiler) is served from the designated
+ * LwMEM instance - typically a dedicated region or pool-backed sub-heap,
+ * since frames cluster in a few sizes - with automatic fallback to the
+ * default instance under pressure:
+ *
+ * \code{.cpp}
+struct Task {
+    struct promise_type : Lwmem::CoroPromiseAllocator {
+        ...
+    };
+};
+Lwmem::CoroPromiseAllocator::set_instance(coro_heap.instance());
+\endcode
+ */
+class CoroPromiseAllocator {
+  public:
+    /**
+     * \brief           Designate LwMEM instance serving coroutine frames
+     * \param           lwobj: LwMEM instance, `NULL` for default one
+     */
+    static void
+    set_instance(lwmem_t* lwobj) noexcept {
+        s_instance = lwobj;
+    }
+
+    static void*
+    operator new(size_t size) {
+        /* Owning instance is remembered in front of the frame for correct routing on destroy.
+           Compiler assumes frames aligned at least to max_align_t */
+        void* raw = lwmem_malloc_aligned_ex(s_instance, nullptr, size + frame_offset, alignof(max_align_t));
+        lwmem_t* owner = s_instance;
+
+        if (raw == nullptr && s_instance != nullptr) { /* Dedicated heap exhausted -> general heap */
+            raw = lwmem_malloc_aligned_ex(nullptr, nullptr, size + frame_offset, alignof(max_align_t));
+            owner = nullptr;
+        }
+#if defined(__cpp_exceptions)
+        if (raw == nullptr) {
+            throw std::bad_alloc();
+        }
+#else /* defined(__cpp_exceptions) */
+        if (raw == nullptr) {
+            return nullptr;
+        }
+#endif /* !defined(__cpp_exceptions) */
+        *static_cast<lwmem_t**>(raw) = owner;
+        return static_cast<unsigned char*>(raw) + frame_offset;
+    }
+
+    static void
+    operator delete(void* ptr) noexcept {
+        if (ptr != nullptr) {
+            void* raw = static_cast<unsigned char*>(ptr) - frame_offset;
+
+            lwmem_free_ex(*static_cast<lwmem_t**>(raw), raw);
+        }
+    }
+
+    static void
+    operator delete(void* ptr, size_t) noexcept {
+        operator delete(ptr);
+    }
+
+  private:
+    /* Keep frame alignment suitable for any fundamental type */
+    static constexpr size_t frame_offset = alignof(max_align_t) > sizeof(lwmem_t*) ? alignof(max_align_t)
+                                                                                   : sizeof(lwmem_t*);
+    static inline lwmem_t* s_instance = nullptr;
+};
+
+#endif /* (LWMEM_CFG_FULL && defined(__cplusplus) && __cplusplus >= 201703L) || __DOXYGEN__ */
+
+#if (LWMEM_HAS_PMR && LWMEM_CFG_FULL) || __DOXYGEN__
+
+/**
+ * \brief           Polymorphic memory resource backed by a LwMEM instance
+ *
+ * Lets `std::pmr` containers (and pool-resource chains) sit on top of a fast
+ * LwMEM region instead of `new_delete_resource`:
+ *
+ * \code{.cpp}
+Lwmem::LwmemLight<16384> mngr;
+Lwmem::MemoryResource res(mngr.instance());
+std::pmr::vector<int> vec(&res);
+\endcode
+ */
+class MemoryResource : public std::pmr::memory_resource {
+  public:
+    /**
+     * \brief           Construct resource bound to LwMEM instance
+     * \param           lwobj: LwMEM instance, `NULL` for default one
+     */
+    explicit MemoryResource(lwmem_t* lwobj = nullptr) noexcept : m_lw(lwobj) {}
+
+  private:
+    void*
+    do_allocate(size_t bytes, size_t alignment) override {
+        void* ptr = alignment > LWMEM_CFG_ALIGN_NUM ? lwmem_malloc_aligned_ex(m_lw, nullptr, bytes, alignment)
+                                                    : lwmem_malloc_ex(m_lw, nullptr, bytes);
+
+#if defined(__cpp_exceptions)
+        if (ptr == nullptr) {
+            throw std::bad_alloc();
+        }
+#endif /* defined(__cpp_exceptions) */
+        return ptr;
+    }
+
+    void
+    do_deallocate(void* ptr, size_t, size_t) override {
+        lwmem_free_ex(m_lw, ptr);
+    }
+
+    bool
+    do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        const MemoryResource* res = dynamic_cast<const MemoryResource*>(&other);
+
+        return res != nullptr && res->m_lw == m_lw;
+    }
+
+    lwmem_t* m_lw;
+};
+
+#endif /* (LWMEM_HAS_PMR && LWMEM_CFG_FULL) || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Dynamic byte buffer with small-buffer optimization on a LwMEM heap
+ * \tparam          SBO_SIZE: Payloads up to this size live inline, without any heap allocation
+ *
+ * Move semantics transfer heap block ownership without copying and
+ * \ref release hands the raw block over to C code freeing it with
+ * \ref lwmem_free_ex, so buffers can cross the C/C++ boundary cleanly
+ */
+template <size_t SBO_SIZE = 32>
+class BasicBuffer {
+  public:
+    /**
+     * \brief           Construct buffer of requested size
+     * \param           size: Payload size in units of bytes
+     * \param           lwobj: LwMEM instance for large payloads, `NULL` for default one
+     */
+    explicit BasicBuffer(size_t size = 0, lwmem_t* lwobj = nullptr) : m_lw(lwobj), m_size(size) {
+        if (size > SBO_SIZE) {
+            m_heap = static_cast<unsigned char*>(lwmem_malloc_ex(m_lw, nullptr, size));
+            if (m_heap == nullptr) {
+                m_size = 0;
+            }
+        }
+    }
+
+    BasicBuffer(BasicBuffer&& other) noexcept : m_lw(other.m_lw), m_size(other.m_size), m_heap(other.m_heap) {
+        if (m_size <= SBO_SIZE) {
+            for (size_t i = 0; i < m_size; ++i) {
+                m_sbo[i] = other.m_sbo[i];
+            }
+        }
+        other.m_heap = nullptr; /* Heap block ownership transferred, no copy */
+        other.m_size = 0;
+    }
+
+    BasicBuffer&
+    operator=(BasicBuffer&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_lw = other.m_lw;
+            m_size = other.m_size;
+            m_heap = other.m_heap;
+            if (m_size <= SBO_SIZE) {
+                for (size_t i = 0; i < m_size; ++i) {
+                    m_sbo[i] = other.m_sbo[i];
+                }
+            }
+            other.m_heap = nullptr;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    ~BasicBuffer() {
+        reset();
+    }
+
+    /**
+     * \brief           Get payload address
+     * \return          Payload address, inline storage or heap block
+     */
+    unsigned char*
+    data() noexcept {
+        return m_size > SBO_SIZE ? m_heap : m_sbo;
+    }
+
+    /**
+     * \brief           Get payload size
+     * \return          Payload size in units of bytes, `0` for empty buffer
+     */
+    size_t
+    size() const noexcept {
+        return m_size;
+    }
+
+    /**
+     * \brief           Check whether payload lives in inline storage
+     * \return          `1` when no heap allocation is held
+     */
+    bool
+    is_inline() const noexcept {
+        return m_size <= SBO_SIZE;
+    }
+
+    /**
+     * \brief           Detach payload as a raw heap block for C code
+     *
+     * Inline payloads are copied into a fresh heap block first. Caller owns
+     * the returned block and frees it with \ref lwmem_free_ex on the same instance
+     *
+     * \return          Heap block with the payload, `NULL` on empty buffer or exhausted heap
+     */
+    unsigned char*
+    release() {
+        unsigned char* ptr = nullptr;
+
+        if (m_size > SBO_SIZE) {
+            ptr = m_heap;
+            m_heap = nullptr;
+        } else if (m_size > 0) {
+            ptr = static_cast<unsigned char*>(lwmem_malloc_ex(m_lw, nullptr, m_size));
+            if (ptr != nullptr) {
+                for (size_t i = 0; i < m_size; ++i) {
+                    ptr[i] = m_sbo[i];
+                }
+            }
+        }
+        m_size = 0;
+        return ptr;
+    }
+
+  private:
+    void
+    reset() noexcept {
+        if (m_size > SBO_SIZE && m_heap != nullptr) {
+            lwmem_free_ex(m_lw, m_heap);
+        }
+        m_heap = nullptr;
+        m_size = 0;
+    }
+
+    BasicBuffer(const BasicBuffer& other) = delete;
+    BasicBuffer& operator=(const BasicBuffer& other) = delete;
+
+    lwmem_t* m_lw = nullptr;
+    size_t m_size = 0;
+    unsigned char* m_heap = nullptr;
+    unsigned char m_sbo[SBO_SIZE];
+};
+
+/**
+ * \brief           Byte buffer with default small-buffer threshold
+ */
+using Buffer = BasicBuffer<>;
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
 }; // namespace Lwmem
 
 /**
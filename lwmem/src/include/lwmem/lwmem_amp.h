@@ -0,0 +1,124 @@
+/**
+ * \file            lwmem_amp.h
+ * \brief           Dual-core remote heap service over shared memory (AMP)
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_AMP_HDR_H
+#define LWMEM_AMP_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_AMP Remote heap service
+ * \brief           Shared-memory allocation protocol for AMP systems
+ * \{
+ */
+
+/**
+ * \brief           Number of command slots in the shared ring
+ */
+#ifndef LWMEM_CFG_AMP_SLOTS
+#define LWMEM_CFG_AMP_SLOTS 8
+#endif
+
+/**
+ * \brief           Depth of the remote-side free-block reuse cache
+ */
+#ifndef LWMEM_CFG_AMP_CACHE
+#define LWMEM_CFG_AMP_CACHE 8
+#endif
+
+/**
+ * \brief           Memory barrier between command payload and state writes
+ *
+ * Define to a data memory barrier (`__DMB()` on Cortex-M) for real
+ * multi-core deployments. Compiler barrier by default
+ */
+#ifndef LWMEM_AMP_BARRIER
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_AMP_BARRIER() __asm volatile("" ::: "memory")
+#else
+#define LWMEM_AMP_BARRIER()
+#endif
+#endif
+
+/**
+ * \brief           Command slot states
+ */
+#define LWMEM_AMP_SLOT_FREE      0U /*!< Slot is available to the remote core */
+#define LWMEM_AMP_SLOT_REQ_ALLOC 1U /*!< Remote core requests an allocation */
+#define LWMEM_AMP_SLOT_REQ_FREE  2U /*!< Remote core requests a free */
+#define LWMEM_AMP_SLOT_DONE      3U /*!< Owner core completed the request */
+
+/**
+ * \brief           Single shared command slot
+ */
+typedef struct {
+    volatile uint32_t state; /*!< Slot state, `LWMEM_AMP_SLOT_xxx` value */
+    uint32_t size;           /*!< Requested size for allocation commands */
+    void* volatile ptr;      /*!< Result of allocation / input of free commands */
+} lwmem_amp_slot_t;
+
+/**
+ * \brief           Shared-memory command ring with remote-side reuse cache
+ *
+ * Structure must live in memory visible to both cores (remote cache
+ * part is only touched by the remote core)
+ */
+typedef struct {
+    lwmem_amp_slot_t slots[LWMEM_CFG_AMP_SLOTS]; /*!< Command slots */
+    struct {
+        void* ptr;     /*!< Cached block, `NULL` for empty entries */
+        uint32_t size; /*!< Cached block size */
+    } cache[LWMEM_CFG_AMP_CACHE]; /*!< Remote-side free-block cache for round-trip-free reuse */
+} lwmem_amp_ring_t;
+
+void lwmem_amp_ring_init(lwmem_amp_ring_t* ring);
+void* lwmem_amp_alloc(lwmem_amp_ring_t* ring, size_t size);
+void lwmem_amp_free(lwmem_amp_ring_t* ring, void* ptr, size_t size);
+size_t lwmem_amp_service_ex(lwmem_t* lwobj, lwmem_amp_ring_t* ring);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_AMP_HDR_H */
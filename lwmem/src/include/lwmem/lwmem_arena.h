@@ -0,0 +1,80 @@
+/**
+ * \file            lwmem_arena.h
+ * \brief           Arena allocator with mark and release support
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_ARENA_HDR_H
+#define LWMEM_ARENA_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_ARENA Arena allocator
+ * \brief           Bump allocator with mark and release, nested inside a LwMEM heap
+ * \{
+ */
+
+/**
+ * \brief           Arena structure
+ */
+typedef struct {
+    lwmem_t* lwobj; /*!< LwMEM instance backing buffer has been allocated from */
+    uint8_t* buff;  /*!< Arena memory */
+    size_t size;    /*!< Arena memory size in units of bytes */
+    size_t offset;  /*!< Current bump offset for next allocation */
+} lwmem_arena_t;
+
+uint8_t lwmem_arena_create_ex(lwmem_t* lwobj, lwmem_arena_t* arena, size_t size);
+uint8_t lwmem_arena_create(lwmem_arena_t* arena, size_t size);
+void* lwmem_arena_alloc(lwmem_arena_t* arena, size_t size);
+size_t lwmem_arena_mark(const lwmem_arena_t* arena);
+void lwmem_arena_release(lwmem_arena_t* arena, size_t mark);
+void lwmem_arena_reset(lwmem_arena_t* arena);
+#if LWMEM_CFG_FULL || __DOXYGEN__
+void lwmem_arena_destroy(lwmem_arena_t* arena);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_ARENA_HDR_H */
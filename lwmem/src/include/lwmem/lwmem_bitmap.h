@@ -0,0 +1,76 @@
+/**
+ * \file            lwmem_bitmap.h
+ * \brief           Bitmap allocator for uniform tiny blocks
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_BITMAP_HDR_H
+#define LWMEM_BITMAP_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_BITMAP Bitmap allocator
+ * \brief           One-bit-per-slot allocator for huge volumes of uniform tiny objects
+ * \{
+ */
+
+/**
+ * \brief           Bitmap allocator structure
+ */
+typedef struct {
+    uint32_t* bits;    /*!< Occupancy bitmap, one bit per slot, `1` means free */
+    uint8_t* slots;    /*!< First slot address */
+    size_t slot_size;  /*!< Size of single slot, aligned */
+    size_t count;      /*!< Total number of slots */
+    size_t word_hint;  /*!< Bitmap word to start next search at */
+} lwmem_bitmap_t;
+
+uint8_t lwmem_bitmap_init(lwmem_bitmap_t* bm, const lwmem_region_t* region, size_t slot_size);
+void* lwmem_bitmap_alloc(lwmem_bitmap_t* bm);
+void lwmem_bitmap_free(lwmem_bitmap_t* bm, void* ptr);
+size_t lwmem_bitmap_used(const lwmem_bitmap_t* bm);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_BITMAP_HDR_H */
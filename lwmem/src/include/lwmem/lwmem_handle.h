@@ -0,0 +1,93 @@
+/**
+ * \file            lwmem_handle.h
+ * \brief           Handle-based compacting heap
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_HANDLE_HDR_H
+#define LWMEM_HANDLE_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_HANDLE Handle-based compacting heap
+ * \brief           Allocations behind stable handles, with defragmentation by block relocation
+ * \{
+ */
+
+/**
+ * \brief           Stable allocation handle, `0` is invalid value
+ */
+typedef size_t lwmem_handle_t;
+
+/**
+ * \brief           Handle table entry
+ */
+typedef struct {
+    uint8_t* ptr;     /*!< Current block address, may change on compaction */
+    uint32_t size;    /*!< Block size in units of bytes */
+    uint8_t lock_cnt; /*!< Number of outstanding locks pinning the address */
+    uint8_t used;     /*!< Set to `1` for live entries */
+} lwmem_handle_entry_t;
+
+/**
+ * \brief           Handle heap structure
+ */
+typedef struct {
+    uint8_t* base;               /*!< Data area */
+    size_t size;                 /*!< Data area size in units of bytes */
+    size_t brk;                  /*!< Top of allocated space */
+    lwmem_handle_entry_t* table; /*!< Handle table */
+    size_t capacity;             /*!< Number of entries in handle table */
+} lwmem_hheap_t;
+
+uint8_t lwmem_hheap_init(lwmem_hheap_t* hheap, const lwmem_region_t* region, size_t max_handles);
+lwmem_handle_t lwmem_hheap_alloc(lwmem_hheap_t* hheap, size_t size);
+void* lwmem_hheap_lock(lwmem_hheap_t* hheap, lwmem_handle_t handle);
+void lwmem_hheap_unlock(lwmem_hheap_t* hheap, lwmem_handle_t handle);
+void lwmem_hheap_free(lwmem_hheap_t* hheap, lwmem_handle_t handle);
+size_t lwmem_compact_ex(lwmem_hheap_t* hheap);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_HANDLE_HDR_H */
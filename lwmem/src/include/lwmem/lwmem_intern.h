@@ -0,0 +1,83 @@
+/**
+ * \file            lwmem_intern.h
+ * \brief           String/blob interning service
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_INTERN_HDR_H
+#define LWMEM_INTERN_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_INTERN Interning service
+ * \brief           Deduplication of identical payloads into canonical refcounted pointers
+ * \{
+ */
+
+/**
+ * \brief           Interning table entry
+ */
+typedef struct {
+    uint32_t hash; /*!< Payload hash */
+    uint32_t refs; /*!< Number of outstanding references */
+    uint32_t len;  /*!< Payload length in units of bytes */
+    void* ptr;     /*!< Canonical payload storage, `NULL` for unused entries */
+} lwmem_intern_entry_t;
+
+/**
+ * \brief           Interning service instance
+ */
+typedef struct {
+    lwmem_t* lwobj;               /*!< LwMEM instance backing table and payloads */
+    lwmem_intern_entry_t* table;  /*!< Open-addressing hash table */
+    size_t capacity;              /*!< Number of table entries */
+} lwmem_intern_t;
+
+uint8_t lwmem_intern_init_ex(lwmem_t* lwobj, lwmem_intern_t* intern, size_t capacity);
+const void* lwmem_intern(lwmem_intern_t* intern, const void* bytes, size_t len);
+void lwmem_intern_release(lwmem_intern_t* intern, const void* ptr);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_INTERN_HDR_H */
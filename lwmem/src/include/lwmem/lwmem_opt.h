@@ -61,6 +61,19 @@ extern "C" {
 #define LWMEM_CFG_OS 0
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` per-instance lock opt-out
+ *
+ * When enabled together with \ref LWMEM_CFG_OS, an instance may set its
+ * `lock_disabled` flag before region assignment, skipping mutex creation and
+ * all lock operations for that instance. Single-owner heaps then compile and
+ * run on the unlocked path while shared heaps keep the mutex, without
+ * separate library builds
+ */
+#ifndef LWMEM_CFG_PER_INSTANCE_LOCKING
+#define LWMEM_CFG_PER_INSTANCE_LOCKING 0
+#endif
+
 /**
  * \brief           Mutex handle type
  *
@@ -85,6 +98,61 @@ extern "C" {
 #define LWMEM_CFG_ALIGN_NUM 4
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` reallocation support within the full manager
+ *
+ * Reallocation (with its in-place merge cases) is the largest function of the
+ * library. Products that free but never realloc can disable it to strip the
+ * code entirely - including \ref lwmem_expand_ex, which builds on it -
+ * keeping the remaining hot code denser
+ */
+#ifndef LWMEM_CFG_SUPPORT_REALLOC
+#define LWMEM_CFG_SUPPORT_REALLOC 1
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` allocation flag in the lowest size bit
+ *
+ * By default the allocated-block flag occupies the MSB of the size field,
+ * halving the representable block size. Since block sizes are always multiples
+ * of \ref LWMEM_CFG_ALIGN_NUM, the lowest size bit is guaranteed zero: storing
+ * the flag there restores the full size range (multi-GB heaps on host-replay
+ * builds) and makes the mask constant cheaper on most instruction sets
+ */
+#ifndef LWMEM_CFG_ALLOC_BIT_LOW
+#define LWMEM_CFG_ALLOC_BIT_LOW 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-instance alignment
+ *
+ * Adds \ref lwmem_set_instance_align_ex, to be called before region
+ * assignment: the instance then aligns its region bases and rounds block
+ * sizes to the requested value, so one library binary serves a 32-byte
+ * aligned DMA heap next to a default-aligned general heap. Compile-time
+ * alignment remains the default and the only path when disabled
+ *
+ * \note            Only used by list-based allocation strategies
+ */
+#ifndef LWMEM_CFG_PER_INSTANCE_ALIGN
+#define LWMEM_CFG_PER_INSTANCE_ALIGN 0
+#endif
+
+/**
+ * \brief           Alignment of block start addresses, in units of bytes
+ *
+ * Defaults to \ref LWMEM_CFG_ALIGN_NUM. Set to the data cache line size
+ * (e.g. `32` on Cortex-M7) so block headers never straddle a cache line with
+ * neighboring user data: free-list walks then touch header lines only.
+ * Block sizes are rounded up accordingly (internal fragmentation trade-off)
+ *
+ * \note            Must be a power of `2` and at least \ref LWMEM_CFG_ALIGN_NUM.
+ *                      Only used by list-based allocation strategies
+ */
+#ifndef LWMEM_CFG_BLOCK_START_ALIGN
+#define LWMEM_CFG_BLOCK_START_ALIGN LWMEM_CFG_ALIGN_NUM
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` full memory management support.
  * 
@@ -97,8 +165,8 @@ extern "C" {
  * When disabled, library only supports allocation and does not provide any other service.
  *  - Its purpose is for memory allocation at the start of firmware initialization only
  * 
- * \note            When disabled, statistics functionaltiy is not available
- *                  and only one region is supported (for now, may be updated later).
+ * \note            When disabled, statistics functionaltiy is not available.
+ *                  Regions are walked in order of definition and exhausted one by one.
  *                  API to allocate memory remains the same as for full configuration.
  */
 #ifndef LWMEM_CFG_FULL
@@ -106,49 +174,1479 @@ extern "C" {
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` memory cleanup on free operation (or realloc).
+ * \brief           First-fit allocation strategy
  *
- * It resets unused memory to `0x00` and prevents other applications seeing old data.
- * It is disabled by default since it has performance penalties.
+ * Allocation linearly walks the single address-ordered list of free blocks
+ * and takes first block big enough for the request. This is the default strategy
  */
-#ifndef LWMEM_CFG_CLEAN_MEMORY
-#define LWMEM_CFG_CLEAN_MEMORY 0
+#define LWMEM_ALLOC_STRATEGY_FIRST_FIT  0
+
+/**
+ * \brief           Segregated free lists allocation strategy
+ *
+ * Free blocks are additionally linked into power-of-two size-class bins,
+ * allowing allocation to pick a fitting block in near-constant time.
+ * Free blocks require more metadata, which slightly increases minimum block size
+ */
+#define LWMEM_ALLOC_STRATEGY_SEGREGATED 1
+
+/**
+ * \brief           Two-level segregated fit (TLSF) allocation strategy
+ *
+ * Free blocks are kept in two-level size-class bins with bitmap of non-empty classes,
+ * giving bounded (near-constant) allocation and free time, independent of number of free blocks.
+ * Suitable for latency-critical systems. Free blocks require more metadata,
+ * which slightly increases minimum block size
+ */
+#define LWMEM_ALLOC_STRATEGY_TLSF       2
+
+/**
+ * \brief           Best-fit allocation strategy
+ *
+ * Allocation walks complete address-ordered list of free blocks and takes
+ * the one with least wasted space. Slower than first-fit,
+ * but keeps large blocks intact for longer
+ */
+#define LWMEM_ALLOC_STRATEGY_BEST_FIT   3
+
+/**
+ * \brief           Next-fit allocation strategy
+ *
+ * Same walk as first-fit, except search resumes at the block
+ * following the most recent allocation (roving pointer) and wraps around once.
+ * Effective when subsequent allocations and frees cluster together
+ */
+#define LWMEM_ALLOC_STRATEGY_NEXT_FIT   4
+
+/**
+ * \brief           Buddy allocation strategy
+ *
+ * Region is carved into power-of-two blocks, which are recursively split on
+ * allocation and merged with their buddy on free, both in logarithmic bounded time.
+ * Very effective for power-of-two sized workloads, while any other sizes
+ * are rounded up to next power of two (internal fragmentation).
+ *
+ * \note            Only one (first) region is supported and reallocation
+ *                  to a different size class always moves the block
+ */
+#define LWMEM_ALLOC_STRATEGY_BUDDY      5
+
+/**
+ * \brief           No size rounding, requests are served at aligned exact size
+ */
+#define LWMEM_SIZE_ROUNDING_NONE      0
+
+/**
+ * \brief           Requests round up to the next power of two
+ */
+#define LWMEM_SIZE_ROUNDING_POW2      1
+
+/**
+ * \brief           Requests round up to the next power of two or its midpoint
+ *
+ * Ladder 16, 24, 32, 48, 64, 96, ... bounds internal waste to `25%`
+ */
+#define LWMEM_SIZE_ROUNDING_POW2_HALF 2
+
+/**
+ * \brief           Size rounding policy applied before the free-block search
+ *
+ * Restricting block sizes to a ladder makes freed blocks far more likely to
+ * exactly satisfy future requests without splitting, trading bounded internal
+ * fragmentation for less external fragmentation on long-uptime devices
+ */
+#ifndef LWMEM_CFG_SIZE_ROUNDING
+#define LWMEM_CFG_SIZE_ROUNDING LWMEM_SIZE_ROUNDING_NONE
 #endif
 
 /**
- * \brief           Enables `1` or disables `0` statistics in the library
+ * \brief           Allocation strategy used by the full memory manager
  *
+ * Select one of `LWMEM_ALLOC_STRATEGY_xxx` values.
+ * It has no effect when \ref LWMEM_CFG_FULL is disabled
  */
-#ifndef LWMEM_CFG_ENABLE_STATS
-#define LWMEM_CFG_ENABLE_STATS 0
+#ifndef LWMEM_CFG_ALLOC_STRATEGY
+#define LWMEM_CFG_ALLOC_STRATEGY LWMEM_ALLOC_STRATEGY_FIRST_FIT
 #endif
 
 /**
- * \brief           Memory set function
- * 
- * \note            Function footprint is the same as \ref memset
+ * \brief           Number of size-class bins for \ref LWMEM_ALLOC_STRATEGY_SEGREGATED strategy
+ *
+ * First bin holds blocks smaller than `32` bytes, each next bin doubles the size class.
+ * Last bin holds all blocks that do not fit to any previous bin
  */
-#ifndef LWMEM_MEMSET
-#define LWMEM_MEMSET(dst, val, len) memset((dst), (val), (len))
+#ifndef LWMEM_CFG_SEGREGATED_BIN_COUNT
+#define LWMEM_CFG_SEGREGATED_BIN_COUNT 16
 #endif
 
 /**
- * \brief           Memory copy function
- * 
- * \note            Function footprint is the same as \ref memcpy
+ * \brief           Number of first-level size ranges for \ref LWMEM_ALLOC_STRATEGY_TLSF strategy
+ *
+ * Level `0` holds smallest blocks, each next level doubles the size range.
+ * Last level is catch-all level for all blocks not fitting to any previous level.
+ * Value must not exceed `32`
  */
-#ifndef LWMEM_MEMCPY
-#define LWMEM_MEMCPY(dst, src, len) memcpy((dst), (src), (len))
+#ifndef LWMEM_CFG_TLSF_FL_COUNT
+#define LWMEM_CFG_TLSF_FL_COUNT 24
 #endif
 
 /**
- * \brief           Memory move function
- * 
- * \note            Function footprint is the same as \ref memmove
+ * \brief           Log2 of number of second-level subdivisions for \ref LWMEM_ALLOC_STRATEGY_TLSF strategy
+ *
+ * Each first-level size range is linearly split to `2^value` classes.
+ * Value must not exceed `5`
  */
-#ifndef LWMEM_MEMMOVE
-#define LWMEM_MEMMOVE(dst, src, len) memmove((dst), (src), (len))
+#ifndef LWMEM_CFG_TLSF_SL_COUNT_LOG2
+#define LWMEM_CFG_TLSF_SL_COUNT_LOG2 4
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` 32-bit offsets in compact headers
+ *
+ * Widens \ref LWMEM_CFG_COMPACT_HEADER offsets from 16 to 32 bits: header is
+ * a fixed 8 bytes on 32-bit and 64-bit builds alike, so host benchmarking and
+ * trace replay reproduce target block layout exactly (and 64-bit builds halve
+ * metadata cache footprint versus pointer-based headers). Region limit grows
+ * to 4 GB with maximal single allocation of 2 GB
+ */
+#ifndef LWMEM_CFG_COMPACT_HEADER_32
+#define LWMEM_CFG_COMPACT_HEADER_32 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` boundary-tag footers in the address-ordered engine
+ *
+ * Every block replicates its size (with the allocation flag) in a footer at
+ * its end. Free then locates the physical predecessor directly: when it is
+ * free, backward merge and the follow-up forward merge complete in O(1)
+ * without any address-ordered list walk - the walk remains only for frees
+ * whose predecessor is allocated. Costs one extra word per block.
+ *
+ * \note            Only used with address-ordered list strategies
+ *                      (first/best/next-fit); incompatible with size-class and
+ *                      cache extras that derive sizes from user capacity
+ */
+#ifndef LWMEM_CFG_BOUNDARY_TAGS
+#define LWMEM_CFG_BOUNDARY_TAGS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` size-ordered free list organization
+ *
+ * Free blocks are kept in ascending size order, so the first fitting block of
+ * the allocation walk is automatically the best fit and small requests
+ * terminate after a few nodes. Address order is not maintained at all:
+ * coalescing instead uses boundary-tag footers (block size replicated at the
+ * block end), making free O(1) apart from the size-ordered re-insertion.
+ * The classic trade for heaps where insertion cost dominates frees.
+ *
+ * \note            Requires first-fit base configuration; incompatible extras
+ *                      are rejected at compile time. Reallocation always moves
+ *                      the block and only default-alignment requests are served
+ */
+#ifndef LWMEM_CFG_SIZE_ORDERED_LIST
+#define LWMEM_CFG_SIZE_ORDERED_LIST 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` out-of-band block metadata
+ *
+ * All metadata lives in a compact side table reserved at the region head,
+ * leaving user data contiguous: a buffer overflow can no longer corrupt
+ * allocator state, and allocation scans a dense cache-friendly array instead
+ * of chasing pointers through the heap. Table capacity (maximal number of
+ * live blocks) is reserved up front.
+ *
+ * \note            Single region with first-fit semantics; growth reallocation
+ *                      moves the block when no free gap follows. Not available
+ *                      together with header-based extras (tags, redzones,
+ *                      thread cache, ISR free queue, compact headers)
+ */
+#ifndef LWMEM_CFG_OOB_METADATA
+#define LWMEM_CFG_OOB_METADATA 0
+#endif
+
+/**
+ * \brief           Maximal number of live blocks with \ref LWMEM_CFG_OOB_METADATA, `0` derives
+ *                  the capacity from region size (one entry per `128` bytes)
+ */
+#ifndef LWMEM_CFG_OOB_MAX_BLOCKS
+#define LWMEM_CFG_OOB_MAX_BLOCKS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` single-region specialization
+ *
+ * Products with exactly one region can compile out the multi-region
+ * generality: the explicit-region search path in the allocator and the region
+ * lookup branches disappear, the assignment accepts a single region only -
+ * cutting code size and branches from the hottest functions
+ */
+#ifndef LWMEM_CFG_SINGLE_REGION
+#define LWMEM_CFG_SINGLE_REGION 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-region free list anchors
+ *
+ * Each region keeps a stable anchor into the global free list, so allocation
+ * from a specific region (`region` parameter of `_ex` functions) scans only
+ * blocks belonging to that region instead of walking all preceding regions.
+ * Region-less allocation iterates regions in their (address) priority order as before
+ *
+ * \note            Only used with full memory manager. Number of supported
+ *                      regions is limited by \ref LWMEM_CFG_MAX_REGIONS
+ */
+#ifndef LWMEM_CFG_PER_REGION_LISTS
+#define LWMEM_CFG_PER_REGION_LISTS 0
+#endif
+
+/**
+ * \brief           Maximal number of regions in single LwMEM instance
+ *                  when \ref LWMEM_CFG_PER_REGION_LISTS is enabled
+ */
+#ifndef LWMEM_CFG_MAX_REGIONS
+#define LWMEM_CFG_MAX_REGIONS 4
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` region attributes and allocation preference
+ *
+ * Extends \ref lwmem_region_t with attribute flags and priority. Region-less
+ * allocation walks regions in rising priority value order (fast SRAM before
+ * slow SDRAM), and \ref lwmem_malloc_attr_ex can demand regions with specific
+ * attributes. Requires \ref LWMEM_CFG_PER_REGION_LISTS
+ */
+#ifndef LWMEM_CFG_REGION_ATTRIBUTES
+#define LWMEM_CFG_REGION_ATTRIBUTES 0
+#endif
+
+/**
+ * \brief           Size from which allocations route to the last region, in units of bytes (`0` disables)
+ *
+ * Large long-lived objects (video frames and similar) gain nothing from
+ * free-list reuse, yet they lengthen every scan and shred the list when
+ * freed. Routing them to the (typically biggest) last region first keeps the
+ * other regions' lists small and fast for the many small blocks.
+ * Requires \ref LWMEM_CFG_PER_REGION_LISTS
+ */
+#ifndef LWMEM_CFG_LARGE_ROUTING_THRESHOLD
+#define LWMEM_CFG_LARGE_ROUTING_THRESHOLD 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` small-block region routing
+ *
+ * Region-less allocations below a runtime threshold (set with
+ * \ref lwmem_set_small_region_ex) are automatically directed to a designated
+ * region, keeping small objects away from large-block regions and preserving
+ * large contiguous space, without touching any call sites.
+ * Requires \ref LWMEM_CFG_PER_REGION_LISTS
+ */
+#ifndef LWMEM_CFG_SMALL_REGION_ROUTING
+#define LWMEM_CFG_SMALL_REGION_ROUTING 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` fallback region chains
+ *
+ * Regions may be chained with \ref lwmem_set_region_fallback_ex: when an
+ * explicitly requested region cannot satisfy an allocation, chained regions
+ * are tried in the same locked pass, so tiered memory behaves as one logical
+ * heap with placement preference. Requires \ref LWMEM_CFG_PER_REGION_LISTS
+ */
+#ifndef LWMEM_CFG_REGION_FALLBACK
+#define LWMEM_CFG_REGION_FALLBACK 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-region statistics
+ *
+ * Every region tracks its own available bytes, minimum-ever available bytes
+ * and allocation/free counters, readable with \ref lwmem_get_region_stats_ex,
+ * so exhaustion of a single tier (e.g. DTCM) is visible even when aggregate
+ * numbers look healthy. Requires \ref LWMEM_CFG_PER_REGION_LISTS
+ */
+#ifndef LWMEM_CFG_PER_REGION_STATS
+#define LWMEM_CFG_PER_REGION_STATS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` compact 16-bit block headers
+ *
+ * Block metadata is stored as 16-bit offsets from region base instead of full
+ * pointer and size pair, shrinking per-block overhead from `8` to `4` bytes on 32-bit CPUs.
+ * Improves effective capacity and cache density of free-list walk on small heaps.
+ *
+ * \note            Single region of up to `64` kB is supported (larger region is truncated),
+ *                  maximal single allocation is `32` kB. Requires default
+ *                  \ref LWMEM_ALLOC_STRATEGY_FIRST_FIT strategy. Reallocation
+ *                  to a bigger size always moves the block
+ */
+#ifndef LWMEM_CFG_COMPACT_HEADER
+#define LWMEM_CFG_COMPACT_HEADER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` skip-list index over the free list
+ *
+ * Auxiliary probabilistic skip-list, keyed by block address, is maintained for
+ * free blocks, so address-ordered insertion on free and predecessor lookup on
+ * reallocation are done in logarithmic instead of linear time. Recommended for
+ * large heaps where free list routinely holds hundreds or thousands of blocks.
+ *
+ * Index is consulted only when number of free blocks exceeds
+ * \ref LWMEM_CFG_SKIP_INDEX_MIN_BLOCKS, plain walk is faster below it.
+ * Free blocks require more metadata, which increases minimum block size
+ *
+ * \note            Only used with full memory manager and address-ordered
+ *                      strategies (first-fit, best-fit, next-fit)
+ */
+#ifndef LWMEM_CFG_SKIP_INDEX
+#define LWMEM_CFG_SKIP_INDEX 0
+#endif
+
+/**
+ * \brief           Number of levels of the skip-list index
+ *
+ * Each level halves expected number of visited blocks, `8` levels
+ * are a good fit for heaps with up to few thousand free blocks
+ */
+#ifndef LWMEM_CFG_SKIP_INDEX_LEVELS
+#define LWMEM_CFG_SKIP_INDEX_LEVELS 8
+#endif
+
+/**
+ * \brief           Number of free blocks above which skip-list index is consulted
+ */
+#ifndef LWMEM_CFG_SKIP_INDEX_MIN_BLOCKS
+#define LWMEM_CFG_SKIP_INDEX_MIN_BLOCKS 64
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` deferred coalescing on free operation
+ *
+ * Free operation pushes the block onto a cheap LIFO list instead of doing
+ * full address-ordered insertion with merging. Blocks are merged back into
+ * the free list lazily: when an allocation cannot be satisfied, or explicitly
+ * with \ref lwmem_coalesce_ex, which application may call from idle time.
+ * Effective for burst frees, such as tearing down a connection with many buffers
+ *
+ * \note            Only used with full memory manager and list-based
+ *                      allocation strategies (not buddy)
+ */
+#ifndef LWMEM_CFG_DEFERRED_COALESCING
+#define LWMEM_CFG_DEFERRED_COALESCING 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` lock-free simple allocation
+ *
+ * Bump pointer of the simple allocator (\ref LWMEM_CFG_FULL disabled) is
+ * advanced with C11 atomic compare-and-swap instead of being protected by the
+ * system mutex, so concurrent startup-time allocation from multiple cores or
+ * tasks scales without any lock.
+ *
+ * \note            Requires C11 `<stdatomic.h>` support and is only
+ *                      used when \ref LWMEM_CFG_FULL is disabled
+ */
+#ifndef LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+#define LWMEM_CFG_ATOMIC_SIMPLE_ALLOC 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` header-inline allocation fast path
+ *
+ * Exposes `static inline` \ref lwmem_malloc_fast and \ref lwmem_free_fast
+ * front ends in the header: the common hit case (thread-cache magazine hit)
+ * compiles inline at the call site - no cross-TU call, full constant
+ * propagation of the size - and only misses tail-call into the library.
+ * Intended for toolchains without LTO where call overhead dominates
+ * small-allocation cost.
+ *
+ * \note            Requires \ref LWMEM_CFG_THREAD_CACHE and full memory manager
+ */
+#ifndef LWMEM_CFG_INLINE_FASTPATH
+#define LWMEM_CFG_INLINE_FASTPATH 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` evictable (discardable) allocations
+ *
+ * Blocks allocated with \ref lwmem_malloc_evictable_ex register an eviction
+ * callback: when a regular allocation would otherwise fail, least-recently
+ * touched discardable blocks are reclaimed on demand (callback notifies the
+ * owner, allocator frees the block) - removing both cache-manager polling and
+ * conservative free headroom
+ */
+#ifndef LWMEM_CFG_EVICTABLE
+#define LWMEM_CFG_EVICTABLE 0
+#endif
+
+/**
+ * \brief           Maximal number of registered evictable blocks per instance
+ */
+#ifndef LWMEM_CFG_EVICTABLE_MAX
+#define LWMEM_CFG_EVICTABLE_MAX 16
+#endif
+
+/**
+ * \brief           Maximal number of allocations within one allocation transaction
+ */
+#ifndef LWMEM_CFG_TXN_MAX_ALLOCS
+#define LWMEM_CFG_TXN_MAX_ALLOCS 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-group memory quotas
+ *
+ * Allocations made through \ref lwmem_malloc_quota_ex are charged against a
+ * caller-owned group budget, checked inside the locked allocation path with a
+ * single compare - so a misbehaving tenant (plugin) exhausts only its own
+ * budget instead of the whole heap
+ */
+#ifndef LWMEM_CFG_QUOTA_GROUPS
+#define LWMEM_CFG_QUOTA_GROUPS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` reference-counted buffers
+ *
+ * Adds \ref lwmem_ref_alloc_ex / \ref lwmem_ref_acquire_ex /
+ * \ref lwmem_ref_release_ex: the counter lives in front of user data inside
+ * the same block, release reaches the real free only at count zero - native
+ * zero-copy fan-out of one buffer to several consumers, safe under
+ * \ref LWMEM_CFG_OS via the instance lock
+ */
+#ifndef LWMEM_CFG_REF_BUFFERS
+#define LWMEM_CFG_REF_BUFFERS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` ISR-safe free queue
+ *
+ * Adds \ref lwmem_free_from_isr_ex function, which pushes the pointer onto a
+ * lock-free queue with a single compare-and-swap, without ever taking the
+ * system mutex. Queue is drained back into the free list on the next
+ * task-context allocation, or explicitly with \ref lwmem_free_from_isr_drain_ex.
+ *
+ * \note            Requires C11 `<stdatomic.h>` support, full memory manager
+ *                      and is not available together with \ref LWMEM_CFG_COMPACT_HEADER
+ */
+#ifndef LWMEM_CFG_FREE_FROM_ISR
+#define LWMEM_CFG_FREE_FROM_ISR 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-CPU free-block caches
+ *
+ * Small blocks freed on a CPU are kept in that CPU's cache-line padded
+ * magazine and served to subsequent allocations on the same CPU before the
+ * shared free list is touched - removing the shared-structure cache-line
+ * ping-pong that limits SMP scaling beyond the mutex itself. Spill happens
+ * automatically on full magazines; \ref lwmem_cpu_cache_flush returns all
+ * cached blocks to the heap.
+ *
+ * \note            Define \ref LWMEM_GET_CPU_ID and, unless CPU migration is
+ *                      otherwise prevented around allocator calls,
+ *                      \ref LWMEM_CPU_LOCK / \ref LWMEM_CPU_UNLOCK.
+ *                      Default-instance allocations only; not available
+ *                      together with \ref LWMEM_CFG_COMPACT_HEADER or
+ *                      \ref LWMEM_CFG_OOB_METADATA
+ */
+#ifndef LWMEM_CFG_CPU_CACHE
+#define LWMEM_CFG_CPU_CACHE 0
+#endif
+
+/**
+ * \brief           Number of CPUs served by per-CPU caches
+ */
+#ifndef LWMEM_CFG_CPU_COUNT
+#define LWMEM_CFG_CPU_COUNT 2
+#endif
+
+/**
+ * \brief           Maximal user allocation size kept in per-CPU caches, in units of bytes
+ */
+#ifndef LWMEM_CFG_CPU_CACHE_MAX_SIZE
+#define LWMEM_CFG_CPU_CACHE_MAX_SIZE 128
+#endif
+
+/**
+ * \brief           Maximal number of cached blocks per size class and CPU
+ */
+#ifndef LWMEM_CFG_CPU_CACHE_DEPTH
+#define LWMEM_CFG_CPU_CACHE_DEPTH 8
+#endif
+
+/**
+ * \brief           Current CPU identifier for per-CPU caches
+ */
+#ifndef LWMEM_GET_CPU_ID
+#define LWMEM_GET_CPU_ID() 0
+#endif
+
+/**
+ * \brief           Hook disabling CPU migration/preemption around a per-CPU cache operation
+ */
+#ifndef LWMEM_CPU_LOCK
+#define LWMEM_CPU_LOCK()
+#endif
+
+/**
+ * \brief           Hook re-enabling CPU migration/preemption after a per-CPU cache operation
+ */
+#ifndef LWMEM_CPU_UNLOCK
+#define LWMEM_CPU_UNLOCK()
+#endif
+
+/**
+ * \brief           Cache-line alignment attribute for per-CPU structures
+ */
+#ifndef LWMEM_CACHELINE_ALIGN
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_CACHELINE_ALIGN __attribute__((aligned(64)))
+#else
+#define LWMEM_CACHELINE_ALIGN
+#endif
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-thread allocation cache
+ *
+ * Small blocks are cached in thread-local magazines, so the common
+ * malloc/free path of repeated small allocations does not touch the global
+ * mutex nor the shared free list at all. Cache misses and full magazines
+ * fall back to the regular (protected) path. Cached memory is not visible
+ * as available to other threads until flushed with \ref lwmem_thread_cache_flush.
+ *
+ * Only allocations from the default instance without region selector are cached.
+ *
+ * \note            Requires working thread-local storage, see \ref LWMEM_CFG_THREAD_LOCAL.
+ *                      Not available together with \ref LWMEM_CFG_COMPACT_HEADER
+ */
+#ifndef LWMEM_CFG_THREAD_CACHE
+#define LWMEM_CFG_THREAD_CACHE 0
+#endif
+
+/**
+ * \brief           Maximal user allocation size kept in per-thread cache, in units of bytes
+ */
+#ifndef LWMEM_CFG_THREAD_CACHE_MAX_SIZE
+#define LWMEM_CFG_THREAD_CACHE_MAX_SIZE 128
+#endif
+
+/**
+ * \brief           Maximal number of cached blocks per size class in single thread
+ */
+#ifndef LWMEM_CFG_THREAD_CACHE_DEPTH
+#define LWMEM_CFG_THREAD_CACHE_DEPTH 8
+#endif
+
+/**
+ * \brief           Thread-local storage class specifier used by per-thread cache
+ *
+ * Defaults to C11 `_Thread_local`. Set to compiler specific keyword
+ * (`__thread` or similar) when C11 keyword is not supported by the toolchain
+ */
+#ifndef LWMEM_CFG_THREAD_LOCAL
+#define LWMEM_CFG_THREAD_LOCAL _Thread_local
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` memory cleanup on free operation (or realloc).
+ *
+ * It resets unused memory to `0x00` and prevents other applications seeing old data.
+ * It is disabled by default since it has performance penalties.
+ */
+#ifndef LWMEM_CFG_CLEAN_MEMORY
+#define LWMEM_CFG_CLEAN_MEMORY 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` statistics in the library
+ *
+ */
+#ifndef LWMEM_CFG_ENABLE_STATS
+#define LWMEM_CFG_ENABLE_STATS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` allocation functions with bounded mutex wait
+ *
+ * Adds \ref lwmem_malloc_try_ex function, acquiring the system mutex with
+ * \ref lwmem_sys_mutex_wait_timeout port function and returning `NULL` fast
+ * when lock cannot be taken in time, so deadline-critical tasks can fall back
+ * to a static buffer instead of blocking for unbounded time.
+ *
+ * \note            When \ref LWMEM_CFG_OS is enabled, port must additionally
+ *                      implement \ref lwmem_sys_mutex_wait_timeout
+ */
+#ifndef LWMEM_CFG_OS_MUTEX_TIMEOUT
+#define LWMEM_CFG_OS_MUTEX_TIMEOUT 0
+#endif
+
+/**
+ * \brief           Emergency reserve kept aside from regular allocations, in units of bytes
+ *
+ * When set to non-zero value, regular allocations fail once they would drop
+ * available memory below the reserve, which stays usable exclusively through
+ * \ref lwmem_malloc_critical_ex (e.g. for failure-logging paths). Reserve
+ * memory is not carved out of the heap: it remains part of the free list and
+ * coalesces with regular memory when pressure subsides.
+ *
+ * \note            Reserve accounting has block granularity and is only
+ *                      used with full memory manager and list-based strategies
+ */
+#ifndef LWMEM_CFG_EMERGENCY_RESERVE_SIZE
+#define LWMEM_CFG_EMERGENCY_RESERVE_SIZE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` out-of-memory handler support
+ *
+ * Application may register per-instance callback with
+ * \ref lwmem_set_oom_handler_ex, invoked outside the instance lock whenever
+ * an allocation cannot be satisfied. Callback may release caches and request
+ * a retry, centralizing memory-pressure handling instead of scattering
+ * fallback code over call sites
+ */
+#ifndef LWMEM_CFG_OOM_HANDLER
+#define LWMEM_CFG_OOM_HANDLER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` reallocation growth policy
+ *
+ * When reallocation must relocate the block, capacity is reserved ahead
+ * (requested size scaled by a per-instance percentage, set with
+ * \ref lwmem_set_realloc_growth_ex), so append-heavy callers growing buffers
+ * step by step hit the in-place path on subsequent grows - amortized O(1)
+ * instead of quadratic behavior. Reserved slack is visible through
+ * \ref lwmem_get_capacity_ex
+ */
+#ifndef LWMEM_CFG_REALLOC_GROWTH
+#define LWMEM_CFG_REALLOC_GROWTH 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` runtime allocation policy switching
+ *
+ * Compiles first-, best- and next-fit searches together with a per-instance
+ * policy block, so \ref lwmem_set_policy_ex can retune the allocator between
+ * run modes (idle / streaming / update) the way clocks are retuned - on a
+ * quiesced heap, without separate builds.
+ *
+ * \note            Requires default \ref LWMEM_ALLOC_STRATEGY_FIRST_FIT build
+ *                      (runtime modes replace the compile-time strategy choice)
+ */
+#ifndef LWMEM_CFG_RUNTIME_POLICY
+#define LWMEM_CFG_RUNTIME_POLICY 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` runtime-configurable split threshold
+ *
+ * Adds \ref lwmem_set_split_threshold_ex: remainders smaller than the
+ * configured per-instance value stay attached to the allocated block instead
+ * of entering the free list as never-usable minimum-size fragments, which are
+ * a primary driver of scan length and tail latency on long soaks. Unsplit
+ * slack is visible through \ref lwmem_get_capacity_ex
+ */
+#ifndef LWMEM_CFG_CONFIGURABLE_SPLIT
+#define LWMEM_CFG_CONFIGURABLE_SPLIT 0
+#endif
+
+/**
+ * \brief           Minimal tail remainder to split off in \ref lwmem_shrink_ex, in units of bytes
+ *
+ * Remainders smaller than the threshold stay attached to the shrunk block
+ * instead of polluting the free list with tiny fragments that slow later scans
+ */
+#ifndef LWMEM_CFG_SHRINK_SPLIT_THRESHOLD
+#define LWMEM_CFG_SHRINK_SPLIT_THRESHOLD (8 * LWMEM_CFG_ALIGN_NUM)
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` deferred memory scrubbing
+ *
+ * Replaces the synchronous memset of \ref LWMEM_CFG_CLEAN_MEMORY on free
+ * operation: freed blocks are queued dirty and zeroed incrementally with
+ * \ref lwmem_scrub_step_ex, callable from idle task with a byte budget.
+ * Queued blocks re-enter the free list only once scrubbed; when an allocation
+ * cannot be satisfied, remaining queue is force-scrubbed and allocation retried.
+ *
+ * \note            Requires \ref LWMEM_CFG_CLEAN_MEMORY, full memory manager
+ *                      with a list-based strategy and is not available together
+ *                      with \ref LWMEM_CFG_DEFERRED_COALESCING
+ */
+#ifndef LWMEM_CFG_CLEAN_MEMORY_DEFERRED
+#define LWMEM_CFG_CLEAN_MEMORY_DEFERRED 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` known-zero memory tracking
+ *
+ * Instance tracks the highest address ever handed out to the application.
+ * Memory above it has never been written (except block metadata), so when
+ * regions are zero-initialized at assign time (placed in `.bss` or cleared by
+ * the application), \ref lwmem_calloc_ex can skip the memset for blocks carved
+ * from fresh memory. Large zeroed startup allocations become pure savings.
+ *
+ * \note            Application must guarantee region memory reads as zero
+ *                      when passed to \ref lwmem_assignmem_ex.
+ *                      Only used with full memory manager and list-based strategies
+ */
+#ifndef LWMEM_CFG_ZERO_TRACKING
+#define LWMEM_CFG_ZERO_TRACKING 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` guaranteed-latency allocation tier
+ *
+ * Airline-seat-map model for mixing hard-real-time and best-effort traffic
+ * on one heap: \ref lwmem_rt_reserve_ex pre-splits a configured set of
+ * size/count guarantees off the free list, \ref lwmem_malloc_rt_ex serves
+ * requests against the guarantee with an O(1) stack pop, and since reserved
+ * blocks are physically removed from the free list, best-effort traffic is
+ * admission-controlled by construction - it can never consume guaranteed
+ * capacity.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ */
+#ifndef LWMEM_CFG_RT_TIER
+#define LWMEM_CFG_RT_TIER 0
+#endif
+
+/**
+ * \brief           Maximal number of distinct size classes of the guaranteed tier
+ */
+#ifndef LWMEM_CFG_RT_TIER_CLASSES
+#define LWMEM_CFG_RT_TIER_CLASSES 4
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-block generation counters
+ *
+ * Every block carries a generation counter bumped when the block is freed.
+ * Long-lived references stored as \ref lwmem_ref_t (pointer plus generation)
+ * are validated in O(1) with \ref lwmem_ref_resolve_ex: a stale reference to
+ * a freed - or freed-and-reallocated - block resolves to `NULL` instead of
+ * silently aliasing someone else's data, closing the classic ABA hazard.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ */
+#ifndef LWMEM_CFG_BLOCK_GENERATION
+#define LWMEM_CFG_BLOCK_GENERATION 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` exact-fit fast cache
+ *
+ * Small direct-mapped cache of recently freed blocks, keyed on block size:
+ * frees stash the block instead of inserting it into the free list, and an
+ * allocation of the exact same size returns it without any list traversal.
+ * High hit rates on workloads re-requesting freed sizes shortly after the
+ * free, at a fraction of the complexity of segregated lists. Cached blocks
+ * are flushed back to the free list automatically when an allocation would
+ * otherwise fail.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ *                      and the plain list engine
+ */
+#ifndef LWMEM_CFG_EXACT_CACHE
+#define LWMEM_CFG_EXACT_CACHE 0
+#endif
+
+/**
+ * \brief           Number of entries of the exact-fit cache. Must be a power of `2`
+ */
+#ifndef LWMEM_CFG_EXACT_CACHE_SIZE
+#define LWMEM_CFG_EXACT_CACHE_SIZE 8
+#endif
+
+/**
+ * \brief           Maximal number of chunks of a single scatter allocation
+ *
+ * Scatter allocations (\ref lwmem_sg_alloc_ex) satisfy oversized requests
+ * from multiple regions when no single free block is large enough
+ */
+#ifndef LWMEM_CFG_SG_MAX_CHUNKS
+#define LWMEM_CFG_SG_MAX_CHUNKS 8
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` persistent heap attach support
+ *
+ * Heap in battery/FRAM-backed memory survives reset: initialize once with
+ * \ref lwmem_persist_init_ex (writes a versioned region header), then after
+ * reboot revalidate and adopt the existing layout with
+ * \ref lwmem_attach_existing_ex instead of wiping it - the free list is
+ * rebuilt from a physical block walk, so warm-boot recovery is instant and
+ * the mapping address may even differ between boots.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ *                      and the plain list engine
+ */
+#ifndef LWMEM_CFG_PERSIST
+#define LWMEM_CFG_PERSIST 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` write-ahead intent records for the persistent heap
+ *
+ * A power cut in the middle of the multi-store free-list updates of
+ * `prv_alloc()`/`prv_free()` can tear block sizes mid-operation. With this
+ * option, operations arm a single intent record (block offset and pre-op
+ * size words) in the persistent region header and disarm it on completion;
+ * \ref lwmem_attach_existing_ex rolls an interrupted operation back in O(1)
+ * before the validation walk, keeping warm-boot attach fast after unclean
+ * shutdowns.
+ *
+ * \note            Feature requires \ref LWMEM_CFG_PERSIST
+ */
+#ifndef LWMEM_CFG_PERSIST_WAL
+#define LWMEM_CFG_PERSIST_WAL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` wear-leveled placement for persistent regions
+ *
+ * Regions flagged with \ref LWMEM_REGION_ATTR_PERSISTENT (MRAM/FRAM backed
+ * memory with finite write endurance) are allocated with a rotating start
+ * point: each allocation resumes the search past the previous one and wraps
+ * at the region end, so header rewrites spread across the whole region
+ * instead of hammering the blocks at the region head.
+ *
+ * \note            Feature requires \ref LWMEM_CFG_REGION_ATTRIBUTES
+ *                      and \ref LWMEM_CFG_PER_REGION_LISTS
+ */
+#ifndef LWMEM_CFG_WEAR_LEVELING
+#define LWMEM_CFG_WEAR_LEVELING 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` interrupt-latency-bounded profile
+ *
+ * Hard-real-time contract for builds using the critical-section locking port:
+ * every allocator critical section runs bounded work. Frees push to the
+ * deferred list in constant time (\ref LWMEM_CFG_DEFERRED_COALESCING is
+ * required), allocation walks visit at most
+ * \ref LWMEM_CFG_BOUNDED_LOCK_MAX_WALK free blocks before failing the request
+ * (aborts counted by \ref lwmem_bound_aborts_ex), on-demand coalescing is
+ * capped to the same block count per critical section and the remaining work
+ * is drained in preemptible stages with \ref lwmem_coalesce_step_ex from
+ * thread context. Masked time per operation is then `C1 + C2 * MAX_WALK`
+ * cycles for platform constants measurable with \ref LWMEM_CFG_PROFILING.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL.
+ *                      Unbounded-walk strategies (best fit, runtime policy)
+ *                      are rejected at compile time
+ */
+#ifndef LWMEM_CFG_BOUNDED_LOCK
+#define LWMEM_CFG_BOUNDED_LOCK 0
+#endif
+
+/**
+ * \brief           Maximal number of free blocks visited inside one critical section
+ */
+#ifndef LWMEM_CFG_BOUNDED_LOCK_MAX_WALK
+#define LWMEM_CFG_BOUNDED_LOCK_MAX_WALK 16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-block user metadata word
+ *
+ * Reserves one `size_t` in every block header, written and read through
+ * \ref lwmem_set_udata_ex / \ref lwmem_get_udata_ex. One inline word of
+ * ownership/type information per buffer replaces application-side wrapper
+ * structs (an extra allocation plus an indirection on every access).
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ */
+#ifndef LWMEM_CFG_BLOCK_UDATA
+#define LWMEM_CFG_BLOCK_UDATA 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` block pinning and the relocation-consent protocol
+ *
+ * Defines one uniform contract for what may move in memory: blocks are
+ * movable by default, \ref lwmem_pin_ex / \ref lwmem_unpin_ex (nesting)
+ * make them immovable, and a relocation fix-up handler registered with
+ * \ref lwmem_set_move_handler_ex is consulted for every proposed move.
+ * Honored by the defragmenter and by any future relocating feature.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ */
+#ifndef LWMEM_CFG_BLOCK_PINNING
+#define LWMEM_CFG_BLOCK_PINNING 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` block metadata integrity checksums
+ *
+ * Every block header carries a checksum over its `next` and `size` fields
+ * plus a complement shadow copy of the free-list link. Headers are verified
+ * as the allocator uses them: corrupted links (EMC events, single-bit RAM
+ * faults) are repaired from the shadow copy, corrupted sizes are detected
+ * and counted before they can be acted upon. Checksum is XOR/rotate
+ * arithmetic, a couple of cycles per header, no CRC table.
+ * Read detection counters with \ref lwmem_chk_stats_ex.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ *                      and the plain list allocation engine
+ */
+#ifndef LWMEM_CFG_BLOCK_CHECKSUM
+#define LWMEM_CFG_BLOCK_CHECKSUM 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` constant-time allocation routing
+ *
+ * Allocations up to the configured size are served from an attached
+ * fixed-slot pool (\ref lwmem_pool_t) with data-independent cycle count -
+ * a single free-stack pop or push regardless of heap history. Closes the
+ * allocation-timing side channel for security-sensitive allocations such as
+ * key material, without a hand-written pool beside LwMEM.
+ * Attach the pool with \ref lwmem_ct_attach_ex.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ */
+#ifndef LWMEM_CFG_CONST_TIME_POOL
+#define LWMEM_CFG_CONST_TIME_POOL 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` crash-safe operation journal
+ *
+ * Application provides a \ref lwmem_journal_t record placed in noinit RAM
+ * (memory not cleared by the startup code) through \ref lwmem_journal_attach_ex.
+ * Every allocation, reallocation and free then updates the record with a few
+ * plain stores - after a watchdog reset, \ref lwmem_journal_valid and
+ * \ref lwmem_journal_read recover the last operations and heap fill level
+ * that preceded the reset.
+ *
+ * \note            Feature is only available with \ref LWMEM_CFG_FULL
+ */
+#ifndef LWMEM_CFG_OP_JOURNAL
+#define LWMEM_CFG_OP_JOURNAL 0
+#endif
+
+/**
+ * \brief           Number of last operations kept in the journal ring
+ *
+ * Must be a power of `2`. Memory cost is `12` bytes per entry in the
+ * application-provided noinit record
+ */
+#ifndef LWMEM_CFG_OP_JOURNAL_DEPTH
+#define LWMEM_CFG_OP_JOURNAL_DEPTH 16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` free-to-reuse audit instrumentation
+ *
+ * Freed blocks are stamped with the \ref LWMEM_GET_TICK time and their size;
+ * the next allocation of the block reports reuse latency (EWMA) and
+ * exact-size hit rate through \ref lwmem_audit_stats_ex - the measurements
+ * that size cache depths and bin granularity instead of guessing.
+ *
+ * \note            QA option for the plain list engine, incompatible with
+ *                      extras storing their own data in free block user areas
+ */
+#ifndef LWMEM_CFG_AUDIT_REUSE
+#define LWMEM_CFG_AUDIT_REUSE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` batched statistics writeback
+ *
+ * Allocation/free counters are accumulated in a per-thread scratch record
+ * (no shared-line store inside the mutexed section) and folded into the
+ * instance statistics by \ref lwmem_stats_flush, called periodically from the
+ * counting threads. Keeps the lock hold time at pure-allocator levels;
+ * counter reads between folds are approximate.
+ *
+ * \note            Intended for default-instance deployments: the scratch
+ *                      record is per thread, not per instance. Requires
+ *                      \ref LWMEM_CFG_ENABLE_STATS and thread-local storage
+ */
+#ifndef LWMEM_CFG_BATCHED_STATS
+#define LWMEM_CFG_BATCHED_STATS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` atomic statistics counters
+ *
+ * Statistics counters are updated with C11 atomic operations, so counter
+ * updates do not lengthen the mutexed section and \ref lwmem_get_stats_ex
+ * reads them without taking the lock at all, making it suitable for
+ * high-rate monitoring tasks.
+ *
+ * \note            Requires C11 `<stdatomic.h>` support
+ *                      and \ref LWMEM_CFG_ENABLE_STATS being enabled
+ */
+#ifndef LWMEM_CFG_ENABLE_STATS_ATOMIC
+#define LWMEM_CFG_ENABLE_STATS_ATOMIC 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` windowed (interval) statistics
+ *
+ * In addition to the ever-ratcheting minimum, per-interval minimum free
+ * memory and allocation/free counts are tracked. Telemetry task rotates the
+ * window with \ref lwmem_stats_epoch_ex (e.g. every 10 seconds), turning
+ * statistics into a usable time series. Requires \ref LWMEM_CFG_ENABLE_STATS
+ */
+#ifndef LWMEM_CFG_WINDOWED_STATS
+#define LWMEM_CFG_WINDOWED_STATS 0
+#endif
+
+/**
+ * \brief           Size of guard zones around user data, in units of bytes (`0` disables)
+ *
+ * QA-build overflow detection: each block allocated through the malloc/calloc/
+ * realloc/free API carries pattern-filled zones before and after user data,
+ * verified word-wise on free and by the incremental
+ * \ref lwmem_redzone_check_ex background checker. Violations are counted on
+ * the instance (\ref lwmem_redzone_violations_ex). Release builds with `0`
+ * compile to the exact regular layout with zero cost.
+ *
+ * \note            Must be a multiple of \ref LWMEM_CFG_ALIGN_NUM.
+ *                      Specialty paths (aligned, DMA, batch, pools) are not zoned
+ *                      and are skipped by verification via the zone magic
+ */
+#ifndef LWMEM_CFG_REDZONE_SIZE
+#define LWMEM_CFG_REDZONE_SIZE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` allocation fault injection
+ *
+ * Test-build facility configured with \ref lwmem_fault_inject_ex: fail the
+ * Nth allocation, fail allocations above a size, or fail with configured
+ * probability - so OOM recovery paths can be exercised deterministically
+ * without shrinking real regions
+ */
+#ifndef LWMEM_CFG_FAULT_INJECT
+#define LWMEM_CFG_FAULT_INJECT 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` memory watermark callbacks
+ *
+ * Per-instance callback (set with \ref lwmem_set_watermarks_ex) fires once
+ * when available memory crosses below the low threshold and once when it
+ * recovers above the high threshold - a single compare in the already locked
+ * alloc/free paths, instead of polling statistics from a task
+ */
+#ifndef LWMEM_CFG_WATERMARK_HOOKS
+#define LWMEM_CFG_WATERMARK_HOOKS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-allocation age tracking
+ *
+ * Every allocated block records a timestamp from the \ref LWMEM_GET_TICK
+ * hook; \ref lwmem_report_stale_ex lists live blocks older than a threshold
+ * (with their site tags when tagging is enabled), turning weeks-long slow
+ * leaks into a single report from a returned unit. QA-build option,
+ * increases per-block metadata overhead
+ *
+ * \note            Not available together with \ref LWMEM_CFG_COMPACT_HEADER
+ *                      or \ref LWMEM_CFG_OOB_METADATA
+ */
+#ifndef LWMEM_CFG_BLOCK_AGE
+#define LWMEM_CFG_BLOCK_AGE 0
+#endif
+
+/**
+ * \brief           Tick source for per-allocation age tracking
+ *
+ * Define to the system tick or RTC counter read
+ */
+#ifndef LWMEM_GET_TICK
+#define LWMEM_GET_TICK() 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` per-task block ownership tracking
+ *
+ * Every allocated block records the owning task (from the
+ * \ref LWMEM_GET_TASK_HANDLE hook) in its header, and
+ * \ref lwmem_free_all_owned_by_ex reclaims everything a deleted task left
+ * behind in one locked sweep - replacing leak-then-reboot policies on
+ * dynamic task unloading. Increases per-block metadata overhead
+ *
+ * \note            Not available together with \ref LWMEM_CFG_COMPACT_HEADER
+ *                      or \ref LWMEM_CFG_OOB_METADATA
+ */
+#ifndef LWMEM_CFG_TASK_OWNERSHIP
+#define LWMEM_CFG_TASK_OWNERSHIP 0
+#endif
+
+/**
+ * \brief           Current task handle source for ownership tracking
+ *
+ * Defaults to the \ref lwmem_sys_get_current_task port function,
+ * may be overridden with a direct kernel macro
+ */
+#ifndef LWMEM_GET_TASK_HANDLE
+#define LWMEM_GET_TASK_HANDLE() lwmem_sys_get_current_task()
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` allocation-site tagging
+ *
+ * Extends the block header with a tag pointer and accounts live bytes and
+ * allocation counts per site in a fixed table. Use \ref LWMEM_MALLOC_TAGGED
+ * (captures file and line) or \ref lwmem_malloc_tagged_ex with a custom tag,
+ * read the aggregates with \ref lwmem_tag_report_ex. Intended for QA builds
+ * when hunting slow leaks; increases per-block metadata overhead.
+ *
+ * \note            Not available together with \ref LWMEM_CFG_COMPACT_HEADER.
+ *                      In-place reallocation of tagged blocks is not re-accounted
+ */
+#ifndef LWMEM_CFG_ALLOC_TAGS
+#define LWMEM_CFG_ALLOC_TAGS 0
+#endif
+
+/**
+ * \brief           Maximal number of distinct allocation sites in the accounting table
+ */
+#ifndef LWMEM_CFG_ALLOC_TAGS_MAX_SITES
+#define LWMEM_CFG_ALLOC_TAGS_MAX_SITES 32
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` compact binary event streaming
+ *
+ * Encodes alloc/free/realloc events as fixed 12-byte records (operation,
+ * 24-bit size, 32-bit address delta, 32-bit cycle timestamp from
+ * \ref LWMEM_GET_CYCLES) into a user ring buffer suitable for SEGGER RTT or
+ * ITM draining - always-on allocation telemetry without printf timing
+ * distortion. Builds on \ref LWMEM_CFG_EVENT_HOOKS and occupies the
+ * event-hook slot of the instance while attached
+ */
+#ifndef LWMEM_CFG_EVENT_STREAM
+#define LWMEM_CFG_EVENT_STREAM 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` latency profiling of allocator operations
+ *
+ * Operations are timestamped with \ref LWMEM_GET_CYCLES and min/max/EWMA
+ * cycles are recorded per operation type (alloc, free, realloc), readable with
+ * \ref lwmem_get_profile_ex. Gives on-device evidence when free-list walks
+ * degrade, without attaching a trace probe
+ */
+#ifndef LWMEM_CFG_PROFILING
+#define LWMEM_CFG_PROFILING 0
+#endif
+
+/**
+ * \brief           Cycle counter source for latency profiling
+ *
+ * Define to CPU cycle counter read, e.g. `(DWT->CYCCNT)` on Cortex-M
+ * with trace unit enabled
+ */
+#ifndef LWMEM_GET_CYCLES
+#define LWMEM_GET_CYCLES() 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` allocation event hooks
+ *
+ * Per-instance callback (set with \ref lwmem_set_event_hook_ex) fires on
+ * alloc, free, realloc and failed allocation, outside the instance lock.
+ * Intended for live tracing (SystemView and similar); fully compiled out
+ * when disabled, so release hot paths are untouched
+ */
+#ifndef LWMEM_CFG_EVENT_HOOKS
+#define LWMEM_CFG_EVENT_HOOKS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` allocation size histogram
+ *
+ * Requested (not rounded) allocation sizes are counted in log2 buckets,
+ * one counter increment per allocation on the hot path. Distribution is read
+ * with \ref lwmem_get_histogram_ex and is invaluable for sizing pool tiers
+ * and size classes offline
+ */
+#ifndef LWMEM_CFG_ALLOC_HISTOGRAM
+#define LWMEM_CFG_ALLOC_HISTOGRAM 0
+#endif
+
+/**
+ * \brief           Number of log2 buckets of the allocation size histogram
+ *
+ * First bucket counts sizes up to `1` byte, each next bucket doubles the range,
+ * last bucket counts everything larger
+ */
+#ifndef LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS
+#define LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS 16
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` instance registry and owner lookup
+ *
+ * Every initialized instance is registered internally, so
+ * \ref lwmem_find_owner locates the instance owning any pointer from its
+ * region address ranges and \ref lwmem_free_any releases memory without the
+ * caller tracking which of several heaps it came from
+ */
+#ifndef LWMEM_CFG_INSTANCE_REGISTRY
+#define LWMEM_CFG_INSTANCE_REGISTRY 0
+#endif
+
+/**
+ * \brief           Maximal number of instances in the registry
+ */
+#ifndef LWMEM_CFG_INSTANCE_REGISTRY_SIZE
+#define LWMEM_CFG_INSTANCE_REGISTRY_SIZE 4
+#endif
+
+/**
+ * \brief           Cache line size used by \ref lwmem_malloc_dma_ex, in units of bytes
+ *
+ * DMA buffers are aligned to (and padded to a multiple of) this value,
+ * so cache maintenance never touches neighboring data
+ */
+#ifndef LWMEM_CFG_DMA_CACHE_LINE_SIZE
+#define LWMEM_CFG_DMA_CACHE_LINE_SIZE 32
+#endif
+
+/**
+ * \brief           Cache clean (write-back) operation for DMA buffers
+ *
+ * Define to CPU specific operation (e.g. `SCB_CleanDCache_by_Addr`) when
+ * data cache is enabled and DMA regions are cacheable. No-op by default
+ */
+#ifndef LWMEM_DMA_CACHE_CLEAN
+#define LWMEM_DMA_CACHE_CLEAN(addr, len)
+#endif
+
+/**
+ * \brief           Cache invalidate operation for DMA buffers
+ *
+ * Define to CPU specific operation (e.g. `SCB_InvalidateDCache_by_Addr`) when
+ * data cache is enabled and DMA regions are cacheable. No-op by default
+ */
+#ifndef LWMEM_DMA_CACHE_INVALIDATE
+#define LWMEM_DMA_CACHE_INVALIDATE(addr, len)
+#endif
+
+/**
+ * \brief           MPU hook making heap metadata writable, fired when allocator enters its critical section
+ *
+ * Define to the MPU reprogramming operation opening write access to the
+ * region(s) holding heap memory. Together with \ref LWMEM_MPU_METADATA_RO,
+ * block headers stay read-only between allocator calls, so a wild write
+ * faults at the offending instruction instead of corrupting the free list.
+ * No-op by default
+ */
+#ifndef LWMEM_MPU_METADATA_RW
+#define LWMEM_MPU_METADATA_RW()
+#endif
+
+/**
+ * \brief           MPU hook restoring read-only heap metadata, fired when allocator leaves its critical section
+ */
+#ifndef LWMEM_MPU_METADATA_RO
+#define LWMEM_MPU_METADATA_RO()
+#endif
+
+/**
+ * \brief           Attribute applied to hot allocator functions for RAM placement
+ *
+ * On flash-XIP parts with wait states, define to the toolchain RAM-function
+ * attribute (e.g. `__attribute__((section(".ramfunc")))` or CMSIS
+ * `__RAM_FUNC`) so the hot allocator paths execute from SRAM/ITCM
+ * without forking the source. Empty by default
+ */
+#ifndef LWMEM_HOT_FN_ATTR
+#define LWMEM_HOT_FN_ATTR
+#endif
+
+/**
+ * \brief           Branch hint for conditions that are almost always true
+ *
+ * Defaults to GCC/Clang `__builtin_expect`, set to toolchain specific
+ * construct (or empty) elsewhere
+ */
+#ifndef LWMEM_LIKELY
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_LIKELY(x) __builtin_expect(!!(x), 1)
+#else
+#define LWMEM_LIKELY(x) (x)
+#endif
+#endif
+
+/**
+ * \brief           Branch hint for conditions that are almost never true (error paths)
+ */
+#ifndef LWMEM_UNLIKELY
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#else
+#define LWMEM_UNLIKELY(x) (x)
+#endif
+#endif
+
+/**
+ * \brief           Attribute marking rarely executed (diagnostic/error) functions
+ *
+ * Moves them out of hot instruction cache lines
+ */
+#ifndef LWMEM_COLD_FN
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_COLD_FN __attribute__((cold, noinline))
+#else
+#define LWMEM_COLD_FN
+#endif
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` prefetch hints in free-list walks
+ *
+ * Issues a prefetch for the following node while the current one is examined,
+ * hiding part of the pointer-chase miss latency - one of the cheapest wins on
+ * SDRAM-resident heaps with long free lists
+ */
+#ifndef LWMEM_CFG_PREFETCH
+#define LWMEM_CFG_PREFETCH 0
+#endif
+
+/**
+ * \brief           Prefetch hint operation
+ *
+ * Defaults to GCC/Clang `__builtin_prefetch`, set to CPU specific
+ * instruction for other toolchains. Argument may be any address, including `NULL`
+ */
+#ifndef LWMEM_PREFETCH
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define LWMEM_PREFETCH(addr)
+#endif
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` built-in word-wise memory primitives
+ *
+ * Replaces the libc defaults of \ref LWMEM_MEMSET / \ref LWMEM_MEMCPY /
+ * \ref LWMEM_MEMMOVE with word-at-a-time implementations shipped by the
+ * library - clearing and reallocation copies then run at bus speed even on
+ * toolchains whose nano-libc uses byte loops
+ */
+#ifndef LWMEM_CFG_BUILTIN_MEMFN
+#define LWMEM_CFG_BUILTIN_MEMFN 0
+#endif
+
+#if LWMEM_CFG_BUILTIN_MEMFN
+#define LWMEM_MEMSET(dst, val, len)  lwmem_builtin_memset((dst), (val), (len))
+#define LWMEM_MEMCPY(dst, src, len)  lwmem_builtin_memcpy((dst), (src), (len))
+#define LWMEM_MEMMOVE(dst, src, len) lwmem_builtin_memmove((dst), (src), (len))
+#endif /* LWMEM_CFG_BUILTIN_MEMFN */
+
+/**
+ * \brief           Memory set function
+ * 
+ * \note            Function footprint is the same as \ref memset
+ */
+#ifndef LWMEM_MEMSET
+#define LWMEM_MEMSET(dst, val, len) memset((dst), (val), (len))
+#endif
+
+/**
+ * \brief           Memory copy function
+ * 
+ * \note            Function footprint is the same as \ref memcpy
+ */
+#ifndef LWMEM_MEMCPY
+#define LWMEM_MEMCPY(dst, src, len) memcpy((dst), (src), (len))
+#endif
+
+/**
+ * \brief           Memory move function
+ * 
+ * \note            Function footprint is the same as \ref memmove
+ */
+#ifndef LWMEM_MEMMOVE
+#define LWMEM_MEMMOVE(dst, src, len) memmove((dst), (src), (len))
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` host sanitizer annotations
+ *
+ * On Linux-hosted builds (trace replay, unit tests), freed block user areas
+ * are poisoned for AddressSanitizer and marked noaccess for Valgrind, and
+ * re-exposed on allocation - so use-after-free inside LwMEM-managed memory
+ * is caught by host tooling instead of surviving until target testing
+ *
+ * \note            Host-build option for the plain list engine: size-class,
+ *                      cache and clean-memory extras are rejected at compile time
+ */
+#ifndef LWMEM_CFG_HOST_SANITIZERS
+#define LWMEM_CFG_HOST_SANITIZERS 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` build-time performance lint
+ *
+ * Emits `#warning` diagnostics for configurations known to hurt latency or
+ * footprint, so accidental slow combinations surface at build time instead of
+ * in profiling sessions
+ */
+#ifndef LWMEM_CFG_PERF_LINT
+#define LWMEM_CFG_PERF_LINT 0
+#endif
+
+/* Configuration validation: fail the build on invalid values and combinations */
+#if (LWMEM_CFG_ALIGN_NUM & (LWMEM_CFG_ALIGN_NUM - 1)) != 0 || LWMEM_CFG_ALIGN_NUM < 4
+#error "LWMEM_CFG_ALIGN_NUM must be a power of 2, at least 4"
+#endif
+#if LWMEM_CFG_ENABLE_STATS && !LWMEM_CFG_FULL
+#error "LWMEM_CFG_ENABLE_STATS requires LWMEM_CFG_FULL"
+#endif
+#if LWMEM_CFG_TASK_OWNERSHIP && !LWMEM_CFG_OS
+#error "LWMEM_CFG_TASK_OWNERSHIP requires LWMEM_CFG_OS, ownership needs a task context"
+#endif
+#if LWMEM_CFG_ENABLE_STATS_ATOMIC && !LWMEM_CFG_ENABLE_STATS
+#error "LWMEM_CFG_ENABLE_STATS_ATOMIC requires LWMEM_CFG_ENABLE_STATS"
+#endif
+#if LWMEM_CFG_WINDOWED_STATS && !LWMEM_CFG_ENABLE_STATS
+#error "LWMEM_CFG_WINDOWED_STATS requires LWMEM_CFG_ENABLE_STATS"
+#endif
+#if LWMEM_CFG_TLSF_FL_COUNT > 32
+#error "LWMEM_CFG_TLSF_FL_COUNT must not exceed 32"
+#endif
+#if LWMEM_CFG_TLSF_SL_COUNT_LOG2 > 5
+#error "LWMEM_CFG_TLSF_SL_COUNT_LOG2 must not exceed 5"
+#endif
+#if LWMEM_CFG_SEGREGATED_BIN_COUNT < 2
+#error "LWMEM_CFG_SEGREGATED_BIN_COUNT must be at least 2"
+#endif
+#if LWMEM_CFG_INLINE_FASTPATH && !LWMEM_CFG_THREAD_CACHE
+#error "LWMEM_CFG_INLINE_FASTPATH requires LWMEM_CFG_THREAD_CACHE"
+#endif
+
+/* Performance lint: known-slow or wasteful combinations */
+#if LWMEM_CFG_PERF_LINT
+#if LWMEM_CFG_CLEAN_MEMORY && !LWMEM_CFG_CLEAN_MEMORY_DEFERRED
+#warning "perf-lint: LWMEM_CFG_CLEAN_MEMORY runs a synchronous memset inside every free, consider LWMEM_CFG_CLEAN_MEMORY_DEFERRED"
+#endif
+#if LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BEST_FIT
+#warning "perf-lint: best-fit walks the complete free list on every allocation"
+#endif
+#if LWMEM_CFG_ALIGN_NUM > 8
+#warning "perf-lint: large LWMEM_CFG_ALIGN_NUM wastes memory on every small allocation"
+#endif
+#if LWMEM_CFG_PROFILING
+#warning "perf-lint: LWMEM_CFG_PROFILING adds cycle-counter reads to every operation"
 #endif
+#endif /* LWMEM_CFG_PERF_LINT */
 
 /**
  * \}
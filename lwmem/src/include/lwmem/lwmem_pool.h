@@ -0,0 +1,73 @@
+/**
+ * \file            lwmem_pool.h
+ * \brief           Fixed-size block pool allocator
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_POOL_HDR_H
+#define LWMEM_POOL_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_POOL Fixed-size block pool
+ * \brief           Fixed-size block pool with constant time alloc and free
+ * \{
+ */
+
+/**
+ * \brief           Pool structure with fixed-size blocks
+ */
+typedef struct lwmem_pool {
+    void* free_head;   /*!< Head of free blocks stack */
+    size_t block_size; /*!< Size of single block, aligned */
+    size_t count;      /*!< Total number of blocks in the pool */
+} lwmem_pool_t;
+
+uint8_t lwmem_pool_init(lwmem_pool_t* pool, const lwmem_region_t* region, size_t block_size, size_t count);
+void* lwmem_pool_alloc(lwmem_pool_t* pool);
+void lwmem_pool_free(lwmem_pool_t* pool, void* ptr);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_POOL_HDR_H */
@@ -0,0 +1,75 @@
+/**
+ * \file            lwmem_ring.h
+ * \brief           Ring allocator for FIFO buffer lifetimes
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_RING_HDR_H
+#define LWMEM_RING_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_RING Ring allocator
+ * \brief           Stream allocator with strict FIFO lifetime, O(1) alloc/free and zero fragmentation
+ * \{
+ */
+
+/**
+ * \brief           Ring allocator structure
+ */
+typedef struct {
+    uint8_t* base; /*!< Ring memory */
+    size_t size;   /*!< Ring memory size in units of bytes */
+    size_t head;   /*!< Write offset of next allocation */
+    size_t tail;   /*!< Read offset of oldest live allocation */
+    size_t used;   /*!< Number of bytes currently in use, including record headers */
+} lwmem_ring_t;
+
+uint8_t lwmem_ring_init(lwmem_ring_t* ring, const lwmem_region_t* region);
+void* lwmem_ring_alloc(lwmem_ring_t* ring, size_t size);
+uint8_t lwmem_ring_free(lwmem_ring_t* ring, void* ptr);
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_RING_HDR_H */
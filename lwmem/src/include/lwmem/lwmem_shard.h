@@ -0,0 +1,97 @@
+/**
+ * \file            lwmem_shard.h
+ * \brief           Sharded heap router for multi-core systems
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_SHARD_HDR_H
+#define LWMEM_SHARD_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_SHARD Sharded heap router
+ * \brief           Router over multiple LwMEM instances for multi-core (AMP/SMP) systems
+ * \{
+ */
+
+/**
+ * \brief           Shard selection callback prototype
+ *
+ * Called on every allocation to pick the shard for the calling context,
+ * typically returning current core or task identifier modulo shard count
+ *
+ * \return          Index of shard to allocate from
+ */
+typedef size_t (*lwmem_shard_select_fn)(void);
+
+/**
+ * \brief           Single shard entry
+ */
+typedef struct {
+    lwmem_t lwobj;                 /*!< LwMEM instance of the shard */
+    const lwmem_region_t* regions; /*!< Regions assigned to the shard, used for owner lookup on free */
+} lwmem_shard_t;
+
+/**
+ * \brief           Sharded heap router structure
+ */
+typedef struct {
+    lwmem_shard_t* shards;           /*!< Array of shard entries */
+    size_t count;                    /*!< Number of shards */
+    lwmem_shard_select_fn select_fn; /*!< Shard selection callback */
+} lwmem_shard_router_t;
+
+uint8_t lwmem_shard_init(lwmem_shard_router_t* router, lwmem_shard_t* shards, size_t count,
+                         lwmem_shard_select_fn select_fn);
+void* lwmem_shard_malloc(lwmem_shard_router_t* router, size_t size);
+void* lwmem_shard_calloc(lwmem_shard_router_t* router, size_t nitems, size_t size);
+#if LWMEM_CFG_FULL || __DOXYGEN__
+void* lwmem_shard_realloc(lwmem_shard_router_t* router, void* ptr, size_t size);
+void lwmem_shard_free(lwmem_shard_router_t* router, void* ptr);
+lwmem_t* lwmem_shard_find_owner(lwmem_shard_router_t* router, const void* ptr);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_SHARD_HDR_H */
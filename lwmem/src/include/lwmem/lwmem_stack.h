@@ -0,0 +1,92 @@
+/**
+ * \file            lwmem_stack.h
+ * \brief           Stack allocator with LIFO free order
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#ifndef LWMEM_STACK_HDR_H
+#define LWMEM_STACK_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \ingroup         LWMEM
+ * \defgroup        LWMEM_STACK Stack allocator
+ * \brief           Watermark allocator for exact reverse-order frees
+ * \{
+ */
+
+/**
+ * \brief           Number of outstanding pushes tracked for LIFO
+ *                      enforcement in development builds
+ */
+#ifndef LWMEM_STACK_DBG_DEPTH
+#define LWMEM_STACK_DBG_DEPTH 32
+#endif
+
+/**
+ * \brief           Stack allocator structure
+ */
+typedef struct lwmem_stack {
+    lwmem_t* lwobj; /*!< LwMEM instance backing buffer was allocated from, `NULL` for user region */
+    uint8_t* buff;  /*!< Stack memory */
+    size_t size;    /*!< Stack memory size in units of bytes */
+    size_t offset;  /*!< Current watermark for next push */
+#if defined(LWMEM_DEV) || __DOXYGEN__
+    size_t dbg_marks[LWMEM_STACK_DBG_DEPTH]; /*!< Watermarks of outstanding pushes */
+    size_t dbg_depth;                        /*!< Number of outstanding pushes */
+    uint8_t dbg_overflow;                    /*!< Set when pushes exceeded tracking depth */
+#endif /* defined(LWMEM_DEV) || __DOXYGEN__ */
+} lwmem_stack_t;
+
+uint8_t lwmem_stack_init(lwmem_stack_t* stack, const lwmem_region_t* region);
+uint8_t lwmem_stack_create_ex(lwmem_t* lwobj, lwmem_stack_t* stack, size_t size);
+void* lwmem_stack_push(lwmem_stack_t* stack, size_t size);
+uint8_t lwmem_stack_pop(lwmem_stack_t* stack, void* ptr);
+void lwmem_stack_reset(lwmem_stack_t* stack);
+#if LWMEM_CFG_FULL || __DOXYGEN__
+void lwmem_stack_destroy(lwmem_stack_t* stack);
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+/**
+ * \}
+ */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_STACK_HDR_H */
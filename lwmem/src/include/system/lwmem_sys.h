@@ -78,6 +78,32 @@ uint8_t lwmem_sys_mutex_wait(LWMEM_CFG_OS_MUTEX_HANDLE* m);
  */
 uint8_t lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m);
 
+#if LWMEM_CFG_TASK_OWNERSHIP || __DOXYGEN__
+
+/**
+ * \brief           Get handle of the currently running task
+ *
+ * Used by per-task ownership tracking, see \ref LWMEM_CFG_TASK_OWNERSHIP
+ *
+ * \return          Opaque task handle, `NULL` in pre-scheduler context
+ */
+void* lwmem_sys_get_current_task(void);
+
+#endif /* LWMEM_CFG_TASK_OWNERSHIP || __DOXYGEN__ */
+
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT || __DOXYGEN__
+
+/**
+ * \brief           Wait for a mutex with bounded time
+ * \param[in]       m: Mutex handle to wait for
+ * \param[in]       timeout_ms: Maximal wait time, in units of milliseconds.
+ *                      Value `0` only tries to acquire without waiting
+ * \return          `1` when mutex acquired, `0` on timeout
+ */
+uint8_t lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms);
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT || __DOXYGEN__ */
+
 /**
  * \}
  */
@@ -32,33 +32,111 @@
  * Version:         v2.2.1
  */
 #include "lwmem/lwmem.h"
+#if LWMEM_CFG_CONST_TIME_POOL
+#include "lwmem/lwmem_pool.h"
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
 #include <limits.h>
 #include <stdint.h>
 #include <string.h>
 
+#if LWMEM_CFG_FREE_FROM_ISR || (!LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC) || LWMEM_CFG_ENABLE_STATS_ATOMIC
+#include <stdatomic.h>
+#endif /* LWMEM_CFG_FREE_FROM_ISR || (!LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC)
+          || LWMEM_CFG_ENABLE_STATS_ATOMIC */
+
 #if LWMEM_CFG_OS
 #include "system/lwmem_sys.h"
 #endif /* LWMEM_CFG_OS */
 
-#if LWMEM_CFG_OS
-#define LWMEM_PROTECT(lwobj)   lwmem_sys_mutex_wait(&((lwobj)->mutex))
-#define LWMEM_UNPROTECT(lwobj) lwmem_sys_mutex_release(&((lwobj)->mutex))
+#if LWMEM_CFG_OS && LWMEM_CFG_PER_INSTANCE_LOCKING
+#define LWMEM_PROTECT(lwobj)                                                                                           \
+    do {                                                                                                               \
+        if (!(lwobj)->lock_disabled) {                                                                                 \
+            lwmem_sys_mutex_wait(&((lwobj)->mutex));                                                                   \
+        }                                                                                                              \
+        LWMEM_MPU_METADATA_RW();                                                                                       \
+    } while (0)
+#define LWMEM_UNPROTECT(lwobj)                                                                                         \
+    do {                                                                                                               \
+        LWMEM_MPU_METADATA_RO();                                                                                       \
+        if (!(lwobj)->lock_disabled) {                                                                                 \
+            lwmem_sys_mutex_release(&((lwobj)->mutex));                                                                \
+        }                                                                                                              \
+    } while (0)
+#elif LWMEM_CFG_OS
+#define LWMEM_PROTECT(lwobj)                                                                                           \
+    do {                                                                                                               \
+        lwmem_sys_mutex_wait(&((lwobj)->mutex));                                                                       \
+        LWMEM_MPU_METADATA_RW();                                                                                       \
+    } while (0)
+#define LWMEM_UNPROTECT(lwobj)                                                                                         \
+    do {                                                                                                               \
+        LWMEM_MPU_METADATA_RO();                                                                                       \
+        lwmem_sys_mutex_release(&((lwobj)->mutex));                                                                    \
+    } while (0)
 #else /* LWMEM_CFG_OS */
-#define LWMEM_PROTECT(lwobj)
-#define LWMEM_UNPROTECT(lwobj)
+#define LWMEM_PROTECT(lwobj)   LWMEM_MPU_METADATA_RW()
+#define LWMEM_UNPROTECT(lwobj) LWMEM_MPU_METADATA_RO()
 #endif /* !LWMEM_CFG_OS */
 
 /* Statistics part */
-#if LWMEM_CFG_ENABLE_STATS
-#define LWMEM_INC_STATS(field) (++(field))
+#if LWMEM_CFG_ENABLE_STATS && LWMEM_CFG_BATCHED_STATS
+
+/**
+ * \brief           Per-thread statistics scratch, folded into instance counters on flush
+ */
+static LWMEM_CFG_THREAD_LOCAL struct {
+    uint32_t nr_alloc; /*!< Allocations counted since last flush */
+    uint32_t nr_free;  /*!< Frees counted since last flush */
+} stats_scratch;
+
+#define LWMEM_INC_STATS(field)       (++(field))
+
+/* Counter increments stay off the shared cache lines inside the lock */
+#define LWMEM_STATS_CNT_ALLOC(lwobj) (++stats_scratch.nr_alloc)
+#define LWMEM_STATS_CNT_FREE(lwobj)  (++stats_scratch.nr_free)
+#if LWMEM_CFG_WINDOWED_STATS
+#define LWMEM_UPDATE_WIN_MIN(lwobj)                                                                                    \
+    do {                                                                                                               \
+        if ((lwobj)->mem_available_bytes < (lwobj)->win_min_avail) {                                                   \
+            (lwobj)->win_min_avail = (uint32_t)(lwobj)->mem_available_bytes;                                           \
+        }                                                                                                              \
+    } while (0)
+#else
+#define LWMEM_UPDATE_WIN_MIN(lwobj)
+#endif /* LWMEM_CFG_WINDOWED_STATS */
+#define LWMEM_UPDATE_MIN_FREE(lwobj)                                                                                   \
+    do {                                                                                                               \
+        if ((lwobj)->mem_available_bytes < (lwobj)->stats.minimum_ever_mem_available_bytes) {                          \
+            (lwobj)->stats.minimum_ever_mem_available_bytes = (lwobj)->mem_available_bytes;                            \
+        }                                                                                                              \
+        LWMEM_UPDATE_WIN_MIN(lwobj);                                                                                   \
+    } while (0)
+#elif LWMEM_CFG_ENABLE_STATS
+#define LWMEM_INC_STATS(field)       (++(field))
+#define LWMEM_STATS_CNT_ALLOC(lwobj) LWMEM_INC_STATS((lwobj)->stats.nr_alloc)
+#define LWMEM_STATS_CNT_FREE(lwobj)  LWMEM_INC_STATS((lwobj)->stats.nr_free)
+#if LWMEM_CFG_WINDOWED_STATS
+#define LWMEM_UPDATE_WIN_MIN(lwobj)                                                                                    \
+    do {                                                                                                               \
+        if ((lwobj)->mem_available_bytes < (lwobj)->win_min_avail) {                                                   \
+            (lwobj)->win_min_avail = (uint32_t)(lwobj)->mem_available_bytes;                                           \
+        }                                                                                                              \
+    } while (0)
+#else
+#define LWMEM_UPDATE_WIN_MIN(lwobj)
+#endif /* LWMEM_CFG_WINDOWED_STATS */
 #define LWMEM_UPDATE_MIN_FREE(lwobj)                                                                                   \
     do {                                                                                                               \
         if ((lwobj)->mem_available_bytes < (lwobj)->stats.minimum_ever_mem_available_bytes) {                          \
             (lwobj)->stats.minimum_ever_mem_available_bytes = (lwobj)->mem_available_bytes;                            \
         }                                                                                                              \
+        LWMEM_UPDATE_WIN_MIN(lwobj);                                                                                   \
     } while (0)
 #else
 #define LWMEM_INC_STATS(field)
+#define LWMEM_STATS_CNT_ALLOC(lwobj)
+#define LWMEM_STATS_CNT_FREE(lwobj)
 #define LWMEM_UPDATE_MIN_FREE(lwobj)
 #endif /* LWMEM_CFG_ENABLE_STATS */
 
@@ -66,6 +144,119 @@
 #if (LWMEM_CFG_ALIGN_NUM & (LWMEM_CFG_ALIGN_NUM - 1) > 0)
 #error "LWMEM_ALIGN_BITS must be power of 2"
 #endif
+#if (LWMEM_CFG_BLOCK_START_ALIGN & (LWMEM_CFG_BLOCK_START_ALIGN - 1)) > 0 \
+    || LWMEM_CFG_BLOCK_START_ALIGN < LWMEM_CFG_ALIGN_NUM
+#error "LWMEM_CFG_BLOCK_START_ALIGN must be a power of 2, at least LWMEM_CFG_ALIGN_NUM"
+#endif
+
+#if LWMEM_CFG_BUILTIN_MEMFN || __DOXYGEN__
+
+/**
+ * \brief           Word-wise memory set, exploiting allocator alignment guarantees
+ *
+ * Aligned bulk goes word-at-a-time, unaligned heads and tails byte-wise
+ *
+ * \param[in]       dst: Destination memory
+ * \param[in]       val: Byte value to store
+ * \param[in]       len: Number of bytes
+ * \return          Destination pointer
+ */
+void*
+lwmem_builtin_memset(void* dst, int val, size_t len) {
+    uint8_t* dst8 = dst;
+    const size_t word_mask = sizeof(size_t) - 1;
+    size_t word_val = (uint8_t)val;
+
+    word_val |= word_val << 8;
+    word_val |= word_val << 16;
+#if defined(UINT64_MAX)
+    if (sizeof(size_t) > 4) {
+        word_val |= word_val << 16 << 16;
+    }
+#endif /* defined(UINT64_MAX) */
+
+    for (; len > 0 && (((size_t)dst8) & word_mask) > 0; --len) {
+        *dst8++ = (uint8_t)val;
+    }
+    for (; len >= sizeof(size_t); len -= sizeof(size_t), dst8 += sizeof(size_t)) {
+        *(size_t*)(void*)dst8 = word_val;
+    }
+    for (; len > 0; --len) {
+        *dst8++ = (uint8_t)val;
+    }
+    return dst;
+}
+
+/**
+ * \brief           Word-wise memory copy for non-overlapping buffers
+ * \param[in]       dst: Destination memory
+ * \param[in]       src: Source memory
+ * \param[in]       len: Number of bytes
+ * \return          Destination pointer
+ */
+void*
+lwmem_builtin_memcpy(void* dst, const void* src, size_t len) {
+    uint8_t* dst8 = dst;
+    const uint8_t* src8 = src;
+    const size_t word_mask = sizeof(size_t) - 1;
+
+    if ((((size_t)dst8) & word_mask) == (((size_t)src8) & word_mask)) {
+        for (; len > 0 && (((size_t)dst8) & word_mask) > 0; --len) {
+            *dst8++ = *src8++;
+        }
+        for (; len >= sizeof(size_t); len -= sizeof(size_t), dst8 += sizeof(size_t), src8 += sizeof(size_t)) {
+            *(size_t*)(void*)dst8 = *(const size_t*)(const void*)src8;
+        }
+    }
+    for (; len > 0; --len) {
+        *dst8++ = *src8++;
+    }
+    return dst;
+}
+
+/**
+ * \brief           Word-wise memory move handling overlapping buffers
+ * \param[in]       dst: Destination memory
+ * \param[in]       src: Source memory
+ * \param[in]       len: Number of bytes
+ * \return          Destination pointer
+ */
+void*
+lwmem_builtin_memmove(void* dst, const void* src, size_t len) {
+    uint8_t* dst8 = dst;
+    const uint8_t* src8 = src;
+
+    if (dst8 <= src8 || dst8 >= (src8 + len)) {
+        return lwmem_builtin_memcpy(dst, src, len); /* Forward copy is safe */
+    }
+    for (dst8 += len, src8 += len; len > 0; --len) { /* Overlap -> copy backwards */
+        *--dst8 = *--src8;
+    }
+    return dst;
+}
+
+#endif /* LWMEM_CFG_BUILTIN_MEMFN || __DOXYGEN__ */
+
+/**
+ * \brief           Versioned layout anchor for debugger tooling
+ *
+ * dev/lwmem_gdb.py reads this structure to stay compatible across
+ * configuration and version changes; keep entries append-only
+ */
+const struct {
+    uint16_t version;        /*!< Anchor layout version */
+    uint16_t meta_size;      /*!< Size of block metadata header */
+    uint16_t align_num;      /*!< Configured allocation alignment */
+    uint16_t alloc_bit_low;  /*!< Set to `1` when allocation flag is in the lowest size bit */
+    uint32_t alloc_mark;     /*!< Value of the allocated-block marker in the next field */
+} lwmem_debug_anchor = {
+    .version = 1,
+    .meta_size = (uint16_t)((sizeof(lwmem_block_t) + (size_t)LWMEM_CFG_ALIGN_NUM - 1)
+                            & ~((size_t)LWMEM_CFG_ALIGN_NUM - 1)),
+    .align_num = (uint16_t)LWMEM_CFG_ALIGN_NUM,
+    .alloc_bit_low = (uint16_t)LWMEM_CFG_ALLOC_BIT_LOW,
+    .alloc_mark = 0xDEADBEEFUL,
+};
 
 /**
  * \brief           LwMEM default structure used by application
@@ -100,6 +291,15 @@ static lwmem_t lwmem_default;
  */
 #define LWMEM_ALIGN(x)            (((x) + (LWMEM_ALIGN_BITS)) & ~(LWMEM_ALIGN_BITS))
 
+/**
+ * \brief           Round full block size up to block start alignment
+ *
+ * Keeps every block start on a \ref LWMEM_CFG_BLOCK_START_ALIGN boundary
+ * (cache line), as region bases are aligned the same way
+ */
+#define LWMEM_BLOCK_SIZE_ALIGN(x)                                                                                      \
+    (((x) + ((size_t)LWMEM_CFG_BLOCK_START_ALIGN - 1)) & ~((size_t)LWMEM_CFG_BLOCK_START_ALIGN - 1))
+
 /**
  * \brief           Cast input pointer to byte
  * \param[in]       p: Input pointer to cast to byte pointer
@@ -115,8 +315,15 @@ static lwmem_t lwmem_default;
 
 /**
  * \brief           Bit indicating memory block is allocated
+ *
+ * Lives in the topmost size bit by default, or in the lowest bit
+ * (always zero for aligned sizes) when \ref LWMEM_CFG_ALLOC_BIT_LOW is enabled
  */
+#if LWMEM_CFG_ALLOC_BIT_LOW
+#define LWMEM_ALLOC_BIT        ((size_t)0x01)
+#else /* LWMEM_CFG_ALLOC_BIT_LOW */
 #define LWMEM_ALLOC_BIT        ((size_t)((size_t)1 << (sizeof(size_t) * CHAR_BIT - 1)))
+#endif /* !LWMEM_CFG_ALLOC_BIT_LOW */
 
 /**
  * \brief           Mark written in `next` field when block is allocated
@@ -145,1029 +352,9900 @@ static lwmem_t lwmem_default;
     (void*)((block) != NULL ? ((LWMEM_TO_BYTE_PTR(block)) + LWMEM_BLOCK_META_SIZE) : NULL)
 
 /**
- * \brief           Minimum amount of memory required to make new empty block
- *
- * Default size is size of meta block
+ * \brief           Set to `1` when segregated free lists strategy is active
  */
-#define LWMEM_BLOCK_MIN_SIZE (LWMEM_BLOCK_META_SIZE)
+#define LWMEM_SEGREGATED_EN  (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_SEGREGATED)
 
 /**
- * \brief           Gets block before input block (marked as prev) and its previous free block
- * \param[in]       in_lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       in_b: Input block to find previous and its previous
- * \param[in]       in_pp: Previous previous of input block. Finding will be stored here
- * \param[in]       in_p: Previous of input block. Finding will be stored here
+ * \brief           Set to `1` when TLSF strategy is active
  */
-static void
-prv_get_prev_curr_of_block(lwmem_t* in_lwobj, const lwmem_block_t* in_b, lwmem_block_t** in_pp, lwmem_block_t** in_p) {
-    for (*in_pp = NULL, *in_p = &((in_lwobj)->start_block); *in_p != NULL && (*in_p)->next < in_b;
-         *in_pp = (*in_p), *in_p = (*in_p)->next) {}
-}
+#define LWMEM_TLSF_EN        (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_TLSF)
 
 /**
- * \brief           Set block as allocated
- * \param[in]       block: Block to set as allocated
+ * \brief           Set to `1` when best-fit strategy is active
  */
-static void
-prv_block_set_alloc(lwmem_block_t* block) {
-    if (block != NULL) {
-        block->size |= LWMEM_ALLOC_BIT;
-        block->next = (void*)(LWMEM_TO_BYTE_PTR(0) + LWMEM_BLOCK_ALLOC_MARK);
-    }
-}
+#define LWMEM_BEST_FIT_EN    (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BEST_FIT)
 
 /**
- * \brief           Get region aligned start address and aligned size
- * \param[in]       region: Region to check for size and address
- * \param[out]      msa: Memory start address output variable
- * \param[out]      msz: Memory size output variable
- * \return          `1` if region valid, `0` otherwise
+ * \brief           Set to `1` when next-fit strategy is active
  */
-static uint8_t
-prv_get_region_addr_size(const lwmem_region_t* region, uint8_t** msa, size_t* msz) {
-    size_t mem_size = 0;
-    uint8_t* mem_start_addr = NULL;
-
-    if (region == NULL || msa == NULL || msz == NULL) {
-        return 0;
-    }
-    *msa = NULL;
-    *msz = 0;
+#define LWMEM_NEXT_FIT_EN    (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_NEXT_FIT)
 
-    /*
-     * Start address must be aligned to configuration
-     * Increase start address and decrease effective region size
-     */
-    mem_start_addr = region->start_addr;
-    mem_size = region->size;
-    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) { /* Check alignment boundary */
-        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
-        mem_size -= (size_t)(mem_start_addr - LWMEM_TO_BYTE_PTR(region->start_addr));
-    }
+/**
+ * \brief           Set to `1` when buddy strategy is active
+ */
+#define LWMEM_BUDDY_EN       (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BUDDY)
 
-    /* Check region size and align it to config bits */
-    mem_size &= ~LWMEM_ALIGN_BITS; /* Align the size to lower bits */
-    if (mem_size < (2 * LWMEM_BLOCK_MIN_SIZE)) {
-        return 0;
-    }
+/**
+ * \brief           Set to `1` when compact 16-bit block headers are active
+ */
+#define LWMEM_COMPACT_EN     (LWMEM_CFG_COMPACT_HEADER)
 
-    /* Check final memory size */
-    if (mem_size >= (2 * LWMEM_BLOCK_MIN_SIZE)) {
-        *msa = mem_start_addr;
-        *msz = mem_size;
+/**
+ * \brief           Set to `1` when out-of-band metadata engine is active
+ */
+#define LWMEM_OOB_EN         (LWMEM_CFG_OOB_METADATA)
 
-        return 1;
-    }
-    return 0;
-}
+/**
+ * \brief           Set to `1` when size-ordered free list engine is active
+ */
+#define LWMEM_SO_EN          (LWMEM_CFG_SIZE_ORDERED_LIST)
 
 /**
- * \brief           Insert free block to linked list of free blocks
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       nblk: New free block to insert into linked list
+ * \brief           Set to `1` when boundary-tag footers are active in the address-ordered engine
  */
-static void
-prv_insert_free_block(lwmem_t* const lwobj, lwmem_block_t* nblk) {
-    lwmem_block_t* prev;
+#define LWMEM_BT_EN          (LWMEM_CFG_BOUNDARY_TAGS && !LWMEM_SO_EN && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN          \
+                              && !LWMEM_OOB_EN)
+
+#if LWMEM_CFG_BOUNDARY_TAGS                                                                                            \
+    && (LWMEM_BINS_EN || LWMEM_CFG_SKIP_INDEX || LWMEM_CFG_THREAD_CACHE || LWMEM_CFG_CPU_CACHE                         \
+        || LWMEM_CFG_REDZONE_SIZE > 0 || LWMEM_CFG_DEFERRED_COALESCING || LWMEM_CFG_CLEAN_MEMORY_DEFERRED              \
+        || LWMEM_CFG_PER_REGION_LISTS)
+#error "LWMEM_CFG_BOUNDARY_TAGS is not available together with size-class, cache or deferred extras"
+#endif
 
-    /* Check valid inputs */
-    if (nblk == NULL) {
-        return;
-    }
+#if LWMEM_SO_EN && (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT || LWMEM_COMPACT_EN || LWMEM_OOB_EN)
+#error "LWMEM_CFG_SIZE_ORDERED_LIST requires plain first-fit base configuration"
+#endif
+#if LWMEM_SO_EN                                                                                                        \
+    && (LWMEM_CFG_SKIP_INDEX || LWMEM_CFG_DEFERRED_COALESCING || LWMEM_CFG_CLEAN_MEMORY_DEFERRED                       \
+        || LWMEM_CFG_THREAD_CACHE || LWMEM_CFG_CPU_CACHE || LWMEM_CFG_REDZONE_SIZE > 0 || LWMEM_CFG_ALLOC_TAGS         \
+        || LWMEM_CFG_TASK_OWNERSHIP || LWMEM_CFG_PER_REGION_LISTS || LWMEM_CFG_RUNTIME_POLICY                          \
+        || LWMEM_CFG_ZERO_TRACKING || LWMEM_CFG_FREE_FROM_ISR || LWMEM_CFG_EMERGENCY_RESERVE_SIZE > 0                  \
+        || LWMEM_CFG_EVICTABLE)
+#error "LWMEM_CFG_SIZE_ORDERED_LIST is not available together with address-list based extras"
+#endif
 
-    /*
-     * Try to find position to put new block in-between
-     * Search until all free block addresses are lower than entry block
-     */
-    for (prev = &(lwobj->start_block); prev != NULL && prev->next < nblk; prev = prev->next) {}
+#if LWMEM_OOB_EN && (LWMEM_COMPACT_EN || (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT))
+#error "LWMEM_CFG_OOB_METADATA requires first-fit strategy without compact headers"
+#endif
+#if LWMEM_OOB_EN                                                                                                       \
+    && (LWMEM_CFG_ALLOC_TAGS || LWMEM_CFG_REDZONE_SIZE > 0 || LWMEM_CFG_THREAD_CACHE || LWMEM_CFG_FREE_FROM_ISR        \
+        || LWMEM_CFG_DEFERRED_COALESCING || LWMEM_CFG_CLEAN_MEMORY_DEFERRED)
+#error "LWMEM_CFG_OOB_METADATA is not available together with header-based extras"
+#endif
 
-    /* This is hard error with wrong memory usage */
-    if (prev == NULL) {
-        return;
-    }
+#if LWMEM_COMPACT_EN && (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT)
+#error "LWMEM_CFG_COMPACT_HEADER requires LWMEM_ALLOC_STRATEGY_FIRST_FIT strategy"
+#endif
 
-    /*
-     * At this point we have valid previous block
-     * Previous block is last free block before input block
-     */
+/**
+ * \brief           Set to `1` when deferred coalescing is active
+ */
+#define LWMEM_DEFERRED_EN    (LWMEM_CFG_DEFERRED_COALESCING && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN)
 
-#if LWMEM_CFG_CLEAN_MEMORY
-    /*
-     * Reset user memory. This is to reset memory
-     * after it has been freed by the application.
-     *
-     * By doing this, we protect data left by app
-     * and we make sure new allocations cannot see old information
-     */
-    if (nblk != NULL) {
-        void* ptr = LWMEM_GET_PTR_FROM_BLOCK(nblk);
-        if (ptr != NULL) {
-            LWMEM_MEMSET(ptr, 0x00, nblk->size - LWMEM_BLOCK_META_SIZE);
-        }
-    }
-#endif /* LWMEM_CFG_RESET_MEMORY */
+#if LWMEM_CFG_DEFERRED_COALESCING && (LWMEM_BUDDY_EN || LWMEM_COMPACT_EN)
+#error "LWMEM_CFG_DEFERRED_COALESCING requires a list-based allocation strategy"
+#endif
 
-    /*
-     * Check if previous block and input block together create one big contiguous block
-     * If this is the case, merge blocks together and increase previous block by input block size
-     */
-    if ((LWMEM_TO_BYTE_PTR(prev) + prev->size) == LWMEM_TO_BYTE_PTR(nblk)) {
-        prev->size += nblk->size; /* Increase current block by size of new block */
-        nblk = prev;              /* New block and current are now the same thing */
-        /*
-         * It is important to set new block as current one
-         * as this allows merging previous and next blocks together with new block
-         * at the same time; follow next steps
-         */
-    }
+/**
+ * \brief           Set to `1` when skip-list index over the free list is active
+ */
+#define LWMEM_SKIP_EN        (LWMEM_CFG_SKIP_INDEX)
 
-    /*
-     * Check if new block and next of previous create big contiguous block
-     * Do not merge with "end of region" indication (commented part of if statement)
-     */
-    if (prev->next != NULL && prev->next->size > 0 /* Do not remove "end of region" indicator in each region */
-        && (LWMEM_TO_BYTE_PTR(nblk) + nblk->size) == LWMEM_TO_BYTE_PTR(prev->next)) {
-        if (prev->next == lwobj->end_block) { /* Does it points to the end? */
-            nblk->next = lwobj->end_block;    /* Set end block pointer */
-        } else {
-            /* Expand of current block for size of next free block which is right behind new block */
-            nblk->size += prev->next->size;
-            nblk->next = prev->next->next; /* Next free is pointed to the next one of previous next */
-        }
-    } else {
-        nblk->next = prev->next; /* Set next of input block as next of current one */
-    }
+/**
+ * \brief           Set to `1` when per-thread allocation cache is active
+ */
+#define LWMEM_TCACHE_EN      (LWMEM_CFG_THREAD_CACHE)
 
-    /*
-     * If new block has not been set as current (and expanded),
-     * then link them together, otherwise ignore as it would point to itself
-     */
-    if (prev != nblk) {
-        prev->next = nblk;
-    }
-}
+#if LWMEM_TCACHE_EN && LWMEM_COMPACT_EN
+#error "LWMEM_CFG_THREAD_CACHE is not available together with LWMEM_CFG_COMPACT_HEADER"
+#endif
 
 /**
- * \brief           Split too big block and add it to list of free blocks
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       block: Pointer to block with size already set
- * \param[in]       new_block_size: New block size to be set
- * \return          `1` if block splitted, `0` otherwise
+ * \brief           Set to `1` when runtime policy switching is active
  */
-static uint8_t
-prv_split_too_big_block(lwmem_t* const lwobj, lwmem_block_t* block, size_t new_block_size) {
-    lwmem_block_t* next;
-    size_t block_size, is_alloc_bit;
-    uint8_t success = 0;
+#define LWMEM_POLICY_EN      (LWMEM_CFG_RUNTIME_POLICY && !LWMEM_SEGREGATED_EN && !LWMEM_TLSF_EN && !LWMEM_BUDDY_EN   \
+                              && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN)
 
-    is_alloc_bit = block->size & LWMEM_ALLOC_BIT; /* Check if allocation bit is set */
-    block_size = block->size & ~LWMEM_ALLOC_BIT;  /* Use size without allocated bit */
+#if LWMEM_CFG_RUNTIME_POLICY && (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT)
+#error "LWMEM_CFG_RUNTIME_POLICY requires LWMEM_ALLOC_STRATEGY_FIRST_FIT, runtime modes replace the strategy choice"
+#endif
 
-    /*
-     * If current block size is greater than requested size,
-     * it is possible to create empty block at the end of existing one
-     * and add it back to list of empty blocks
-     */
-    if ((block_size - new_block_size) >= LWMEM_BLOCK_MIN_SIZE) {
-        next = (void*)(LWMEM_TO_BYTE_PTR(block) + new_block_size); /* Put next block after size of current allocation */
-        next->size = block_size - new_block_size;                  /* Modify block data */
-        block->size = new_block_size;                              /* Current size is now smaller */
+/**
+ * \brief           Set to `1` when emergency reserve is active
+ */
+#define LWMEM_RESERVE_EN     (LWMEM_CFG_EMERGENCY_RESERVE_SIZE > 0 && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN)
 
-        lwobj->mem_available_bytes += next->size; /* Increase available bytes by new block size */
-        prv_insert_free_block(lwobj, next);       /* Add new block to the free list */
+/**
+ * \brief           Set to `1` when deferred memory scrubbing is active
+ */
+#define LWMEM_SCRUB_EN       (LWMEM_CFG_CLEAN_MEMORY_DEFERRED && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN)
 
-        success = 1;
-    } else {
-        /* TODO: If next of current is free, check if we can increase next by at least some bytes */
-        /* This can only happen during reallocation process when allocated block is reallocated to previous one */
-        /* Very rare case, but may happen! */
-    }
-
-    /* If allocation bit was set before, set it now again */
-    if (is_alloc_bit) {
-        prv_block_set_alloc(block);
-    }
-    return success;
-}
+#if LWMEM_CFG_CLEAN_MEMORY_DEFERRED && !LWMEM_CFG_CLEAN_MEMORY
+#error "LWMEM_CFG_CLEAN_MEMORY_DEFERRED requires LWMEM_CFG_CLEAN_MEMORY"
+#endif
+#if LWMEM_CFG_CLEAN_MEMORY_DEFERRED && LWMEM_CFG_DEFERRED_COALESCING
+#error "LWMEM_CFG_CLEAN_MEMORY_DEFERRED is not available together with LWMEM_CFG_DEFERRED_COALESCING"
+#endif
 
 /**
- * \brief           Private allocation function
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       region: Pointer to region to allocate from.
- *                      Set to `NULL` for any region
- * \param[in]       size: Application wanted size, excluding size of meta header
- * \return          Pointer to allocated memory, `NULL` otherwise
+ * \brief           Set to `1` when ISR-safe free queue is active
  */
-static void*
-prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
-    lwmem_block_t *prev, *curr;
-    void* retval = NULL;
+#define LWMEM_ISR_FREE_EN    (LWMEM_CFG_FREE_FROM_ISR)
 
-    /* Calculate final size including meta data size */
-    const size_t final_size = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE;
+#if LWMEM_ISR_FREE_EN && LWMEM_COMPACT_EN
+#error "LWMEM_CFG_FREE_FROM_ISR is not available together with LWMEM_CFG_COMPACT_HEADER"
+#endif
+#if LWMEM_CFG_REF_BUFFERS && (LWMEM_CFG_REDZONE_SIZE > 0)
+#error "LWMEM_CFG_REF_BUFFERS is not available together with LWMEM_CFG_REDZONE_SIZE"
+#endif
+#if LWMEM_CFG_CPU_CACHE && (LWMEM_CFG_REDZONE_SIZE > 0)
+#error "LWMEM_CFG_CPU_CACHE is not available together with LWMEM_CFG_REDZONE_SIZE"
+#endif
+#if LWMEM_CFG_EVICTABLE && (LWMEM_CFG_REDZONE_SIZE > 0)
+#error "LWMEM_CFG_EVICTABLE is not available together with LWMEM_CFG_REDZONE_SIZE"
+#endif
 
-    /* Check if initialized and if size is in the limits */
-    if (lwobj->end_block == NULL || final_size == LWMEM_BLOCK_META_SIZE || (final_size & LWMEM_ALLOC_BIT) > 0) {
-        return NULL;
-    }
+/**
+ * \brief           Set to `1` when active strategy keeps free blocks in size-class bins
+ */
+#define LWMEM_BINS_EN        (LWMEM_SEGREGATED_EN || LWMEM_TLSF_EN)
 
-    /* Set default values */
-    prev = &(lwobj->start_block); /* Use pointer from custom lwmem block */
-    curr = prev->next;            /* Curr represents first actual free block */
+#if LWMEM_SKIP_EN && (LWMEM_BINS_EN || LWMEM_BUDDY_EN || LWMEM_COMPACT_EN)
+#error "LWMEM_CFG_SKIP_INDEX requires an address-ordered allocation strategy (first-fit, best-fit or next-fit)"
+#endif
 
-    /*
-     * If region is not set to NULL,
-     * request for memory allocation came from specific region:
-     *
-     * - Start at the beginning like normal (from very first region)
-     * - Loop until free block is between region start addr and its size
-     */
-    if (region != NULL) {
-        uint8_t* region_start_addr;
-        size_t region_size;
+/**
+ * \brief           Set to `1` when per-region free list anchors are active
+ */
+#define LWMEM_PER_REGION_EN  (LWMEM_CFG_PER_REGION_LISTS && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN)
 
-        /* Get data about region */
-        if (!prv_get_region_addr_size(region, &region_start_addr, &region_size)) {
-            return NULL;
-        }
+#if LWMEM_CFG_SINGLE_REGION && LWMEM_CFG_PER_REGION_LISTS
+#error "LWMEM_CFG_SINGLE_REGION and LWMEM_CFG_PER_REGION_LISTS are mutually exclusive"
+#endif
 
-        /*
-         * Scan all regions from lwmem and find first available block
-         * which is within address of region and is big enough
-         */
-        for (; curr != NULL; prev = curr, curr = curr->next) {
-            /* Check bounds */
-            if (curr->next == NULL || curr == lwobj->end_block) {
-                return NULL;
-            }
-            if ((uint8_t*)curr < (uint8_t*)region_start_addr) { /* Check if we reached region */
-                continue;
-            }
-            if ((uint8_t*)curr >= (uint8_t*)(region_start_addr + region_size)) { /* Check if we are out already */
-                return NULL;
-            }
-            if (curr->size >= final_size) {
-                break; /* Free block identified */
-            }
-        }
-    } else {
-        /*
-         * Try to find first block with at least `size` bytes of available memory
-         * Loop until size of current block is smaller than requested final size
-         */
-        for (; curr != NULL && curr->size < final_size; prev = curr, curr = curr->next) {
-            if (curr->next == NULL || curr == lwobj->end_block) { /* If no more blocks available */
-                return NULL; /* No sufficient memory available to allocate block of memory */
-            }
-        }
-    }
+/**
+ * \brief           Set to `1` when region attributes are active
+ */
+#define LWMEM_REGION_ATTR_EN (LWMEM_CFG_REGION_ATTRIBUTES && LWMEM_PER_REGION_EN)
 
-    /* Check curr pointer. During normal use, this should be always false */
-    if (curr == NULL) {
-        return NULL;
-    }
+/**
+ * \brief           Set to `1` when fallback region chains are active
+ */
+#define LWMEM_REGION_FB_EN   (LWMEM_CFG_REGION_FALLBACK && LWMEM_PER_REGION_EN)
 
-    /* There is a valid block available */
-    retval = LWMEM_GET_PTR_FROM_BLOCK(curr); /* Return pointer does not include meta part */
-    prev->next = curr->next; /* Remove this block from linked list by setting next of previous to next of current */
+#if LWMEM_CFG_REGION_FALLBACK && !LWMEM_CFG_PER_REGION_LISTS
+#error "LWMEM_CFG_REGION_FALLBACK requires LWMEM_CFG_PER_REGION_LISTS"
+#endif
 
-    /* curr block is now removed from linked list */
+/**
+ * \brief           Set to `1` when small-block region routing is active
+ */
+#define LWMEM_SMALL_ROUTE_EN (LWMEM_CFG_SMALL_REGION_ROUTING && LWMEM_PER_REGION_EN)
 
-    lwobj->mem_available_bytes -= curr->size;         /* Decrease available bytes by allocated block size */
-    prv_split_too_big_block(lwobj, curr, final_size); /* Split block if it is too big */
-    prv_block_set_alloc(curr);                        /* Set block as allocated */
+/**
+ * \brief           Set to `1` when large-allocation routing is active
+ */
+#define LWMEM_LARGE_ROUTE_EN (LWMEM_CFG_LARGE_ROUTING_THRESHOLD > 0 && LWMEM_PER_REGION_EN)
 
-    LWMEM_UPDATE_MIN_FREE(lwobj);
-    LWMEM_INC_STATS(lwobj->stats.nr_alloc);
+#if (LWMEM_CFG_LARGE_ROUTING_THRESHOLD > 0) && !LWMEM_CFG_PER_REGION_LISTS
+#error "LWMEM_CFG_LARGE_ROUTING_THRESHOLD requires LWMEM_CFG_PER_REGION_LISTS"
+#endif
 
-    return retval;
-}
+#if LWMEM_CFG_SMALL_REGION_ROUTING && !LWMEM_CFG_PER_REGION_LISTS
+#error "LWMEM_CFG_SMALL_REGION_ROUTING requires LWMEM_CFG_PER_REGION_LISTS"
+#endif
 
 /**
- * \brief           Free input pointer
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       ptr: Input pointer to free
+ * \brief           Set to `1` when per-region statistics are active
  */
-static void
-prv_free(lwmem_t* const lwobj, void* const ptr) {
-    lwmem_block_t* const block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
-    if (LWMEM_BLOCK_IS_ALLOC(block)) {   /* Check if block is valid */
-        block->size &= ~LWMEM_ALLOC_BIT; /* Clear allocated bit indication */
+#define LWMEM_REGION_STATS_EN (LWMEM_CFG_PER_REGION_STATS && LWMEM_PER_REGION_EN)
 
-        lwobj->mem_available_bytes += block->size; /* Increase available bytes */
-        prv_insert_free_block(lwobj, block);       /* Put block back to list of free block */
+#if LWMEM_CFG_PER_REGION_STATS && !LWMEM_CFG_PER_REGION_LISTS
+#error "LWMEM_CFG_PER_REGION_STATS requires LWMEM_CFG_PER_REGION_LISTS"
+#endif
 
-        LWMEM_INC_STATS(lwobj->stats.nr_free);
-    }
-}
+#if LWMEM_CFG_REGION_ATTRIBUTES && !LWMEM_CFG_PER_REGION_LISTS
+#error "LWMEM_CFG_REGION_ATTRIBUTES requires LWMEM_CFG_PER_REGION_LISTS"
+#endif
+#if LWMEM_CFG_CLEAN_MEMORY_DEFERRED && (LWMEM_BUDDY_EN || LWMEM_COMPACT_EN)
+#error "LWMEM_CFG_CLEAN_MEMORY_DEFERRED requires a list-based allocation strategy"
+#endif
+
+#if LWMEM_CFG_SIZE_ROUNDING != LWMEM_SIZE_ROUNDING_NONE
 
 /**
- * \brief           Reallocates already allocated memory with new size
- *
- * Function behaves differently, depends on input parameter of `ptr` and `size`:
- *
- *  - `ptr == NULL; size == 0`: Function returns `NULL`, no memory is allocated or freed
- *  - `ptr == NULL; size > 0`: Function tries to allocate new block of memory with `size` length, equivalent to `malloc(size)`
- *  - `ptr != NULL; size == 0`: Function frees memory, equivalent to `free(ptr)`
- *  - `ptr != NULL; size > 0`: Function tries to allocate new memory of copy content before returning pointer on success
- *
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       region: Pointer to region to allocate from.
- *                      Set to `NULL` for any region
- * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
- *                      It may be set to `NULL` to create new clean allocation
- * \param[in]       size: Size of new memory to reallocate
- * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \brief           Round requested size up to the configured size ladder
+ * \param[in]       size: Application requested size
+ * \return          Rounded size
  */
-static void*
-prv_realloc(lwmem_t* const lwobj, const lwmem_region_t* region, void* const ptr, const size_t size) {
-    lwmem_block_t *block = NULL, *prevprev = NULL, *prev = NULL;
-    size_t block_size; /* Holds size of input block (ptr), including metadata size */
-    const size_t final_size =
-        LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE; /* Holds size of new requested block size, including metadata size */
-    void* retval;                                  /* Return pointer, used with LWMEM_RETURN macro */
+static size_t
+prv_round_size(size_t size) {
+    size_t pow2 = 16;
 
-    /* Check optional input parameters */
-    if (size == 0) {
-        if (ptr != NULL) {
-            prv_free(lwobj, ptr);
-        }
-        return NULL;
-    }
-    if (ptr == NULL) {
-        return prv_alloc(lwobj, region, size);
+    while (pow2 < size && (pow2 << 1) > pow2) { /* Stop on overflow */
+        pow2 <<= 1;
     }
+#if LWMEM_CFG_SIZE_ROUNDING == LWMEM_SIZE_ROUNDING_POW2_HALF
+    {
+        const size_t midpoint = pow2 - (pow2 >> 2);
 
-    /* Try to reallocate existing pointer */
-    if ((size & LWMEM_ALLOC_BIT) || (final_size & LWMEM_ALLOC_BIT)) {
-        return NULL;
+        if (size <= (pow2 >> 1)) {
+            return pow2 >> 1;
+        }
+        if (size <= midpoint) {
+            return midpoint;
+        }
     }
+#endif /* LWMEM_CFG_SIZE_ROUNDING == LWMEM_SIZE_ROUNDING_POW2_HALF */
+    return pow2;
+}
 
-    /* Process existing block */
-    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
-    if (!LWMEM_BLOCK_IS_ALLOC(block)) {
+/**
+ * \brief           Apply configured rounding to requested size
+ */
+#define LWMEM_ROUND_SIZE(size) prv_round_size(size)
+#else
+#define LWMEM_ROUND_SIZE(size) (size)
+#endif /* LWMEM_CFG_SIZE_ROUNDING != LWMEM_SIZE_ROUNDING_NONE */
 
-        /* Hard error. Input pointer is not NULL and block is not considered allocated */
-        return NULL;
-    }
-    block_size = block->size & ~LWMEM_ALLOC_BIT; /* Get actual block size, without memory allocation bit */
+#if LWMEM_CFG_HOST_SANITIZERS
 
-    /* Check current block size is the same as new requested size */
-    if (block_size == final_size) {
-        return ptr; /* Just return pointer, nothing to do */
-    }
+#if LWMEM_CFG_CLEAN_MEMORY || LWMEM_CFG_THREAD_CACHE || LWMEM_CFG_CPU_CACHE || LWMEM_CFG_DEFERRED_COALESCING          \
+    || LWMEM_CFG_CLEAN_MEMORY_DEFERRED                                                                                 \
+    || (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT                                                     \
+        && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_BEST_FIT                                                   \
+        && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_NEXT_FIT)
+#error "LWMEM_CFG_HOST_SANITIZERS requires the plain list engine without cache or clean-memory extras"
+#endif
 
-    /*
-     * Abbreviations
-     *
-     * - "Current block" or "Input block" is allocated block from input variable "ptr"
-     * - "Next free block" is next free block, on address space after input block
-     * - "Prev free block" is last free block, on address space before input block
-     * - "PrevPrev free block" is previous free block of "Prev free block"
-     */
+#if defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define LWMEM_HAS_ASAN 1
+#endif
+#elif defined(__SANITIZE_ADDRESS__)
+#define LWMEM_HAS_ASAN 1
+#endif
 
-    /*
-     * When new requested size is smaller than existing one,
-     * it is enough to modify size of current block only.
-     *
-     * If new requested size is much smaller than existing one,
-     * check if it is possible to create new empty block and add it to list of empty blocks
-     *
-     * Application returns same pointer
-     */
-    if (final_size < block_size) {
-        if ((block_size - final_size) >= LWMEM_BLOCK_MIN_SIZE) {
-            prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
-        } else {
-            /*
-             * It is not possible to create new empty block at the end of input block
-             *
-             * But if next free block is just after input block,
-             * it is possible to find this block and increase it by "block_size - final_size" bytes
-             */
+#if defined(LWMEM_HAS_ASAN)
+#include <sanitizer/asan_interface.h>
+#endif
+#if defined(__has_include)
+#if __has_include(<valgrind/memcheck.h>)
+#include <valgrind/memcheck.h>
+#define LWMEM_HAS_VALGRIND 1
+#endif
+#endif
 
-            /* Find free blocks before input block */
-            prv_get_prev_curr_of_block(lwobj, block, &prevprev, &prev);
+/**
+ * \brief           Re-expose user memory to host sanitizers on allocation
+ */
+static void
+prv_san_expose(void* addr, size_t len) {
+#if defined(LWMEM_HAS_ASAN)
+    __asan_unpoison_memory_region(addr, len);
+#endif
+#if defined(LWMEM_HAS_VALGRIND)
+    VALGRIND_MAKE_MEM_UNDEFINED(addr, len);
+#endif
+    (void)addr;
+    (void)len;
+}
 
-            /* Check if current block and next free are connected */
-            if ((LWMEM_TO_BYTE_PTR(block) + block_size) == LWMEM_TO_BYTE_PTR(prev->next)
-                && prev->next->size > 0) { /* Must not be end of region indicator */
-                /* Make temporary variables as prev->next will point to different location */
-                const size_t tmp_size = prev->next->size;
-                void* const tmp_next = prev->next->next;
+/**
+ * \brief           Hide freed user memory from the application under host sanitizers
+ */
+static void
+prv_san_hide(void* addr, size_t len) {
+#if defined(LWMEM_HAS_ASAN)
+    __asan_poison_memory_region(addr, len);
+#endif
+#if defined(LWMEM_HAS_VALGRIND)
+    VALGRIND_MAKE_MEM_NOACCESS(addr, len);
+#endif
+    (void)addr;
+    (void)len;
+}
 
-                /* Shift block up, effectively increase its size */
-                prev->next = (void*)(LWMEM_TO_BYTE_PTR(prev->next) - (block_size - final_size));
-                prev->next->size = tmp_size + (block_size - final_size);
-                prev->next->next = tmp_next;
+#define LWMEM_SAN_EXPOSE(addr, len) prv_san_expose((addr), (len))
+#define LWMEM_SAN_HIDE(addr, len)   prv_san_hide((addr), (len))
+#else
+#define LWMEM_SAN_EXPOSE(addr, len)
+#define LWMEM_SAN_HIDE(addr, len)
+#endif /* LWMEM_CFG_HOST_SANITIZERS */
 
-                /* Increase available bytes by increase of free block */
-                lwobj->mem_available_bytes += block_size - final_size;
+#if LWMEM_CFG_PREFETCH
+/**
+ * \brief           Prefetch next node of a free-list walk
+ */
+#define LWMEM_WALK_PREFETCH(node) LWMEM_PREFETCH(node)
+#else
+#define LWMEM_WALK_PREFETCH(node)
+#endif /* LWMEM_CFG_PREFETCH */
 
-                block->size = final_size; /* Block size is requested size */
-            }
-        }
-        prv_block_set_alloc(block); /* Set block as allocated */
-        return ptr;                 /* Return existing pointer */
-    }
+#if LWMEM_CFG_PER_INSTANCE_ALIGN
+/**
+ * \brief           Round full block size up to the instance alignment
+ */
+#define LWMEM_INSTANCE_SIZE_ALIGN(lwobj, x)                                                                            \
+    ((lwobj)->instance_align > 0 ? (((x) + (lwobj)->instance_align - 1) & ~((lwobj)->instance_align - 1)) : (x))
+#else
+#define LWMEM_INSTANCE_SIZE_ALIGN(lwobj, x) (x)
+#endif /* LWMEM_CFG_PER_INSTANCE_ALIGN */
 
-    /* New requested size is bigger than current block size is */
+/**
+ * \brief           Set to `1` when guard zones are active
+ */
+#define LWMEM_REDZONE_EN     (LWMEM_CFG_REDZONE_SIZE > 0 && !LWMEM_COMPACT_EN && !LWMEM_BUDDY_EN)
 
-    /* Find last free (and its previous) block, located just before input block */
-    prv_get_prev_curr_of_block(lwobj, block, &prevprev, &prev);
+#if (LWMEM_CFG_REDZONE_SIZE % LWMEM_CFG_ALIGN_NUM) != 0
+#error "LWMEM_CFG_REDZONE_SIZE must be a multiple of LWMEM_CFG_ALIGN_NUM"
+#endif
+#if (LWMEM_CFG_REDZONE_SIZE > 0) && LWMEM_CFG_THREAD_CACHE
+#error "LWMEM_CFG_REDZONE_SIZE is not available together with LWMEM_CFG_THREAD_CACHE"
+#endif
 
-    /* If entry could not be found, there is a hard error */
-    if (prev == NULL) {
-        return NULL;
-    }
+#if LWMEM_CFG_OP_JOURNAL
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_OP_JOURNAL requires LWMEM_CFG_FULL"
+#endif
+#if (LWMEM_CFG_OP_JOURNAL_DEPTH & (LWMEM_CFG_OP_JOURNAL_DEPTH - 1)) != 0
+#error "LWMEM_CFG_OP_JOURNAL_DEPTH must be a power of 2"
+#endif
 
-    /* Order of variables is: | prevprev ---> prev --->--->--->--->--->--->--->--->--->---> prev->next  | */
+/**
+ * \brief           Journal validity marker, `LWJN` in ASCII
+ */
+#define LWMEM_JOURNAL_MAGIC  ((uint32_t)0x4C574A4EUL)
+
+/**
+ * \brief           Return address of the current function, for journal caller field
+ */
+#if defined(__GNUC__) || defined(__clang__)
+#define LWMEM_RETURN_ADDR()  ((uint32_t)(uintptr_t)__builtin_return_address(0))
+#else
+#define LWMEM_RETURN_ADDR()  ((uint32_t)0)
+#endif
+
+/**
+ * \brief           Journal one heap operation with a few plain stores
+ * \param[in]       lwobj: LwMEM instance with journal possibly attached
+ * \param[in]       opc: Operation code, \ref lwmem_journal_op_t value
+ * \param[in]       in_ptr: Pointer involved in the operation
+ * \param[in]       in_size: Requested size of the operation
+ * \param[in]       in_caller: Return address of the public API caller
+ */
+#define LWMEM_JOURNAL_OP(lwobj, opc, in_ptr, in_size, in_caller)                                                       \
+    do {                                                                                                               \
+        if ((lwobj)->journal != NULL) {                                                                                \
+            lwmem_journal_entry_t* ent_;                                                                               \
+            lwmem_journal_t* jrn_;                                                                                     \
+            LWMEM_PROTECT(lwobj); /* Concurrent writers must not tear ring entries */                                  \
+            jrn_ = (lwobj)->journal;                                                                                   \
+            if (jrn_ != NULL) {                                                                                        \
+                ent_ = &jrn_->entries[jrn_->head & (LWMEM_CFG_OP_JOURNAL_DEPTH - 1)];                                  \
+                ent_->op_size = ((uint32_t)(opc) << 30) | ((uint32_t)(in_size) & 0x3FFFFFFFUL);                        \
+                ent_->addr = (uint32_t)(uintptr_t)(in_ptr);                                                            \
+                ent_->caller = (in_caller);                                                                            \
+                ++jrn_->head;                                                                                          \
+                jrn_->available_bytes = (uint32_t)(lwobj)->mem_available_bytes;                                        \
+            }                                                                                                          \
+            LWMEM_UNPROTECT(lwobj);                                                                                    \
+        }                                                                                                              \
+    } while (0)
+#else /* LWMEM_CFG_OP_JOURNAL */
+#define LWMEM_JOURNAL_OP(lwobj, opc, in_ptr, in_size, in_caller)
+#endif /* !LWMEM_CFG_OP_JOURNAL */
+
+/**
+ * \brief           Set to `1` when persistent heap attach support is active
+ */
+#define LWMEM_PERSIST_EN                                                                                               \
+    (LWMEM_CFG_PERSIST && LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN      \
+     && !LWMEM_BT_EN && !LWMEM_BINS_EN && !LWMEM_SKIP_EN && !LWMEM_PER_REGION_EN && !LWMEM_DEFERRED_EN                 \
+     && !LWMEM_SCRUB_EN && !LWMEM_ISR_FREE_EN && !LWMEM_CFG_AUDIT_REUSE && !LWMEM_CFG_BLOCK_CHECKSUM                  \
+     && !LWMEM_CFG_EXACT_CACHE)
+
+#if LWMEM_CFG_PERSIST                                                                                                  \
+    && (!LWMEM_CFG_FULL                                                                                                \
+        || (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT                                                 \
+            && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_BEST_FIT                                               \
+            && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_NEXT_FIT)                                              \
+        || LWMEM_CFG_COMPACT_HEADER || LWMEM_CFG_OOB_METADATA || LWMEM_CFG_SIZE_ORDERED_LIST                           \
+        || LWMEM_CFG_BOUNDARY_TAGS || LWMEM_CFG_SKIP_INDEX || LWMEM_CFG_PER_REGION_LISTS                               \
+        || LWMEM_CFG_DEFERRED_COALESCING || LWMEM_CFG_CLEAN_MEMORY_DEFERRED || LWMEM_CFG_FREE_FROM_ISR                 \
+        || LWMEM_CFG_AUDIT_REUSE || LWMEM_CFG_BLOCK_CHECKSUM || LWMEM_CFG_EXACT_CACHE)
+#error "LWMEM_CFG_PERSIST requires the plain list engine without extras keeping volatile side state"
+#endif
+
+/**
+ * \brief           Set to `1` when persistent-heap write-ahead intent records are active
+ */
+#define LWMEM_WAL_EN (LWMEM_CFG_PERSIST_WAL && LWMEM_PERSIST_EN)
+
+#if LWMEM_CFG_PERSIST_WAL && !LWMEM_CFG_PERSIST
+#error "LWMEM_CFG_PERSIST_WAL requires LWMEM_CFG_PERSIST"
+#endif
+
+/**
+ * \brief           Set to `1` when wear-leveled persistent-region placement is active
+ */
+#define LWMEM_WEAR_EN (LWMEM_CFG_WEAR_LEVELING && LWMEM_REGION_ATTR_EN && !LWMEM_SKIP_EN && !LWMEM_BINS_EN)
+
+#if LWMEM_CFG_WEAR_LEVELING && !(LWMEM_CFG_REGION_ATTRIBUTES && LWMEM_CFG_PER_REGION_LISTS)
+#error "LWMEM_CFG_WEAR_LEVELING requires LWMEM_CFG_REGION_ATTRIBUTES and LWMEM_CFG_PER_REGION_LISTS"
+#endif
+
+#if LWMEM_CFG_BOUNDED_LOCK
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_BOUNDED_LOCK requires LWMEM_CFG_FULL"
+#endif
+#if !LWMEM_CFG_DEFERRED_COALESCING
+#error "LWMEM_CFG_BOUNDED_LOCK requires LWMEM_CFG_DEFERRED_COALESCING for constant-time free"
+#endif
+#if LWMEM_BEST_FIT_EN || LWMEM_POLICY_EN
+#error "LWMEM_CFG_BOUNDED_LOCK cannot bound full-list search strategies"
+#endif
+#if LWMEM_CFG_CLEAN_MEMORY
+#error "LWMEM_CFG_BOUNDED_LOCK cannot bound clean-memory length inside the lock"
+#endif
+
+/**
+ * \brief           Declare remaining walk budget of the current critical section
+ */
+#define LWMEM_BOUND_WALK_DECL                                                                                          \
+    size_t walk_bound_left = LWMEM_CFG_BOUNDED_LOCK_MAX_WALK;                                                          \
+    (void)walk_bound_left
+/**
+ * \brief           Account one visited free block, fail the request when budget is spent
+ */
+#define LWMEM_BOUND_WALK_STEP(lwobj)                                                                                   \
+    do {                                                                                                               \
+        if (--walk_bound_left == 0) {                                                                                  \
+            ++(lwobj)->bound_alloc_aborts; /* Fail fast instead of exceeding the masked-time contract */               \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+#else /* LWMEM_CFG_BOUNDED_LOCK */
+#define LWMEM_BOUND_WALK_DECL
+#define LWMEM_BOUND_WALK_STEP(lwobj)
+#endif /* !LWMEM_CFG_BOUNDED_LOCK */
+
+/**
+ * \brief           Set to `1` when per-block user metadata word is active
+ */
+#define LWMEM_UDATA_EN (LWMEM_CFG_BLOCK_UDATA && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN)
+
+#if LWMEM_CFG_BLOCK_UDATA
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_BLOCK_UDATA requires LWMEM_CFG_FULL"
+#endif
+#if !LWMEM_UDATA_EN
+#error "LWMEM_CFG_BLOCK_UDATA requires an engine with standard block headers"
+#endif
+#endif /* LWMEM_CFG_BLOCK_UDATA */
+
+/**
+ * \brief           Set to `1` when block pinning protocol is active
+ */
+#define LWMEM_PIN_EN (LWMEM_CFG_BLOCK_PINNING && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN)
+
+#if LWMEM_CFG_BLOCK_PINNING
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_BLOCK_PINNING requires LWMEM_CFG_FULL"
+#endif
+#if !LWMEM_PIN_EN
+#error "LWMEM_CFG_BLOCK_PINNING requires an engine with standard block headers"
+#endif
+#endif /* LWMEM_CFG_BLOCK_PINNING */
+
+/**
+ * \brief           Set to `1` when block metadata checksums are active
+ */
+#define LWMEM_CHK_EN                                                                                                   \
+    (LWMEM_CFG_BLOCK_CHECKSUM && !LWMEM_BINS_EN && !LWMEM_SKIP_EN && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN              \
+     && !LWMEM_OOB_EN && !LWMEM_SO_EN && !LWMEM_BT_EN && !LWMEM_DEFERRED_EN && !LWMEM_SCRUB_EN && !LWMEM_ISR_FREE_EN)
+
+#if LWMEM_CFG_BLOCK_CHECKSUM
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_BLOCK_CHECKSUM requires LWMEM_CFG_FULL"
+#endif
+#if (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT                                                        \
+     && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_BEST_FIT                                                      \
+     && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_NEXT_FIT)                                                     \
+    || LWMEM_CFG_SKIP_INDEX || LWMEM_CFG_COMPACT_HEADER || LWMEM_CFG_OOB_METADATA || LWMEM_CFG_SIZE_ORDERED_LIST       \
+    || LWMEM_CFG_BOUNDARY_TAGS || LWMEM_CFG_DEFERRED_COALESCING || LWMEM_CFG_CLEAN_MEMORY_DEFERRED                     \
+    || LWMEM_CFG_FREE_FROM_ISR
+#error "LWMEM_CFG_BLOCK_CHECKSUM requires the plain list engine without deferred/scrub/ISR extras"
+#endif
+
+/**
+ * \brief           Compute header checksum from current `next` and `size` fields
+ *
+ * XOR with rotated link so a same-position bit fault
+ * in both fields still changes the result
+ */
+#define LWMEM_CHK_CALC(block)                                                                                          \
+    ((block)->size ^ (((size_t)(uintptr_t)(block)->next << 1) | ((size_t)(uintptr_t)(block)->next >> (sizeof(size_t) * 8 - 1)))   \
+     ^ (size_t)0xA55A6996UL)
+
+/**
+ * \brief           Refresh checksum and shadow link after header fields settled
+ */
+#define LWMEM_CHK_SET(block)                                                                                           \
+    do {                                                                                                               \
+        (block)->next_shadow = ~(size_t)(uintptr_t)(block)->next;                                                      \
+        (block)->chk = LWMEM_CHK_CALC(block);                                                                          \
+    } while (0)
+
+/**
+ * \brief           Verify header before use, repairing what the shadow copy allows
+ *
+ * Corrupted `next` is restored from the shadow complement, corrupted shadow
+ * is refreshed from the (checksum-confirmed) link, corrupted `size` cannot
+ * be recovered and is only counted - the heap is compromised at that point
+ */
+#define LWMEM_CHK_VERIFY(lwobj, block)                                                                                 \
+    do {                                                                                                               \
+        if ((block)->chk != LWMEM_CHK_CALC(block)) {                                                                   \
+            lwmem_block_t* vrf_ = (block);                                                                             \
+            void* const repaired_next_ = (void*)(uintptr_t)~vrf_->next_shadow;                                         \
+            void* const orig_next_ = vrf_->next;                                                                       \
+                                                                                                                       \
+            vrf_->next = repaired_next_;                                                                               \
+            if (vrf_->chk == LWMEM_CHK_CALC(vrf_)) {                                                                   \
+                ++(lwobj)->chk_repaired; /* Link restored from shadow copy */                                          \
+            } else {                                                                                                   \
+                vrf_->next = orig_next_;                                                                               \
+                ++(lwobj)->chk_detected; /* Size or multi-field corruption, not recoverable */                         \
+            }                                                                                                          \
+        } else if (~(size_t)(uintptr_t)(block)->next != (block)->next_shadow) {                                        \
+            (block)->next_shadow = ~(size_t)(uintptr_t)(block)->next; /* Shadow itself took the hit */                 \
+            ++(lwobj)->chk_repaired;                                                                                   \
+        }                                                                                                              \
+    } while (0)
+#else /* LWMEM_CFG_BLOCK_CHECKSUM */
+#define LWMEM_CHK_SET(block)
+#define LWMEM_CHK_VERIFY(lwobj, block)
+#endif /* !LWMEM_CFG_BLOCK_CHECKSUM */
+
+#if LWMEM_CFG_CONST_TIME_POOL
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_CONST_TIME_POOL requires LWMEM_CFG_FULL"
+#endif
+#if LWMEM_CFG_REDZONE_SIZE > 0
+#error "LWMEM_CFG_CONST_TIME_POOL cannot be combined with red zones, pool blocks carry no header to verify"
+#endif
+
+/**
+ * \brief           Check if pointer belongs to the attached constant-time pool
+ */
+#define LWMEM_CT_OWNS(lwobj, in_ptr)                                                                                   \
+    ((lwobj)->ct_pool != NULL && LWMEM_TO_BYTE_PTR(in_ptr) >= (lwobj)->ct_base                                         \
+     && LWMEM_TO_BYTE_PTR(in_ptr) < ((lwobj)->ct_base + (lwobj)->ct_range))
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+
+/**
+ * \brief           Set to `1` when the guaranteed-latency tier is active
+ */
+#define LWMEM_RT_EN                                                                                                    \
+    (LWMEM_CFG_RT_TIER && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && LWMEM_CFG_REDZONE_SIZE == 0         \
+     && !LWMEM_CFG_CONFIGURABLE_SPLIT)
+
+#if LWMEM_CFG_RT_TIER
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_RT_TIER requires LWMEM_CFG_FULL"
+#endif
+#if !LWMEM_RT_EN
+#error "LWMEM_CFG_RT_TIER requires an engine with standard block headers and no red zones"
+#endif
+#endif /* LWMEM_CFG_RT_TIER */
+
+/**
+ * \brief           Set to `1` when per-block generation counters are active
+ */
+#define LWMEM_GEN_EN (LWMEM_CFG_BLOCK_GENERATION && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN)
+
+#if LWMEM_CFG_BLOCK_GENERATION
+#if !LWMEM_CFG_FULL
+#error "LWMEM_CFG_BLOCK_GENERATION requires LWMEM_CFG_FULL"
+#endif
+#if !LWMEM_GEN_EN
+#error "LWMEM_CFG_BLOCK_GENERATION requires an engine with standard block headers"
+#endif
+#endif /* LWMEM_CFG_BLOCK_GENERATION */
+
+/**
+ * \brief           Set to `1` when the exact-fit fast cache is active
+ */
+#define LWMEM_EXACT_EN                                                                                                 \
+    (LWMEM_CFG_EXACT_CACHE && LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN  \
+     && !LWMEM_BINS_EN && !LWMEM_SKIP_EN && !LWMEM_BT_EN && !LWMEM_DEFERRED_EN && !LWMEM_SCRUB_EN && !LWMEM_WEAR_EN   \
+     && !LWMEM_CFG_HOST_SANITIZERS && !LWMEM_CFG_CLEAN_MEMORY)
+
+#if LWMEM_CFG_EXACT_CACHE
+#if (LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT                                                        \
+     && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_BEST_FIT                                                      \
+     && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_NEXT_FIT)                                                     \
+    || LWMEM_CFG_SKIP_INDEX || LWMEM_CFG_COMPACT_HEADER || LWMEM_CFG_OOB_METADATA || LWMEM_CFG_SIZE_ORDERED_LIST       \
+    || LWMEM_CFG_BOUNDARY_TAGS || LWMEM_CFG_DEFERRED_COALESCING || LWMEM_CFG_CLEAN_MEMORY_DEFERRED                     \
+    || LWMEM_CFG_WEAR_LEVELING || LWMEM_CFG_HOST_SANITIZERS || LWMEM_CFG_CLEAN_MEMORY || !LWMEM_CFG_FULL
+#error "LWMEM_CFG_EXACT_CACHE requires the plain list engine"
+#endif
+#if (LWMEM_CFG_EXACT_CACHE_SIZE & (LWMEM_CFG_EXACT_CACHE_SIZE - 1)) != 0
+#error "LWMEM_CFG_EXACT_CACHE_SIZE must be a power of 2"
+#endif
+
+/**
+ * \brief           Direct-mapped cache slot of the block size
+ */
+#define LWMEM_EXACT_SLOT(lwobj, in_size)                                                                               \
+    (&(lwobj)->exact_cache[((in_size) / LWMEM_CFG_ALIGN_NUM) & (LWMEM_CFG_EXACT_CACHE_SIZE - 1)])
+#endif /* LWMEM_CFG_EXACT_CACHE */
+
+#if LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE
+/* Registry helper lives with the eviction code below, every free path must maintain it */
+static void prv_evictable_forget(lwmem_t* const lwobj, const void* ptr);
+
+/**
+ * \brief           Drop pointer from the eviction registry, block is leaving the heap
+ */
+#define LWMEM_EVICTABLE_FORGET(lwobj, in_ptr) prv_evictable_forget(lwobj, in_ptr)
+
+static void prv_evictable_rehome(lwmem_t* const lwobj, const void* old_ptr, void* new_ptr);
+
+/**
+ * \brief           Keep registry entry tracking a block across its relocation
+ */
+#define LWMEM_EVICTABLE_REHOME(lwobj, old_ptr, new_ptr) prv_evictable_rehome(lwobj, old_ptr, new_ptr)
+#else /* LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE */
+#define LWMEM_EVICTABLE_FORGET(lwobj, in_ptr)
+#define LWMEM_EVICTABLE_REHOME(lwobj, old_ptr, new_ptr)
+#endif /* !(LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE) */
+
+#if LWMEM_WAL_EN
+/* Intent-record helpers live with the persistent heap code below */
+static void prv_wal_arm_block(lwmem_t* lwobj, const lwmem_block_t* block);
+static void prv_wal_arm_prev(lwmem_t* lwobj, const lwmem_block_t* prev);
+static void prv_wal_disarm(lwmem_t* lwobj);
+
+/**
+ * \brief           Record pre-operation state of the block about to be modified
+ */
+#define LWMEM_WAL_ARM_BLOCK(lwobj, block) prv_wal_arm_block(lwobj, block)
+/**
+ * \brief           Record pre-merge state of the free-list predecessor
+ */
+#define LWMEM_WAL_ARM_PREV(lwobj, prev)   prv_wal_arm_prev(lwobj, prev)
+/**
+ * \brief           Commit: operation reached its consistent final state
+ */
+#define LWMEM_WAL_DISARM(lwobj)           prv_wal_disarm(lwobj)
+#else /* LWMEM_WAL_EN */
+#define LWMEM_WAL_ARM_BLOCK(lwobj, block)
+#define LWMEM_WAL_ARM_PREV(lwobj, prev)
+#define LWMEM_WAL_DISARM(lwobj)
+#endif /* !LWMEM_WAL_EN */
+
+/**
+ * \brief           Set to `1` when free-to-reuse auditing is active
+ */
+#define LWMEM_AUDIT_EN       (LWMEM_CFG_AUDIT_REUSE && !LWMEM_BINS_EN && !LWMEM_SKIP_EN && !LWMEM_BUDDY_EN             \
+                              && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN)
+
+#if LWMEM_CFG_AUDIT_REUSE                                                                                              \
+    && ((LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_FIRST_FIT                                                    \
+         && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_BEST_FIT                                                  \
+         && LWMEM_CFG_ALLOC_STRATEGY != LWMEM_ALLOC_STRATEGY_NEXT_FIT)                                                 \
+        || LWMEM_CFG_SKIP_INDEX || LWMEM_CFG_COMPACT_HEADER || LWMEM_CFG_OOB_METADATA                                  \
+        || LWMEM_CFG_SIZE_ORDERED_LIST || LWMEM_CFG_CLEAN_MEMORY)
+#error "LWMEM_CFG_AUDIT_REUSE requires the plain list engine without clean-memory"
+#endif
+
+/**
+ * \brief           Set to `1` when per-allocation age tracking is active
+ */
+#define LWMEM_AGE_EN         (LWMEM_CFG_BLOCK_AGE && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN)
+
+#if LWMEM_CFG_BLOCK_AGE && (LWMEM_COMPACT_EN || LWMEM_OOB_EN)
+#error "LWMEM_CFG_BLOCK_AGE is not available together with compact headers or out-of-band metadata"
+#endif
+
+/**
+ * \brief           Set to `1` when per-task ownership tracking is active
+ */
+#define LWMEM_OWNER_EN       (LWMEM_CFG_TASK_OWNERSHIP && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN)
+
+#if LWMEM_CFG_TASK_OWNERSHIP && (LWMEM_COMPACT_EN || LWMEM_OOB_EN)
+#error "LWMEM_CFG_TASK_OWNERSHIP is not available together with compact headers or out-of-band metadata"
+#endif
+
+/**
+ * \brief           Set to `1` when allocation-site tagging is active
+ */
+#define LWMEM_TAGS_EN        (LWMEM_CFG_ALLOC_TAGS && !LWMEM_COMPACT_EN)
+
+#if LWMEM_CFG_ALLOC_TAGS && LWMEM_COMPACT_EN
+#error "LWMEM_CFG_ALLOC_TAGS is not available together with LWMEM_CFG_COMPACT_HEADER"
+#endif
+
+#if LWMEM_REDZONE_EN
+
+/**
+ * \brief           Pattern word filling the guard zones
+ */
+#define LWMEM_REDZONE_MAGIC ((uint32_t)0xA9A9A9A9U)
+
+/**
+ * \brief           Fill guard zones of an allocated block
+ *
+ * Front zone is the first \ref LWMEM_CFG_REDZONE_SIZE bytes and rear zone the
+ * last ones of the block user area, so positions derive from the block header
+ *
+ * \param[in]       block: Allocated block to fill zones of
+ */
+static void
+prv_redzone_fill(lwmem_block_t* block) {
+    uint8_t* user = LWMEM_GET_PTR_FROM_BLOCK(block);
+    const size_t user_size = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+
+    LWMEM_MEMSET(user, 0xA9, LWMEM_CFG_REDZONE_SIZE);
+    LWMEM_MEMSET(user + user_size - LWMEM_CFG_REDZONE_SIZE, 0xA9, LWMEM_CFG_REDZONE_SIZE);
+}
+
+/**
+ * \brief           Verify guard zones of an allocated block, word at a time
+ * \param[in]       block: Allocated block to verify
+ * \return          `1` when zones are intact, `0` on violation
+ */
+static uint8_t
+prv_redzone_verify(const lwmem_block_t* block) {
+    const uint8_t* user = LWMEM_GET_PTR_FROM_BLOCK(block);
+    const size_t user_size = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+    const uint32_t* front = (const void*)user;
+    const uint32_t* rear = (const void*)(user + user_size - LWMEM_CFG_REDZONE_SIZE);
+
+    for (size_t i = 0; i < (LWMEM_CFG_REDZONE_SIZE / sizeof(uint32_t)); ++i) {
+        if (front[i] != LWMEM_REDZONE_MAGIC || rear[i] != LWMEM_REDZONE_MAGIC) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * \brief           Inflate application request so the block carries both guard zones.
+ *                      Requests that would wrap collapse to `0` and fail downstream
+ */
+#define LWMEM_RZ_INFLATE(in_size)                                                                                      \
+    (((in_size) > 0 && (in_size) < ((size_t)-1 - 2 * LWMEM_CFG_REDZONE_SIZE))                                          \
+         ? ((in_size) + 2 * LWMEM_CFG_REDZONE_SIZE)                                                                    \
+         : 0)
+
+/**
+ * \brief           Map application pointer back to the raw (zoned) block pointer
+ */
+#define LWMEM_RZ_RAW(in_ptr) ((in_ptr) != NULL ? (void*)(LWMEM_TO_BYTE_PTR(in_ptr) - LWMEM_CFG_REDZONE_SIZE) : NULL)
+
+/**
+ * \brief           Finish a raw allocation: fill both guard zones
+ *                      and step the pointer over the front zone
+ * \param[in]       raw_ptr: Raw block pointer fresh from the engine, `NULL` tolerated
+ * \return          Application pointer past the front zone
+ */
+static void*
+prv_redzone_finish(void* raw_ptr) {
+    if (raw_ptr != NULL) {
+        prv_redzone_fill(LWMEM_GET_BLOCK_FROM_PTR(raw_ptr));
+        raw_ptr = LWMEM_TO_BYTE_PTR(raw_ptr) + LWMEM_CFG_REDZONE_SIZE;
+    }
+    return raw_ptr;
+}
+
+/**
+ * \brief           Finish a raw allocation under guard zones, see \ref prv_redzone_finish
+ */
+#define LWMEM_RZ_FINISH(in_ptr) prv_redzone_finish(in_ptr)
+
+#else /* LWMEM_REDZONE_EN */
+#define LWMEM_RZ_INFLATE(in_size) (in_size)
+#define LWMEM_RZ_RAW(in_ptr)      (in_ptr)
+#define LWMEM_RZ_FINISH(in_ptr)   (in_ptr)
+#endif /* !LWMEM_REDZONE_EN */
+
+/**
+ * \brief           Set to `1` when known-zero memory tracking is active
+ */
+#define LWMEM_ZERO_TRACK_EN                                                                                            \
+    (LWMEM_CFG_ZERO_TRACKING && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN                  \
+     && !LWMEM_BINS_EN && !LWMEM_SKIP_EN) /* Bin links and index towers write into free-block bodies,                  \
+                                             memory above the watermark does not stay zero there */
+
+#if LWMEM_CFG_PROFILING
+
+/**
+ * \brief           Record operation duration into its profile entry
+ * \param[in]       profile: Profile entry of the operation type
+ * \param[in]       cycles: Measured operation duration, in cycles
+ */
+static void
+prv_prof_record(lwmem_op_profile_t* profile, uint32_t cycles) {
+    if (profile->count == 0 || cycles < profile->min_cycles) {
+        profile->min_cycles = cycles;
+    }
+    if (cycles > profile->max_cycles) {
+        profile->max_cycles = cycles;
+    }
+    /* Exponentially weighted moving average with 1/8 weight */
+    profile->avg_cycles += ((int32_t)(cycles - profile->avg_cycles)) / 8;
+    ++profile->count;
+}
+
+/**
+ * \brief           Take operation start timestamp
+ */
+#define LWMEM_PROF_START()         uint32_t prof_start_cycles = (uint32_t)LWMEM_GET_CYCLES()
+
+/**
+ * \brief           Record operation duration into instance profile
+ */
+#define LWMEM_PROF_END(lwobj, field)                                                                                   \
+    prv_prof_record(&(lwobj)->profile.field, (uint32_t)LWMEM_GET_CYCLES() - prof_start_cycles)
+#else
+#define LWMEM_PROF_START()
+#define LWMEM_PROF_END(lwobj, field)
+#endif /* LWMEM_CFG_PROFILING */
+
+#if LWMEM_CFG_FAULT_INJECT
+
+/**
+ * \brief           Evaluate configured fault injectors for an allocation attempt
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       in_size: Application requested size
+ * \return          `1` when allocation shall fail, `0` otherwise
+ */
+static uint8_t
+prv_fault_triggered(lwmem_t* const lwobj, size_t in_size) {
+    if (lwobj->fi_countdown > 0 && --lwobj->fi_countdown == 0) {
+        return 1;
+    }
+    if (lwobj->fi_above_size > 0 && in_size > lwobj->fi_above_size) {
+        return 1;
+    }
+    if (lwobj->fi_permille > 0) {
+        lwobj->fi_rng ^= lwobj->fi_rng << 13;
+        lwobj->fi_rng ^= lwobj->fi_rng >> 17;
+        lwobj->fi_rng ^= lwobj->fi_rng << 5;
+        if ((lwobj->fi_rng % 1000) < lwobj->fi_permille) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Fail allocation when a fault injector triggers
+ */
+#define LWMEM_FAULT_CHECK(lwobj, in_size)                                                                              \
+    do {                                                                                                               \
+        if (prv_fault_triggered((lwobj), (in_size))) {                                                                 \
+            return NULL;                                                                                               \
+        }                                                                                                              \
+    } while (0)
+#else
+#define LWMEM_FAULT_CHECK(lwobj, in_size)
+#endif /* LWMEM_CFG_FAULT_INJECT */
+
+#if LWMEM_CFG_WATERMARK_HOOKS
+/**
+ * \brief           Fire watermark callback on threshold crossings of available memory
+ */
+#define LWMEM_WATERMARK_CHECK(lwobj)                                                                                   \
+    do {                                                                                                               \
+        if ((lwobj)->wm_callback != NULL) {                                                                            \
+            if (!(lwobj)->wm_below && (lwobj)->mem_available_bytes < (lwobj)->wm_low) {                                \
+                (lwobj)->wm_below = 1;                                                                                 \
+                (lwobj)->wm_callback((lwobj), 0, (lwobj)->mem_available_bytes);                                        \
+            } else if ((lwobj)->wm_below && (lwobj)->mem_available_bytes > (lwobj)->wm_high) {                         \
+                (lwobj)->wm_below = 0;                                                                                 \
+                (lwobj)->wm_callback((lwobj), 1, (lwobj)->mem_available_bytes);                                        \
+            }                                                                                                          \
+        }                                                                                                              \
+    } while (0)
+#else
+#define LWMEM_WATERMARK_CHECK(lwobj)
+#endif /* LWMEM_CFG_WATERMARK_HOOKS */
+
+#if LWMEM_CFG_EVENT_HOOKS
+/**
+ * \brief           Fire allocation event hook when registered
+ */
+#define LWMEM_EVENT(lwobj, evt_type, ptr, in_size)                                                                     \
+    do {                                                                                                               \
+        if ((lwobj)->event_hook != NULL) {                                                                             \
+            (lwobj)->event_hook((lwobj), (evt_type), (ptr), (in_size));                                                \
+        }                                                                                                              \
+    } while (0)
+#else
+#define LWMEM_EVENT(lwobj, evt_type, ptr, in_size)
+#endif /* LWMEM_CFG_EVENT_HOOKS */
+
+#if LWMEM_CFG_ALLOC_HISTOGRAM
+/**
+ * \brief           Count requested allocation size into its log2 histogram bucket
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       in_size: Requested application size
+ */
+#define LWMEM_HISTOGRAM_COUNT(lwobj, in_size)                                                                          \
+    do {                                                                                                               \
+        size_t hist_size = (in_size), hist_idx = 0;                                                                    \
+        for (; hist_size > 1 && hist_idx < (LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS - 1); hist_size >>= 1) {                 \
+            ++hist_idx;                                                                                                \
+        }                                                                                                              \
+        ++(lwobj)->alloc_histogram[hist_idx];                                                                          \
+    } while (0)
+#else
+#define LWMEM_HISTOGRAM_COUNT(lwobj, in_size)
+#endif /* LWMEM_CFG_ALLOC_HISTOGRAM */
+
+
+#if LWMEM_NEXT_FIT_EN
+
+/**
+ * \brief           Invalidate roving pointer when block it references leaves the free list
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Block being removed, moved or merged away
+ */
+#define LWMEM_NEXTFIT_FORGET(lwobj, block)                                                                             \
+    do {                                                                                                               \
+        if ((lwobj)->next_fit_prev == (block)) {                                                                       \
+            (lwobj)->next_fit_prev = &((lwobj)->start_block);                                                          \
+        }                                                                                                              \
+    } while (0)
+#elif LWMEM_CFG_RUNTIME_POLICY
+
+/**
+ * \brief           Invalidate runtime-policy roving pointer when its block leaves the free list
+ */
+#define LWMEM_NEXTFIT_FORGET(lwobj, block)                                                                             \
+    do {                                                                                                               \
+        if ((lwobj)->policy_rover == (block)) {                                                                        \
+            (lwobj)->policy_rover = &((lwobj)->start_block);                                                           \
+        }                                                                                                              \
+    } while (0)
+#else
+#define LWMEM_NEXTFIT_FORGET(lwobj, block)
+#endif /* LWMEM_NEXT_FIT_EN */
+
+#if LWMEM_BINS_EN
+
+/**
+ * \brief           Additional links for free blocks in segregated mode
+ *
+ * Structure is stored in (otherwise unused) user data area of every free block,
+ * right after block metadata. It is not part of block metadata for allocated blocks
+ */
+typedef struct {
+    lwmem_block_t* addr_prev; /*!< Previous free block on address-ordered linked list */
+    lwmem_block_t* bin_next;  /*!< Next free block in the same size-class bin */
+    lwmem_block_t* bin_prev;  /*!< Previous free block in the same size-class bin */
+} lwmem_block_links_t;
+
+/**
+ * \brief           Get links structure of a free block
+ * \param[in]       block: Free block to get links of
+ */
+#define LWMEM_BLOCK_LINKS(block) ((lwmem_block_links_t*)LWMEM_GET_PTR_FROM_BLOCK(block))
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Free block must be able to hold additional links in its user data area
+ */
+#define LWMEM_BLOCK_MIN_SIZE     (LWMEM_BLOCK_META_SIZE + LWMEM_ALIGN(sizeof(lwmem_block_links_t)))
+
+#elif LWMEM_BUDDY_EN
+
+/**
+ * \brief           Links for free blocks of buddy strategy
+ *
+ * Structure is stored in (otherwise unused) user data area of every free block,
+ * right after block metadata
+ */
+typedef struct {
+    lwmem_block_t* list_next; /*!< Next free block of the same order */
+    lwmem_block_t* list_prev; /*!< Previous free block of the same order */
+} lwmem_buddy_links_t;
+
+/**
+ * \brief           Get links structure of a free block
+ * \param[in]       block: Free block to get links of
+ */
+#define LWMEM_BUDDY_LINKS(block) ((lwmem_buddy_links_t*)LWMEM_GET_PTR_FROM_BLOCK(block))
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Free block must be able to hold links in its user data area
+ */
+#define LWMEM_BLOCK_MIN_SIZE     (LWMEM_BLOCK_META_SIZE + LWMEM_ALIGN(sizeof(lwmem_buddy_links_t)))
+
+#elif LWMEM_SO_EN
+
+/**
+ * \brief           Links of free blocks on the size-ordered list, stored in user data area
+ *
+ * Forward link lives in the block header `next` field, only the backward
+ * link needs user-area storage
+ */
+typedef struct {
+    lwmem_block_t* so_prev; /*!< Previous (smaller or equal) free block on the size-ordered list */
+} lwmem_so_links_t;
+
+/**
+ * \brief           Get size-ordered list links of a free block
+ */
+#define LWMEM_SO_LINKS(block) ((lwmem_so_links_t*)LWMEM_GET_PTR_FROM_BLOCK(block))
+
+/**
+ * \brief           Size of the boundary-tag footer at the end of every block
+ */
+#define LWMEM_SO_FOOTER_SIZE  LWMEM_ALIGN(sizeof(size_t))
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Block carries metadata header, backward list link and boundary-tag footer
+ */
+#define LWMEM_BLOCK_MIN_SIZE  (LWMEM_BLOCK_META_SIZE + LWMEM_ALIGN(sizeof(lwmem_so_links_t)) + LWMEM_SO_FOOTER_SIZE)
+
+#elif LWMEM_SKIP_EN
+
+/**
+ * \brief           Skip-list index tower, stored in user data area of every free block
+ */
+typedef struct {
+    struct lwmem_block* fwd[LWMEM_CFG_SKIP_INDEX_LEVELS]; /*!< Next indexed block per index level */
+    uint8_t level;                                        /*!< Number of levels this block participates in */
+} lwmem_skip_links_t;
+
+/**
+ * \brief           Get skip-list links structure of a free block
+ * \param[in]       block: Free block to get links of
+ */
+#define LWMEM_SKIP_LINKS(block) ((lwmem_skip_links_t*)LWMEM_GET_PTR_FROM_BLOCK(block))
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Free block must be able to hold skip-list tower in its user data area
+ */
+#define LWMEM_BLOCK_MIN_SIZE    (LWMEM_BLOCK_META_SIZE + LWMEM_ALIGN(sizeof(lwmem_skip_links_t)))
+
+#elif LWMEM_AUDIT_EN
+
+/**
+ * \brief           Audit stamp stored in user area of free blocks
+ */
+typedef struct {
+    size_t free_tick; /*!< Tick at which the block was freed */
+    size_t free_size; /*!< Block size at free time */
+} lwmem_audit_stamp_t;
+
+/**
+ * \brief           Get audit stamp of a free block
+ */
+#define LWMEM_AUDIT_STAMP(block) ((lwmem_audit_stamp_t*)LWMEM_GET_PTR_FROM_BLOCK(block))
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Free block must be able to hold the audit stamp in its user data area
+ */
+#define LWMEM_BLOCK_MIN_SIZE     (LWMEM_BLOCK_META_SIZE + LWMEM_ALIGN(sizeof(lwmem_audit_stamp_t)))
+
+#elif LWMEM_BT_EN
+
+/**
+ * \brief           Size of the boundary-tag footer at the end of every block
+ */
+#define LWMEM_BT_WORD        LWMEM_ALIGN(sizeof(size_t))
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Block must hold metadata header and its boundary-tag footer
+ */
+#define LWMEM_BLOCK_MIN_SIZE (LWMEM_BLOCK_META_SIZE + LWMEM_BT_WORD)
+
+#else /* LWMEM_SKIP_EN */
+
+/**
+ * \brief           Minimum amount of memory required to make new empty block
+ *
+ * Default size is size of meta block
+ */
+#define LWMEM_BLOCK_MIN_SIZE (LWMEM_BLOCK_META_SIZE)
+
+#endif /* !LWMEM_SKIP_EN */
+
+#if LWMEM_BT_EN
+/**
+ * \brief           Refresh boundary-tag footer from current block header
+ */
+#define LWMEM_BT_SET(block)                                                                                            \
+    (*(size_t*)(void*)(LWMEM_TO_BYTE_PTR(block) + ((block)->size & ~LWMEM_ALLOC_BIT) - LWMEM_BT_WORD) = (block)->size)
+
+/**
+ * \brief           Extra per-block bytes of the boundary-tag layout
+ */
+#define LWMEM_BT_EXTRA LWMEM_BT_WORD
+#else
+#define LWMEM_BT_SET(block)
+#define LWMEM_BT_EXTRA 0
+#endif /* LWMEM_BT_EN */
+
+#if LWMEM_SEGREGATED_EN
+
+/**
+ * \brief           Get size-class bin index for input size
+ *
+ * First bin holds blocks smaller than `32` bytes, each next bin doubles the size class.
+ * Last bin is catch-all bin for all blocks not fitting to previous bins
+ *
+ * \param[in]       size: Block size, including metadata part
+ * \return          Bin index between `0` and \ref LWMEM_CFG_SEGREGATED_BIN_COUNT - 1
+ */
+static size_t
+prv_get_bin_idx(size_t size) {
+    size_t idx = 0;
+
+    for (size >>= 5U; size > 0 && idx < (LWMEM_CFG_SEGREGATED_BIN_COUNT - 1); size >>= 1U) {
+        ++idx;
+    }
+    return idx;
+}
+
+#endif /* LWMEM_SEGREGATED_EN */
+
+#if LWMEM_TLSF_EN
+
+/**
+ * \brief           Number of second-level subdivisions for TLSF strategy
+ */
+#define LWMEM_TLSF_SL_COUNT    ((size_t)1 << LWMEM_CFG_TLSF_SL_COUNT_LOG2)
+
+/**
+ * \brief           Power of two below which all blocks map to first-level `0`
+ *
+ * Small classes are linearly subdivided by alignment granularity
+ */
+#define LWMEM_TLSF_SMALL_SHIFT (LWMEM_CFG_TLSF_SL_COUNT_LOG2 + 2)
+
+/**
+ * \brief           Get position of most significant set bit of input value
+ * \param[in]       val: Input value, must not be `0`
+ * \return          Zero-based bit position
+ */
+static size_t
+prv_msb_idx(size_t val) {
+    size_t idx = 0;
+
+    while ((val >>= 1U) > 0) {
+        ++idx;
+    }
+    return idx;
+}
+
+/**
+ * \brief           Get position of least significant set bit of input value
+ * \param[in]       val: Input value, must not be `0`
+ * \return          Zero-based bit position
+ */
+static size_t
+prv_lsb_idx(uint32_t val) {
+    size_t idx = 0;
+
+    while ((val & 0x01U) == 0) {
+        val >>= 1U;
+        ++idx;
+    }
+    return idx;
+}
+
+/**
+ * \brief           Map block size to TLSF first and second level indexes
+ * \param[in]       size: Block size, including metadata part
+ * \param[out]      fl: First level index output
+ * \param[out]      sl: Second level index output
+ */
+static void
+prv_tlsf_map(size_t size, size_t* fl, size_t* sl) {
+    if (size < ((size_t)1 << LWMEM_TLSF_SMALL_SHIFT)) {
+        *fl = 0;
+        *sl = size >> (LWMEM_TLSF_SMALL_SHIFT - LWMEM_CFG_TLSF_SL_COUNT_LOG2);
+    } else {
+        const size_t msb = prv_msb_idx(size);
+
+        *fl = msb - LWMEM_TLSF_SMALL_SHIFT + 1;
+        *sl = (size >> (msb - LWMEM_CFG_TLSF_SL_COUNT_LOG2)) - LWMEM_TLSF_SL_COUNT;
+        if (*fl >= LWMEM_CFG_TLSF_FL_COUNT) { /* Catch-all entry for all biggest blocks */
+            *fl = LWMEM_CFG_TLSF_FL_COUNT - 1;
+            *sl = LWMEM_TLSF_SL_COUNT - 1;
+        }
+    }
+}
+
+/**
+ * \brief           Get size-class bin index for input size
+ * \param[in]       size: Block size, including metadata part
+ * \return          Flattened index of first and second level TLSF mapping
+ */
+static size_t
+prv_get_bin_idx(size_t size) {
+    size_t fl = 0, sl = 0;
+
+    prv_tlsf_map(size, &fl, &sl);
+    return (fl << LWMEM_CFG_TLSF_SL_COUNT_LOG2) + sl;
+}
+
+#endif /* LWMEM_TLSF_EN */
+
+#if LWMEM_SKIP_EN
+
+/**
+ * \brief           Find skip-list predecessors of input address on every index level
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       addr: Address (block) to search predecessors for
+ * \param[out]      prevs: Optional array to store per-level predecessors. `NULL` entry means level head
+ * \return          Closest indexed block with address lower than input, `NULL` when there is none
+ */
+static lwmem_block_t*
+prv_skip_find_prevs(lwmem_t* const lwobj, const lwmem_block_t* addr, lwmem_block_t** prevs) {
+    lwmem_block_t* prev = NULL;
+
+    for (size_t lvl = LWMEM_CFG_SKIP_INDEX_LEVELS; lvl-- > 0;) {
+        lwmem_block_t* blk = prev == NULL ? lwobj->skip_head[lvl] : LWMEM_SKIP_LINKS(prev)->fwd[lvl];
+
+        while (blk != NULL && blk < addr) {
+            prev = blk;
+            blk = LWMEM_SKIP_LINKS(prev)->fwd[lvl];
+        }
+        if (prevs != NULL) {
+            prevs[lvl] = prev;
+        }
+    }
+    return prev;
+}
+
+/**
+ * \brief           Insert free block to the skip-list index
+ *
+ * Tower level is selected with deterministic counter, giving
+ * the same `1/2` per-level distribution as a random source
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Free block to index
+ */
+static void
+prv_skip_insert(lwmem_t* const lwobj, lwmem_block_t* block) {
+    lwmem_block_t* prevs[LWMEM_CFG_SKIP_INDEX_LEVELS];
+    lwmem_skip_links_t* links = LWMEM_SKIP_LINKS(block);
+    size_t level = 1;
+
+    prv_skip_find_prevs(lwobj, block, prevs);
+    for (++lwobj->skip_counter;
+         level < LWMEM_CFG_SKIP_INDEX_LEVELS && (lwobj->skip_counter & ((uint32_t)1 << (level - 1))) == 0; ++level) {}
+    links->level = (uint8_t)level;
+    for (size_t lvl = 0; lvl < level; ++lvl) {
+        if (prevs[lvl] == NULL) {
+            links->fwd[lvl] = lwobj->skip_head[lvl];
+            lwobj->skip_head[lvl] = block;
+        } else {
+            links->fwd[lvl] = LWMEM_SKIP_LINKS(prevs[lvl])->fwd[lvl];
+            LWMEM_SKIP_LINKS(prevs[lvl])->fwd[lvl] = block;
+        }
+    }
+    ++lwobj->free_block_count;
+}
+
+/**
+ * \brief           Remove free block from the skip-list index
+ *
+ * Must be called before block user data area is modified or moved,
+ * as index tower is stored inside it
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Free block to remove from index
+ */
+static void
+prv_skip_remove(lwmem_t* const lwobj, lwmem_block_t* block) {
+    lwmem_block_t* prevs[LWMEM_CFG_SKIP_INDEX_LEVELS];
+    lwmem_skip_links_t* links = LWMEM_SKIP_LINKS(block);
+
+    prv_skip_find_prevs(lwobj, block, prevs);
+    for (size_t lvl = 0; lvl < links->level; ++lvl) {
+        if (prevs[lvl] == NULL) {
+            if (lwobj->skip_head[lvl] == block) {
+                lwobj->skip_head[lvl] = links->fwd[lvl];
+            }
+        } else if (LWMEM_SKIP_LINKS(prevs[lvl])->fwd[lvl] == block) {
+            LWMEM_SKIP_LINKS(prevs[lvl])->fwd[lvl] = links->fwd[lvl];
+        }
+    }
+    --lwobj->free_block_count;
+}
+
+/**
+ * \brief           Get free-list block preceding input address, using skip-list index
+ *
+ * Index does not contain end of region indicators, therefore result
+ * is walked forward over (bounded number of) markers up to real predecessor
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       addr: Address (block) to search predecessor for
+ * \return          Free-list entry directly preceding input address
+ */
+static lwmem_block_t*
+prv_skip_find_list_prev(lwmem_t* const lwobj, const lwmem_block_t* addr) {
+    lwmem_block_t* prev = prv_skip_find_prevs(lwobj, addr, NULL);
+
+    if (prev == NULL) {
+        prev = &(lwobj->start_block);
+    }
+    while (prev->next != NULL && prev->next < addr) {
+        prev = prev->next;
+    }
+    return prev;
+}
+
+#endif /* LWMEM_SKIP_EN */
+
+#if LWMEM_BINS_EN
+
+/**
+ * \brief           Insert free block to the head of its size-class bin
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Free block to insert, with final size already set
+ */
+static void
+prv_bin_insert(lwmem_t* const lwobj, lwmem_block_t* block) {
+    const size_t idx = prv_get_bin_idx(block->size);
+    lwmem_block_links_t* links = LWMEM_BLOCK_LINKS(block);
+
+    links->bin_prev = NULL;
+    links->bin_next = lwobj->free_bins[idx];
+    if (links->bin_next != NULL) {
+        LWMEM_BLOCK_LINKS(links->bin_next)->bin_prev = block;
+    }
+    lwobj->free_bins[idx] = block;
+
+#if LWMEM_TLSF_EN
+    /* Mark first and second level as non-empty */
+    lwobj->sl_bitmap[idx >> LWMEM_CFG_TLSF_SL_COUNT_LOG2] |= (uint32_t)1 << (idx & (LWMEM_TLSF_SL_COUNT - 1));
+    lwobj->fl_bitmap |= (uint32_t)1 << (idx >> LWMEM_CFG_TLSF_SL_COUNT_LOG2);
+#endif /* LWMEM_TLSF_EN */
+}
+
+/**
+ * \brief           Remove free block from its size-class bin
+ *
+ * Must be called before block size or address is modified,
+ * as bin index is calculated from current block size
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Free block to remove from bin
+ */
+static void
+prv_bin_unlink(lwmem_t* const lwobj, lwmem_block_t* block) {
+    const size_t idx = prv_get_bin_idx(block->size);
+    lwmem_block_links_t* links = LWMEM_BLOCK_LINKS(block);
+
+    if (links->bin_prev != NULL) {
+        LWMEM_BLOCK_LINKS(links->bin_prev)->bin_next = links->bin_next;
+    } else {
+        lwobj->free_bins[idx] = links->bin_next;
+    }
+    if (links->bin_next != NULL) {
+        LWMEM_BLOCK_LINKS(links->bin_next)->bin_prev = links->bin_prev;
+    }
+
+#if LWMEM_TLSF_EN
+    /* Clear first and second level bits when respective lists are emptied */
+    if (lwobj->free_bins[idx] == NULL) {
+        const size_t fl = idx >> LWMEM_CFG_TLSF_SL_COUNT_LOG2;
+
+        lwobj->sl_bitmap[fl] &= ~((uint32_t)1 << (idx & (LWMEM_TLSF_SL_COUNT - 1)));
+        if (lwobj->sl_bitmap[fl] == 0) {
+            lwobj->fl_bitmap &= ~((uint32_t)1 << fl);
+        }
+    }
+#endif /* LWMEM_TLSF_EN */
+}
+
+/**
+ * \brief           Store address-ordered list previous block pointer to a free block
+ *
+ * Region end indicators (size `0`) have no user data area, therefore
+ * pointer is only written to regular free blocks
+ *
+ * \param[in]       block: Free block to write pointer to. May be `NULL` or end of region indicator
+ * \param[in]       prev: Previous block on address-ordered list
+ */
+static void
+prv_set_addr_prev(lwmem_block_t* block, lwmem_block_t* prev) {
+    if (block != NULL && block->size > 0) {
+        LWMEM_BLOCK_LINKS(block)->addr_prev = prev;
+    }
+}
+
+#endif /* LWMEM_BINS_EN */
+
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN && LWMEM_CFG_SUPPORT_REALLOC
+
+/**
+ * \brief           Gets block before input block (marked as prev) and its previous free block
+ * \param[in]       in_lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       in_b: Input block to find previous and its previous
+ * \param[in]       in_pp: Previous previous of input block. Finding will be stored here
+ * \param[in]       in_p: Previous of input block. Finding will be stored here
+ */
+static void
+prv_get_prev_curr_of_block(lwmem_t* in_lwobj, const lwmem_block_t* in_b, lwmem_block_t** in_pp, lwmem_block_t** in_p) {
+#if LWMEM_SKIP_EN
+    if (in_lwobj->free_block_count >= LWMEM_CFG_SKIP_INDEX_MIN_BLOCKS) {
+        lwmem_block_t *prev = prv_skip_find_list_prev(in_lwobj, in_b), *prevprev = NULL;
+
+        if (prev != &(in_lwobj)->start_block) {
+            /* Find predecessor of found predecessor, to match linear walk output */
+            for (prevprev = prv_skip_find_list_prev(in_lwobj, prev); prevprev->next != prev;
+                 prevprev = prevprev->next) {}
+        }
+        *in_pp = prevprev;
+        *in_p = prev;
+        return;
+    }
+#endif /* LWMEM_SKIP_EN */
+    for (*in_pp = NULL, *in_p = &((in_lwobj)->start_block); *in_p != NULL && (*in_p)->next < in_b;
+         *in_pp = (*in_p), *in_p = (*in_p)->next) {}
+}
+
+#endif /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN && LWMEM_CFG_SUPPORT_REALLOC */
+
+#if !LWMEM_COMPACT_EN && !LWMEM_OOB_EN
+
+/**
+ * \brief           Set block as allocated
+ * \param[in]       block: Block to set as allocated
+ */
+static void
+prv_block_set_alloc(lwmem_block_t* block) {
+    if (block != NULL) {
+        block->size |= LWMEM_ALLOC_BIT;
+        block->next = (void*)(LWMEM_TO_BYTE_PTR(0) + LWMEM_BLOCK_ALLOC_MARK);
+        LWMEM_BT_SET(block);
+        LWMEM_CHK_SET(block);
+    }
+}
+
+#endif /* !LWMEM_COMPACT_EN && !LWMEM_OOB_EN */
+
+/**
+ * \brief           Get region aligned start address and aligned size
+ * \param[in]       region: Region to check for size and address
+ * \param[out]      msa: Memory start address output variable
+ * \param[out]      msz: Memory size output variable
+ * \return          `1` if region valid, `0` otherwise
+ */
+static uint8_t
+prv_get_region_addr_size(const lwmem_region_t* region, uint8_t** msa, size_t* msz) {
+    size_t mem_size = 0;
+    uint8_t* mem_start_addr = NULL;
+
+    if (region == NULL || msa == NULL || msz == NULL) {
+        return 0;
+    }
+    *msa = NULL;
+    *msz = 0;
+
+    /*
+     * Start address must be aligned to configuration
+     * Increase start address and decrease effective region size
+     */
+    mem_start_addr = region->start_addr;
+    mem_size = region->size;
+    if (((size_t)mem_start_addr) & ((size_t)LWMEM_CFG_BLOCK_START_ALIGN - 1)) { /* Check alignment boundary */
+        mem_start_addr += ((size_t)LWMEM_CFG_BLOCK_START_ALIGN)
+                          - ((size_t)mem_start_addr & ((size_t)LWMEM_CFG_BLOCK_START_ALIGN - 1));
+        mem_size -= (size_t)(mem_start_addr - LWMEM_TO_BYTE_PTR(region->start_addr));
+    }
+
+    /* Check region size and align it to config bits */
+    mem_size &= ~LWMEM_ALIGN_BITS; /* Align the size to lower bits */
+    if (mem_size < (2 * LWMEM_BLOCK_MIN_SIZE)) {
+        return 0;
+    }
+
+    /* Check final memory size */
+    if (mem_size >= (2 * LWMEM_BLOCK_MIN_SIZE)) {
+        *msa = mem_start_addr;
+        *msz = mem_size;
+
+        return 1;
+    }
+    return 0;
+}
+
+
+#if LWMEM_COMPACT_EN
+
+/**
+ * \brief           Offset type of compact headers
+ *
+ * 16-bit by default, widened to 32 bits with \ref LWMEM_CFG_COMPACT_HEADER_32
+ * for identical 8-byte headers across 32-bit and 64-bit builds
+ */
+#if LWMEM_CFG_COMPACT_HEADER_32
+typedef uint32_t lwmem_compact_off_t;
+#else
+typedef uint16_t lwmem_compact_off_t;
+#endif /* LWMEM_CFG_COMPACT_HEADER_32 */
+
+/**
+ * \brief           Compact memory block structure, stored as offsets from region base
+ */
+typedef struct {
+    lwmem_compact_off_t next; /*!< Offset of next free block. Set to \ref LWMEM_COMPACT_ALLOC_MARK when block is allocated */
+    lwmem_compact_off_t size; /*!< Size of block, including metadata part. MSB bit set to `1` when block is allocated */
+} lwmem_compact_block_t;
+
+/**
+ * \brief           Size of compact metadata header for block information
+ */
+#define LWMEM_COMPACT_META_SIZE     LWMEM_ALIGN(sizeof(lwmem_compact_block_t))
+
+/**
+ * \brief           Bit indicating compact memory block is allocated
+ */
+#define LWMEM_COMPACT_ALLOC_BIT                                                                                        \
+    ((lwmem_compact_off_t)((lwmem_compact_off_t)1 << (sizeof(lwmem_compact_off_t) * CHAR_BIT - 1)))
+
+/**
+ * \brief           Mark written in `next` field when compact block is allocated
+ */
+#define LWMEM_COMPACT_ALLOC_MARK    ((lwmem_compact_off_t)0xDEADU)
+
+/**
+ * \brief           Offset value indicating end of free list
+ */
+#define LWMEM_COMPACT_NO_OFFS       ((lwmem_compact_off_t)~(lwmem_compact_off_t)0)
+
+/**
+ * \brief           Get compact block from its offset
+ */
+#define LWMEM_COMPACT_BLOCK(lwobj, offs) ((lwmem_compact_block_t*)(void*)((lwobj)->compact_base + (offs)))
+
+/**
+ * \brief           Get offset of compact block from region base
+ */
+#define LWMEM_COMPACT_OFFS(lwobj, block)                                                                               \
+    ((lwmem_compact_off_t)(LWMEM_TO_BYTE_PTR(block) - (lwobj)->compact_base))
+
+/**
+ * \brief           Check if input compact block is properly allocated and valid
+ */
+#define LWMEM_COMPACT_IS_ALLOC(block)                                                                                  \
+    ((block) != NULL && ((block)->size & LWMEM_COMPACT_ALLOC_BIT) > 0 && (block)->next == LWMEM_COMPACT_ALLOC_MARK)
+
+/**
+ * \brief           Insert free compact block to offset-ordered list and merge with neighbors
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       nblk: New free block to insert, with size already set
+ */
+static void
+prv_compact_insert(lwmem_t* const lwobj, lwmem_compact_block_t* nblk) {
+    lwmem_compact_off_t noffs = LWMEM_COMPACT_OFFS(lwobj, nblk);
+    lwmem_compact_off_t* link = &(lwobj->compact_free_offs);
+    lwmem_compact_block_t* prev = NULL;
+
+    /* Find insert position, list is ordered by increasing offsets */
+    while (*link != LWMEM_COMPACT_NO_OFFS && *link < noffs) {
+        prev = LWMEM_COMPACT_BLOCK(lwobj, *link);
+        link = &(prev->next);
+    }
+
+    /* Merge with previous block when they create contiguous memory */
+    if (prev != NULL && (lwmem_compact_off_t)(LWMEM_COMPACT_OFFS(lwobj, prev) + prev->size) == noffs) {
+        prev->size += nblk->size;
+        nblk = prev;
+        noffs = LWMEM_COMPACT_OFFS(lwobj, prev);
+    } else {
+        nblk->next = *link;
+        *link = noffs;
+    }
+
+    /* Merge with next block, but never with end of region indicator (size = 0) */
+    if (nblk->next != LWMEM_COMPACT_NO_OFFS) {
+        lwmem_compact_block_t* next_blk = LWMEM_COMPACT_BLOCK(lwobj, nblk->next);
+
+        if (next_blk->size > 0 && (lwmem_compact_off_t)(noffs + nblk->size) == nblk->next) {
+            nblk->size += next_blk->size;
+            nblk->next = next_blk->next;
+        }
+    }
+}
+
+/**
+ * \brief           Private allocation function for compact header mode
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Not used in compact header mode, kept for signature compatibility
+ * \param[in]       size: Application wanted size, excluding size of meta header
+ * \return          Pointer to allocated memory, `NULL` otherwise
+ */
+static void* LWMEM_HOT_FN_ATTR
+prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+    lwmem_compact_block_t* blk = NULL;
+    lwmem_compact_off_t* link = NULL;
+    const size_t final_size = LWMEM_ALIGN(size) + LWMEM_COMPACT_META_SIZE;
+
+    /* Check if initialized and if size is in the limits of 15-bit value */
+    if (lwobj->compact_base == NULL || final_size == LWMEM_COMPACT_META_SIZE
+        || final_size >= LWMEM_COMPACT_ALLOC_BIT) {
+        return NULL;
+    }
+    LWMEM_FAULT_CHECK(lwobj, size);
+
+    /* First-fit walk over offset-ordered free list */
+    for (link = &(lwobj->compact_free_offs); *link != LWMEM_COMPACT_NO_OFFS; link = &(blk->next)) {
+        blk = LWMEM_COMPACT_BLOCK(lwobj, *link);
+        if (blk->size >= final_size) {
+            break;
+        }
+    }
+    if (*link == LWMEM_COMPACT_NO_OFFS) {
+        return NULL; /* No sufficient memory available to allocate block of memory */
+    }
+
+    /* Create new empty block at the end of current one when split is possible */
+    if ((size_t)(blk->size - final_size) >= LWMEM_COMPACT_META_SIZE) {
+        lwmem_compact_block_t* next_blk = (void*)(LWMEM_TO_BYTE_PTR(blk) + final_size);
+
+        next_blk->size = blk->size - (uint16_t)final_size;
+        next_blk->next = blk->next;
+        blk->size = (uint16_t)final_size;
+        *link = LWMEM_COMPACT_OFFS(lwobj, next_blk);
+    } else {
+        *link = blk->next; /* Remove block from free list */
+    }
+
+    lwobj->mem_available_bytes -= blk->size; /* Decrease available bytes by allocated block size */
+    blk->size |= LWMEM_COMPACT_ALLOC_BIT;
+    blk->next = LWMEM_COMPACT_ALLOC_MARK;
+
+    LWMEM_UPDATE_MIN_FREE(lwobj);
+    LWMEM_STATS_CNT_ALLOC(lwobj);
+
+    (void)region; /* Only single region is supported in compact header mode */
+    return (void*)(LWMEM_TO_BYTE_PTR(blk) + LWMEM_COMPACT_META_SIZE);
+}
+
+/**
+ * \brief           Free input pointer in compact header mode
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Input pointer to free
+ */
+static void LWMEM_HOT_FN_ATTR
+prv_free(lwmem_t* const lwobj, void* const ptr) {
+    LWMEM_EVICTABLE_FORGET(lwobj, ptr); /* Every free path drops the block from the eviction registry */
+    lwmem_compact_block_t* blk =
+        ptr != NULL ? (void*)(LWMEM_TO_BYTE_PTR(ptr) - LWMEM_COMPACT_META_SIZE) : NULL;
+
+    if (LWMEM_COMPACT_IS_ALLOC(blk)) {          /* Check if block is valid */
+        blk->size &= ~LWMEM_COMPACT_ALLOC_BIT;  /* Clear allocated bit indication */
+
+        lwobj->mem_available_bytes += blk->size; /* Increase available bytes */
+#if LWMEM_CFG_CLEAN_MEMORY
+        LWMEM_MEMSET(ptr, 0x00, blk->size - LWMEM_COMPACT_META_SIZE);
+#endif /* LWMEM_CFG_CLEAN_MEMORY */
+        prv_compact_insert(lwobj, blk); /* Put block back to list of free blocks */
+
+        LWMEM_STATS_CNT_FREE(lwobj);
+    }
+}
+
+#if LWMEM_CFG_SUPPORT_REALLOC
+
+/**
+ * \brief           Reallocates already allocated memory with new size in compact header mode
+ *
+ * Shrink requests are served in place, any grow request allocates
+ * new block, copies content and frees old block
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Not used in compact header mode, kept for signature compatibility
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \param[in]       allow_move: Set to `1` to allow allocation of new block with content copy
+ * \param[in]       preserve: Set to `1` to copy existing content on any block relocation,
+ *                      or `0` when caller regenerates the content anyway
+ *                      when block cannot be grown in place, or `0` to fail cleanly instead
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+static void*
+prv_realloc(lwmem_t* const lwobj, const lwmem_region_t* region, void* const ptr, const size_t size,
+            const uint8_t allow_move, const uint8_t preserve) {
+    lwmem_compact_block_t* blk;
+    const size_t final_size = LWMEM_ALIGN(size) + LWMEM_COMPACT_META_SIZE;
+    size_t block_size;
+    void* retval;
+
+    /* Check optional input parameters */
+    if (size == 0) {
+        if (ptr != NULL) {
+            prv_free(lwobj, ptr);
+        }
+        return NULL;
+    }
+    if (ptr == NULL) {
+        return prv_alloc(lwobj, region, size);
+    }
+    if (final_size >= LWMEM_COMPACT_ALLOC_BIT) {
+        return NULL;
+    }
+
+    /* Process existing block */
+    blk = (void*)(LWMEM_TO_BYTE_PTR(ptr) - LWMEM_COMPACT_META_SIZE);
+    if (!LWMEM_COMPACT_IS_ALLOC(blk)) {
+        return NULL; /* Hard error. Input pointer is not NULL and block is not considered allocated */
+    }
+    block_size = blk->size & ~LWMEM_COMPACT_ALLOC_BIT;
+
+    /* Shrink (or equal size) is served in place, with split when new empty block can be created */
+    if (final_size <= block_size) {
+        if ((block_size - final_size) >= LWMEM_COMPACT_META_SIZE) {
+            lwmem_compact_block_t* next_blk = (void*)(LWMEM_TO_BYTE_PTR(blk) + final_size);
+
+            next_blk->size = (uint16_t)(block_size - final_size);
+            blk->size = (uint16_t)final_size | LWMEM_COMPACT_ALLOC_BIT;
+
+            lwobj->mem_available_bytes += next_blk->size;
+            prv_compact_insert(lwobj, next_blk);
+        }
+        return ptr;
+    }
+    if (!allow_move) {
+        return NULL; /* Caller accepts in-place operations only */
+    }
+
+    /* Grow allocates new block and copies existing content */
+    retval = prv_alloc(lwobj, region, size);
+    if (retval != NULL) {
+        if (preserve) {
+            LWMEM_MEMCPY(retval, ptr, block_size - LWMEM_COMPACT_META_SIZE);
+        }
+        prv_free(lwobj, ptr);
+    }
+    return retval;
+}
+
+#endif /* LWMEM_CFG_SUPPORT_REALLOC */
+
+/**
+ * \brief           Assign the memory structure for compact header mode
+ *
+ * First valid region is used, of up to `64` kB of memory.
+ * Larger region is truncated to addressable range of 16-bit offsets
+ *
+ * \param           lwobj: LwMEM object
+ * \param           regions: List of regions, only first valid entry is used
+ * \return          Number of regions used
+ */
+static size_t
+prv_assignmem(lwmem_t* lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    lwmem_compact_block_t *first_block = NULL, *end_block = NULL;
+
+    for (; regions->size > 0 && regions->start_addr != NULL; ++regions) {
+        if (prv_get_region_addr_size(regions, &mem_start_addr, &mem_size)) {
+            break; /* Use first valid region */
+        }
+    }
+    if (mem_start_addr == NULL) {
+        return 0;
+    }
+
+    /* Limit region to the range addressable with 16-bit offsets */
+    if (mem_size > (size_t)(LWMEM_COMPACT_NO_OFFS & ~LWMEM_ALIGN_BITS)) {
+        mem_size = (size_t)(LWMEM_COMPACT_NO_OFFS & ~LWMEM_ALIGN_BITS);
+    }
+    lwobj->compact_base = mem_start_addr;
+
+    /* Put end of region indicator to the very end with size = 0 */
+    end_block = (void*)(mem_start_addr + mem_size - LWMEM_COMPACT_META_SIZE);
+    end_block->next = LWMEM_COMPACT_NO_OFFS;
+    end_block->size = 0;
+
+    /* Remaining memory is one free block, linked to end of region indicator */
+    first_block = (void*)mem_start_addr;
+    first_block->size = (lwmem_compact_off_t)(mem_size - LWMEM_COMPACT_META_SIZE);
+    first_block->next = LWMEM_COMPACT_OFFS(lwobj, end_block);
+    lwobj->compact_free_offs = 0;
+
+    lwobj->mem_available_bytes = first_block->size;
+    lwobj->mem_regions_count = 1;
+
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes = lwobj->mem_available_bytes;
+    lwobj->stats.minimum_ever_mem_available_bytes = lwobj->mem_available_bytes;
+#endif /* LWMEM_CFG_ENABLE_STATS */
+
+    return lwobj->mem_regions_count; /* Return number of regions used by manager */
+}
+
+#elif LWMEM_OOB_EN
+
+/**
+ * \brief           Side table entry describing one allocated block
+ */
+typedef struct {
+    uint32_t offset; /*!< Block offset in the user data area */
+    uint32_t size;   /*!< Block size in units of bytes */
+} lwmem_oob_entry_t;
+
+/**
+ * \brief           Get typed side table of the instance
+ */
+#define LWMEM_OOB_TABLE(lwobj) ((lwmem_oob_entry_t*)(lwobj)->oob_table)
+
+/**
+ * \brief           Find table index of entry with exact offset, or insertion position
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       offset: Offset to search for
+ * \param[out]      found: Set to `1` when exact entry exists
+ * \return          Entry index (or position where it would be inserted)
+ */
+static uint32_t
+prv_oob_find(const lwmem_t* lwobj, uint32_t offset, uint8_t* found) {
+    const lwmem_oob_entry_t* table = LWMEM_OOB_TABLE(lwobj);
+    uint32_t low = 0, high = lwobj->oob_count;
+
+    while (low < high) {
+        uint32_t mid = (low + high) / 2;
+
+        if (table[mid].offset < offset) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    *found = low < lwobj->oob_count && table[low].offset == offset;
+    return low;
+}
+
+/**
+ * \brief           Private allocation function for out-of-band metadata engine
+ *
+ * First-fit scan over gaps between consecutive entries of the dense,
+ * offset-sorted side table. User data area itself is never touched
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Not used in this engine, kept for signature compatibility
+ * \param[in]       size: Application wanted size
+ * \return          Pointer to allocated memory, `NULL` otherwise
+ */
+static void* LWMEM_HOT_FN_ATTR
+prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+    lwmem_oob_entry_t* table = LWMEM_OOB_TABLE(lwobj);
+    const size_t final_size = LWMEM_ALIGN(size);
+    size_t prev_end = 0;
+    uint32_t idx;
+
+    if (lwobj->oob_base == NULL || size == 0 || final_size > lwobj->oob_data_size
+        || lwobj->oob_count >= lwobj->oob_capacity) {
+        return NULL;
+    }
+    LWMEM_FAULT_CHECK(lwobj, size);
+
+    /* First fitting gap between entries (or before first / after last) takes the block */
+    for (idx = 0; idx < lwobj->oob_count; ++idx) {
+        if ((table[idx].offset - prev_end) >= final_size) {
+            break;
+        }
+        prev_end = table[idx].offset + table[idx].size;
+    }
+    if (idx >= lwobj->oob_count && (lwobj->oob_data_size - prev_end) < final_size) {
+        return NULL; /* No sufficient memory available to allocate block of memory */
+    }
+
+    /* Keep table dense and sorted */
+    for (uint32_t move = lwobj->oob_count; move > idx; --move) {
+        table[move] = table[move - 1];
+    }
+    table[idx].offset = (uint32_t)prev_end;
+    table[idx].size = (uint32_t)final_size;
+    ++lwobj->oob_count;
+
+    lwobj->mem_available_bytes -= final_size;
+    LWMEM_UPDATE_MIN_FREE(lwobj);
+    LWMEM_STATS_CNT_ALLOC(lwobj);
+
+    (void)region; /* Only single region is supported in this engine */
+    return lwobj->oob_base + prev_end;
+}
+
+/**
+ * \brief           Free input pointer in out-of-band metadata engine
+ *
+ * Invalid and double frees are rejected inherently, as only table
+ * entries with the exact offset are removable
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Input pointer to free
+ */
+static void LWMEM_HOT_FN_ATTR
+prv_free(lwmem_t* const lwobj, void* const ptr) {
+    LWMEM_EVICTABLE_FORGET(lwobj, ptr); /* Every free path drops the block from the eviction registry */
+    lwmem_oob_entry_t* table = LWMEM_OOB_TABLE(lwobj);
+    uint8_t found = 0;
+    uint32_t idx;
+
+    if (ptr == NULL || LWMEM_TO_BYTE_PTR(ptr) < lwobj->oob_base
+        || LWMEM_TO_BYTE_PTR(ptr) >= (lwobj->oob_base + lwobj->oob_data_size)) {
+        return;
+    }
+    idx = prv_oob_find(lwobj, (uint32_t)(LWMEM_TO_BYTE_PTR(ptr) - lwobj->oob_base), &found);
+    if (found) {
+        lwobj->mem_available_bytes += table[idx].size;
+#if LWMEM_CFG_CLEAN_MEMORY
+        LWMEM_MEMSET(ptr, 0x00, table[idx].size);
+#endif /* LWMEM_CFG_CLEAN_MEMORY */
+        for (uint32_t move = idx; (move + 1) < lwobj->oob_count; ++move) {
+            table[move] = table[move + 1];
+        }
+        --lwobj->oob_count;
+        LWMEM_STATS_CNT_FREE(lwobj);
+    }
+}
+
+/*
+ * Note: kept compiled even without LWMEM_CFG_SUPPORT_REALLOC,
+ * as the in-place shrink path of this engine builds on it
+ */
+
+/**
+ * \brief           Reallocates already allocated memory with new size in out-of-band metadata engine
+ *
+ * Shrink and growth into the following gap are served in place,
+ * any other growth allocates a new block and copies content
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Not used in this engine, kept for signature compatibility
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \param[in]       allow_move: Set to `1` to allow allocation of new block with content copy
+ * \param[in]       preserve: Set to `1` to copy existing content on any block relocation,
+ *                      or `0` when caller regenerates the content anyway
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+static void*
+prv_realloc(lwmem_t* const lwobj, const lwmem_region_t* region, void* const ptr, const size_t size,
+            const uint8_t allow_move, const uint8_t preserve) {
+    lwmem_oob_entry_t* table = LWMEM_OOB_TABLE(lwobj);
+    const size_t final_size = LWMEM_ALIGN(size);
+    size_t gap_end;
+    uint8_t found = 0;
+    uint32_t idx;
+    void* retval;
+
+    if (size == 0) {
+        if (ptr != NULL) {
+            prv_free(lwobj, ptr);
+        }
+        return NULL;
+    }
+    if (ptr == NULL) {
+        return prv_alloc(lwobj, region, size);
+    }
+    idx = prv_oob_find(lwobj, (uint32_t)(LWMEM_TO_BYTE_PTR(ptr) - lwobj->oob_base), &found);
+    if (!found) {
+        return NULL; /* Hard error. Input pointer is not a live allocation */
+    }
+
+    /* In-place when new size fits to own extent plus the gap up to the next entry */
+    gap_end = (idx + 1) < lwobj->oob_count ? table[idx + 1].offset : lwobj->oob_data_size;
+    if (final_size <= (gap_end - table[idx].offset)) {
+        lwobj->mem_available_bytes += table[idx].size;
+        lwobj->mem_available_bytes -= final_size;
+        LWMEM_UPDATE_MIN_FREE(lwobj);
+        table[idx].size = (uint32_t)final_size;
+        return ptr;
+    }
+    if (!allow_move) {
+        return NULL; /* Caller accepts in-place operations only */
+    }
+
+    /* Allocate new block and copy content. Table entry index
+       is stale after the allocation inserts a new entry, so keep size first */
+    {
+        const size_t old_size = table[idx].size;
+
+        retval = prv_alloc(lwobj, region, size);
+        if (retval != NULL) {
+            if (preserve) {
+                LWMEM_MEMCPY(retval, ptr, old_size < size ? old_size : size);
+            }
+            prv_free(lwobj, ptr);
+        }
+    }
+    return retval;
+}
+
+/**
+ * \brief           Assign the memory structure for out-of-band metadata engine
+ *
+ * Side table capacity is reserved at the region head up front,
+ * remaining memory forms the contiguous user data area
+ *
+ * \param           lwobj: LwMEM object
+ * \param           regions: List of regions, only first valid entry is used
+ * \return          Number of regions used
+ */
+static size_t
+prv_assignmem(lwmem_t* lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, capacity, table_bytes;
+
+    for (; regions->size > 0 && regions->start_addr != NULL; ++regions) {
+        if (prv_get_region_addr_size(regions, &mem_start_addr, &mem_size)) {
+            break; /* Use first valid region */
+        }
+    }
+    if (mem_start_addr == NULL) {
+        return 0;
+    }
+
+    capacity = LWMEM_CFG_OOB_MAX_BLOCKS > 0 ? (size_t)LWMEM_CFG_OOB_MAX_BLOCKS : (mem_size / 128);
+    table_bytes = LWMEM_ALIGN(capacity * sizeof(lwmem_oob_entry_t));
+    if (capacity == 0 || mem_size <= (table_bytes + LWMEM_CFG_ALIGN_NUM)) {
+        return 0;
+    }
+
+    lwobj->oob_table = mem_start_addr;
+    lwobj->oob_capacity = (uint32_t)capacity;
+    lwobj->oob_count = 0;
+    lwobj->oob_base = mem_start_addr + table_bytes;
+    lwobj->oob_data_size = mem_size - table_bytes;
+    lwobj->mem_available_bytes = lwobj->oob_data_size;
+    lwobj->mem_regions_count = 1;
+
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes = lwobj->mem_available_bytes;
+    lwobj->stats.minimum_ever_mem_available_bytes = lwobj->mem_available_bytes;
+#endif /* LWMEM_CFG_ENABLE_STATS */
+
+    return lwobj->mem_regions_count; /* Return number of regions used by manager */
+}
+
+#elif LWMEM_SO_EN
+
+/**
+ * \brief           Refresh boundary-tag footer from current block header
+ * \param[in]       block: Block to refresh footer of (size field must be final, flag included)
+ */
+static void
+prv_so_footer_set(lwmem_block_t* block) {
+    *(size_t*)(void*)(LWMEM_TO_BYTE_PTR(block) + (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_SO_FOOTER_SIZE) =
+        block->size;
+}
+
+/**
+ * \brief           Insert free block into the ascending size-ordered list
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Free block with final size (footer already refreshed)
+ */
+static void
+prv_so_insert(lwmem_t* const lwobj, lwmem_block_t* block) {
+    lwmem_block_t *prev = NULL, *curr = lwobj->so_head;
+
+    while (curr != NULL && curr->size < block->size) {
+        prev = curr;
+        curr = curr->next;
+    }
+    block->next = curr;
+    LWMEM_SO_LINKS(block)->so_prev = prev;
+    if (curr != NULL) {
+        LWMEM_SO_LINKS(curr)->so_prev = block;
+    }
+    if (prev != NULL) {
+        prev->next = block;
+    } else {
+        lwobj->so_head = block;
+    }
+}
+
+/**
+ * \brief           Remove free block from the size-ordered list in constant time
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Free block currently on the list
+ */
+static void
+prv_so_remove(lwmem_t* const lwobj, lwmem_block_t* block) {
+    lwmem_block_t* prev = LWMEM_SO_LINKS(block)->so_prev;
+
+    if (prev != NULL) {
+        prev->next = block->next;
+    } else {
+        lwobj->so_head = block->next;
+    }
+    if (block->next != NULL) {
+        LWMEM_SO_LINKS(block->next)->so_prev = prev;
+    }
+}
+
+/**
+ * \brief           Private allocation function for size-ordered list engine
+ *
+ * List ascends by size, therefore the first fitting block is the best fit
+ * and the walk terminates early for small requests
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from. Set to `NULL` for any region
+ * \param[in]       size: Application wanted size, excluding size of meta header
+ * \return          Pointer to allocated memory, `NULL` otherwise
+ */
+static void*
+prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+    lwmem_block_t* curr;
+    size_t final_size = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE + LWMEM_SO_FOOTER_SIZE;
+    uint8_t* region_start_addr = NULL;
+    size_t region_size = 0;
+
+    if (LWMEM_UNLIKELY(lwobj->end_block == NULL || size == 0 || (final_size & LWMEM_ALLOC_BIT) > 0)) {
+        return NULL;
+    }
+    LWMEM_FAULT_CHECK(lwobj, size);
+    if (final_size < LWMEM_BLOCK_MIN_SIZE) {
+        final_size = LWMEM_BLOCK_MIN_SIZE; /* Freed block must hold its list link again */
+    }
+    if (region != NULL && !prv_get_region_addr_size(region, &region_start_addr, &region_size)) {
+        return NULL;
+    }
+
+    /* First fit on the ascending list is the best fit */
+    for (curr = lwobj->so_head; curr != NULL; curr = curr->next) {
+        if (curr->size < final_size) {
+            continue;
+        }
+        if (region_start_addr != NULL
+            && (LWMEM_TO_BYTE_PTR(curr) < region_start_addr
+                || LWMEM_TO_BYTE_PTR(curr) >= (region_start_addr + region_size))) {
+            continue; /* Block belongs to another region */
+        }
+        break;
+    }
+    if (curr == NULL) {
+        return NULL; /* No sufficient memory available to allocate block of memory */
+    }
+    prv_so_remove(lwobj, curr);
+
+    /* Split leftover back to the list when big enough */
+    if ((curr->size - final_size) >= LWMEM_BLOCK_MIN_SIZE) {
+        lwmem_block_t* leftover = (void*)(LWMEM_TO_BYTE_PTR(curr) + final_size);
+
+        leftover->size = curr->size - final_size;
+        prv_so_footer_set(leftover);
+        prv_so_insert(lwobj, leftover);
+        curr->size = final_size;
+        lwobj->mem_available_bytes -= final_size;
+    } else {
+        lwobj->mem_available_bytes -= curr->size;
+    }
+    prv_block_set_alloc(curr);
+    prv_so_footer_set(curr);
+
+    LWMEM_UPDATE_MIN_FREE(lwobj);
+    LWMEM_STATS_CNT_ALLOC(lwobj);
+    LWMEM_WATERMARK_CHECK(lwobj);
+    return LWMEM_GET_PTR_FROM_BLOCK(curr);
+}
+
+/**
+ * \brief           Free input pointer with boundary-tag coalescing
+ *
+ * Physical neighbors are located through the footers (backward) and the size
+ * field (forward), so no address-ordered walk exists: free is the merge work
+ * plus one size-ordered insertion
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Input pointer to free
+ */
+static void
+prv_free(lwmem_t* const lwobj, void* const ptr) {
+    LWMEM_EVICTABLE_FORGET(lwobj, ptr); /* Every free path drops the block from the eviction registry */
+    lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    size_t prev_footer;
+
+    if (!LWMEM_BLOCK_IS_ALLOC(block)) { /* Check if block is valid */
+        return;
+    }
+    block->size &= ~LWMEM_ALLOC_BIT;
+    lwobj->mem_available_bytes += block->size;
+#if LWMEM_CFG_CLEAN_MEMORY
+    LWMEM_MEMSET(ptr, 0x00, block->size - LWMEM_BLOCK_META_SIZE - LWMEM_SO_FOOTER_SIZE);
+#endif /* LWMEM_CFG_CLEAN_MEMORY */
+
+    /* Backward merge: footer of the physical predecessor sits right below the header */
+    prev_footer = *(size_t*)(void*)(LWMEM_TO_BYTE_PTR(block) - LWMEM_SO_FOOTER_SIZE);
+    if ((prev_footer & LWMEM_ALLOC_BIT) == 0) {
+        lwmem_block_t* prev_block = (void*)(LWMEM_TO_BYTE_PTR(block) - prev_footer);
+
+        prv_so_remove(lwobj, prev_block);
+        prev_block->size += block->size;
+        block = prev_block;
+    }
+
+    /* Forward merge: next physical block, end of region indicators have size 0 */
+    {
+        lwmem_block_t* next_block = (void*)(LWMEM_TO_BYTE_PTR(block) + block->size);
+
+        if (next_block->size > 0 && (next_block->size & LWMEM_ALLOC_BIT) == 0) {
+            prv_so_remove(lwobj, next_block);
+            block->size += next_block->size;
+        }
+    }
+
+    prv_so_footer_set(block);
+    prv_so_insert(lwobj, block);
+    LWMEM_STATS_CNT_FREE(lwobj);
+    LWMEM_WATERMARK_CHECK(lwobj);
+}
+
+#if LWMEM_CFG_SUPPORT_REALLOC
+
+/**
+ * \brief           Reallocates already allocated memory with new size in size-ordered list engine
+ *
+ * Same-capacity requests return the input pointer, anything else
+ * allocates a new block and copies content
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from. Set to `NULL` for any region
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \param[in]       allow_move: Set to `1` to allow allocation of new block with content copy
+ * \param[in]       preserve: Set to `1` to copy existing content on any block relocation,
+ *                      or `0` when caller regenerates the content anyway
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+static void*
+prv_realloc(lwmem_t* const lwobj, const lwmem_region_t* region, void* const ptr, const size_t size,
+            const uint8_t allow_move, const uint8_t preserve) {
+    lwmem_block_t* block;
+    size_t block_size, final_size = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE + LWMEM_SO_FOOTER_SIZE;
+    void* retval;
+
+    if (size == 0) {
+        if (ptr != NULL) {
+            prv_free(lwobj, ptr);
+        }
+        return NULL;
+    }
+    if (ptr == NULL) {
+        return prv_alloc(lwobj, region, size);
+    }
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (!LWMEM_BLOCK_IS_ALLOC(block)) {
+        return NULL; /* Hard error. Input pointer is not NULL and block is not considered allocated */
+    }
+    block_size = block->size & ~LWMEM_ALLOC_BIT;
+    if (final_size <= block_size) {
+        return ptr; /* Existing capacity serves the request */
+    }
+    if (!allow_move) {
+        return NULL; /* Caller accepts in-place operations only */
+    }
+
+    retval = prv_alloc(lwobj, region, size);
+    if (retval != NULL) {
+        if (preserve) {
+            LWMEM_MEMCPY(retval, ptr, block_size - LWMEM_BLOCK_META_SIZE - LWMEM_SO_FOOTER_SIZE);
+        }
+        prv_free(lwobj, ptr);
+    }
+    return retval;
+}
+
+#endif /* LWMEM_CFG_SUPPORT_REALLOC */
+
+/**
+ * \brief           Assign the memory structure for size-ordered list engine
+ *
+ * Every region starts with an allocated-marked sentinel footer (so backward
+ * merging never reads below the region) and ends with the regular
+ * end of region indicator
+ *
+ * \param           lwobj: LwMEM object
+ * \param           regions: List of regions with address and respective size
+ * \return          Number of regions used
+ */
+static size_t
+prv_assignmem(lwmem_t* lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    for (; regions->size > 0 && regions->start_addr != NULL; ++regions) {
+        lwmem_block_t* first_block;
+        lwmem_block_t* region_end_block;
+
+        if (!prv_get_region_addr_size(regions, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        if (mem_size < (LWMEM_SO_FOOTER_SIZE + LWMEM_BLOCK_MIN_SIZE + LWMEM_BLOCK_META_SIZE)) {
+            continue;
+        }
+
+        /* Region-start sentinel reads as allocated footer, blocking backward merge */
+        *(size_t*)(void*)mem_start_addr = LWMEM_ALLOC_BIT | LWMEM_SO_FOOTER_SIZE;
+
+        region_end_block = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
+        region_end_block->next = NULL;
+        region_end_block->size = 0;
+
+        first_block = (void*)(mem_start_addr + LWMEM_SO_FOOTER_SIZE);
+        first_block->size = mem_size - LWMEM_SO_FOOTER_SIZE - LWMEM_BLOCK_META_SIZE;
+        prv_so_footer_set(first_block);
+        prv_so_insert(lwobj, first_block);
+
+        lwobj->end_block = region_end_block; /* Doubles as initialization marker */
+        lwobj->mem_available_bytes += first_block->size;
+        ++lwobj->mem_regions_count;
+    }
+
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes = lwobj->mem_available_bytes;
+    lwobj->stats.minimum_ever_mem_available_bytes = lwobj->mem_available_bytes;
+#endif /* LWMEM_CFG_ENABLE_STATS */
+
+    return lwobj->mem_regions_count; /* Return number of regions used by manager */
+}
+
+#elif LWMEM_BUDDY_EN
+
+/**
+ * \brief           Get order (log2) of smallest power-of-two greater or equal to input size
+ * \param[in]       size: Input size
+ * \return          Order of size
+ */
+static size_t
+prv_buddy_order(size_t size) {
+    size_t order = 0;
+
+    while (((size_t)1 << order) < size) {
+        ++order;
+    }
+    return order;
+}
+
+/**
+ * \brief           Put free block to the head of free list of its order
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Block to put to list
+ * \param[in]       order: Order of the block
+ */
+static void
+prv_buddy_push(lwmem_t* const lwobj, lwmem_block_t* block, size_t order) {
+    lwmem_buddy_links_t* links = LWMEM_BUDDY_LINKS(block);
+
+    block->size = (size_t)1 << order;
+    block->next = NULL;
+    links->list_prev = NULL;
+    links->list_next = lwobj->buddy_lists[order];
+    if (links->list_next != NULL) {
+        LWMEM_BUDDY_LINKS(links->list_next)->list_prev = block;
+    }
+    lwobj->buddy_lists[order] = block;
+}
+
+/**
+ * \brief           Remove free block from free list of its order
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       block: Block to remove from list
+ */
+static void
+prv_buddy_remove(lwmem_t* const lwobj, lwmem_block_t* block) {
+    lwmem_buddy_links_t* links = LWMEM_BUDDY_LINKS(block);
+
+    if (links->list_prev != NULL) {
+        LWMEM_BUDDY_LINKS(links->list_prev)->list_next = links->list_next;
+    } else {
+        lwobj->buddy_lists[prv_buddy_order(block->size)] = links->list_next;
+    }
+    if (links->list_next != NULL) {
+        LWMEM_BUDDY_LINKS(links->list_next)->list_prev = links->list_prev;
+    }
+}
+
+/**
+ * \brief           Private allocation function for buddy strategy
+ *
+ * Requested size is rounded up to next power of two, then smallest
+ * sufficient free block is recursively split in halves until target order is reached
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Not used in buddy strategy, kept for signature compatibility
+ * \param[in]       size: Application wanted size, excluding size of meta header
+ * \return          Pointer to allocated memory, `NULL` otherwise
+ */
+static void* LWMEM_HOT_FN_ATTR
+prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+    lwmem_block_t* block = NULL;
+    size_t final_size = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE, order, avail_order;
+    const size_t max_order = prv_buddy_order(lwobj->buddy_size);
+
+    /* Check if initialized and if size is in the limits */
+    if (lwobj->buddy_base == NULL || final_size == LWMEM_BLOCK_META_SIZE || (final_size & LWMEM_ALLOC_BIT) > 0) {
+        return NULL;
+    }
+    LWMEM_FAULT_CHECK(lwobj, size);
+    if (final_size < LWMEM_BLOCK_MIN_SIZE) {
+        final_size = LWMEM_BLOCK_MIN_SIZE; /* Block must be able to hold free links once it gets freed */
+    }
+    order = prv_buddy_order(final_size);
+    if (((size_t)1 << order) > lwobj->buddy_size) {
+        return NULL; /* Request does not fit to managed memory */
+    }
+
+    /* Find smallest available order big enough for the request */
+    for (avail_order = order; avail_order <= max_order && lwobj->buddy_lists[avail_order] == NULL; ++avail_order) {}
+    if (avail_order > max_order) {
+        return NULL; /* No sufficient memory available to allocate block of memory */
+    }
+
+    /* Take block and split it in halves until target order is reached */
+    block = lwobj->buddy_lists[avail_order];
+    prv_buddy_remove(lwobj, block);
+    while (avail_order > order) {
+        lwmem_block_t* half;
+
+        --avail_order;
+        half = (void*)(LWMEM_TO_BYTE_PTR(block) + ((size_t)1 << avail_order));
+        prv_buddy_push(lwobj, half, avail_order); /* Upper half goes back to free list */
+    }
+    block->size = (size_t)1 << order;
+    prv_block_set_alloc(block);
+#if LWMEM_TAGS_EN
+    block->tag = NULL; /* Fresh allocations are untagged */
+#endif /* LWMEM_TAGS_EN */
+#if LWMEM_OWNER_EN
+    block->owner = LWMEM_GET_TASK_HANDLE(); /* Record owning task for bulk cleanup */
+#endif /* LWMEM_OWNER_EN */
+#if LWMEM_AGE_EN
+    block->birth_tick = (uint32_t)LWMEM_GET_TICK(); /* Allocation timestamp for stale reports */
+#endif /* LWMEM_AGE_EN */
+
+    lwobj->mem_available_bytes -= (size_t)1 << order;
+    LWMEM_UPDATE_MIN_FREE(lwobj);
+    LWMEM_STATS_CNT_ALLOC(lwobj);
+    LWMEM_WATERMARK_CHECK(lwobj);
+
+    (void)region; /* Only single region is supported in buddy strategy */
+    return LWMEM_GET_PTR_FROM_BLOCK(block);
+}
+
+/**
+ * \brief           Free input pointer and merge released block with its free buddy, recursively
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Input pointer to free
+ */
+static void LWMEM_HOT_FN_ATTR
+prv_free(lwmem_t* const lwobj, void* const ptr) {
+    LWMEM_EVICTABLE_FORGET(lwobj, ptr); /* Every free path drops the block from the eviction registry */
+    lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    const size_t max_order = prv_buddy_order(lwobj->buddy_size);
+    size_t order;
+
+    if (!LWMEM_BLOCK_IS_ALLOC(block)) { /* Check if block is valid */
+        return;
+    }
+#if LWMEM_TAGS_EN
+    if (block->tag != NULL) { /* Remove block from its site accounting */
+        prv_tag_update(block->tag, 0, (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE);
+        block->tag = NULL;
+    }
+#endif /* LWMEM_TAGS_EN */
+    block->size &= ~LWMEM_ALLOC_BIT; /* Clear allocated bit indication */
+    order = prv_buddy_order(block->size);
+
+    lwobj->mem_available_bytes += block->size; /* Increase available bytes */
+
+#if LWMEM_CFG_CLEAN_MEMORY
+    /* Reset user memory, so new allocations cannot see old information */
+    LWMEM_MEMSET(LWMEM_GET_PTR_FROM_BLOCK(block), 0x00, block->size - LWMEM_BLOCK_META_SIZE);
+#endif /* LWMEM_CFG_CLEAN_MEMORY */
+
+    /* Merge with buddy block as long as buddy is free and of the very same order */
+    while (order < max_order) {
+        lwmem_block_t* buddy =
+            (void*)(lwobj->buddy_base + (((size_t)(LWMEM_TO_BYTE_PTR(block) - lwobj->buddy_base)) ^ ((size_t)1 << order)));
+
+        if ((buddy->size & LWMEM_ALLOC_BIT) > 0 || buddy->size != ((size_t)1 << order)) {
+            break; /* Buddy is allocated or is split to smaller orders */
+        }
+        prv_buddy_remove(lwobj, buddy);
+        block = block < buddy ? block : buddy; /* Merged block starts at lower of the two */
+        ++order;
+    }
+    prv_buddy_push(lwobj, block, order);
+
+    LWMEM_STATS_CNT_FREE(lwobj);
+    LWMEM_WATERMARK_CHECK(lwobj);
+}
+
+#if LWMEM_CFG_SUPPORT_REALLOC
+
+/**
+ * \brief           Reallocates already allocated memory with new size in buddy strategy
+ *
+ * When new requested size maps to the same power-of-two class,
+ * input pointer is returned unchanged. In any other case new block
+ * is allocated, content copied and old block freed
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Not used in buddy strategy, kept for signature compatibility
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \param[in]       allow_move: Set to `1` to allow allocation of new block with content copy
+ * \param[in]       preserve: Set to `1` to copy existing content on any block relocation,
+ *                      or `0` when caller regenerates the content anyway
+ *                      when size class changes, or `0` to fail cleanly instead
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+static void*
+prv_realloc(lwmem_t* const lwobj, const lwmem_region_t* region, void* const ptr, const size_t size,
+            const uint8_t allow_move, const uint8_t preserve) {
+    lwmem_block_t* block;
+    size_t final_size = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE, block_size;
+    void* retval;
+
+    /* Check optional input parameters */
+    if (size == 0) {
+        if (ptr != NULL) {
+            prv_free(lwobj, ptr);
+        }
+        return NULL;
+    }
+    if (ptr == NULL) {
+        return prv_alloc(lwobj, region, size);
+    }
+    if ((size & LWMEM_ALLOC_BIT) || (final_size & LWMEM_ALLOC_BIT)) {
+        return NULL;
+    }
+
+    /* Process existing block */
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (!LWMEM_BLOCK_IS_ALLOC(block)) {
+        return NULL; /* Hard error. Input pointer is not NULL and block is not considered allocated */
+    }
+    if (final_size < LWMEM_BLOCK_MIN_SIZE) {
+        final_size = LWMEM_BLOCK_MIN_SIZE;
+    }
+    block_size = block->size & ~LWMEM_ALLOC_BIT;
+    if (((size_t)1 << prv_buddy_order(final_size)) == block_size) {
+        return ptr; /* Same size class -> nothing to do */
+    }
+    if (!allow_move) {
+        return NULL; /* Caller accepts in-place operations only */
+    }
+
+    /* Allocate new block of target class and copy content */
+    retval = prv_alloc(lwobj, region, size);
+    if (retval != NULL) {
+        const size_t app_size = block_size - LWMEM_BLOCK_META_SIZE;
+
+        if (preserve) {
+            LWMEM_MEMCPY(retval, ptr, size > app_size ? app_size : size);
+        }
+        prv_free(lwobj, ptr);
+    }
+    return retval;
+}
+
+#endif /* LWMEM_CFG_SUPPORT_REALLOC */
+
+/**
+ * \brief           Assign the memory structure for buddy strategy
+ *
+ * First valid region is used. Managed size is largest power of two
+ * that fits to the region, remaining memory stays unused
+ *
+ * \param           lwobj: LwMEM object
+ * \param           regions: List of regions, only first valid entry is used
+ * \return          Number of regions used
+ */
+static size_t
+prv_assignmem(lwmem_t* lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, order;
+
+    for (; regions->size > 0 && regions->start_addr != NULL; ++regions) {
+        if (prv_get_region_addr_size(regions, &mem_start_addr, &mem_size)) {
+            break; /* Use first valid region */
+        }
+    }
+    if (mem_start_addr == NULL) {
+        return 0;
+    }
+
+    /* Largest power of two fitting to the region is managed */
+    for (order = 0; ((size_t)1 << (order + 1)) <= mem_size; ++order) {}
+
+    lwobj->buddy_base = mem_start_addr;
+    lwobj->buddy_size = (size_t)1 << order;
+    lwobj->mem_available_bytes = lwobj->buddy_size;
+    lwobj->mem_regions_count = 1;
+
+    /* Whole managed memory is one free block of maximal order */
+    prv_buddy_push(lwobj, (void*)mem_start_addr, order);
+
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes = lwobj->mem_available_bytes;
+    lwobj->stats.minimum_ever_mem_available_bytes = lwobj->mem_available_bytes;
+#endif /* LWMEM_CFG_ENABLE_STATS */
+
+    return lwobj->mem_regions_count; /* Return number of regions used by manager */
+}
+
+#else /* LWMEM_BUDDY_EN */
+
+#if LWMEM_CFG_FULL && LWMEM_TAGS_EN
+
+/**
+ * \brief           Accounting table of allocation sites, linearly probed by tag pointer
+ */
+static struct {
+    const char* tag;      /*!< Site tag, `NULL` for unused entries */
+    size_t live_bytes;    /*!< Currently allocated bytes */
+    uint32_t live_count;  /*!< Currently allocated blocks */
+    uint32_t total_count; /*!< Number of allocations ever done */
+} tag_sites[LWMEM_CFG_ALLOC_TAGS_MAX_SITES];
+
+/**
+ * \brief           Update accounting of an allocation site
+ *
+ * Must be called with instance protected (mutex taken)
+ *
+ * \param[in]       tag: Site tag
+ * \param[in]       alloc: Set to `1` for allocation, `0` for free
+ * \param[in]       size: Application block size in units of bytes
+ */
+static void
+prv_tag_update(const char* tag, uint8_t alloc, size_t size) {
+    for (size_t idx = 0; idx < LWMEM_CFG_ALLOC_TAGS_MAX_SITES; ++idx) {
+        if (tag_sites[idx].tag == tag || tag_sites[idx].tag == NULL) {
+            tag_sites[idx].tag = tag;
+            if (alloc) {
+                tag_sites[idx].live_bytes += size;
+                ++tag_sites[idx].live_count;
+                ++tag_sites[idx].total_count;
+            } else {
+                tag_sites[idx].live_bytes -= size;
+                --tag_sites[idx].live_count;
+            }
+            return;
+        }
+    }
+}
+
+#endif /* LWMEM_CFG_FULL && LWMEM_TAGS_EN */
+
+#if LWMEM_REGION_STATS_EN
+
+/**
+ * \brief           Update available-bytes statistics of region owning input address
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       addr: Any address within the region (block being allocated or freed)
+ * \param[in]       add: Set to `1` when bytes become available, `0` when they are taken
+ * \param[in]       size: Number of bytes changing availability
+ */
+static void
+prv_region_stats_avail(lwmem_t* const lwobj, const void* addr, uint8_t add, size_t size) {
+    for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+        if ((const uint8_t*)addr >= (const uint8_t*)lwobj->region_heads[idx].start_addr
+            && (const uint8_t*)addr
+                   < ((const uint8_t*)lwobj->region_heads[idx].start_addr + lwobj->region_heads[idx].size)) {
+            lwmem_stats_t* stats = &lwobj->region_heads[idx].stats;
+
+            if (add) {
+                stats->mem_available_bytes += (uint32_t)size;
+            } else {
+                stats->mem_available_bytes -= (uint32_t)size;
+                if (stats->mem_available_bytes < stats->minimum_ever_mem_available_bytes) {
+                    stats->minimum_ever_mem_available_bytes = stats->mem_available_bytes;
+                }
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * \brief           Increment per-region counter of region owning input address
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       addr: Any address within the region
+ * \param[in]       is_alloc: Set to `1` for allocation counter, `0` for free counter
+ */
+static void
+prv_region_stats_count(lwmem_t* const lwobj, const void* addr, uint8_t is_alloc) {
+    for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+        if ((const uint8_t*)addr >= (const uint8_t*)lwobj->region_heads[idx].start_addr
+            && (const uint8_t*)addr
+                   < ((const uint8_t*)lwobj->region_heads[idx].start_addr + lwobj->region_heads[idx].size)) {
+            if (is_alloc) {
+                ++lwobj->region_heads[idx].stats.nr_alloc;
+            } else {
+                ++lwobj->region_heads[idx].stats.nr_free;
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * \brief           Update region available-bytes statistics
+ */
+#define LWMEM_REGION_AVAIL(lwobj, addr, add, size) prv_region_stats_avail((lwobj), (addr), (add), (size))
+
+/**
+ * \brief           Update region allocation/free counter statistics
+ */
+#define LWMEM_REGION_COUNT(lwobj, addr, is_alloc)  prv_region_stats_count((lwobj), (addr), (is_alloc))
+
+#else /* LWMEM_REGION_STATS_EN */
+#define LWMEM_REGION_AVAIL(lwobj, addr, add, size)
+#define LWMEM_REGION_COUNT(lwobj, addr, is_alloc)
+#endif /* !LWMEM_REGION_STATS_EN */
+
+/**
+ * \brief           Insert free block to linked list of free blocks
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       nblk: New free block to insert into linked list
+ * \param[in]       start_prev: Free-list entry known to be before the new block,
+ *                      to resume position search from. Set to `NULL` to search from list beginning
+ * \return          Final inserted block: input block itself, or previous block when both got merged
+ */
+static lwmem_block_t* LWMEM_HOT_FN_ATTR
+prv_insert_free_block(lwmem_t* const lwobj, lwmem_block_t* nblk, lwmem_block_t* start_prev) {
+    lwmem_block_t* prev;
+
+    /* Check valid inputs */
+    if (LWMEM_UNLIKELY(nblk == NULL)) {
+        return NULL;
+    }
+
+    /*
+     * Try to find position to put new block in-between
+     * Search until all free block addresses are lower than entry block
+     */
+#if LWMEM_SKIP_EN
+    if (lwobj->free_block_count >= LWMEM_CFG_SKIP_INDEX_MIN_BLOCKS) {
+        prev = prv_skip_find_list_prev(lwobj, nblk); /* Logarithmic lookup through the index */
+    } else
+#endif /* LWMEM_SKIP_EN */
+    {
+        for (prev = start_prev != NULL ? start_prev : &(lwobj->start_block); prev != NULL && prev->next < nblk;
+             prev = prev->next) {
+            LWMEM_WALK_PREFETCH(prev->next);
+        }
+    }
+
+    /* This is hard error with wrong memory usage */
+    if (prev == NULL) {
+        return NULL;
+    }
+    LWMEM_WAL_ARM_PREV(lwobj, prev); /* Pre-merge predecessor size survives a power cut */
+
+    /*
+     * At this point we have valid previous block
+     * Previous block is last free block before input block
+     */
+
+#if LWMEM_CFG_CLEAN_MEMORY && !LWMEM_SCRUB_EN
+    /*
+     * Reset user memory. This is to reset memory
+     * after it has been freed by the application.
+     *
+     * By doing this, we protect data left by app
+     * and we make sure new allocations cannot see old information
+     */
+    if (nblk != NULL) {
+        void* ptr = LWMEM_GET_PTR_FROM_BLOCK(nblk);
+        if (ptr != NULL) {
+            LWMEM_MEMSET(ptr, 0x00, nblk->size - LWMEM_BLOCK_META_SIZE);
+        }
+    }
+#endif /* LWMEM_CFG_CLEAN_MEMORY && !LWMEM_SCRUB_EN */
+
+    /*
+     * Check if previous block and input block together create one big contiguous block
+     * If this is the case, merge blocks together and increase previous block by input block size
+     */
+    if ((LWMEM_TO_BYTE_PTR(prev) + prev->size) == LWMEM_TO_BYTE_PTR(nblk)) {
+#if LWMEM_BINS_EN
+        prv_bin_unlink(lwobj, prev); /* Size of previous block is about to change -> remove from its bin */
+#endif /* LWMEM_BINS_EN */
+        prev->size += nblk->size; /* Increase current block by size of new block */
+        nblk = prev;              /* New block and current are now the same thing */
+        /*
+         * It is important to set new block as current one
+         * as this allows merging previous and next blocks together with new block
+         * at the same time; follow next steps
+         */
+    }
+
+    /*
+     * Check if new block and next of previous create big contiguous block
+     * Do not merge with "end of region" indication (commented part of if statement)
+     */
+    if (prev->next != NULL && prev->next->size > 0 /* Do not remove "end of region" indicator in each region */
+        && (LWMEM_TO_BYTE_PTR(nblk) + nblk->size) == LWMEM_TO_BYTE_PTR(prev->next)) {
+        if (prev->next == lwobj->end_block) { /* Does it points to the end? */
+            nblk->next = lwobj->end_block;    /* Set end block pointer */
+        } else {
+#if LWMEM_BINS_EN
+            prv_bin_unlink(lwobj, prev->next); /* Next block is being absorbed -> remove from its bin */
+#endif /* LWMEM_BINS_EN */
+            LWMEM_NEXTFIT_FORGET(lwobj, prev->next); /* Next block is being absorbed */
+#if LWMEM_SKIP_EN
+            prv_skip_remove(lwobj, prev->next); /* Next block is being absorbed -> remove from index */
+#endif /* LWMEM_SKIP_EN */
+            /* Expand of current block for size of next free block which is right behind new block */
+            nblk->size += prev->next->size;
+            nblk->next = prev->next->next; /* Next free is pointed to the next one of previous next */
+        }
+    } else {
+        nblk->next = prev->next; /* Set next of input block as next of current one */
+    }
+
+    /*
+     * If new block has not been set as current (and expanded),
+     * then link them together, otherwise ignore as it would point to itself
+     */
+    if (prev != nblk) {
+        prev->next = nblk;
+#if LWMEM_BINS_EN
+        prv_set_addr_prev(nblk, prev); /* Block is freshly linked after previous one */
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+        prv_skip_insert(lwobj, nblk); /* Put new block to the index */
+#endif /* LWMEM_SKIP_EN */
+    }
+#if LWMEM_BINS_EN
+    prv_set_addr_prev(nblk->next, nblk); /* Next block has new previous entry */
+    prv_bin_insert(lwobj, nblk);         /* Put block to bin matching its final size */
+#endif /* LWMEM_BINS_EN */
+    LWMEM_BT_SET(nblk); /* Footer tracks final merged size and free state */
+    LWMEM_CHK_SET(nblk);
+    LWMEM_CHK_SET(prev); /* Link of previous entry may have been re-pointed */
+    return nblk;
+}
+
+#if LWMEM_EXACT_EN
+
+/**
+ * \brief           Return all cached exact-fit blocks to the free list
+ *
+ * Must be called with instance protected (mutex taken)
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \return          `1` when at least one block was flushed, `0` otherwise
+ */
+static uint8_t
+prv_exact_cache_flush(lwmem_t* const lwobj) {
+    uint8_t flushed = 0;
+
+    for (size_t idx = 0; idx < LWMEM_CFG_EXACT_CACHE_SIZE; ++idx) {
+        lwmem_block_t* block = (lwmem_block_t*)lwobj->exact_cache[idx].block;
+
+        if (block != NULL) {
+            lwobj->exact_cache[idx].block = NULL;
+            block->size &= ~LWMEM_ALLOC_BIT; /* Clear allocated bit indication */
+            lwobj->mem_available_bytes += block->size;
+            prv_insert_free_block(lwobj, block, NULL);
+            flushed = 1;
+        }
+    }
+    return flushed;
+}
+
+#endif /* LWMEM_EXACT_EN */
+
+/**
+ * \brief           Split too big block and add it to list of free blocks
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       block: Pointer to block with size already set
+ * \param[in]       new_block_size: New block size to be set
+ * \return          `1` if block splitted, `0` otherwise
+ */
+static uint8_t LWMEM_HOT_FN_ATTR
+prv_split_too_big_block(lwmem_t* const lwobj, lwmem_block_t* block, size_t new_block_size) {
+    lwmem_block_t* next;
+    size_t block_size, is_alloc_bit;
+    uint8_t success = 0;
+
+    is_alloc_bit = block->size & LWMEM_ALLOC_BIT; /* Check if allocation bit is set */
+    block_size = block->size & ~LWMEM_ALLOC_BIT;  /* Use size without allocated bit */
+
+    /*
+     * If current block size is greater than requested size,
+     * it is possible to create empty block at the end of existing one
+     * and add it back to list of empty blocks
+     */
+    if ((block_size - new_block_size) >= LWMEM_BLOCK_MIN_SIZE
+#if LWMEM_CFG_CONFIGURABLE_SPLIT
+        /* Anti-churn hysteresis: tiny remainders stay attached as block slack */
+        && (block_size - new_block_size) >= lwobj->min_split_remainder
+#endif /* LWMEM_CFG_CONFIGURABLE_SPLIT */
+    ) {
+        next = (void*)(LWMEM_TO_BYTE_PTR(block) + new_block_size); /* Put next block after size of current allocation */
+        next->size = block_size - new_block_size;                  /* Modify block data */
+        block->size = new_block_size;                              /* Current size is now smaller */
+        LWMEM_BT_SET(block);
+        LWMEM_BT_SET(next);
+        LWMEM_CHK_SET(block);
+
+        lwobj->mem_available_bytes += next->size; /* Increase available bytes by new block size */
+        LWMEM_REGION_AVAIL(lwobj, next, 1, next->size);
+        prv_insert_free_block(lwobj, next, NULL); /* Add new block to the free list */
+
+        success = 1;
+    } else {
+        /* TODO: If next of current is free, check if we can increase next by at least some bytes */
+        /* This can only happen during reallocation process when allocated block is reallocated to previous one */
+        /* Very rare case, but may happen! */
+    }
+
+    /* If allocation bit was set before, set it now again */
+    if (is_alloc_bit) {
+        prv_block_set_alloc(block);
+    }
+    return success;
+}
+
+#if LWMEM_DEFERRED_EN
+
+/**
+ * \brief           Merge all blocks from deferred free list back to the list of free blocks
+ * \param[in]       lwobj: LwMEM instance
+ */
+static void
+prv_coalesce_deferred(lwmem_t* const lwobj) {
+    lwmem_block_t* block = lwobj->deferred_free;
+#if LWMEM_CFG_BOUNDED_LOCK
+    size_t budget = LWMEM_CFG_BOUNDED_LOCK_MAX_WALK; /* Remaining work drains in preemptible stages */
+#endif /* LWMEM_CFG_BOUNDED_LOCK */
+
+    lwobj->deferred_free = NULL;
+    while (block != NULL) {
+        lwmem_block_t* next_deferred = block->next;
+
+        prv_insert_free_block(lwobj, block, NULL); /* Full address-ordered insertion with merge */
+        block = next_deferred;
+#if LWMEM_CFG_BOUNDED_LOCK
+        if (--budget == 0) {
+            lwobj->deferred_free = block; /* Critical-section budget spent, rest stays deferred */
+            break;
+        }
+#endif /* LWMEM_CFG_BOUNDED_LOCK */
+    }
+}
+
+#endif /* LWMEM_DEFERRED_EN */
+
+#if LWMEM_SCRUB_EN
+
+/**
+ * \brief           Scrub pending dirty blocks and return clean ones to the free list
+ *
+ * Must be called with instance protected (mutex taken)
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       max_bytes: Scrub byte budget, `0` for no limit
+ * \return          Number of bytes still waiting to be scrubbed
+ */
+static size_t
+prv_scrub_step(lwmem_t* const lwobj, size_t max_bytes) {
+    size_t budget = max_bytes > 0 ? max_bytes : (size_t)-1;
+    size_t remaining = 0;
+
+    while (lwobj->scrub_pending != NULL && budget > 0) {
+        lwmem_block_t* block = lwobj->scrub_pending;
+        const size_t dirty_size = block->size - LWMEM_BLOCK_META_SIZE;
+        const size_t chunk =
+            (dirty_size - lwobj->scrub_done) > budget ? budget : (dirty_size - lwobj->scrub_done);
+
+        LWMEM_MEMSET(LWMEM_TO_BYTE_PTR(LWMEM_GET_PTR_FROM_BLOCK(block)) + lwobj->scrub_done, 0x00, chunk);
+        lwobj->scrub_done += chunk;
+        budget -= chunk;
+
+        if (lwobj->scrub_done == dirty_size) { /* Block fully scrubbed -> back to the free list */
+            lwobj->scrub_pending = block->next;
+            lwobj->scrub_done = 0;
+            prv_insert_free_block(lwobj, block, NULL);
+        }
+    }
+
+    /* Report how much work is left for the caller to schedule next step */
+    for (const lwmem_block_t* block = lwobj->scrub_pending; block != NULL; block = block->next) {
+        remaining += block->size - LWMEM_BLOCK_META_SIZE;
+    }
+    if (lwobj->scrub_pending != NULL) {
+        remaining -= lwobj->scrub_done;
+    }
+    return remaining;
+}
+
+#endif /* LWMEM_SCRUB_EN */
+
+/**
+ * \brief           Private allocation function
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from.
+ *                      Set to `NULL` for any region
+ * \param[in]       size: Application wanted size, excluding size of meta header
+ * \return          Pointer to allocated memory, `NULL` otherwise
+ */
+#if LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN
+/**
+ * \brief           Name the allocation body refers to itself by
+ *
+ * Region-routing recursions stay on the no-coalesce body on purpose: the
+ * outer \ref prv_alloc wrapper owns the single drain-and-retry, so routed
+ * candidates are not each paying a full deferred-list flush
+ */
+#define LWMEM_PRV_ALLOC_SELF prv_alloc_no_coalesce
+#else /* LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN */
+#define LWMEM_PRV_ALLOC_SELF prv_alloc
+#endif /* !(LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN) */
+static void*
+#if LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN
+prv_alloc_no_coalesce(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+#else /* LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN */
+prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+#endif /* !(LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN) */
+    lwmem_block_t *prev, *curr;
+    void* retval = NULL;
+
+    /* Calculate final size including meta data size */
+    size_t final_size = LWMEM_INSTANCE_SIZE_ALIGN(
+        lwobj, LWMEM_BLOCK_SIZE_ALIGN(LWMEM_ALIGN(LWMEM_ROUND_SIZE(size)) + LWMEM_BLOCK_META_SIZE + LWMEM_BT_EXTRA));
+
+    /* Check if initialized and if size is in the limits */
+    if (LWMEM_UNLIKELY(lwobj->end_block == NULL || final_size == LWMEM_BLOCK_META_SIZE
+                       || (final_size & LWMEM_ALLOC_BIT) > 0)) {
+        return NULL;
+    }
+    LWMEM_FAULT_CHECK(lwobj, size);
+#if LWMEM_BINS_EN || LWMEM_SKIP_EN || LWMEM_AUDIT_EN
+    if (final_size < LWMEM_BLOCK_MIN_SIZE) {
+        final_size = LWMEM_BLOCK_MIN_SIZE; /* Block must be able to hold free links once it gets freed */
+    }
+#endif /* LWMEM_BINS_EN || LWMEM_SKIP_EN || LWMEM_AUDIT_EN */
+#if LWMEM_RESERVE_EN
+    /* Regular allocations must not eat into the emergency reserve */
+    if (!lwobj->reserve_bypass
+        && (final_size + (size_t)LWMEM_CFG_EMERGENCY_RESERVE_SIZE) > lwobj->mem_available_bytes) {
+        return NULL;
+    }
+#endif /* LWMEM_RESERVE_EN */
+#if LWMEM_EXACT_EN
+    if (region == NULL) {
+        lwmem_block_t* cached = (lwmem_block_t*)LWMEM_EXACT_SLOT(lwobj, final_size)->block;
+
+        /* Freed size re-requested shortly after the free: hand the block
+           straight back, no list traversal and no split */
+        if (cached != NULL && LWMEM_EXACT_SLOT(lwobj, final_size)->size == final_size) {
+            void* cached_ptr = LWMEM_GET_PTR_FROM_BLOCK(cached);
+
+            LWMEM_EXACT_SLOT(lwobj, final_size)->block = NULL;
+#if LWMEM_OWNER_EN
+            cached->owner = LWMEM_GET_TASK_HANDLE(); /* Record owning task for bulk cleanup */
+#endif /* LWMEM_OWNER_EN */
+#if LWMEM_AGE_EN
+            cached->birth_tick = (uint32_t)LWMEM_GET_TICK(); /* Allocation timestamp for stale reports */
+#endif /* LWMEM_AGE_EN */
+#if LWMEM_PIN_EN
+            cached->pin_cnt = 0; /* Fresh allocations are movable */
+#endif /* LWMEM_PIN_EN */
+#if LWMEM_UDATA_EN
+            cached->udata = 0; /* Fresh allocations carry no metadata word */
+#endif /* LWMEM_UDATA_EN */
+            LWMEM_STATS_CNT_ALLOC(lwobj);
+            return cached_ptr;
+        }
+    }
+#endif /* LWMEM_EXACT_EN */
+
+    LWMEM_BOUND_WALK_DECL; /* One walk budget per critical section */
+
+    /* Set default values */
+    prev = &(lwobj->start_block); /* Use pointer from custom lwmem block */
+    LWMEM_CHK_VERIFY(lwobj, prev); /* Entry link into the free list must be sound */
+    curr = prev->next;            /* Curr represents first actual free block */
+
+    /*
+     * If region is not set to NULL,
+     * request for memory allocation came from specific region:
+     *
+     * - Start at the beginning like normal (from very first region)
+     * - Loop until free block is between region start addr and its size
+     */
+#if LWMEM_CFG_SINGLE_REGION
+    (void)region; /* Single-region build, the only region serves every request */
+#else /* LWMEM_CFG_SINGLE_REGION */
+#if LWMEM_LARGE_ROUTE_EN
+    /* Keep big, long-lived objects out of the small-block regions */
+    if (region == NULL && size >= (size_t)LWMEM_CFG_LARGE_ROUTING_THRESHOLD && lwobj->mem_regions_count > 1) {
+        lwmem_region_t tmp_region = {0};
+        void* routed_ptr;
+
+        tmp_region.start_addr = lwobj->region_heads[lwobj->mem_regions_count - 1].start_addr;
+        tmp_region.size = lwobj->region_heads[lwobj->mem_regions_count - 1].size;
+        routed_ptr = LWMEM_PRV_ALLOC_SELF(lwobj, &tmp_region, size);
+        if (routed_ptr != NULL) {
+            return routed_ptr;
+        }
+        /* Last region exhausted -> fall through to regular placement */
+    }
+#endif /* LWMEM_LARGE_ROUTE_EN */
+
+#if LWMEM_SMALL_ROUTE_EN
+    /* Route small region-less allocations to the designated region first */
+    if (region == NULL && lwobj->small_threshold > 0 && size <= lwobj->small_threshold
+        && lwobj->small_region_idx < lwobj->mem_regions_count) {
+        lwmem_region_t tmp_region = {0};
+        void* routed_ptr;
+
+        tmp_region.start_addr = lwobj->region_heads[lwobj->small_region_idx].start_addr;
+        tmp_region.size = lwobj->region_heads[lwobj->small_region_idx].size;
+        routed_ptr = LWMEM_PRV_ALLOC_SELF(lwobj, &tmp_region, size);
+        if (routed_ptr != NULL) {
+            return routed_ptr;
+        }
+        /* Designated region exhausted -> fall through to regular placement */
+    }
+#endif /* LWMEM_SMALL_ROUTE_EN */
+
+#if LWMEM_REGION_ATTR_EN
+    if (region == NULL) {
+        /*
+         * Walk regions in rising priority value order,
+         * so hot allocations prefer fast memory tiers
+         */
+        uint8_t visited[LWMEM_CFG_MAX_REGIONS] = {0};
+
+        for (size_t round = 0; round < lwobj->mem_regions_count; ++round) {
+            size_t best = lwobj->mem_regions_count;
+
+            for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+                if (!visited[idx]
+                    && (best >= lwobj->mem_regions_count
+                        || lwobj->region_heads[idx].priority < lwobj->region_heads[best].priority)) {
+                    best = idx;
+                }
+            }
+            visited[best] = 1;
+            {
+                lwmem_region_t tmp_region = {0};
+                void* attr_ptr;
+
+                tmp_region.start_addr = lwobj->region_heads[best].start_addr;
+                tmp_region.size = lwobj->region_heads[best].size;
+                attr_ptr = LWMEM_PRV_ALLOC_SELF(lwobj, &tmp_region, size);
+                if (attr_ptr != NULL) {
+                    return attr_ptr;
+                }
+            }
+        }
+        return NULL;
+    }
+#endif /* LWMEM_REGION_ATTR_EN */
+
+    if (region != NULL) {
+#if LWMEM_PER_REGION_EN
+        size_t ridx;
+
+        /* Find region entry matching user region description */
+        for (ridx = 0; ridx < lwobj->mem_regions_count; ++ridx) {
+            const uint8_t* reg_addr = lwobj->region_heads[ridx].start_addr;
+
+            if (LWMEM_TO_BYTE_PTR(region->start_addr) <= reg_addr
+                && reg_addr < (LWMEM_TO_BYTE_PTR(region->start_addr) + region->size)) {
+                break;
+            }
+        }
+        if (ridx >= lwobj->mem_regions_count) {
+            return NULL;
+        }
+
+        /*
+         * Start scan at stable anchor preceding region's first block,
+         * so only blocks belonging to this region are visited.
+         * End of region indicator (size = 0) terminates the walk,
+         * optionally continuing over the fallback chain of the region
+         */
+        for (size_t hops = 0; hops <= lwobj->mem_regions_count; ++hops) {
+            prev = lwobj->region_heads[ridx].head;
+            curr = prev->next;
+#if LWMEM_WEAR_EN
+            if (lwobj->region_heads[ridx].attr & LWMEM_REGION_ATTR_PERSISTENT) {
+                /*
+                 * Rotate the search start across the region: resume past the previous
+                 * allocation and wrap below, spreading header rewrites over the whole
+                 * region instead of wearing the blocks at the region head
+                 */
+                const uint8_t* rotate_from = LWMEM_TO_BYTE_PTR(lwobj->region_heads[ridx].start_addr)
+                                             + LWMEM_ALIGN(lwobj->region_heads[ridx].wear_offs);
+
+                /* First block providing final_size bytes at or above the rotation point qualifies */
+                for (; curr != NULL && curr->size != 0
+                       && ((LWMEM_TO_BYTE_PTR(curr) + curr->size) < (rotate_from + final_size)
+                           || curr->size < final_size);
+                     prev = curr, curr = curr->next) {}
+                if (curr != NULL && curr->size != 0 && curr->size >= final_size
+                    && LWMEM_TO_BYTE_PTR(curr) < rotate_from
+                    && (size_t)(rotate_from - LWMEM_TO_BYTE_PTR(curr)) >= LWMEM_BLOCK_MIN_SIZE
+                    && (curr->size - (size_t)(rotate_from - LWMEM_TO_BYTE_PTR(curr))) >= final_size) {
+                    /* Block straddles the rotation point -> carve so allocation starts there,
+                       front part stays on the free list and absorbs no header rewrites */
+                    lwmem_block_t* rot_blk = (void*)(LWMEM_TO_BYTE_PTR(0) + (size_t)(uintptr_t)rotate_from);
+                    const size_t front_size = (size_t)(rotate_from - LWMEM_TO_BYTE_PTR(curr));
+
+                    rot_blk->size = curr->size - front_size;
+                    rot_blk->next = curr->next;
+                    curr->size = front_size;
+                    curr->next = rot_blk;
+                    LWMEM_CHK_SET(curr);
+                    LWMEM_CHK_SET(rot_blk);
+                    prev = curr;
+                    curr = rot_blk;
+                }
+                if (curr != NULL && curr->size != 0 && curr->size >= final_size
+                    && LWMEM_TO_BYTE_PTR(curr) >= rotate_from) {
+                    /* Forced advance: next search starts behind this allocation, even on exact fit */
+                    lwobj->region_heads[ridx].wear_offs =
+                        (size_t)(LWMEM_TO_BYTE_PTR(curr) - LWMEM_TO_BYTE_PTR(lwobj->region_heads[ridx].start_addr))
+                        + final_size;
+                    if (lwobj->region_heads[ridx].wear_offs >= lwobj->region_heads[ridx].size) {
+                        lwobj->region_heads[ridx].wear_offs = 0;
+                    }
+                    break;
+                }
+                prev = lwobj->region_heads[ridx].head; /* Nothing at or above the rover -> wrap */
+                curr = prev->next;
+            }
+#endif /* LWMEM_WEAR_EN */
+            for (; curr != NULL && curr->size != 0 && curr->size < final_size; prev = curr, curr = curr->next) {}
+            if (curr != NULL && curr->size >= final_size) {
+#if LWMEM_WEAR_EN
+                if (lwobj->region_heads[ridx].attr & LWMEM_REGION_ATTR_PERSISTENT) {
+                    lwobj->region_heads[ridx].wear_offs =
+                        (size_t)(LWMEM_TO_BYTE_PTR(curr) - LWMEM_TO_BYTE_PTR(lwobj->region_heads[ridx].start_addr))
+                        + final_size;
+                    if (lwobj->region_heads[ridx].wear_offs >= lwobj->region_heads[ridx].size) {
+                        lwobj->region_heads[ridx].wear_offs = 0;
+                    }
+                }
+#endif /* LWMEM_WEAR_EN */
+                break; /* Free block identified */
+            }
+#if LWMEM_REGION_FB_EN
+            if (lwobj->region_heads[ridx].fallback_idx < lwobj->mem_regions_count) {
+                ridx = lwobj->region_heads[ridx].fallback_idx; /* Region full -> overflow to chained region */
+                continue;
+            }
+#endif /* LWMEM_REGION_FB_EN */
+            return NULL;
+        }
+        if (curr == NULL || curr->size < final_size) {
+            return NULL; /* Fallback chain exhausted (or cycled) without a fitting block */
+        }
+#else /* LWMEM_PER_REGION_EN */
+        uint8_t* region_start_addr;
+        size_t region_size;
+
+        /* Get data about region */
+        if (!prv_get_region_addr_size(region, &region_start_addr, &region_size)) {
+            return NULL;
+        }
+
+        /*
+         * Scan all regions from lwmem and find first available block
+         * which is within address of region and is big enough
+         */
+        for (; curr != NULL; prev = curr, curr = curr->next) {
+            /* Check bounds */
+            if (curr->next == NULL || curr == lwobj->end_block) {
+                return NULL;
+            }
+            if ((uint8_t*)curr < (uint8_t*)region_start_addr) { /* Check if we reached region */
+                continue;
+            }
+            if ((uint8_t*)curr >= (uint8_t*)(region_start_addr + region_size)) { /* Check if we are out already */
+                return NULL;
+            }
+            if (curr->size >= final_size) {
+                break; /* Free block identified */
+            }
+        }
+#endif /* !LWMEM_PER_REGION_EN */
+    } else
+#endif /* !LWMEM_CFG_SINGLE_REGION */
+    {
+#if LWMEM_SEGREGATED_EN
+        /*
+         * Scan bins, starting at the one matching requested size.
+         *
+         * Within matching bin, block must be explicitly checked for fit
+         * (it may be smaller than request). First block of any higher bin
+         * is guaranteed to be big enough, with exception of last (catch-all) bin
+         */
+        curr = NULL;
+        for (size_t idx = prv_get_bin_idx(final_size); curr == NULL && idx < LWMEM_CFG_SEGREGATED_BIN_COUNT; ++idx) {
+            for (curr = lwobj->free_bins[idx]; curr != NULL && curr->size < final_size;
+                 curr = LWMEM_BLOCK_LINKS(curr)->bin_next) {}
+        }
+        if (curr == NULL) {
+            return NULL; /* No sufficient memory available to allocate block of memory */
+        }
+        prev = LWMEM_BLOCK_LINKS(curr)->addr_prev; /* Previous entry on address-ordered list */
+#elif LWMEM_TLSF_EN
+        size_t fl = 0, sl = 0, search_size = final_size;
+        uint32_t slmap;
+
+        /*
+         * Round request up to the next size class,
+         * so that any block in the mapped (or any higher) bin is guaranteed to fit.
+         * Small classes are subdivided by alignment granularity and are always exact
+         */
+        if (search_size >= ((size_t)1 << LWMEM_TLSF_SMALL_SHIFT)) {
+            search_size += ((size_t)1 << (prv_msb_idx(search_size) - LWMEM_CFG_TLSF_SL_COUNT_LOG2)) - 1;
+        }
+        prv_tlsf_map(search_size, &fl, &sl);
+
+        /* Scan bitmaps for first non-empty bin at mapped or any higher class */
+        curr = NULL;
+        slmap = lwobj->sl_bitmap[fl] & (uint32_t)(~(uint32_t)0 << sl);
+        if (slmap == 0) {
+            uint32_t flmap = 0;
+
+            if ((fl + 1) < LWMEM_CFG_TLSF_FL_COUNT) {
+                flmap = lwobj->fl_bitmap & (uint32_t)(~(uint32_t)0 << (fl + 1));
+            }
+            if (flmap != 0) {
+                fl = prv_lsb_idx(flmap);
+                slmap = lwobj->sl_bitmap[fl];
+            }
+        }
+        if (slmap != 0) {
+            sl = prv_lsb_idx(slmap);
+            curr = lwobj->free_bins[(fl << LWMEM_CFG_TLSF_SL_COUNT_LOG2) + sl];
+
+            /* Blocks in last catch-all bin are not guaranteed to fit -> take first that does */
+            for (; curr != NULL && curr->size < final_size; curr = LWMEM_BLOCK_LINKS(curr)->bin_next) {}
+        }
+        if (curr == NULL) {
+            /*
+             * Good-fit search failed, but a barely-big-enough block
+             * may still sit in the exact class of the (not rounded up) request
+             */
+            for (curr = lwobj->free_bins[prv_get_bin_idx(final_size)]; curr != NULL && curr->size < final_size;
+                 curr = LWMEM_BLOCK_LINKS(curr)->bin_next) {}
+        }
+        if (curr == NULL) {
+            return NULL; /* No sufficient memory available to allocate block of memory */
+        }
+        prev = LWMEM_BLOCK_LINKS(curr)->addr_prev; /* Previous entry on address-ordered list */
+#elif LWMEM_BEST_FIT_EN
+        lwmem_block_t *best_prev = NULL, *best = NULL;
+
+        /* Walk complete list of free blocks and remember the one with least wasted space */
+        for (; curr != NULL; prev = curr, curr = curr->next) {
+            LWMEM_WALK_PREFETCH(curr->next);
+            LWMEM_CHK_VERIFY(lwobj, curr);
+            if (curr->size >= final_size && (best == NULL || curr->size < best->size)) {
+                best_prev = prev;
+                best = curr;
+                if (best->size == final_size) { /* Exact fit -> cannot do any better */
+                    break;
+                }
+            }
+            if (curr->next == NULL || curr == lwobj->end_block) { /* If no more blocks available */
+                break;
+            }
+        }
+        if (best == NULL) {
+            return NULL; /* No sufficient memory available to allocate block of memory */
+        }
+        prev = best_prev;
+        curr = best;
+#elif LWMEM_NEXT_FIT_EN
+        uint8_t wrapped = 0;
+
+        /* Resume search at roving pointer and wrap around begin of list (once) when end is reached */
+        prev = lwobj->next_fit_prev != NULL ? lwobj->next_fit_prev : &(lwobj->start_block);
+        curr = prev->next;
+        while (curr == NULL || curr->size < final_size) {
+            if (curr == NULL || curr->next == NULL) { /* If no more blocks available */
+                if (wrapped) {
+                    return NULL; /* No sufficient memory available to allocate block of memory */
+                }
+                wrapped = 1;
+                prev = &(lwobj->start_block);
+                curr = prev->next;
+                continue;
+            }
+            LWMEM_BOUND_WALK_STEP(lwobj);
+            prev = curr;
+            curr = curr->next;
+        }
+#elif LWMEM_POLICY_EN
+        if (lwobj->policy_fit == (uint8_t)LWMEM_FIT_BEST) {
+            lwmem_block_t *best_prev = NULL, *best = NULL;
+
+            for (; curr != NULL; prev = curr, curr = curr->next) {
+                if (curr->size >= final_size && (best == NULL || curr->size < best->size)) {
+                    best_prev = prev;
+                    best = curr;
+                    if (best->size == final_size) {
+                        break;
+                    }
+                }
+                if (curr->next == NULL || curr == lwobj->end_block) {
+                    break;
+                }
+            }
+            if (best == NULL) {
+                return NULL;
+            }
+            prev = best_prev;
+            curr = best;
+        } else if (lwobj->policy_fit == (uint8_t)LWMEM_FIT_NEXT) {
+            uint8_t wrapped = 0;
+
+            prev = lwobj->policy_rover != NULL ? lwobj->policy_rover : &(lwobj->start_block);
+            curr = prev->next;
+            while (curr == NULL || curr->size < final_size) {
+                if (curr == NULL || curr->next == NULL) {
+                    if (wrapped) {
+                        return NULL;
+                    }
+                    wrapped = 1;
+                    prev = &(lwobj->start_block);
+                    curr = prev->next;
+                    continue;
+                }
+                prev = curr;
+                curr = curr->next;
+            }
+        } else {
+            for (; curr != NULL && curr->size < final_size; prev = curr, curr = curr->next) {
+                LWMEM_WALK_PREFETCH(curr->next);
+                if (curr->next == NULL || curr == lwobj->end_block) {
+                    return NULL;
+                }
+            }
+        }
+#else  /* LWMEM_NEXT_FIT_EN */
+        /*
+         * Try to find first block with at least `size` bytes of available memory
+         * Loop until size of current block is smaller than requested final size
+         */
+        for (; curr != NULL && curr->size < final_size; prev = curr, curr = curr->next) {
+            LWMEM_WALK_PREFETCH(curr->next); /* Hide part of the next pointer-chase miss */
+            LWMEM_CHK_VERIFY(lwobj, curr);   /* Header is about to be trusted for the walk */
+            LWMEM_BOUND_WALK_STEP(lwobj);
+            if (curr->next == NULL || curr == lwobj->end_block) { /* If no more blocks available */
+                return NULL; /* No sufficient memory available to allocate block of memory */
+            }
+        }
+#endif /* !LWMEM_NEXT_FIT_EN */
+    }
+
+    /* Check curr pointer. During normal use, this should be always false */
+    if (LWMEM_UNLIKELY(curr == NULL)) {
+        return NULL;
+    }
+
+    /* There is a valid block available */
+    LWMEM_CHK_VERIFY(lwobj, curr);           /* Selected header is about to be consumed */
+    LWMEM_WAL_ARM_BLOCK(lwobj, curr);        /* Pre-op size survives a power cut mid-update */
+    retval = LWMEM_GET_PTR_FROM_BLOCK(curr); /* Return pointer does not include meta part */
+    LWMEM_SAN_EXPOSE(retval, curr->size - LWMEM_BLOCK_META_SIZE); /* Whole area, split writes inside it */
+#if LWMEM_AUDIT_EN
+    {
+        const lwmem_audit_stamp_t* stamp = LWMEM_AUDIT_STAMP(curr);
+
+        if (stamp->free_tick > 0) { /* Block has been through a free before */
+            const uint32_t delta = (uint32_t)((size_t)LWMEM_GET_TICK() - stamp->free_tick);
+
+            lwobj->audit_reuse_ewma += ((int32_t)(delta - lwobj->audit_reuse_ewma)) / 8;
+            lwobj->audit_exact_hits += stamp->free_size == final_size;
+            ++lwobj->audit_samples;
+        }
+    }
+#endif /* LWMEM_AUDIT_EN */
+#if LWMEM_TAGS_EN
+    curr->tag = NULL; /* Fresh allocations are untagged */
+#endif /* LWMEM_TAGS_EN */
+#if LWMEM_PIN_EN
+    curr->pin_cnt = 0; /* Fresh allocations are movable */
+#endif /* LWMEM_PIN_EN */
+#if LWMEM_UDATA_EN
+    curr->udata = 0; /* Fresh allocations carry no metadata word */
+#endif /* LWMEM_UDATA_EN */
+#if LWMEM_OWNER_EN
+    curr->owner = LWMEM_GET_TASK_HANDLE(); /* Record owning task for bulk cleanup */
+#endif /* LWMEM_OWNER_EN */
+#if LWMEM_AGE_EN
+    curr->birth_tick = (uint32_t)LWMEM_GET_TICK(); /* Allocation timestamp for stale reports */
+#endif /* LWMEM_AGE_EN */
+#if LWMEM_BINS_EN
+    prv_bin_unlink(lwobj, curr); /* Remove block from its size-class bin before size is modified */
+#endif /* LWMEM_BINS_EN */
+    prev->next = curr->next; /* Remove this block from linked list by setting next of previous to next of current */
+    LWMEM_CHK_SET(prev);
+
+    /* curr block is now removed from linked list */
+#if LWMEM_NEXT_FIT_EN
+    lwobj->next_fit_prev = prev; /* Next search resumes right after this allocation */
+#endif /* LWMEM_NEXT_FIT_EN */
+#if LWMEM_POLICY_EN
+    lwobj->policy_rover = prev; /* Runtime next-fit mode resumes here */
+#endif /* LWMEM_POLICY_EN */
+#if LWMEM_BINS_EN
+    prv_set_addr_prev(curr->next, prev); /* Next block has new previous entry */
+#if LWMEM_CFG_CLEAN_MEMORY
+    LWMEM_MEMSET(retval, 0x00, sizeof(lwmem_block_links_t)); /* Links are not part of cleaned memory promise */
+#endif /* LWMEM_CFG_CLEAN_MEMORY */
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+    prv_skip_remove(lwobj, curr); /* Block is leaving the free list -> remove from index */
+#if LWMEM_CFG_CLEAN_MEMORY
+    LWMEM_MEMSET(retval, 0x00, sizeof(lwmem_skip_links_t)); /* Index tower is not part of cleaned memory promise */
+#endif /* LWMEM_CFG_CLEAN_MEMORY */
+#endif /* LWMEM_SKIP_EN */
+
+    lwobj->mem_available_bytes -= curr->size;         /* Decrease available bytes by allocated block size */
+    LWMEM_REGION_AVAIL(lwobj, curr, 0, curr->size);
+    LWMEM_REGION_COUNT(lwobj, curr, 1);
+    prv_split_too_big_block(lwobj, curr, final_size); /* Split block if it is too big */
+    prv_block_set_alloc(curr);                        /* Set block as allocated */
+    LWMEM_WAL_DISARM(lwobj);                          /* Layout reached its consistent final state */
+
+    LWMEM_UPDATE_MIN_FREE(lwobj);
+    LWMEM_STATS_CNT_ALLOC(lwobj);
+    LWMEM_WATERMARK_CHECK(lwobj);
+
+#if LWMEM_ZERO_TRACK_EN
+    /* Track highest address handed out, memory above it remains untouched */
+    if ((LWMEM_TO_BYTE_PTR(curr) + (curr->size & ~LWMEM_ALLOC_BIT)) > lwobj->alloc_watermark) {
+        lwobj->alloc_watermark = LWMEM_TO_BYTE_PTR(curr) + (curr->size & ~LWMEM_ALLOC_BIT);
+    }
+#endif /* LWMEM_ZERO_TRACK_EN */
+
+    return retval;
+}
+
+#if LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN
+
+/**
+ * \brief           Private allocation function with deferred list fallback
+ *
+ * When allocation cannot be satisfied from the list of free blocks,
+ * deferred (or dirty pending) blocks are returned back and allocation is retried once
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from.
+ *                      Set to `NULL` for any region
+ * \param[in]       size: Application wanted size, excluding size of meta header
+ * \return          Pointer to allocated memory, `NULL` otherwise
+ */
+static void* LWMEM_HOT_FN_ATTR
+prv_alloc(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+    void* ptr = prv_alloc_no_coalesce(lwobj, region, size);
+
+#if LWMEM_DEFERRED_EN
+    if (ptr == NULL && lwobj->deferred_free != NULL) {
+        prv_coalesce_deferred(lwobj);
+        ptr = prv_alloc_no_coalesce(lwobj, region, size);
+    }
+#else  /* LWMEM_DEFERRED_EN */
+    if (ptr == NULL && lwobj->scrub_pending != NULL) {
+        prv_scrub_step(lwobj, 0); /* Force-scrub remaining dirty blocks */
+        ptr = prv_alloc_no_coalesce(lwobj, region, size);
+    }
+#endif /* !LWMEM_DEFERRED_EN */
+    return ptr;
+}
+
+#endif /* LWMEM_DEFERRED_EN || LWMEM_SCRUB_EN */
+
+/**
+ * \brief           Free input pointer
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Input pointer to free
+ */
+static void LWMEM_HOT_FN_ATTR
+prv_free(lwmem_t* const lwobj, void* const ptr) {
+    LWMEM_EVICTABLE_FORGET(lwobj, ptr); /* Every free path drops the block from the eviction registry */
+    lwmem_block_t* const block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (LWMEM_LIKELY(LWMEM_BLOCK_IS_ALLOC(block))) { /* Check if block is valid */
+        LWMEM_CHK_VERIFY(lwobj, block); /* Size field is about to be trusted for the insert */
+        LWMEM_WAL_ARM_BLOCK(lwobj, block); /* Pre-op size survives a power cut mid-insert */
+#if LWMEM_TAGS_EN
+        if (block->tag != NULL) { /* Remove block from its site accounting */
+            prv_tag_update(block->tag, 0, (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE);
+            block->tag = NULL;
+        }
+#endif /* LWMEM_TAGS_EN */
+#if LWMEM_GEN_EN
+        ++block->gen; /* Outstanding references to this block become stale now */
+#endif /* LWMEM_GEN_EN */
+#if LWMEM_EXACT_EN
+        {
+            const size_t raw_size = block->size & ~LWMEM_ALLOC_BIT;
+
+            /* Stash block for an upcoming same-size request. Entry keyed on the
+               exact block size; an occupied slot rotates, old entry goes to the list */
+            if (LWMEM_EXACT_SLOT(lwobj, raw_size)->block != NULL) {
+                lwmem_block_t* old = (lwmem_block_t*)LWMEM_EXACT_SLOT(lwobj, raw_size)->block;
+
+                LWMEM_EXACT_SLOT(lwobj, raw_size)->block = NULL;
+                old->size &= ~LWMEM_ALLOC_BIT;
+                lwobj->mem_available_bytes += old->size;
+                prv_insert_free_block(lwobj, old, NULL);
+            }
+            LWMEM_EXACT_SLOT(lwobj, raw_size)->block = (struct lwmem_block*)block;
+            LWMEM_EXACT_SLOT(lwobj, raw_size)->size = raw_size;
+            LWMEM_STATS_CNT_FREE(lwobj);
+            return;
+        }
+#endif /* LWMEM_EXACT_EN */
+        block->size &= ~LWMEM_ALLOC_BIT; /* Clear allocated bit indication */
+
+        lwobj->mem_available_bytes += block->size; /* Increase available bytes */
+        LWMEM_REGION_AVAIL(lwobj, block, 1, block->size);
+        LWMEM_REGION_COUNT(lwobj, block, 0);
+#if LWMEM_BT_EN
+        {
+            /* Physical predecessor is known from its footer: when free,
+               backward and forward merge complete without any list walk */
+            const size_t prev_footer = *(size_t*)(void*)(LWMEM_TO_BYTE_PTR(block) - LWMEM_BT_WORD);
+
+            if ((prev_footer & LWMEM_ALLOC_BIT) == 0) {
+                lwmem_block_t* prev_block = (void*)(LWMEM_TO_BYTE_PTR(block) - prev_footer);
+                lwmem_block_t* next_block;
+
+                LWMEM_NEXTFIT_FORGET(lwobj, prev_block);
+                prev_block->size += block->size;
+
+                next_block = (void*)(LWMEM_TO_BYTE_PTR(prev_block) + prev_block->size);
+                if (next_block->size > 0 && (next_block->size & LWMEM_ALLOC_BIT) == 0) {
+                    /* Adjacent free successor is the list neighbor of the predecessor */
+                    LWMEM_NEXTFIT_FORGET(lwobj, next_block);
+                    prev_block->size += next_block->size;
+                    prev_block->next = next_block->next;
+                }
+                LWMEM_BT_SET(prev_block);
+                LWMEM_STATS_CNT_FREE(lwobj);
+                LWMEM_WATERMARK_CHECK(lwobj);
+                return;
+            }
+        }
+#endif /* LWMEM_BT_EN */
+#if LWMEM_DEFERRED_EN && LWMEM_POLICY_EN
+        if (lwobj->policy_defer) { /* Policy decides between lazy and immediate coalescing */
+            block->next = lwobj->deferred_free;
+            lwobj->deferred_free = block;
+        } else {
+            prv_insert_free_block(lwobj, block, NULL);
+        }
+#elif LWMEM_DEFERRED_EN
+        /* Push to cheap LIFO list, coalescing is done lazily on demand */
+        block->next = lwobj->deferred_free;
+        lwobj->deferred_free = block;
+#elif LWMEM_SCRUB_EN
+        /* Queue dirty, block re-enters free list once scrubbed */
+        block->next = lwobj->scrub_pending;
+        lwobj->scrub_pending = block;
+#else  /* LWMEM_DEFERRED_EN */
+#if LWMEM_AUDIT_EN
+        {
+            lwmem_block_t* merged = prv_insert_free_block(lwobj, block, NULL);
+
+            if (merged != NULL) { /* Stamp free time and size for the reuse audit */
+                LWMEM_AUDIT_STAMP(merged)->free_tick = (size_t)LWMEM_GET_TICK();
+                LWMEM_AUDIT_STAMP(merged)->free_size = merged->size;
+            }
+        }
+#else  /* LWMEM_AUDIT_EN */
+        prv_insert_free_block(lwobj, block, NULL); /* Put block back to list of free block */
+#endif /* !LWMEM_AUDIT_EN */
+#endif /* !LWMEM_DEFERRED_EN */
+        LWMEM_SAN_HIDE(ptr, (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE); /* Freed area goes dark */
+        LWMEM_WAL_DISARM(lwobj); /* Free list reached its consistent final state */
+
+        LWMEM_STATS_CNT_FREE(lwobj);
+        LWMEM_WATERMARK_CHECK(lwobj);
+    }
+}
+
+#if LWMEM_CFG_SUPPORT_REALLOC
+
+/**
+ * \brief           Reallocates already allocated memory with new size
+ *
+ * Function behaves differently, depends on input parameter of `ptr` and `size`:
+ *
+ *  - `ptr == NULL; size == 0`: Function returns `NULL`, no memory is allocated or freed
+ *  - `ptr == NULL; size > 0`: Function tries to allocate new block of memory with `size` length, equivalent to `malloc(size)`
+ *  - `ptr != NULL; size == 0`: Function frees memory, equivalent to `free(ptr)`
+ *  - `ptr != NULL; size > 0`: Function tries to allocate new memory of copy content before returning pointer on success
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from.
+ *                      Set to `NULL` for any region
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \param[in]       allow_move: Set to `1` to allow allocation of new block with content copy
+ * \param[in]       preserve: Set to `1` to copy existing content on any block relocation,
+ *                      or `0` when caller regenerates the content anyway
+ *                      when block cannot be grown in place, or `0` to fail cleanly instead
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+static void*
+prv_realloc(lwmem_t* const lwobj, const lwmem_region_t* region, void* const ptr, const size_t size,
+            const uint8_t allow_move, const uint8_t preserve) {
+    lwmem_block_t *block = NULL, *prevprev = NULL, *prev = NULL;
+    size_t block_size; /* Holds size of input block (ptr), including metadata size */
+    size_t final_size = LWMEM_INSTANCE_SIZE_ALIGN(
+        lwobj,
+        LWMEM_BLOCK_SIZE_ALIGN(LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE
+                               + LWMEM_BT_EXTRA)); /* Size of new requested block, including metadata */
+    void* retval;                                  /* Return pointer, used with LWMEM_RETURN macro */
+
+#if LWMEM_BINS_EN || LWMEM_SKIP_EN || LWMEM_AUDIT_EN
+    if (final_size < LWMEM_BLOCK_MIN_SIZE) {
+        final_size = LWMEM_BLOCK_MIN_SIZE; /* Block must be able to hold free links once it gets freed */
+    }
+#endif /* LWMEM_BINS_EN || LWMEM_SKIP_EN */
+
+    /* Check optional input parameters */
+    if (size == 0) {
+        if (ptr != NULL) {
+            prv_free(lwobj, ptr);
+        }
+        return NULL;
+    }
+    if (ptr == NULL) {
+        return prv_alloc(lwobj, region, size);
+    }
+
+    /* Try to reallocate existing pointer */
+    if ((size & LWMEM_ALLOC_BIT) || (final_size & LWMEM_ALLOC_BIT)) {
+        return NULL;
+    }
+
+    /* Process existing block */
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (!LWMEM_BLOCK_IS_ALLOC(block)) {
+
+        /* Hard error. Input pointer is not NULL and block is not considered allocated */
+        return NULL;
+    }
+    block_size = block->size & ~LWMEM_ALLOC_BIT; /* Get actual block size, without memory allocation bit */
+
+    /* Check current block size is the same as new requested size */
+    if (block_size == final_size) {
+        return ptr; /* Just return pointer, nothing to do */
+    }
+
+    /*
+     * Abbreviations
+     *
+     * - "Current block" or "Input block" is allocated block from input variable "ptr"
+     * - "Next free block" is next free block, on address space after input block
+     * - "Prev free block" is last free block, on address space before input block
+     * - "PrevPrev free block" is previous free block of "Prev free block"
+     */
+
+    /*
+     * When new requested size is smaller than existing one,
+     * it is enough to modify size of current block only.
+     *
+     * If new requested size is much smaller than existing one,
+     * check if it is possible to create new empty block and add it to list of empty blocks
+     *
+     * Application returns same pointer
+     */
+    if (final_size < block_size) {
+        if ((block_size - final_size) >= LWMEM_BLOCK_MIN_SIZE) {
+            prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
+        } else {
+            /*
+             * It is not possible to create new empty block at the end of input block
+             *
+             * But if next free block is just after input block,
+             * it is possible to find this block and increase it by "block_size - final_size" bytes
+             */
+
+            /* Find free blocks before input block */
+            prv_get_prev_curr_of_block(lwobj, block, &prevprev, &prev);
+
+            /* Check if current block and next free are connected */
+            if ((LWMEM_TO_BYTE_PTR(block) + block_size) == LWMEM_TO_BYTE_PTR(prev->next)
+                && prev->next->size > 0) { /* Must not be end of region indicator */
+                /* Make temporary variables as prev->next will point to different location */
+                const size_t tmp_size = prev->next->size;
+                void* const tmp_next = prev->next->next;
+
+#if LWMEM_BINS_EN
+                prv_bin_unlink(lwobj, prev->next); /* Block will move in memory and change its size */
+#endif /* LWMEM_BINS_EN */
+                LWMEM_NEXTFIT_FORGET(lwobj, prev->next); /* Block will move in memory */
+#if LWMEM_SKIP_EN
+                prv_skip_remove(lwobj, prev->next); /* Block address is changing -> re-index below */
+#endif /* LWMEM_SKIP_EN */
+                /* Shift block up, effectively increase its size */
+                prev->next = (void*)(LWMEM_TO_BYTE_PTR(prev->next) - (block_size - final_size));
+                prev->next->size = tmp_size + (block_size - final_size);
+                prev->next->next = tmp_next;
+                LWMEM_BT_SET(prev->next);
+                LWMEM_CHK_SET(prev->next);
+                LWMEM_CHK_SET(prev);
+#if LWMEM_BINS_EN
+                prv_set_addr_prev(prev->next, prev);             /* Re-store links on new block location */
+                prv_set_addr_prev(prev->next->next, prev->next); /* Next block points to moved block */
+                prv_bin_insert(lwobj, prev->next);               /* Put block to bin matching its new size */
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+                prv_skip_insert(lwobj, prev->next); /* Put moved block back to the index */
+#endif /* LWMEM_SKIP_EN */
+
+                /* Increase available bytes by increase of free block */
+                lwobj->mem_available_bytes += block_size - final_size;
+                LWMEM_REGION_AVAIL(lwobj, block, 1, block_size - final_size);
+
+                block->size = final_size; /* Block size is requested size */
+            }
+        }
+        prv_block_set_alloc(block); /* Set block as allocated */
+        return ptr;                 /* Return existing pointer */
+    }
+
+    /* New requested size is bigger than current block size is */
+
+    /* Find last free (and its previous) block, located just before input block */
+    prv_get_prev_curr_of_block(lwobj, block, &prevprev, &prev);
+
+    /* If entry could not be found, there is a hard error */
+    if (prev == NULL) {
+        return NULL;
+    }
+
+    /* Order of variables is: | prevprev ---> prev --->--->--->--->--->--->--->--->--->---> prev->next  | */
     /*                        |                      (input_block, which is not on a list)              | */
     /* Input block points to address somewhere between "prev" and "prev->next" pointers                   */
 
-    /* Check if "block" and next free "prev->next" create contiguous memory with size of at least new requested size */
-    if ((LWMEM_TO_BYTE_PTR(block) + block_size) == LWMEM_TO_BYTE_PTR(prev->next)
-        && (block_size + prev->next->size) >= final_size) {
+    /* Check if "block" and next free "prev->next" create contiguous memory with size of at least new requested size */
+    if ((LWMEM_TO_BYTE_PTR(block) + block_size) == LWMEM_TO_BYTE_PTR(prev->next)
+        && (block_size + prev->next->size) >= final_size) {
+
+        /*
+         * Merge blocks together by increasing current block with size of next free one
+         * and remove next free from list of free blocks
+         */
+#if LWMEM_BINS_EN
+        prv_bin_unlink(lwobj, prev->next); /* Next block is being absorbed -> remove from its bin */
+#endif /* LWMEM_BINS_EN */
+        LWMEM_NEXTFIT_FORGET(lwobj, prev->next); /* Next block is being absorbed */
+#if LWMEM_SKIP_EN
+        prv_skip_remove(lwobj, prev->next); /* Next block is being absorbed -> remove from index */
+#endif /* LWMEM_SKIP_EN */
+        lwobj->mem_available_bytes -= prev->next->size; /* For now decrease effective available bytes */
+        LWMEM_REGION_AVAIL(lwobj, prev->next, 0, prev->next->size);
+        LWMEM_UPDATE_MIN_FREE(lwobj);
+        block->size = block_size + prev->next->size; /* Increase effective size of new block */
+        LWMEM_SAN_EXPOSE(LWMEM_GET_PTR_FROM_BLOCK(block), block->size - LWMEM_BLOCK_META_SIZE);
+        prev->next = prev->next->next;               /* Set next to next's next,
+                                                            effectively remove expanded block from free list */
+        LWMEM_CHK_SET(prev);
+#if LWMEM_BINS_EN
+        prv_set_addr_prev(prev->next, prev); /* Next block has new previous entry */
+#endif /* LWMEM_BINS_EN */
+
+        prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
+        prv_block_set_alloc(block);                        /* Set block as allocated */
+        return ptr;                                        /* Return existing pointer */
+    }
+
+    /*
+     * Check if "block" and last free before "prev" create contiguous memory with size of at least new requested size.
+     *
+     * It is necessary to make a memory move and shift content up as new return pointer is now upper on address space
+     */
+    if ((LWMEM_TO_BYTE_PTR(prev) + prev->size) == LWMEM_TO_BYTE_PTR(block) && (prev->size + block_size) >= final_size) {
+        /* Move memory from block to block previous to current */
+        void* const old_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(block);
+        void* const new_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(prev);
+
+        /*
+         * If memmove overwrites metadata of current block (when shifting content up),
+         * it is not an issue as we know its size (block_size) and next is already NULL.
+         *
+         * Memmove must be used to guarantee move of data as addresses + their sizes may overlap
+         *
+         * Metadata of "prev" are not modified during memmove
+         */
+#if LWMEM_BINS_EN
+        prv_bin_unlink(lwobj, prev); /* Remove from bin before move, links in user area are overwritten */
+#endif /* LWMEM_BINS_EN */
+        LWMEM_SAN_EXPOSE(LWMEM_GET_PTR_FROM_BLOCK(prev), prev->size - LWMEM_BLOCK_META_SIZE);
+        LWMEM_NEXTFIT_FORGET(lwobj, prev); /* Previous block is being used for allocation */
+#if LWMEM_SKIP_EN
+        prv_skip_remove(lwobj, prev); /* Remove from index before move, tower in user area is overwritten */
+#endif /* LWMEM_SKIP_EN */
+        if (preserve) {
+            LWMEM_MEMMOVE(new_data_ptr, old_data_ptr, block_size);
+        }
+
+        lwobj->mem_available_bytes -= prev->size; /* For now decrease effective available bytes */
+        LWMEM_REGION_AVAIL(lwobj, prev, 0, prev->size);
+        LWMEM_UPDATE_MIN_FREE(lwobj);
+        prev->size += block_size;    /* Increase size of input block size */
+        prevprev->next = prev->next; /* Remove prev from free list as it is now being used
+                                                for allocation together with existing block */
+        LWMEM_CHK_SET(prevprev);
+#if LWMEM_BINS_EN
+        prv_set_addr_prev(prevprev->next, prevprev); /* Next block has new previous entry */
+#endif /* LWMEM_BINS_EN */
+        block = prev;                /* Move block pointer to previous one */
+#if LWMEM_PIN_EN
+        block->pin_cnt = 0; /* Header comes from a free block, pins moved with the content owner */
+#endif /* LWMEM_PIN_EN */
+#if LWMEM_UDATA_EN
+        block->udata = 0; /* Header comes from a free block, metadata word did not travel */
+#endif /* LWMEM_UDATA_EN */
+
+        prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
+        prv_block_set_alloc(block);                        /* Set block as allocated */
+        LWMEM_EVICTABLE_REHOME(lwobj, old_data_ptr, new_data_ptr); /* Registry keeps tracking the moved block */
+        return new_data_ptr;                               /* Return new data ptr */
+    }
+
+    /*
+     * At this point, it was not possible to expand existing block with free before or free after due to:
+     * - Input block & next free block do not create contiguous block or its new size is too small
+     * - Previous free block & input block do not create contiguous block or its new size is too small
+     *
+     * Last option is to check if previous free block "prev", input block "block" and next free block "prev->next" create contiguous block
+     * and size of new block (from 3 contiguous blocks) together is big enough
+     */
+    if ((LWMEM_TO_BYTE_PTR(prev) + prev->size) == LWMEM_TO_BYTE_PTR(block)
+        && (LWMEM_TO_BYTE_PTR(block) + block_size) == LWMEM_TO_BYTE_PTR(prev->next)
+        && (prev->size + block_size + prev->next->size) >= final_size) {
+
+        /* Move memory from block to block previous to current */
+        void* const old_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(block);
+        void* const new_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(prev);
+
+        /*
+         * If memmove overwrites metadata of current block (when shifting content up),
+         * it is not an issue as we know its size (block_size) and next is already NULL.
+         *
+         * Memmove must be used to guarantee move of data as addresses and their sizes may overlap
+         *
+         * Metadata of "prev" are not modified during memmove
+         */
+#if LWMEM_BINS_EN
+        /* Both surrounding blocks are being absorbed -> remove from bins before move overwrites links */
+        prv_bin_unlink(lwobj, prev);
+        prv_bin_unlink(lwobj, prev->next);
+#endif /* LWMEM_BINS_EN */
+        LWMEM_SAN_EXPOSE(LWMEM_GET_PTR_FROM_BLOCK(prev), prev->size - LWMEM_BLOCK_META_SIZE);
+        LWMEM_SAN_EXPOSE(LWMEM_GET_PTR_FROM_BLOCK(prev->next), prev->next->size - LWMEM_BLOCK_META_SIZE);
+        LWMEM_NEXTFIT_FORGET(lwobj, prev);       /* Both surrounding blocks are being used for allocation */
+        LWMEM_NEXTFIT_FORGET(lwobj, prev->next);
+#if LWMEM_SKIP_EN
+        prv_skip_remove(lwobj, prev);
+        prv_skip_remove(lwobj, prev->next);
+#endif /* LWMEM_SKIP_EN */
+        if (preserve) {
+            LWMEM_MEMMOVE(new_data_ptr, old_data_ptr, block_size);
+        }
+
+        /* Decrease effective available bytes for free blocks before and after input block */
+        lwobj->mem_available_bytes -= prev->size + prev->next->size;
+        LWMEM_REGION_AVAIL(lwobj, prev, 0, prev->size + prev->next->size);
+        LWMEM_UPDATE_MIN_FREE(lwobj);
+        prev->size += block_size + prev->next->size; /* Increase size of new block by size of 2 free blocks */
+
+        /* Remove free block before current one and block after current one from linked list (remove 2) */
+        prevprev->next = prev->next->next;
+        LWMEM_CHK_SET(prevprev);
+#if LWMEM_BINS_EN
+        prv_set_addr_prev(prevprev->next, prevprev); /* Next block has new previous entry */
+#endif /* LWMEM_BINS_EN */
+        block = prev; /* Previous block is now current */
+#if LWMEM_PIN_EN
+        block->pin_cnt = 0; /* Header comes from a free block, pins moved with the content owner */
+#endif /* LWMEM_PIN_EN */
+#if LWMEM_UDATA_EN
+        block->udata = 0; /* Header comes from a free block, metadata word did not travel */
+#endif /* LWMEM_UDATA_EN */
+
+        prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
+        prv_block_set_alloc(block);                        /* Set block as allocated */
+        LWMEM_EVICTABLE_REHOME(lwobj, old_data_ptr, new_data_ptr); /* Registry keeps tracking the moved block */
+        return new_data_ptr;                               /* Return new data ptr */
+    }
+
+    /*
+     * If application reaches this point, it means:
+     * - New requested size is greater than input block size
+     * - Input block & next free block do not create contiguous block or its new size is too small
+     * - Last free block & input block do not create contiguous block or its new size is too small
+     * - Last free block & input block & next free block do not create contiguous block or its size is too small
+     *
+     * Final solution is to find completely new empty block of sufficient size and copy content from old one to new one
+     */
+    if (!allow_move) {
+        return NULL; /* Caller accepts in-place operations only */
+    }
+#if LWMEM_CFG_REALLOC_GROWTH
+    /* Relocation reserves growth headroom, so subsequent grows stay in place */
+    if (lwobj->realloc_growth_pct > 100) {
+        const size_t grown_size = (size * lwobj->realloc_growth_pct) / 100;
+
+        if (grown_size > size) { /* Guard against multiplication overflow */
+            retval = prv_alloc(lwobj, region, grown_size);
+            if (retval != NULL) {
+                block_size = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+                if (preserve) {
+                    LWMEM_MEMCPY(retval, ptr, size > block_size ? block_size : size);
+                }
+                LWMEM_EVICTABLE_REHOME(lwobj, ptr, retval); /* Registry keeps tracking the moved block */
+                prv_free(lwobj, ptr);
+                return retval;
+            }
+            /* Headroom not available -> fall back to the exact request */
+        }
+    }
+#endif /* LWMEM_CFG_REALLOC_GROWTH */
+    retval = prv_alloc(lwobj, region, size); /* Try to allocate new block */
+    if (retval != NULL) {
+        /* Get application size from input pointer, then copy content to new block */
+        block_size = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+        if (preserve) {
+            LWMEM_MEMCPY(retval, ptr, size > block_size ? block_size : size);
+        }
+        LWMEM_EVICTABLE_REHOME(lwobj, ptr, retval); /* Registry keeps tracking the moved block */
+        prv_free(lwobj, ptr); /* Free old block */
+    }
+    return retval;
+}
+
+#endif /* LWMEM_CFG_SUPPORT_REALLOC */
+
+/**
+ * \brief           Assign the memory structure for advanced memory allocation system
+ * 
+ * \param           lwobj 
+ * \param           regions 
+ * \return          size_t 
+ */
+static size_t
+prv_assignmem(lwmem_t* lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    lwmem_block_t *first_block = NULL, *prev_end_block = NULL;
+
+    for (size_t idx = 0; regions->size > 0 && regions->start_addr != NULL; ++idx, ++regions) {
+        /* Get region start address and size, stop on failure */
+        if (!prv_get_region_addr_size(regions, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+#if LWMEM_CFG_PER_INSTANCE_ALIGN
+        /* Apply instance specific alignment on top of the compile-time one */
+        if (lwobj->instance_align > 0 && (((size_t)mem_start_addr) & (lwobj->instance_align - 1)) > 0) {
+            const size_t shift = lwobj->instance_align - (((size_t)mem_start_addr) & (lwobj->instance_align - 1));
+
+            mem_start_addr += shift;
+            mem_size = (mem_size - shift) & ~(lwobj->instance_align - 1);
+            if (mem_size < (2 * LWMEM_BLOCK_MIN_SIZE)) {
+                continue;
+            }
+        } else if (lwobj->instance_align > 0) {
+            mem_size &= ~(lwobj->instance_align - 1);
+        }
+#endif /* LWMEM_CFG_PER_INSTANCE_ALIGN */
+
+        /*
+         * If end_block == NULL, this indicates first iteration.
+         * In first indication application shall set start_block and never again
+         * end_block value holds
+         */
+        if (lwobj->end_block == NULL) {
+            /*
+             * Next entry of start block is first region
+             * It points to beginning of region data
+             * In the later step(s) first block is manually set on top of memory region
+             */
+            lwobj->start_block.next = (void*)(mem_start_addr + LWMEM_BT_EXTRA);
+            lwobj->start_block.size = 0; /* Size of dummy start block is zero */
+        }
+
+        /* Save current end block status as it is used later for linked list insertion */
+        prev_end_block = lwobj->end_block;
+
+        /* Put end block to the end of the region with size = 0 */
+        lwobj->end_block = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
+        lwobj->end_block->next = NULL; /* End block in region does not have next entry */
+        lwobj->end_block->size = 0;    /* Size of end block is zero */
+
+        /*
+         * Create memory region first block.
+         *
+         * First block meta size includes size of metadata too
+         * Subtract MEM_BLOCK_META_SIZE as there is one more block (end_block) at the end of region
+         *
+         * Actual maximal available size for application in the region is mem_size - 2 * MEM_BLOCK_META_SIZE
+         */
+#if LWMEM_BT_EN
+        /* Allocated-marked sentinel keeps backward merge from reading below the region */
+        *(size_t*)(void*)mem_start_addr = LWMEM_ALLOC_BIT | LWMEM_BT_WORD;
+        first_block = (void*)(mem_start_addr + LWMEM_BT_WORD);
+        first_block->next = lwobj->end_block; /* Next block of first is last block */
+        first_block->size = mem_size - LWMEM_BLOCK_META_SIZE - LWMEM_BT_WORD;
+        LWMEM_BT_SET(first_block);
+#else  /* LWMEM_BT_EN */
+        first_block = (void*)mem_start_addr;
+        first_block->next = lwobj->end_block; /* Next block of first is last block */
+        first_block->size = mem_size - LWMEM_BLOCK_META_SIZE;
+#endif /* !LWMEM_BT_EN */
+
+        LWMEM_CHK_SET(first_block);
+        LWMEM_CHK_SET(lwobj->end_block);
+        LWMEM_CHK_SET(&lwobj->start_block);
+
+        /* Check if previous regions exist by checking previous end block state */
+        if (prev_end_block != NULL) {
+            prev_end_block->next = first_block; /* End block of previous region now points to start of current region */
+            LWMEM_CHK_SET(prev_end_block);
+        }
+
+#if LWMEM_PER_REGION_EN
+        /* Remember stable anchor and address range of the region */
+        lwobj->region_heads[lwobj->mem_regions_count].head =
+            prev_end_block != NULL ? prev_end_block : &(lwobj->start_block);
+        lwobj->region_heads[lwobj->mem_regions_count].start_addr = mem_start_addr;
+        lwobj->region_heads[lwobj->mem_regions_count].size = mem_size;
+#if LWMEM_REGION_ATTR_EN
+        lwobj->region_heads[lwobj->mem_regions_count].attr = regions->attr;
+        lwobj->region_heads[lwobj->mem_regions_count].priority = regions->priority;
+#endif /* LWMEM_REGION_ATTR_EN */
+#if LWMEM_REGION_STATS_EN
+        lwobj->region_heads[lwobj->mem_regions_count].stats.mem_size_bytes = (uint32_t)first_block->size;
+        lwobj->region_heads[lwobj->mem_regions_count].stats.mem_available_bytes = (uint32_t)first_block->size;
+        lwobj->region_heads[lwobj->mem_regions_count].stats.minimum_ever_mem_available_bytes =
+            (uint32_t)first_block->size;
+#endif /* LWMEM_REGION_STATS_EN */
+#if LWMEM_REGION_FB_EN
+        lwobj->region_heads[lwobj->mem_regions_count].fallback_idx = 0xFFU; /* No fallback by default */
+#endif /* LWMEM_REGION_FB_EN */
+#endif /* LWMEM_PER_REGION_EN */
+
+#if LWMEM_BINS_EN
+        /* Put region block to respective size-class bin and link it backwards */
+        prv_set_addr_prev(first_block, prev_end_block != NULL ? prev_end_block : &(lwobj->start_block));
+        prv_bin_insert(lwobj, first_block);
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+        prv_skip_insert(lwobj, first_block); /* Put region block to the index */
+#endif /* LWMEM_SKIP_EN */
+
+        lwobj->mem_available_bytes += first_block->size; /* Increase number of available bytes */
+        ++lwobj->mem_regions_count;                      /* Increase number of used regions */
+    }
+
+#if defined(LWMEM_DEV)
+    /* Copy default state of start block */
+    LWMEM_MEMCPY(&lwmem_default.start_block_first_use, &lwmem_default.start_block, sizeof(lwmem_default.start_block));
+#endif /* defined(LWMEM_DEV) */
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes = lwobj->mem_available_bytes;
+    lwobj->stats.minimum_ever_mem_available_bytes = lwobj->mem_available_bytes;
+#if LWMEM_CFG_WINDOWED_STATS
+    lwobj->win_min_avail = (uint32_t)lwobj->mem_available_bytes;
+#endif /* LWMEM_CFG_WINDOWED_STATS */
+#endif
+
+    return lwobj->mem_regions_count; /* Return number of regions used by manager */
+}
+
+#endif /* !LWMEM_BUDDY_EN && !LWMEM_OOB_EN */
+
+#else /* LWMEM_CFG_FULL */
+
+/**
+ * \brief           Assign the regions for simple algorithm
+ * 
+ *                  At this point, regions check has been performed, so we assume
+ *                  everything is ready to proceed
+ * 
+ * \param           lwobj: LwMEM object
+ * \param           regions: List of regions to assign
+ * \return          Number of regions used
+ */
+static size_t
+prv_assignmem_simple(lwmem_t* const lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = regions[0].start_addr;
+    size_t mem_size = regions[0].size, len = 1;
+
+    /* Adjust alignment data */
+    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) {
+        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
+        mem_size -= (size_t)(mem_start_addr - LWMEM_TO_BYTE_PTR(regions[0].start_addr));
+    }
+
+    /* Align mem to alignment*/
+    mem_size = mem_size & ~LWMEM_ALIGN_BITS;
+
+    /* Store the available information */
+    lwobj->mem_available_bytes = mem_size;
+    lwobj->mem_next_available_ptr = mem_start_addr;
+#if LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+    lwobj->mem_end_ptr = mem_start_addr + mem_size; /* Stable limit for lock-free allocation */
+#else  /* LWMEM_CFG_ATOMIC_SIMPLE_ALLOC */
+    /* Remaining regions are walked lazily as memory gets exhausted */
+    lwobj->region_idx = 0;
+    for (; regions[len].size > 0 && regions[len].start_addr != NULL; ++len) {}
+#endif /* !LWMEM_CFG_ATOMIC_SIMPLE_ALLOC */
+    lwobj->is_initialized = 1;
+    return len;
+}
+
+/**
+ * \brief           Simple allocation algorithm, that can only allocate memory,
+ *                  but it does not support free.
+ * 
+ *                  It uses simple first-in-first-serve concept,
+ *                  where memory grows upward gradually, up until it reaches the end
+ *                  of memory area
+ * 
+ * \param           lwobj: LwMEM object
+ * \param           region: Selected region. Not used in the current revision,
+ *                      but footprint remains the same if one day library will support it
+ * \param           size: Requested allocation size
+ * \return          `NULL` on failure, or pointer to allocated memory
+ */
+static void*
+prv_alloc_simple(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
+    void* retval = NULL;
+    const size_t alloc_size = LWMEM_ALIGN(size);
+
+#if LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+    uint8_t* old_ptr = atomic_load(&(lwobj->mem_next_available_ptr));
+
+    /* Advance bump pointer with compare-and-swap, retry when another thread won the race */
+    do {
+        if (old_ptr == NULL || alloc_size > (size_t)(lwobj->mem_end_ptr - old_ptr)) {
+            return NULL;
+        }
+    } while (!atomic_compare_exchange_weak(&(lwobj->mem_next_available_ptr), &old_ptr, old_ptr + alloc_size));
+    retval = old_ptr;
+    atomic_fetch_sub(&(lwobj->mem_available_bytes), alloc_size);
+#else  /* LWMEM_CFG_ATOMIC_SIMPLE_ALLOC */
+    /* Advance to next region(s) when current one cannot hold the request */
+    while (alloc_size > lwobj->mem_available_bytes && lwobj->regions_list != NULL
+           && lwobj->regions_list[lwobj->region_idx + 1].size > 0
+           && lwobj->regions_list[lwobj->region_idx + 1].start_addr != NULL) {
+        const lwmem_region_t* next_region = &lwobj->regions_list[++lwobj->region_idx];
+        uint8_t* mem_start_addr = next_region->start_addr;
+        size_t mem_size = next_region->size;
+
+        if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) { /* Check alignment boundary */
+            mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
+            mem_size -= (size_t)(mem_start_addr - LWMEM_TO_BYTE_PTR(next_region->start_addr));
+        }
+        lwobj->mem_next_available_ptr = mem_start_addr;
+        lwobj->mem_available_bytes = mem_size & ~LWMEM_ALIGN_BITS;
+    }
+    if (alloc_size <= lwobj->mem_available_bytes) {
+        retval = lwobj->mem_next_available_ptr;
+
+        /* Get ready for next iteration */
+        lwobj->mem_next_available_ptr += alloc_size;
+        lwobj->mem_available_bytes -= alloc_size;
+    }
+#endif /* !LWMEM_CFG_ATOMIC_SIMPLE_ALLOC */
+    (void)region;
+    return retval;
+}
+
+#endif /* LWMEM_CFG_FULL */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Walk all blocks (allocated and free) of the instance
+ *
+ * Callback is invoked for every block under the instance lock, in address
+ * order per region, so monitoring tasks can compute custom metrics or a crash
+ * handler can dump heap state without printf-based tooling. Callback must be
+ * short and must not allocate or free memory
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       callback: Function called for every block
+ * \param[in]       user: User argument passed to the callback
+ * \return          Number of visited blocks
+ * \note            Walk is only supported by list-based allocation strategies.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_walk_ex(lwmem_t* lwobj, lwmem_walk_fn callback, void* user) {
+    size_t count = 0;
+
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    if (callback == NULL) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+
+        /* Step over physical blocks up to end of region indicator */
+        for (lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA);;) {
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+            if (block_size == 0) { /* End of region indicator */
+                break;
+            }
+            ++count;
+            if (!callback(lwobj, block, block_size, !LWMEM_BLOCK_IS_ALLOC(block), user)) {
+                LWMEM_UNPROTECT(lwobj);
+                return count;
+            }
+            block = (void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+    (void)lwobj;
+    (void)callback;
+    (void)user;
+#endif /* LWMEM_BUDDY_EN || LWMEM_COMPACT_EN || LWMEM_OOB_EN || LWMEM_SO_EN */
+    return count;
+}
+
+/**
+ * \brief           Serialize heap layout into a compact binary stream
+ *
+ * Stream format (all little endian, native width):
+ *  - header: `"LWSN"`, `uint16_t` version (`1`), `uint16_t` pointer size
+ *  - per region: `0xFFFFFFFF` marker, `uintptr_t` start address, `uint32_t` size
+ *  - per block: `uint32_t` offset in region, `uint32_t` size with MSB set for allocated blocks
+ *
+ * Intended to be streamed over UART/RTT and replayed through desktop tooling
+ * to visualize fragmentation evolution over long soak runs
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       write_fn: Stream writer called with data chunks
+ * \param[in]       user: User argument passed to the writer
+ * \return          `1` when complete snapshot has been streamed, `0` otherwise
+ * \note            Snapshot is only supported by list-based allocation strategies.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+LWMEM_COLD_FN uint8_t
+lwmem_snapshot_ex(lwmem_t* lwobj, lwmem_snapshot_write_fn write_fn, void* user) {
+    uint8_t success = 0;
+
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    const struct {
+        char magic[4];
+        uint16_t version;
+        uint16_t ptr_size;
+    } header = {{'L', 'W', 'S', 'N'}, 1, (uint16_t)sizeof(void*)};
+
+    if (write_fn == NULL) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    success = write_fn(user, &header, sizeof(header));
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         success && region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        {
+            const uint32_t marker = 0xFFFFFFFFU;
+            const uintptr_t addr = (uintptr_t)mem_start_addr;
+            const uint32_t rsize = (uint32_t)mem_size;
+
+            success = write_fn(user, &marker, sizeof(marker)) && write_fn(user, &addr, sizeof(addr))
+                      && write_fn(user, &rsize, sizeof(rsize));
+        }
+        for (const lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA); success;) {
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+            uint32_t rec[2];
+
+            if (block_size == 0) { /* End of region indicator */
+                break;
+            }
+            rec[0] = (uint32_t)(LWMEM_TO_BYTE_PTR(block) - mem_start_addr);
+            rec[1] = (uint32_t)block_size | (LWMEM_BLOCK_IS_ALLOC(block) ? 0x80000000U : 0);
+            success = write_fn(user, rec, sizeof(rec));
+            block = (const void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+    (void)lwobj;
+    (void)write_fn;
+    (void)user;
+#endif /* LWMEM_BUDDY_EN || LWMEM_COMPACT_EN || LWMEM_OOB_EN || LWMEM_SO_EN */
+    return success;
+}
+
+/**
+ * \brief           Cursor over a serialized heap snapshot stream
+ */
+typedef struct {
+    const uint8_t* data; /*!< Stream data */
+    size_t len;          /*!< Stream length */
+    size_t pos;          /*!< Read position */
+    uintptr_t region;    /*!< Region base of the record cursor is in */
+} snapshot_cursor_t;
+
+/**
+ * \brief           Advance cursor to next allocated-block record
+ * \param[in]       cursor: Stream cursor
+ * \param[out]      offset: Block offset output
+ * \param[out]      size: Block size output (allocation flag stripped)
+ * \return          `1` when an allocated record has been produced, `0` at end of stream
+ */
+static uint8_t
+prv_snapshot_next_alloc(snapshot_cursor_t* cursor, uint32_t* offset, uint32_t* size) {
+    while ((cursor->pos + 2 * sizeof(uint32_t)) <= cursor->len) {
+        uint32_t first;
+
+        LWMEM_MEMCPY(&first, &cursor->data[cursor->pos], sizeof(first));
+        if (first == 0xFFFFFFFFU) { /* Region record: marker, address, size */
+            if ((cursor->pos + sizeof(uint32_t) + sizeof(uintptr_t) + sizeof(uint32_t)) > cursor->len) {
+                return 0;
+            }
+            LWMEM_MEMCPY(&cursor->region, &cursor->data[cursor->pos + sizeof(uint32_t)], sizeof(cursor->region));
+            cursor->pos += sizeof(uint32_t) + sizeof(uintptr_t) + sizeof(uint32_t);
+            continue;
+        }
+        LWMEM_MEMCPY(size, &cursor->data[cursor->pos + sizeof(uint32_t)], sizeof(*size));
+        cursor->pos += 2 * sizeof(uint32_t);
+        if ((*size & 0x80000000U) > 0) { /* Allocated block record */
+            *offset = first;
+            *size &= ~0x80000000U;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Check whether snapshot contains an allocated block at region/offset
+ */
+static uint8_t
+prv_snapshot_contains(const void* snap, size_t len, uintptr_t region, uint32_t offset) {
+    snapshot_cursor_t cursor = {snap, len, sizeof(uint32_t) * 2, 0};
+    uint32_t rec_offset, rec_size;
+
+    while (prv_snapshot_next_alloc(&cursor, &rec_offset, &rec_size)) {
+        if (cursor.region == region && rec_offset == offset) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Report allocations present in snapshot B but not in snapshot A
+ *
+ * Feed two streams captured with \ref lwmem_snapshot_ex (e.g. before and
+ * after a steady-state soak window): every block allocated in B at an
+ * offset that was not allocated in A is reported - the allocation-regression
+ * gate for CI-on-hardware rigs, catching idle-loop allocations before they
+ * become fragmentation problems
+ *
+ * \param[in]       snap_a: Baseline snapshot stream
+ * \param[in]       len_a: Baseline stream length
+ * \param[in]       snap_b: Later snapshot stream
+ * \param[in]       len_b: Later stream length
+ * \param[in]       report_fn: Called once per new allocation, may be `NULL` to only count
+ * \param[in]       user: User argument passed to the callback
+ * \return          Number of new allocations found
+ */
+size_t
+lwmem_snapshot_diff(const void* snap_a, size_t len_a, const void* snap_b, size_t len_b,
+                    lwmem_snapshot_diff_fn report_fn, void* user) {
+    snapshot_cursor_t cursor = {snap_b, len_b, sizeof(uint32_t) * 2, 0};
+    uint32_t offset, size;
+    size_t count = 0;
+
+    if (snap_a == NULL || snap_b == NULL || len_a < 8 || len_b < 8 || memcmp(snap_b, "LWSN", 4) != 0
+        || memcmp(snap_a, "LWSN", 4) != 0) {
+        return 0;
+    }
+    while (prv_snapshot_next_alloc(&cursor, &offset, &size)) {
+        if (!prv_snapshot_contains(snap_a, len_a, cursor.region, offset)) {
+            ++count;
+            if (report_fn != NULL) {
+                report_fn(cursor.region, offset, size, user);
+            }
+        }
+    }
+    return count;
+}
+
+/**
+ * \brief           Verify heap invariants, cheap enough for a watchdog task
+ *
+ * Physical block chains of all regions are checked for aligned in-range
+ * sizes, valid allocation marks and exact termination at the end of region
+ * indicator; the free list is checked for strict address ordering and
+ * free-state entries. First violation stops the walk and reports the block,
+ * localizing corruption (e.g. a DMA overrun) for post-mortem analysis
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       max_blocks: Maximal number of blocks to verify, `0` for no limit
+ * \param[out]      fault_addr: Optional output for address of the offending block
+ * \return          \ref LWMEM_VALIDATE_OK on success, fault code otherwise
+ * \note            Validation is only supported by list-based allocation strategies.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+LWMEM_COLD_FN lwmem_validate_res_t
+lwmem_validate_ex(lwmem_t* lwobj, size_t max_blocks, void** fault_addr) {
+    lwmem_validate_res_t res = LWMEM_VALIDATE_OK;
+    void* fault = NULL;
+
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, budget = max_blocks > 0 ? max_blocks : (size_t)-1;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+
+    /* Physical walk over all blocks of every region */
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         res == LWMEM_VALIDATE_OK && budget > 0 && region != NULL && region->size > 0 && region->start_addr != NULL;
+         ++region) {
+        const uint8_t* region_end;
+
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        region_end = mem_start_addr + mem_size;
+        for (const lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA); budget > 0; --budget) {
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+            if (block_size == 0) {
+                /* Chain must terminate exactly at the end of region indicator position */
+                if (LWMEM_TO_BYTE_PTR(block) != (region_end - LWMEM_BLOCK_META_SIZE)) {
+                    res = LWMEM_VALIDATE_ERR_CHAIN;
+                    fault = (void*)block;
+                }
+                break;
+            }
+            if ((block_size & LWMEM_ALIGN_BITS) > 0
+                || (LWMEM_TO_BYTE_PTR(block) + block_size) > (region_end - LWMEM_BLOCK_META_SIZE)) {
+                res = LWMEM_VALIDATE_ERR_SIZE;
+                fault = (void*)block;
+                break;
+            }
+            if ((block->size & LWMEM_ALLOC_BIT) > 0 && !LWMEM_BLOCK_IS_ALLOC(block)) {
+                res = LWMEM_VALIDATE_ERR_MARK;
+                fault = (void*)block;
+                break;
+            }
+            block = (const void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+        }
+    }
+
+    /* Free list must be strictly address ordered, in-range and with free-state entries only */
+    if (res == LWMEM_VALIDATE_OK) {
+        for (const lwmem_block_t* block = lwobj->start_block.next; block != NULL && budget > 0;
+             block = block->next, --budget) {
+            uint8_t in_range = 0;
+
+            /* Never dereference a link before proving it points into a region */
+            for (const lwmem_region_t* region = lwobj->regions_list;
+                 !in_range && region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+                in_range = LWMEM_TO_BYTE_PTR(block) >= LWMEM_TO_BYTE_PTR(region->start_addr)
+                           && LWMEM_TO_BYTE_PTR(block) < (LWMEM_TO_BYTE_PTR(region->start_addr) + region->size);
+            }
+            if (!in_range) {
+                res = LWMEM_VALIDATE_ERR_LIST_PTR;
+                fault = (void*)block;
+                break;
+            }
+            if ((block->size & LWMEM_ALLOC_BIT) > 0) {
+                res = LWMEM_VALIDATE_ERR_FREE_BIT;
+                fault = (void*)block;
+                break;
+            }
+            if (block->next != NULL && block->next <= block) {
+                res = LWMEM_VALIDATE_ERR_ORDER;
+                fault = (void*)block;
+                break;
+            }
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+    (void)lwobj;
+    (void)max_blocks;
+#endif /* LWMEM_BUDDY_EN || LWMEM_COMPACT_EN || LWMEM_OOB_EN || LWMEM_SO_EN */
+    if (fault_addr != NULL) {
+        *fault_addr = fault;
+    }
+    return res;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_ALLOC_HISTOGRAM || __DOXYGEN__
+
+/**
+ * \brief           Read allocation size histogram of the instance
+ *
+ * Bucket `i` counts requests of up to `2^i` bytes,
+ * last bucket counts everything larger
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[out]      buckets: Array to copy bucket counters to
+ * \param[in]       bucket_count: Number of entries in the output array
+ * \return          Number of copied buckets
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_get_histogram_ex(lwmem_t* lwobj, uint32_t* buckets, size_t bucket_count) {
+    size_t len = 0;
+
+    if (buckets != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        len = bucket_count < LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS ? bucket_count : LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS;
+        LWMEM_PROTECT(lwobj);
+        LWMEM_MEMCPY(buckets, lwobj->alloc_histogram, len * sizeof(*buckets));
+        LWMEM_UNPROTECT(lwobj);
+    }
+    return len;
+}
+
+#endif /* LWMEM_CFG_ALLOC_HISTOGRAM || __DOXYGEN__ */
+
+#if LWMEM_CFG_INSTANCE_REGISTRY
+
+/**
+ * \brief           Registry of initialized instances, used for pointer owner lookup
+ */
+static lwmem_t* instance_registry[LWMEM_CFG_INSTANCE_REGISTRY_SIZE];
+
+/**
+ * \brief           Put instance to the registry, once
+ * \param[in]       lwobj: Initialized LwMEM instance
+ */
+static void
+prv_registry_add(lwmem_t* lwobj) {
+    for (size_t idx = 0; idx < LWMEM_CFG_INSTANCE_REGISTRY_SIZE; ++idx) {
+        if (instance_registry[idx] == lwobj) {
+            return;
+        }
+        if (instance_registry[idx] == NULL) {
+            instance_registry[idx] = lwobj;
+            return;
+        }
+    }
+}
+
+/**
+ * \brief           Find instance owning the pointer, from registered region address ranges
+ * \param[in]       ptr: Pointer to look up
+ * \return          Owning LwMEM instance, `NULL` when pointer belongs to no registered instance
+ */
+lwmem_t*
+lwmem_find_owner(void* ptr) {
+    if (ptr != NULL) {
+        for (size_t idx = 0; idx < LWMEM_CFG_INSTANCE_REGISTRY_SIZE; ++idx) {
+            lwmem_t* lwobj = instance_registry[idx];
+
+            if (lwobj == NULL) {
+                break;
+            }
+            for (const lwmem_region_t* region = lwobj->regions_list;
+                 region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+                if (LWMEM_TO_BYTE_PTR(ptr) >= LWMEM_TO_BYTE_PTR(region->start_addr)
+                    && LWMEM_TO_BYTE_PTR(ptr) < (LWMEM_TO_BYTE_PTR(region->start_addr) + region->size)) {
+                    return lwobj;
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+#if LWMEM_CFG_FULL
+
+/**
+ * \brief           Free memory in whichever registered instance owns it
+ *
+ * Removes the need to carry a per-object back pointer to the owning heap
+ * in multi-instance deployments
+ *
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
+ * \return          `1` when owning instance was found, `0` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_free_any(void* ptr) {
+    lwmem_t* lwobj = lwmem_find_owner(ptr);
+
+    if (lwobj != NULL) {
+        lwmem_free_ex(lwobj == &lwmem_default ? NULL : lwobj, ptr);
+        return 1;
+    }
+    return 0;
+}
+
+#endif /* LWMEM_CFG_FULL */
+
+#endif /* LWMEM_CFG_INSTANCE_REGISTRY */
+
+/**
+ * \brief           Initializes and assigns user regions for memory used by allocator algorithm
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       regions: Pointer to array of regions with address and respective size.
+ *                      Regions must be in increasing order (start address) and must not overlap in-between.
+ *                      Last region entry must have address `NULL` and size set to `0`
+ * \code{.c}
+//Example definition
+lwmem_region_t regions[] = {
+    { (void *)0x10000000, 0x1000 }, //Region starts at address 0x10000000 and is 0x1000 bytes long
+    { (void *)0x20000000, 0x2000 }, //Region starts at address 0x20000000 and is 0x2000 bytes long
+    { (void *)0x30000000, 0x3000 }, //Region starts at address 0x30000000 and is 0x3000 bytes long
+    { NULL, 0 }                     //Array termination indicator
+}
+\endcode
+ * \return          `0` on failure, number of final regions used for memory manager on success
+ * \note            This function is not thread safe when used with operating system.
+ *                      It must be called only once to setup memory regions
+ */
+size_t
+lwmem_assignmem_ex(lwmem_t* lwobj, const lwmem_region_t* regions) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, len = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+
+    /* Check first things first */
+    if (regions == NULL
+#if LWMEM_CFG_FULL && LWMEM_CFG_OOB_METADATA
+        || lwobj->oob_base != NULL /* Init function may only be called once per lwmem instance */
+#elif LWMEM_CFG_FULL && LWMEM_CFG_COMPACT_HEADER
+        || lwobj->compact_base != NULL /* Init function may only be called once per lwmem instance */
+#elif LWMEM_CFG_FULL && (LWMEM_CFG_ALLOC_STRATEGY == LWMEM_ALLOC_STRATEGY_BUDDY)
+        || lwobj->buddy_base != NULL /* Init function may only be called once per lwmem instance */
+#elif LWMEM_CFG_FULL
+        || lwobj->end_block != NULL /* Init function may only be called once per lwmem instance */
+#else
+        || lwobj->is_initialized /* Already initialized? */
+#endif /* LWMEM_CFG_FULL */
+    ) {
+        return 0;
+    }
+
+    /* Check values entered by application */
+    mem_start_addr = (void*)0;
+    mem_size = 0;
+    for (size_t idx = 0;; ++idx) {
+        /*
+         * Check for valid entry or end of array descriptor
+         * Invalid entry is considered as "end-of-region" indicator
+         */
+        if (regions[idx].size == 0 && regions[idx].start_addr == NULL) {
+            len = idx;
+            if (len == 0) {
+                return 0;
+            }
+            break;
+        }
+#if LWMEM_CFG_FULL && LWMEM_CFG_PER_REGION_LISTS
+        else if (idx >= LWMEM_CFG_MAX_REGIONS) {
+            return 0; /* Number of regions is limited when per-region anchors are used */
+        }
+#endif /* LWMEM_CFG_FULL && LWMEM_CFG_PER_REGION_LISTS */
+
+#if (!LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC) || LWMEM_CFG_SINGLE_REGION
+        /*
+         * Single-region configurations allow exactly one region:
+         * lock-free simple allocation uses a single stable end pointer and
+         * the single-region specialization compiles the lookup paths out.
+         */
+        else if (idx > 0) {
+            return 0;
+        }
+#endif /* (!LWMEM_CFG_FULL && LWMEM_CFG_ATOMIC_SIMPLE_ALLOC) || LWMEM_CFG_SINGLE_REGION */
+
+        /* New region(s) must be higher (in address space) than previous one */
+        if ((mem_start_addr + mem_size) > LWMEM_TO_BYTE_PTR(regions[idx].start_addr)) {
+            return 0;
+        }
+
+        /* Save new values for next round */
+        mem_start_addr = regions[idx].start_addr;
+        mem_size = regions[idx].size;
+    }
+
+    /* Final init and check before initializing the regions */
+    if (len == 0
+#if LWMEM_CFG_OS && LWMEM_CFG_PER_INSTANCE_LOCKING
+        /* Lock-disabled instances need no mutex at all */
+        || (!lwobj->lock_disabled
+            && (lwmem_sys_mutex_isvalid(&(lwobj->mutex)) || !lwmem_sys_mutex_create(&(lwobj->mutex))))
+#elif LWMEM_CFG_OS
+        || lwmem_sys_mutex_isvalid(&(lwobj->mutex)) /* Check if mutex valid already = must not be */
+        || !lwmem_sys_mutex_create(&(lwobj->mutex)) /* Final step = try to create mutex for new instance */
+#endif                                              /* LWMEM_CFG_OS */
+    ) {
+        return 0;
+    }
+
+    lwobj->regions_list = regions; /* Regions array must stay valid for instance lifetime */
+#if LWMEM_CFG_INSTANCE_REGISTRY
+    prv_registry_add(lwobj); /* Make instance discoverable for owner lookup */
+#endif /* LWMEM_CFG_INSTANCE_REGISTRY */
+#if LWMEM_CFG_FULL
+    return prv_assignmem(lwobj, regions);
+#else  /* LWMEM_CFG_FULL */
+    return prv_assignmem_simple(lwobj, regions);
+#endif /* LWMEM_CFG_FULL */
+}
+
+#if LWMEM_PERSIST_EN || __DOXYGEN__
+
+/**
+ * \brief           Persistent heap region header, written at start of the managed region
+ */
+typedef struct {
+    uint32_t magic;     /*!< Validity marker */
+    uint16_t version;   /*!< Layout version of this implementation */
+    uint16_t layout;    /*!< Alignment and header-size fingerprint of the building firmware */
+    uint32_t heap_size; /*!< Size of heap area following the header, in units of bytes */
+    uint32_t wal_state; /*!< Intent record armed flag, non-zero while an operation is in flight */
+    uint32_t wal_blk_offs;  /*!< Heap offset of the block being modified */
+    uint32_t wal_blk_size;  /*!< Pre-operation raw size word of the block */
+    uint32_t wal_prev_offs; /*!< Heap offset of the list predecessor, all-ones when outside the heap */
+    uint32_t wal_prev_size; /*!< Pre-merge raw size word of the predecessor */
+} lwmem_persist_hdr_t;
+
+/**
+ * \brief           Persistent header validity marker, `LWPH` in ASCII
+ */
+#define LWMEM_PERSIST_MAGIC   ((uint32_t)0x4C575048UL)
+
+/**
+ * \brief           Persistent layout version implemented by this firmware
+ */
+#define LWMEM_PERSIST_VERSION ((uint16_t)0x0001U)
+
+/**
+ * \brief           Block layout fingerprint, attach rejects regions written
+ *                      by firmware with different alignment or header size
+ */
+#define LWMEM_PERSIST_LAYOUT  ((uint16_t)((LWMEM_CFG_ALIGN_NUM << 8) | LWMEM_BLOCK_META_SIZE))
+
+/**
+ * \brief           Adjust single persistent region descriptor to exclude space of the header
+ * \param[in]       regions: Region descriptor array with one entry, adjusted in place
+ * \return          Pointer to the header location, `NULL` on invalid input
+ */
+static lwmem_persist_hdr_t*
+prv_persist_carve_hdr(lwmem_region_t* regions) {
+    const size_t hdr_size = LWMEM_ALIGN(sizeof(lwmem_persist_hdr_t));
+    uint8_t* start;
+
+    if (regions == NULL || regions[0].start_addr == NULL || regions[0].size <= 2 * hdr_size
+        || (regions[1].start_addr != NULL || regions[1].size != 0)) { /* Exactly one region supported */
+        return NULL;
+    }
+    start = LWMEM_TO_BYTE_PTR(regions[0].start_addr);
+    if (((size_t)start) & LWMEM_ALIGN_BITS) { /* Header must start aligned */
+        const size_t shift = ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)start & LWMEM_ALIGN_BITS);
+
+        start += shift;
+        regions[0].size -= shift;
+    }
+    regions[0].start_addr = start + hdr_size; /* Heap area follows the header */
+    regions[0].size -= hdr_size;
+    return (void*)start;
+}
+
+/**
+ * \brief           Initialize region as persistent heap
+ *
+ * Writes the versioned region header and initializes the heap area like
+ * \ref lwmem_assignmem_ex. After the next reboot the region can be adopted
+ * with \ref lwmem_attach_existing_ex without losing its content.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       regions: Region descriptor array with exactly one entry and
+ *                      `NULL` terminator. Adjusted in place to exclude the header,
+ *                      must stay valid for instance lifetime
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_persist_init_ex(lwmem_t* lwobj, lwmem_region_t* regions) {
+    lwmem_persist_hdr_t* hdr = prv_persist_carve_hdr(regions);
+
+    if (hdr == NULL || lwmem_assignmem_ex(lwobj, regions) == 0) {
+        return 0;
+    }
+    hdr->magic = LWMEM_PERSIST_MAGIC;
+    hdr->version = LWMEM_PERSIST_VERSION;
+    hdr->layout = LWMEM_PERSIST_LAYOUT;
+    hdr->heap_size = (uint32_t)regions[0].size;
+    hdr->wal_state = 0;
+#if LWMEM_CFG_PERSIST
+    LWMEM_GET_LWOBJ(lwobj)->persist_hdr = hdr;
+#endif /* LWMEM_CFG_PERSIST */
+    return 1;
+}
+
+#if LWMEM_WAL_EN
+
+/**
+ * \brief           Offset sentinel for list anchors living outside the heap area
+ */
+#define LWMEM_WAL_NO_OFFS ((uint32_t)~(uint32_t)0)
+
+/**
+ * \brief           Compute heap offset of block, sentinel when block is the instance anchor
+ */
+static uint32_t
+prv_wal_offs(lwmem_t* lwobj, const lwmem_block_t* block) {
+    uint8_t* base = NULL;
+    size_t size = 0;
+
+    if (lwobj->regions_list == NULL || !prv_get_region_addr_size(&lwobj->regions_list[0], &base, &size)
+        || (const uint8_t*)block < base || (const uint8_t*)block >= (base + size)) {
+        return LWMEM_WAL_NO_OFFS;
+    }
+    return (uint32_t)((const uint8_t*)block - base);
+}
+
+/**
+ * \brief           Arm intent record with pre-operation state of the block
+ */
+static void
+prv_wal_arm_block(lwmem_t* lwobj, const lwmem_block_t* block) {
+    lwmem_persist_hdr_t* hdr = lwobj->persist_hdr;
+
+    if (hdr != NULL) {
+        hdr->wal_blk_offs = prv_wal_offs(lwobj, block);
+        hdr->wal_blk_size = (uint32_t)block->size;
+        hdr->wal_prev_offs = LWMEM_WAL_NO_OFFS; /* Predecessor is armed separately when touched */
+        hdr->wal_state = 1;                     /* Intent becomes visible only after state words settled */
+    }
+}
+
+/**
+ * \brief           Arm pre-merge state of the list predecessor into the active intent record
+ */
+static void
+prv_wal_arm_prev(lwmem_t* lwobj, const lwmem_block_t* prev) {
+    lwmem_persist_hdr_t* hdr = lwobj->persist_hdr;
+
+    if (hdr != NULL && hdr->wal_state != 0) {
+        hdr->wal_prev_offs = prv_wal_offs(lwobj, prev);
+        hdr->wal_prev_size = (uint32_t)prev->size;
+    }
+}
+
+/**
+ * \brief           Commit the in-flight operation, intent record no longer applies
+ */
+static void
+prv_wal_disarm(lwmem_t* lwobj) {
+    lwmem_persist_hdr_t* hdr = lwobj->persist_hdr;
+
+    if (hdr != NULL) {
+        hdr->wal_state = 0;
+    }
+}
+
+#endif /* LWMEM_WAL_EN */
+
+/**
+ * \brief           Adopt previously initialized persistent heap region
+ *
+ * Region header is validated (magic, version, layout fingerprint, size),
+ * every block is walked physically the way \ref lwmem_validate_ex would and
+ * the free list is rebuilt from the walk - allocated content stays untouched
+ * and becomes immediately usable, replacing a deserialization pass with a
+ * bounded validation walk. Since links are reconstructed and allocated
+ * blocks carry only address-independent marks, the region may be mapped at
+ * a different address than the one it was initialized at.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       regions: Region descriptor array with exactly one entry and
+ *                      `NULL` terminator, same memory as given to
+ *                      \ref lwmem_persist_init_ex before reboot. Adjusted in place,
+ *                      must stay valid for instance lifetime
+ * \return          `1` when region was adopted, `0` when validation failed
+ *                      (initialize with \ref lwmem_persist_init_ex instead)
+ */
+uint8_t
+lwmem_attach_existing_ex(lwmem_t* lwobj, lwmem_region_t* regions) {
+    lwmem_persist_hdr_t* hdr;
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, available = 0;
+    lwmem_block_t* last_free;
+    lwmem_block_t* end_block;
+    uint8_t* pos;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    if (lwobj->end_block != NULL) { /* Attach may only run on a fresh instance */
+        return 0;
+    }
+    hdr = prv_persist_carve_hdr(regions);
+    if (hdr == NULL || hdr->magic != LWMEM_PERSIST_MAGIC || hdr->version != LWMEM_PERSIST_VERSION
+        || hdr->layout != LWMEM_PERSIST_LAYOUT || hdr->heap_size != regions[0].size
+        || !prv_get_region_addr_size(&regions[0], &mem_start_addr, &mem_size)) {
+        return 0;
+    }
+
+#if LWMEM_WAL_EN
+    if (hdr->wal_state != 0) {
+        /*
+         * Power was lost with an operation in flight: restore the armed pre-op
+         * sizes (predecessor first, it may have absorbed the block) and the
+         * interrupted operation never happened - O(1) roll-back, walk stays fast
+         */
+        if (hdr->wal_prev_offs != LWMEM_WAL_NO_OFFS && hdr->wal_prev_offs < mem_size) {
+            ((lwmem_block_t*)(void*)(mem_start_addr + hdr->wal_prev_offs))->size = hdr->wal_prev_size;
+        }
+        if (hdr->wal_blk_offs != LWMEM_WAL_NO_OFFS && hdr->wal_blk_offs < mem_size) {
+            ((lwmem_block_t*)(void*)(mem_start_addr + hdr->wal_blk_offs))->size = hdr->wal_blk_size;
+        }
+        hdr->wal_state = 0;
+    }
+#endif /* LWMEM_WAL_EN */
+
+    /* Walk all blocks physically, chained by their size fields */
+    end_block = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
+    last_free = &(lwobj->start_block);
+    for (pos = mem_start_addr; pos < (uint8_t*)end_block;) {
+        lwmem_block_t* block = (void*)pos;
+        const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+        /* Sizes must be aligned, at least one header long and end exactly at the end marker */
+        if (block_size < LWMEM_BLOCK_META_SIZE || (block_size & LWMEM_ALIGN_BITS) != 0
+            || (pos + block_size) > (uint8_t*)end_block) {
+            return 0; /* Corrupted layout, region content cannot be trusted */
+        }
+        if (!LWMEM_BLOCK_IS_ALLOC(block)) {
+            if ((block->size & LWMEM_ALLOC_BIT) != 0) {
+                return 0; /* Allocation bit without the allocation mark is corruption */
+            }
+            last_free->next = block; /* Free list is rebuilt in address order */
+            last_free = block;
+            available += block->size;
+        }
+        pos += block_size;
+    }
+    if (pos != (uint8_t*)end_block) {
+        return 0; /* Walk did not terminate exactly at the end marker */
+    }
+
+#if LWMEM_CFG_OS && LWMEM_CFG_PER_INSTANCE_LOCKING
+    if (!lwobj->lock_disabled
+        && (lwmem_sys_mutex_isvalid(&(lwobj->mutex)) || !lwmem_sys_mutex_create(&(lwobj->mutex)))) {
+        return 0;
+    }
+#elif LWMEM_CFG_OS
+    if (lwmem_sys_mutex_isvalid(&(lwobj->mutex)) || !lwmem_sys_mutex_create(&(lwobj->mutex))) {
+        return 0;
+    }
+#endif /* LWMEM_CFG_OS */
+
+    /* Adopt: anchor list head and terminator, volatile accounting restarts here */
+    lwobj->start_block.size = 0;
+    last_free->next = end_block;
+    end_block->next = NULL;
+    end_block->size = 0;
+    lwobj->end_block = end_block;
+#if LWMEM_CFG_PERSIST
+    lwobj->persist_hdr = hdr;
+#endif /* LWMEM_CFG_PERSIST */
+    lwobj->regions_list = regions; /* Regions array must stay valid for instance lifetime */
+    lwobj->mem_regions_count = 1;
+    lwobj->mem_available_bytes = available;
+#if LWMEM_CFG_INSTANCE_REGISTRY
+    prv_registry_add(lwobj); /* Make instance discoverable for owner lookup */
+#endif /* LWMEM_CFG_INSTANCE_REGISTRY */
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes = mem_size - LWMEM_BLOCK_META_SIZE;
+    lwobj->stats.minimum_ever_mem_available_bytes = available;
+#if LWMEM_CFG_WINDOWED_STATS
+    lwobj->win_min_avail = (uint32_t)available;
+#endif /* LWMEM_CFG_WINDOWED_STATS */
+#endif /* LWMEM_CFG_ENABLE_STATS */
+    return 1;
+}
+
+#endif /* LWMEM_PERSIST_EN || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN && !LWMEM_BT_EN           \
+     && !LWMEM_PER_REGION_EN)                                                                                          \
+    || __DOXYGEN__
+
+/**
+ * \brief           Migrate allocated block ownership to another instance, without copying
+ *
+ * For per-core heaps sharing one address space: the block's memory range is
+ * donated from `src` to `dst`. Payload bytes are untouched and the pointer
+ * stays valid; the block must from now on be freed (or reallocated) through
+ * `dst`, where it re-enters that instance's free list as an isolated range
+ * reusable for further allocations. `src` permanently cedes the range, so
+ * the donated bytes leave its size accounting. Both instances must be built
+ * from this translation unit (identical block layout).
+ *
+ * \param[in]       src: Source instance the block was allocated from.
+ *                      Set to `NULL` to use default instance
+ * \param[in]       dst: Destination instance taking ownership.
+ *                      Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously allocated from source instance
+ * \return          `1` on success, `0` when pointer is not an allocated block
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ * \note            Not supported together with per-region lists, boundary tags
+ *                      or table/offset based engines, where region accounting
+ *                      cannot host a donated range
+ */
+uint8_t
+lwmem_migrate_ex(lwmem_t* src, lwmem_t* dst, void* ptr) {
+    lwmem_block_t* block;
+    uint8_t res = 0;
+    void* raw_ptr = LWMEM_RZ_RAW(ptr); /* Header sits below the front zone */
+
+    src = LWMEM_GET_LWOBJ(src);
+    dst = LWMEM_GET_LWOBJ(dst);
+    if (ptr == NULL || src == dst) {
+        return ptr != NULL; /* Same-instance migration is a no-op */
+    }
+
+    /* Lock both instances in stable (address) order to avoid deadlock with a concurrent reverse migration */
+    if (src < dst) {
+        LWMEM_PROTECT(src);
+        LWMEM_PROTECT(dst);
+    } else {
+        LWMEM_PROTECT(dst);
+        LWMEM_PROTECT(src);
+    }
+    block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+    if (LWMEM_BLOCK_IS_ALLOC(block)
+        /*
+         * Address-ordered insertion can only host the donated range while it
+         * sorts below the destination's end sentinel: a block above it would
+         * be linked after the terminator on free and never be reachable again.
+         * Reject such migrations instead of silently losing the memory
+         */
+        && dst->end_block != NULL && LWMEM_TO_BYTE_PTR(block) < (uint8_t*)dst->end_block) {
+        const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+#if LWMEM_CFG_ENABLE_STATS
+        /* Donated range leaves source size accounting and joins destination */
+        src->stats.mem_size_bytes -= (LWMEM_STATS_CNT_T)block_size;
+        dst->stats.mem_size_bytes += (LWMEM_STATS_CNT_T)block_size;
+#else  /* LWMEM_CFG_ENABLE_STATS */
+        (void)block_size;
+#endif /* !LWMEM_CFG_ENABLE_STATS */
+        LWMEM_STATS_CNT_FREE(src); /* Source books the handoff as free... */
+        LWMEM_STATS_CNT_ALLOC(dst); /* ...destination as allocation */
+        res = 1;
+    }
+    if (src < dst) {
+        LWMEM_UNPROTECT(dst);
+        LWMEM_UNPROTECT(src);
+    } else {
+        LWMEM_UNPROTECT(src);
+        LWMEM_UNPROTECT(dst);
+    }
+    return res;
+}
+
+#endif /* (LWMEM_CFG_FULL && !engine exclusions) || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Allocate oversized request as scattered chunks across regions
+ *
+ * When no single free block (or region) can hold the request, total free
+ * memory across regions often still can: the request is satisfied from up to
+ * \ref LWMEM_CFG_SG_MAX_CHUNKS separate blocks, sized by binary back-off from
+ * the remaining length. Access the result through the chunk list or the
+ * \ref lwmem_sg_read / \ref lwmem_sg_write helpers. Nothing is allocated
+ * when the request cannot be fully satisfied.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in,out]   sg: Scatter descriptor to fill
+ * \param[in]       size: Total number of bytes to allocate
+ * \return          `1` on success, `0` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_sg_alloc_ex(lwmem_t* lwobj, lwmem_sg_t* sg, size_t size) {
+    size_t remaining = size;
+
+    if (sg == NULL || size == 0) {
+        return 0;
+    }
+    sg->count = 0;
+    sg->total = 0;
+    while (remaining > 0) {
+        size_t chunk = remaining;
+        void* ptr = NULL;
+
+        if (sg->count >= LWMEM_CFG_SG_MAX_CHUNKS) {
+            lwmem_sg_free_ex(lwobj, sg); /* Descriptor exhausted, no partial allocations escape */
+            return 0;
+        }
+
+        /* Binary back-off: try the full remainder, halve until a block fits */
+        while (chunk >= LWMEM_CFG_ALIGN_NUM && (ptr = lwmem_malloc_ex(lwobj, NULL, chunk)) == NULL) {
+            chunk /= 2;
+        }
+        if (ptr == NULL) {
+            lwmem_sg_free_ex(lwobj, sg); /* Heap exhausted before request was satisfied */
+            return 0;
+        }
+        sg->chunks[sg->count].ptr = ptr;
+        sg->chunks[sg->count].len = chunk;
+        ++sg->count;
+        sg->total += chunk;
+        remaining -= chunk;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Allocate several logical parts as one compound block
+ *
+ * The canonical frame-building pattern - header + payload + trailer - needs
+ * one allocation instead of three and zero gathering copies: parts live at
+ * published interior offsets of a single block, respecting each part's
+ * alignment requirement, and the whole frame is released with one
+ * \ref lwmem_free_ex of the returned base pointer. The filled chunk list is
+ * an iovec-style view usable directly for scatter-gather transmit.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       sizes: Array of part sizes, in units of bytes
+ * \param[in]       aligns: Optional array of per-part alignments (powers of `2`),
+ *                      `NULL` for default alignment of every part
+ * \param[in]       count: Number of parts
+ * \param[out]      parts: Output chunk list, one entry per part
+ * \return          Base address to free the compound with, `NULL` on failure
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_compound_alloc_ex(lwmem_t* lwobj, const size_t* sizes, const size_t* aligns, size_t count,
+                        lwmem_sg_chunk_t* parts) {
+    size_t total = 0;
+    uint8_t* base;
+
+    if (sizes == NULL || parts == NULL || count == 0) {
+        return NULL;
+    }
+
+    /* First pass computes interior offsets, second pass publishes them */
+    for (size_t idx = 0; idx < count; ++idx) {
+        const size_t align = aligns != NULL && aligns[idx] > LWMEM_CFG_ALIGN_NUM ? aligns[idx] : LWMEM_CFG_ALIGN_NUM;
+
+        if (sizes[idx] == 0 || (aligns != NULL && aligns[idx] != 0 && (aligns[idx] & (aligns[idx] - 1)) != 0)) {
+            return NULL; /* Empty parts and non-power-of-2 alignments are rejected */
+        }
+        total = (total + align - 1) & ~(align - 1); /* Pad to this part's alignment */
+        parts[idx].len = sizes[idx];
+        parts[idx].ptr = LWMEM_TO_BYTE_PTR(0) + total; /* Offset for now, rebased below */
+        total += sizes[idx];
+    }
+
+    /*
+     * Block start is aligned to the default boundary only: when a part needs
+     * more, over-allocate by that alignment and shift all offsets once
+     */
+    {
+        size_t max_align = LWMEM_CFG_ALIGN_NUM;
+
+        if (aligns != NULL) {
+            for (size_t idx = 0; idx < count; ++idx) {
+                if (aligns[idx] > max_align) {
+                    max_align = aligns[idx];
+                }
+            }
+        }
+        base = lwmem_malloc_ex(lwobj, NULL, total + (max_align - LWMEM_CFG_ALIGN_NUM));
+        if (base == NULL) {
+            return NULL;
+        }
+        if (max_align > LWMEM_CFG_ALIGN_NUM && ((size_t)base & (max_align - 1)) != 0) {
+            const size_t shift = max_align - ((size_t)base & (max_align - 1));
+
+            for (size_t idx = 0; idx < count; ++idx) {
+                parts[idx].ptr = LWMEM_TO_BYTE_PTR(parts[idx].ptr) + shift;
+            }
+        }
+    }
+    for (size_t idx = 0; idx < count; ++idx) {
+        parts[idx].ptr = base + (size_t)(LWMEM_TO_BYTE_PTR(parts[idx].ptr) - LWMEM_TO_BYTE_PTR(0));
+    }
+    return base;
+}
+
+/**
+ * \brief           Free all chunks of a scatter allocation
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       sg: Scatter descriptor previously filled by \ref lwmem_sg_alloc_ex.
+ *                      Reset to empty state
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_sg_free_ex(lwmem_t* lwobj, lwmem_sg_t* sg) {
+    if (sg != NULL) {
+        for (size_t idx = 0; idx < sg->count; ++idx) {
+            lwmem_free_ex(lwobj, sg->chunks[idx].ptr);
+        }
+        sg->count = 0;
+        sg->total = 0;
+    }
+}
+
+/**
+ * \brief           Copy data out of a scatter allocation
+ * \param[in]       sg: Scatter descriptor to read from
+ * \param[in]       offs: Logical offset to start reading at
+ * \param[out]      dst: Destination buffer
+ * \param[in]       len: Number of bytes to copy
+ * \return          Number of bytes copied, may be less than `len` at the end of allocation
+ */
+size_t
+lwmem_sg_read(const lwmem_sg_t* sg, size_t offs, void* dst, size_t len) {
+    size_t copied = 0;
+
+    if (sg == NULL || dst == NULL) {
+        return 0;
+    }
+    for (size_t idx = 0; idx < sg->count && copied < len; ++idx) {
+        const size_t chunk_len = sg->chunks[idx].len;
+
+        if (offs >= chunk_len) {
+            offs -= chunk_len; /* Start lies in one of the later chunks */
+            continue;
+        }
+        {
+            const size_t part = (chunk_len - offs) < (len - copied) ? (chunk_len - offs) : (len - copied);
+
+            LWMEM_MEMCPY(LWMEM_TO_BYTE_PTR(dst) + copied, LWMEM_TO_BYTE_PTR(sg->chunks[idx].ptr) + offs, part);
+            copied += part;
+            offs = 0;
+        }
+    }
+    return copied;
+}
+
+/**
+ * \brief           Copy data into a scatter allocation
+ * \param[in]       sg: Scatter descriptor to write to
+ * \param[in]       offs: Logical offset to start writing at
+ * \param[in]       src: Source buffer
+ * \param[in]       len: Number of bytes to copy
+ * \return          Number of bytes copied, may be less than `len` at the end of allocation
+ */
+size_t
+lwmem_sg_write(const lwmem_sg_t* sg, size_t offs, const void* src, size_t len) {
+    size_t copied = 0;
+
+    if (sg == NULL || src == NULL) {
+        return 0;
+    }
+    for (size_t idx = 0; idx < sg->count && copied < len; ++idx) {
+        const size_t chunk_len = sg->chunks[idx].len;
+
+        if (offs >= chunk_len) {
+            offs -= chunk_len;
+            continue;
+        }
+        {
+            const size_t part = (chunk_len - offs) < (len - copied) ? (chunk_len - offs) : (len - copied);
+
+            LWMEM_MEMCPY(LWMEM_TO_BYTE_PTR(sg->chunks[idx].ptr) + offs, (const uint8_t*)src + copied, part);
+            copied += part;
+            offs = 0;
+        }
+    }
+    return copied;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE
+
+/**
+ * \brief           Evict least-recently touched discardable block
+ *
+ * Must be called with instance protected (mutex taken). Owner is
+ * notified through its callback, then the block is freed
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \return          `1` when a block has been evicted, `0` when none is registered
+ */
+static uint8_t
+prv_evict_lru(lwmem_t* const lwobj) {
+    size_t lru = LWMEM_CFG_EVICTABLE_MAX;
+
+    for (size_t idx = 0; idx < LWMEM_CFG_EVICTABLE_MAX; ++idx) {
+        if (lwobj->evictable[idx].ptr != NULL
+            && (lru >= LWMEM_CFG_EVICTABLE_MAX || lwobj->evictable[idx].tick < lwobj->evictable[lru].tick)) {
+            lru = idx;
+        }
+    }
+    if (lru >= LWMEM_CFG_EVICTABLE_MAX) {
+        return 0;
+    }
+    if (lwobj->evictable[lru].evict_cb != NULL) {
+        lwobj->evictable[lru].evict_cb(lwobj->evictable[lru].ptr, lwobj->evictable[lru].user);
+    }
+    prv_free(lwobj, lwobj->evictable[lru].ptr);
+    lwobj->evictable[lru].ptr = NULL;
+    return 1;
+}
+
+/**
+ * \brief           Remove pointer from the evictable registry, e.g. on explicit free
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       ptr: Pointer being freed
+ */
+static void
+prv_evictable_forget(lwmem_t* const lwobj, const void* ptr) {
+    for (size_t idx = 0; idx < LWMEM_CFG_EVICTABLE_MAX; ++idx) {
+        if (lwobj->evictable[idx].ptr == ptr) {
+            lwobj->evictable[idx].ptr = NULL;
+            return;
+        }
+    }
+}
+
+/**
+ * \brief           Re-point registry entry when a tracked block is relocated
+ *
+ * Must be called with instance protected (mutex taken)
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       old_ptr: Address the block lived at before relocation
+ * \param[in]       new_ptr: Address the block content moved to
+ */
+static void
+prv_evictable_rehome(lwmem_t* const lwobj, const void* old_ptr, void* new_ptr) {
+    for (size_t idx = 0; idx < LWMEM_CFG_EVICTABLE_MAX; ++idx) {
+        if (lwobj->evictable[idx].ptr == old_ptr) {
+            lwobj->evictable[idx].ptr = new_ptr;
+            return;
+        }
+    }
+}
+
+#endif /* LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE */
+
+#if LWMEM_CFG_FULL && LWMEM_ISR_FREE_EN
+
+/**
+ * \brief           Drain queue of blocks freed from interrupt context into the free list
+ *
+ * Must be called with instance protected (mutex taken)
+ *
+ * \param[in]       lwobj: LwMEM instance
+ */
+static void
+prv_isr_free_drain(lwmem_t* const lwobj) {
+    lwmem_block_t* block = atomic_exchange(&(lwobj->isr_free_head), NULL);
+
+    while (block != NULL) {
+        lwmem_block_t* next_queued = block->next;
+
+        /* Restore allocation mark, cleared during lock-free push, then do regular free */
+        block->next = (void*)(LWMEM_TO_BYTE_PTR(0) + LWMEM_BLOCK_ALLOC_MARK);
+        prv_free(lwobj, LWMEM_GET_PTR_FROM_BLOCK(block));
+        block = next_queued;
+    }
+}
+
+#endif /* LWMEM_CFG_FULL && LWMEM_ISR_FREE_EN */
+
+#if LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE
+
+#if LWMEM_COMPACT_EN || LWMEM_OOB_EN
+#error "LWMEM_CFG_CPU_CACHE is not available together with compact headers or out-of-band metadata"
+#endif
+
+/**
+ * \brief           Number of size classes of per-CPU caches, one per alignment step
+ */
+#define LWMEM_CPU_CACHE_CLASSES (LWMEM_CFG_CPU_CACHE_MAX_SIZE / LWMEM_CFG_ALIGN_NUM)
+
+/**
+ * \brief           Per-CPU magazines, each padded to its own cache line set
+ *
+ * Blocks on these lists remain marked as allocated in the heap
+ * and hold link to next cached block in their user data area
+ */
+static struct {
+    void* heads[LWMEM_CPU_CACHE_CLASSES];    /*!< Head of cached blocks stack, one per size class */
+    uint8_t counts[LWMEM_CPU_CACHE_CLASSES]; /*!< Number of cached blocks per size class */
+} LWMEM_CACHELINE_ALIGN cpu_caches[LWMEM_CFG_CPU_COUNT];
+
+#endif /* LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE */
+
+#if LWMEM_CFG_FULL && LWMEM_TCACHE_EN
+
+/*
+ * Per-thread magazines with cached allocated blocks.
+ *
+ * Blocks on these lists remain marked as allocated in the heap
+ * and hold link to next cached block in their user data area.
+ * Storage is exported when the header-inline fast path is enabled
+ */
+#if LWMEM_CFG_INLINE_FASTPATH
+LWMEM_CFG_THREAD_LOCAL lwmem_tcache_t lwmem_thread_cache;
+#define thread_cache lwmem_thread_cache
+#else /* LWMEM_CFG_INLINE_FASTPATH */
+static LWMEM_CFG_THREAD_LOCAL lwmem_tcache_t thread_cache;
+#endif /* !LWMEM_CFG_INLINE_FASTPATH */
+
+/**
+ * \brief           Get thread cache class index for aligned user size
+ * \param[in]       aligned_size: Aligned user size, must be in cacheable range
+ */
+#define LWMEM_TCACHE_IDX(aligned_size) ((aligned_size) / LWMEM_CFG_ALIGN_NUM - 1)
+
+/**
+ * \brief           Check if aligned user size is eligible for thread cache
+ *
+ * Block user area must be able to hold stack link when cached
+ *
+ * \param[in]       aligned_size: Aligned user size
+ */
+#define LWMEM_TCACHE_FITS(aligned_size)                                                                                \
+    ((aligned_size) >= sizeof(void*) && (aligned_size) <= LWMEM_CFG_THREAD_CACHE_MAX_SIZE)
+
+#endif /* LWMEM_CFG_FULL && LWMEM_TCACHE_EN */
+
+/**
+ * \brief           Create heap instance stored inside the region itself
+ *
+ * Instance structure and a private two-entry regions array are carved from
+ * the head of the region, remaining memory becomes the heap. No static
+ * storage is needed, enabling cheap on-demand sub-heaps
+ *
+ * \param[in]       region: Region with address and size to build the heap in
+ * \return          Handle of the created instance to use with `_ex` functions,
+ *                      `NULL` when region is too small
+ */
+lwmem_t*
+lwmem_create_in_region(const lwmem_region_t* region) {
+    uint8_t* addr;
+    size_t size, head_size;
+    lwmem_t* lwobj;
+    lwmem_region_t* regions;
+
+    if (region == NULL || region->start_addr == NULL) {
+        return NULL;
+    }
+
+    /* Align region start address */
+    addr = region->start_addr;
+    size = region->size;
+    if (((size_t)addr) & LWMEM_ALIGN_BITS) {
+        addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)addr & LWMEM_ALIGN_BITS);
+        size -= (size_t)(addr - LWMEM_TO_BYTE_PTR(region->start_addr));
+    }
+
+    /* Instance structure and private regions array live at the head of the region */
+    head_size = LWMEM_ALIGN(sizeof(lwmem_t)) + LWMEM_ALIGN(2 * sizeof(lwmem_region_t));
+    if (size < (head_size + 4 * sizeof(lwmem_block_t))) {
+        return NULL; /* Not enough space for bookkeeping and a useful heap */
+    }
+
+    lwobj = (void*)addr;
+    LWMEM_MEMSET(lwobj, 0x00, sizeof(*lwobj));
+    regions = (void*)(addr + LWMEM_ALIGN(sizeof(lwmem_t)));
+    regions[0].start_addr = addr + head_size;
+    regions[0].size = size - head_size;
+    regions[1].start_addr = NULL;
+    regions[1].size = 0;
+
+    if (lwmem_assignmem_ex(lwobj, regions) == 0) {
+        return NULL;
+    }
+    return lwobj;
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Create fully functional child heap carved from a parent heap
+ *
+ * Backing block comes from a single parent allocation and hosts the child
+ * instance, its region table and its heap (see \ref lwmem_create_in_region),
+ * so a subsystem gets a private tunable arena it can destroy wholesale
+ *
+ * \param[in]       parent: Parent LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       size: Total sub-heap size in units of bytes, including child bookkeeping
+ * \return          Child instance handle to use with `_ex` functions, `NULL` on failure
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+lwmem_t*
+lwmem_subheap_create_ex(lwmem_t* parent, size_t size) {
+    void* block = lwmem_malloc_ex(parent, NULL, size);
+    lwmem_region_t region;
+    lwmem_t* subheap;
+
+    if (block == NULL) {
+        return NULL;
+    }
+    region.start_addr = block;
+    region.size = size;
+    subheap = lwmem_create_in_region(&region);
+    if (subheap == NULL) {
+        lwmem_free_ex(parent, block);
+        return NULL;
+    }
+    return subheap;
+}
+
+/**
+ * \brief           Destroy child heap, returning its backing block in one free
+ *
+ * Replaces walking thousands of individual frees when a subsystem
+ * instance goes away. All child allocations become invalid
+ *
+ * \param[in]       parent: Parent LwMEM instance the child was created from
+ * \param[in]       subheap: Child instance returned by \ref lwmem_subheap_create_ex
+ * \note            With \ref LWMEM_CFG_OS enabled, the mutex created for the child
+ *                      is not returned to the system, as ports carry no delete operation.
+ *                      Prefer re-using sub-heaps over rapid create/destroy cycles there
+ */
+void
+lwmem_subheap_destroy_ex(lwmem_t* parent, lwmem_t* subheap) {
+    if (subheap != NULL) {
+        lwmem_free_ex(parent, subheap); /* Instance lives at the very start of the backing block */
+    }
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+/**
+ * \brief           Reset instance to its pristine post-assignment state
+ *
+ * All regions are rebuilt in O(regions) time, orders of magnitude faster
+ * than freeing outstanding objects one by one. Intended for test harnesses
+ * and between-mission re-initialization paths
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \return          `1` on success, `0` when instance has never been assigned
+ * \note            All previously allocated pointers become invalid.
+ *                      Application must guarantee no allocation is in use
+ *                      (or in flight on another thread) during the call
+ */
+uint8_t
+lwmem_reset_ex(lwmem_t* lwobj) {
+    const lwmem_region_t* regions;
+    uint8_t success = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    regions = lwobj->regions_list;
+    if (regions != NULL) {
+#if LWMEM_CFG_OS
+        LWMEM_CFG_OS_MUTEX_HANDLE mutex = lwobj->mutex; /* Keep existing mutex over the wipe */
+#endif /* LWMEM_CFG_OS */
+#if LWMEM_CFG_OOM_HANDLER
+        lwmem_oom_handler_fn oom_handler = lwobj->oom_handler;
+#endif /* LWMEM_CFG_OOM_HANDLER */
+
+        LWMEM_MEMSET(lwobj, 0x00, sizeof(*lwobj));
+#if LWMEM_CFG_OS
+        lwobj->mutex = mutex;
+#endif /* LWMEM_CFG_OS */
+#if LWMEM_CFG_OOM_HANDLER
+        lwobj->oom_handler = oom_handler;
+#endif /* LWMEM_CFG_OOM_HANDLER */
+        lwobj->regions_list = regions;
+
+#if LWMEM_CFG_FULL
+        success = prv_assignmem(lwobj, regions) > 0;
+#else  /* LWMEM_CFG_FULL */
+        success = prv_assignmem_simple(lwobj, regions) > 0;
+#endif /* !LWMEM_CFG_FULL */
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return success;
+}
+
+/**
+ * \brief           Reset default LwMEM instance to its pristine post-assignment state
+ *
+ * This is a wrapper for \ref lwmem_reset_ex function
+ *
+ * \return          `1` on success, `0` when instance has never been assigned
+ */
+uint8_t
+lwmem_reset(void) {
+    return lwmem_reset_ex(NULL);
+}
+
+/**
+ * \brief           Allocate memory of requested size in specific lwmem instance and optional region.
+ * \note            This is an extended malloc version function declaration to support advanced features
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size) {
+    void* ptr = NULL;
+    /* Guarded builds inflate the request to carry both zones, pass-through otherwise */
+    const size_t alloc_size = LWMEM_RZ_INFLATE(size);
+
+#if LWMEM_CFG_CONST_TIME_POOL
+    /* Security-sensitive alloc_size band is served with data-independent timing,
+       pool exhaustion fails the allocation instead of leaking timing through
+       a heap-history dependent fallback walk. Routing fields are only read
+       under the lock, so a concurrent attach cannot be observed half-written */
+    if (alloc_size > 0 && region == NULL) {
+        lwmem_t* ct_obj = LWMEM_GET_LWOBJ(lwobj);
+
+        if (ct_obj->ct_pool != NULL) {
+            uint8_t ct_routed = 0;
+            void* ct_ptr = NULL;
+
+            LWMEM_PROTECT(ct_obj);
+            if (ct_obj->ct_pool != NULL && alloc_size <= ct_obj->ct_max_size) {
+                ct_ptr = lwmem_pool_alloc(ct_obj->ct_pool);
+                ct_routed = 1;
+            }
+            LWMEM_UNPROTECT(ct_obj);
+            if (ct_routed) {
+                return ct_ptr;
+            }
+        }
+    }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+
+#if LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE
+    /* Serve small default-instance allocations from this CPU's cache,
+       keeping shared free-list lines out of the inter-core traffic */
+    if (lwobj == NULL && region == NULL && alloc_size > 0) {
+        const size_t cc_aligned = LWMEM_ALIGN(alloc_size);
+
+        if (cc_aligned >= sizeof(void*) && cc_aligned <= LWMEM_CFG_CPU_CACHE_MAX_SIZE) {
+            const size_t cc_idx = cc_aligned / LWMEM_CFG_ALIGN_NUM - 1;
+            void* cc_ptr = NULL;
+
+            LWMEM_CPU_LOCK();
+            {
+                const size_t cpu = (size_t)LWMEM_GET_CPU_ID() % LWMEM_CFG_CPU_COUNT;
+
+                if (cpu_caches[cpu].heads[cc_idx] != NULL) {
+                    cc_ptr = cpu_caches[cpu].heads[cc_idx];
+                    cpu_caches[cpu].heads[cc_idx] = *(void**)cc_ptr;
+                    --cpu_caches[cpu].counts[cc_idx];
+                }
+            }
+            LWMEM_CPU_UNLOCK();
+            if (cc_ptr != NULL) {
+                return cc_ptr;
+            }
+        }
+    }
+#endif /* LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE */
+
+#if LWMEM_CFG_FULL && LWMEM_TCACHE_EN
+    /* Serve small default-instance allocations from thread cache, without touching the lock */
+    if (lwobj == NULL && region == NULL && alloc_size > 0) {
+        const size_t aligned_size = LWMEM_ALIGN(alloc_size);
+
+        if (LWMEM_TCACHE_FITS(aligned_size)) {
+            const size_t idx = LWMEM_TCACHE_IDX(aligned_size);
+
+            if (thread_cache.heads[idx] != NULL) {
+                ptr = thread_cache.heads[idx];
+                thread_cache.heads[idx] = *(void**)ptr;
+                --thread_cache.counts[idx];
+                return ptr;
+            }
+        }
+    }
+#endif /* LWMEM_CFG_FULL && LWMEM_TCACHE_EN */
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+
+#if LWMEM_CFG_FULL
+    LWMEM_PROF_START();
+#if LWMEM_CFG_OOM_HANDLER
+    do {
+#endif /* LWMEM_CFG_OOM_HANDLER */
+        LWMEM_PROTECT(lwobj);
+        LWMEM_HISTOGRAM_COUNT(lwobj, alloc_size);
+#if LWMEM_ISR_FREE_EN
+        if (atomic_load(&(lwobj->isr_free_head)) != NULL) {
+            prv_isr_free_drain(lwobj); /* Return interrupt-freed blocks before allocation attempt */
+        }
+#endif /* LWMEM_ISR_FREE_EN */
+        ptr = prv_alloc(lwobj, region, alloc_size);
+#if LWMEM_EXACT_EN
+        if (ptr == NULL && alloc_size > 0 && prv_exact_cache_flush(lwobj)) {
+            ptr = prv_alloc(lwobj, region, alloc_size); /* Cached blocks back on the list may coalesce enough */
+        }
+#endif /* LWMEM_EXACT_EN */
+#if LWMEM_CFG_EVICTABLE
+        /* Reclaim discardable blocks in LRU order, exactly on demand.
+           Region-targeted requests skip this, evicted blocks may live elsewhere */
+        while (ptr == NULL && alloc_size > 0 && region == NULL && prv_evict_lru(lwobj)) {
+            ptr = prv_alloc(lwobj, region, alloc_size);
+        }
+#endif /* LWMEM_CFG_EVICTABLE */
+        LWMEM_UNPROTECT(lwobj);
+#if LWMEM_CFG_OOM_HANDLER
+        /* Handler runs outside the lock and may free caches, then request one more attempt */
+    } while (ptr == NULL && alloc_size > 0 && lwobj->oom_handler != NULL && lwobj->oom_handler(lwobj, alloc_size));
+#endif /* LWMEM_CFG_OOM_HANDLER */
+#if LWMEM_CFG_FULL
+    LWMEM_PROF_END(lwobj, alloc);
+#endif /* LWMEM_CFG_FULL */
+    ptr = LWMEM_RZ_FINISH(ptr); /* Guard zones filled, application pointer past the front zone */
+    LWMEM_JOURNAL_OP(lwobj, ptr != NULL ? LWMEM_JOURNAL_OP_ALLOC : LWMEM_JOURNAL_OP_ALLOC_FAIL, ptr, size,
+                     LWMEM_RETURN_ADDR());
+    LWMEM_EVENT(lwobj, ptr != NULL ? LWMEM_EVT_ALLOC : LWMEM_EVT_ALLOC_FAIL, ptr, size);
+#elif LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+    ptr = prv_alloc_simple(lwobj, region, size); /* Lock-free, no mutex required */
+#else  /* LWMEM_CFG_FULL */
+    LWMEM_PROTECT(lwobj);
+    ptr = prv_alloc_simple(lwobj, region, size);
+    LWMEM_UNPROTECT(lwobj);
+#endif /* LWMEM_CFG_FULL */
+    return ptr;
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory with reserved capacity for future in-place growth
+ *
+ * Block is allocated (and not split) to hold at least `reserve` bytes, while
+ * application initially uses first `size` bytes only. Growth up to the block
+ * capacity then needs no reallocation at all: use \ref lwmem_get_capacity_ex
+ * to read the true capacity and only reallocate when it is exceeded
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       size: Number of bytes application uses initially
+ * \param[in]       reserve: Number of bytes to size the block for. Values smaller
+ *                      than `size` are treated as `size`
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_reserve_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, const size_t reserve) {
+    return lwmem_malloc_ex(lwobj, region, size > reserve ? size : reserve);
+}
+
+/**
+ * \brief           Get true capacity of allocated block
+ *
+ * Capacity is the number of bytes application may use without reallocation.
+ * It may exceed originally requested size due to reserve allocation,
+ * alignment or an unsplittable block remainder
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Pointer to allocated memory
+ * \return          Block capacity for user in units of bytes
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_get_capacity_ex(lwmem_t* lwobj, void* ptr) {
+    return lwmem_get_size_ex(lwobj, ptr);
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_SMALL_ROUTE_EN || __DOXYGEN__
+
+/**
+ * \brief           Designate region for automatic small-block routing
+ *
+ * Region-less allocations up to `threshold` bytes are directed to the
+ * designated region first, spilling to regular placement when it is full
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Region (as used at assignment) to route small blocks to
+ * \param[in]       threshold: Maximal application size to route, `0` disables routing
+ * \return          `1` on success, `0` when region is unknown to the instance
+ */
+uint8_t
+lwmem_set_small_region_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t threshold) {
+    uint8_t success = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+        const uint8_t* reg_addr = lwobj->region_heads[idx].start_addr;
+
+        if (region != NULL && LWMEM_TO_BYTE_PTR(region->start_addr) <= reg_addr
+            && reg_addr < (LWMEM_TO_BYTE_PTR(region->start_addr) + region->size)) {
+            lwobj->small_region_idx = (uint8_t)idx;
+            lwobj->small_threshold = threshold;
+            success = 1;
+            break;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return success;
+}
+
+#endif /* LWMEM_SMALL_ROUTE_EN || __DOXYGEN__ */
+
+#if LWMEM_REGION_FB_EN || __DOXYGEN__
+
+/**
+ * \brief           Chain region to a fallback region for overflow allocations
+ *
+ * When explicit-region allocation cannot be satisfied, fallback
+ * region(s) are tried in the same locked pass
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Region (as used at assignment) to set fallback of
+ * \param[in]       fallback_region: Region to overflow to, `NULL` to remove chaining
+ * \return          `1` on success, `0` when any region is unknown to the instance
+ */
+uint8_t
+lwmem_set_region_fallback_ex(lwmem_t* lwobj, const lwmem_region_t* region, const lwmem_region_t* fallback_region) {
+    size_t src_idx = (size_t)-1, dst_idx = (size_t)-1;
+    uint8_t success = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+        const uint8_t* reg_addr = lwobj->region_heads[idx].start_addr;
+
+        if (region != NULL && LWMEM_TO_BYTE_PTR(region->start_addr) <= reg_addr
+            && reg_addr < (LWMEM_TO_BYTE_PTR(region->start_addr) + region->size)) {
+            src_idx = idx;
+        }
+        if (fallback_region != NULL && LWMEM_TO_BYTE_PTR(fallback_region->start_addr) <= reg_addr
+            && reg_addr < (LWMEM_TO_BYTE_PTR(fallback_region->start_addr) + fallback_region->size)) {
+            dst_idx = idx;
+        }
+    }
+    if (src_idx < lwobj->mem_regions_count) {
+        if (fallback_region == NULL) {
+            lwobj->region_heads[src_idx].fallback_idx = 0xFFU;
+            success = 1;
+        } else if (dst_idx < lwobj->mem_regions_count && dst_idx != src_idx) {
+            lwobj->region_heads[src_idx].fallback_idx = (uint8_t)dst_idx;
+            success = 1;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return success;
+}
+
+#endif /* LWMEM_REGION_FB_EN || __DOXYGEN__ */
+
+#if LWMEM_REGION_STATS_EN || __DOXYGEN__
+
+/**
+ * \brief           Get statistics of a single region
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region_idx: Region index, in order of initial assignment
+ * \param[in,out]   stats: Pointer to \ref lwmem_stats_t to store result
+ * \return          `1` on success, `0` when region index is out of range
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_get_region_stats_ex(lwmem_t* lwobj, size_t region_idx, lwmem_stats_t* stats) {
+    uint8_t success = 0;
+
+    if (stats != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        if (region_idx < lwobj->mem_regions_count) {
+            *stats = lwobj->region_heads[region_idx].stats;
+            success = 1;
+        }
+        LWMEM_UNPROTECT(lwobj);
+    }
+    return success;
+}
+
+#endif /* LWMEM_REGION_STATS_EN || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN) || __DOXYGEN__
+
+/**
+ * \brief           Trim region tail and hand the recovered memory to a donor
+ *
+ * When the region ends in one free block, the managed part of the region is
+ * shrunk in place (keeping at least `min_keep` managed bytes) and the
+ * recovered tail range is reported, ready to be attached to another
+ * instance - the reverse of \ref lwmem_region_attach_ex, letting memory
+ * shuttle between subsystems in O(1) instead of static worst-case partitioning
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Region (as used at assignment) to trim
+ * \param[in]       min_keep: Minimal number of managed bytes to keep in the region
+ * \param[out]      recovered: Output descriptor of the recovered memory range
+ * \return          `1` on success, `0` when region is unknown or its tail is not free
+ * \note            Heap validation reports trimmed regions as shortened chains,
+ *                      since the original region descriptor keeps its full size.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_trim_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t min_keep, lwmem_region_t* recovered) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, tail_offs = 0, keep_size, new_managed;
+    lwmem_block_t *tail = NULL, *new_marker = NULL, *old_marker = NULL;
+    uint8_t success = 0;
+
+    if (recovered == NULL || !prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+
+    /* Find last block in front of the end of region indicator */
+    old_marker = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
+    for (lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA);;) {
+        const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+        if (block_size == 0) {
+            break;
+        }
+        tail = block;
+        tail_offs = (size_t)(LWMEM_TO_BYTE_PTR(block) - mem_start_addr);
+        block = (void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+    }
+
+    if (tail != NULL && !LWMEM_BLOCK_IS_ALLOC(tail)) {
+        /* Keep at least requested managed bytes and a minimal tail block */
+        keep_size = LWMEM_BLOCK_MIN_SIZE;
+        if (min_keep > (tail_offs + LWMEM_BLOCK_META_SIZE)
+            && (min_keep - tail_offs - LWMEM_BLOCK_META_SIZE) > keep_size) {
+            keep_size = LWMEM_ALIGN(min_keep - tail_offs - LWMEM_BLOCK_META_SIZE);
+        }
+        if (tail->size > (keep_size + LWMEM_BLOCK_META_SIZE + LWMEM_BLOCK_MIN_SIZE)) {
+#if LWMEM_BINS_EN
+            prv_bin_unlink(lwobj, tail); /* Size is about to change */
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+            prv_skip_remove(lwobj, tail);
+#endif /* LWMEM_SKIP_EN */
+            new_managed = tail_offs + keep_size + LWMEM_BLOCK_META_SIZE;
+            lwobj->mem_available_bytes -= tail->size - keep_size;
+            tail->size = keep_size;
+
+            /* New end of region indicator inherits linkage of the old one */
+            new_marker = (void*)(mem_start_addr + new_managed - LWMEM_BLOCK_META_SIZE);
+            new_marker->next = old_marker->next;
+            new_marker->size = 0;
+            tail->next = new_marker;
+            LWMEM_BT_SET(tail);
+            if (lwobj->end_block == old_marker) {
+                lwobj->end_block = new_marker;
+            }
+#if LWMEM_BINS_EN
+            prv_bin_insert(lwobj, tail);
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+            prv_skip_insert(lwobj, tail);
+#endif /* LWMEM_SKIP_EN */
+#if LWMEM_PER_REGION_EN
+            for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+                if (lwobj->region_heads[idx].start_addr == (void*)mem_start_addr) {
+                    lwobj->region_heads[idx].size = new_managed;
+                    break;
+                }
+            }
+#endif /* LWMEM_PER_REGION_EN */
+#if LWMEM_CFG_ENABLE_STATS
+            lwobj->stats.mem_size_bytes -= (uint32_t)(mem_size - new_managed);
+#endif /* LWMEM_CFG_ENABLE_STATS */
+
+            recovered->start_addr = mem_start_addr + new_managed;
+            recovered->size = mem_size - new_managed;
+            success = 1;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return success;
+}
+
+/**
+ * \brief           Attach additional region to an already initialized instance
+ *
+ * Region free block and its end-of-region indicator are spliced into the
+ * address-ordered free list at runtime, so big slow memories (powered up
+ * after early boot) can be brought online lazily without delaying
+ * \ref lwmem_assignmem_ex for everything else
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Region with address and size to attach.
+ *                      Must not overlap with already attached regions
+ * \return          `1` on success, `0` otherwise
+ * \note            Runtime-attached regions are not part of the assignment regions
+ *                      array, therefore walk, snapshot and validate functions do not
+ *                      cover them. This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_region_attach_ex(lwmem_t* lwobj, const lwmem_region_t* region) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    lwmem_block_t *first_block = NULL, *region_end_block = NULL, *prev = NULL;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size) || lwobj->end_block == NULL) {
+        return 0;
+    }
+#if LWMEM_PER_REGION_EN
+    if (lwobj->mem_regions_count >= LWMEM_CFG_MAX_REGIONS) {
+        return 0; /* Number of regions is limited when per-region anchors are used */
+    }
+#endif /* LWMEM_PER_REGION_EN */
+
+    LWMEM_PROTECT(lwobj);
+
+    /* Find free-list entry directly preceding the new region */
+    for (prev = &(lwobj->start_block); prev->next != NULL && LWMEM_TO_BYTE_PTR(prev->next) < mem_start_addr;
+         prev = prev->next) {}
+
+    /* Build region end indicator and its single free block, exactly as initial assignment does */
+    region_end_block = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
+    region_end_block->next = prev->next;
+    region_end_block->size = 0;
+
+#if LWMEM_BT_EN
+    *(size_t*)(void*)mem_start_addr = LWMEM_ALLOC_BIT | LWMEM_BT_WORD; /* Region-start sentinel */
+#endif /* LWMEM_BT_EN */
+    first_block = (void*)(mem_start_addr + LWMEM_BT_EXTRA);
+    first_block->next = region_end_block;
+    first_block->size = mem_size - LWMEM_BLOCK_META_SIZE - LWMEM_BT_EXTRA;
+    LWMEM_BT_SET(first_block);
+
+    prev->next = first_block;
+    if (region_end_block->next == NULL) { /* New region is now the last one */
+        lwobj->end_block = region_end_block;
+    }
+
+#if LWMEM_BINS_EN
+    prv_set_addr_prev(first_block, prev);
+    prv_bin_insert(lwobj, first_block);
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+    prv_skip_insert(lwobj, first_block);
+#endif /* LWMEM_SKIP_EN */
+#if LWMEM_PER_REGION_EN
+    {
+        size_t ridx = lwobj->mem_regions_count;
+
+        /* Stable anchor is end indicator of preceding region, or list start */
+        lwobj->region_heads[ridx].head = &(lwobj->start_block);
+        for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+            uint8_t* reg_end = LWMEM_TO_BYTE_PTR(lwobj->region_heads[idx].start_addr) + lwobj->region_heads[idx].size;
+
+            if (reg_end <= mem_start_addr
+                && (lwobj->region_heads[ridx].head == &(lwobj->start_block)
+                    || reg_end > LWMEM_TO_BYTE_PTR(lwobj->region_heads[ridx].head))) {
+                lwobj->region_heads[ridx].head = (void*)(reg_end - LWMEM_BLOCK_META_SIZE);
+            }
+        }
+        lwobj->region_heads[ridx].start_addr = mem_start_addr;
+        lwobj->region_heads[ridx].size = mem_size;
+#if LWMEM_REGION_ATTR_EN
+        lwobj->region_heads[ridx].attr = region->attr;
+        lwobj->region_heads[ridx].priority = region->priority;
+#endif /* LWMEM_REGION_ATTR_EN */
+#if LWMEM_REGION_FB_EN
+        lwobj->region_heads[ridx].fallback_idx = 0xFFU; /* No fallback by default */
+#endif /* LWMEM_REGION_FB_EN */
+    }
+#endif /* LWMEM_PER_REGION_EN */
+
+    lwobj->mem_available_bytes += first_block->size;
+    ++lwobj->mem_regions_count;
+#if LWMEM_CFG_ENABLE_STATS
+    lwobj->stats.mem_size_bytes += first_block->size;
+#endif /* LWMEM_CFG_ENABLE_STATS */
+    LWMEM_UNPROTECT(lwobj);
+    return 1;
+}
+
+/**
+ * \brief           Detach previously attached (or assigned) region from the instance
+ *
+ * Detach succeeds only when region memory is completely free,
+ * meaning it holds exactly one free block covering the full region
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Region to detach, same description as used on attach
+ * \return          `1` on success, `0` otherwise (region busy or unknown)
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_region_detach_ex(lwmem_t* lwobj, const lwmem_region_t* region) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    lwmem_block_t *first_block = NULL, *region_end_block = NULL, *prev = NULL;
+    uint8_t success = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size) || lwobj->end_block == NULL) {
+        return 0;
+    }
+    first_block = (void*)(mem_start_addr + LWMEM_BT_EXTRA);
+    region_end_block = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
+
+    LWMEM_PROTECT(lwobj);
+
+    /* Find free-list entry directly preceding the region */
+    for (prev = &(lwobj->start_block); prev->next != NULL && LWMEM_TO_BYTE_PTR(prev->next) < mem_start_addr;
+         prev = prev->next) {}
+
+    /* Region is fully free when its single free block spans up to the end indicator */
+    if (prev->next == first_block && first_block->size == (mem_size - LWMEM_BLOCK_META_SIZE - LWMEM_BT_EXTRA)
+        && first_block->next == region_end_block && region_end_block->size == 0) {
+#if LWMEM_BINS_EN
+        prv_bin_unlink(lwobj, first_block);
+#endif /* LWMEM_BINS_EN */
+#if LWMEM_SKIP_EN
+        prv_skip_remove(lwobj, first_block);
+#endif /* LWMEM_SKIP_EN */
+        LWMEM_NEXTFIT_FORGET(lwobj, first_block);
+        LWMEM_NEXTFIT_FORGET(lwobj, region_end_block);
+
+        prev->next = region_end_block->next; /* Unlink both region blocks from the list */
+#if LWMEM_BINS_EN
+        prv_set_addr_prev(prev->next, prev);
+#endif /* LWMEM_BINS_EN */
+        if (lwobj->end_block == region_end_block) { /* Last region is being removed */
+            lwmem_block_t* blk = &(lwobj->start_block);
+
+            while (blk->next != NULL) { /* New end indicator is the last entry on the list */
+                blk = blk->next;
+            }
+            lwobj->end_block = blk != &(lwobj->start_block) ? blk : NULL;
+        }
+
+#if LWMEM_PER_REGION_EN
+        for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+            if (lwobj->region_heads[idx].start_addr == (void*)mem_start_addr) {
+                for (; (idx + 1) < lwobj->mem_regions_count; ++idx) {
+                    lwobj->region_heads[idx] = lwobj->region_heads[idx + 1];
+                }
+                break;
+            }
+        }
+#endif /* LWMEM_PER_REGION_EN */
+
+        lwobj->mem_available_bytes -= first_block->size;
+        --lwobj->mem_regions_count;
+#if LWMEM_CFG_ENABLE_STATS
+        lwobj->stats.mem_size_bytes -= first_block->size;
+#endif /* LWMEM_CFG_ENABLE_STATS */
+        success = 1;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return success;
+}
+
+#endif /* (LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN) || __DOXYGEN__ */
+
+#if LWMEM_REGION_ATTR_EN || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory from regions matching requested attributes
+ *
+ * Only regions having all requested attribute bits set are considered,
+ * in rising priority value order
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       attr: Attribute bits the region must have set, `LWMEM_REGION_ATTR_xxx` or application values
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_attr_ex(lwmem_t* lwobj, uint16_t attr, const size_t size) {
+    void* ptr = NULL;
+    uint8_t visited[LWMEM_CFG_MAX_REGIONS] = {0};
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (size_t round = 0; round < lwobj->mem_regions_count && ptr == NULL; ++round) {
+        size_t best = lwobj->mem_regions_count;
+
+        for (size_t idx = 0; idx < lwobj->mem_regions_count; ++idx) {
+            if (!visited[idx]
+                && (best >= lwobj->mem_regions_count
+                    || lwobj->region_heads[idx].priority < lwobj->region_heads[best].priority)) {
+                best = idx;
+            }
+        }
+        visited[best] = 1;
+        if ((lwobj->region_heads[best].attr & attr) == attr) {
+            lwmem_region_t tmp_region = {0};
+
+            tmp_region.start_addr = lwobj->region_heads[best].start_addr;
+            tmp_region.size = lwobj->region_heads[best].size;
+            ptr = prv_alloc(lwobj, &tmp_region, LWMEM_RZ_INFLATE(size));
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return LWMEM_RZ_FINISH(ptr);
+}
+
+/**
+ * \brief           Allocate cache-line aligned buffer from a DMA-safe region
+ *
+ * Only regions marked with \ref LWMEM_REGION_ATTR_DMA are considered, in
+ * rising priority value order. Buffer is aligned to (and padded to a multiple
+ * of) \ref LWMEM_CFG_DMA_CACHE_LINE_SIZE, so cache maintenance operations on
+ * it never touch neighboring allocations
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_dma_ex(lwmem_t* lwobj, const size_t size) {
+    void* ptr = NULL;
+    const size_t padded_size =
+        (size + LWMEM_CFG_DMA_CACHE_LINE_SIZE - 1) & ~((size_t)LWMEM_CFG_DMA_CACHE_LINE_SIZE - 1);
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    for (size_t idx = 0; idx < lwobj->mem_regions_count && ptr == NULL; ++idx) {
+        if ((lwobj->region_heads[idx].attr & LWMEM_REGION_ATTR_DMA) > 0) {
+            lwmem_region_t tmp_region = {0};
+
+            tmp_region.start_addr = lwobj->region_heads[idx].start_addr;
+            tmp_region.size = lwobj->region_heads[idx].size;
+            ptr = lwmem_malloc_aligned_ex(lwobj, &tmp_region, padded_size, LWMEM_CFG_DMA_CACHE_LINE_SIZE);
+        }
+    }
+    return ptr;
+}
+
+/**
+ * \brief           Clean (write-back) data cache over a DMA buffer, before device reads it
+ * \param[in]       ptr: Buffer address
+ * \param[in]       len: Buffer length in units of bytes
+ */
+void
+lwmem_dma_cache_clean(void* ptr, size_t len) {
+    LWMEM_DMA_CACHE_CLEAN(ptr, len);
+    (void)ptr;
+    (void)len;
+}
+
+/**
+ * \brief           Invalidate data cache over a DMA buffer, after device has written it
+ * \param[in]       ptr: Buffer address
+ * \param[in]       len: Buffer length in units of bytes
+ */
+void
+lwmem_dma_cache_invalidate(void* ptr, size_t len) {
+    LWMEM_DMA_CACHE_INVALIDATE(ptr, len);
+    (void)ptr;
+    (void)len;
+}
+
+#endif /* LWMEM_REGION_ATTR_EN || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Prepare buffer for a device-read DMA transfer (clean data cache)
+ *
+ * Maintained range is bounded by the allocator's exact block-size knowledge,
+ * so drivers neither over-clean whole buffers nor touch neighboring data
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Buffer handed to the DMA engine
+ * \param[in]       len: Number of bytes the device will read, `0` for the whole block
+ * \note            Cache operation itself comes from \ref LWMEM_DMA_CACHE_CLEAN.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_dma_prepare_ex(lwmem_t* lwobj, void* ptr, size_t len) {
+    if (ptr != NULL) {
+        const size_t block_len = lwmem_get_size_ex(lwobj, ptr);
+
+        if (block_len > 0) {
+            LWMEM_DMA_CACHE_CLEAN(ptr, (len == 0 || len > block_len) ? block_len : len);
+        }
+    }
+    (void)len;
+}
+
+/**
+ * \brief           Complete a device-write DMA transfer (invalidate data cache)
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Buffer the DMA engine has written to
+ * \param[in]       len: Number of bytes the device wrote, `0` for the whole block
+ * \note            Cache operation itself comes from \ref LWMEM_DMA_CACHE_INVALIDATE.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_dma_complete_ex(lwmem_t* lwobj, void* ptr, size_t len) {
+    if (ptr != NULL) {
+        const size_t block_len = lwmem_get_size_ex(lwobj, ptr);
+
+        if (block_len > 0) {
+            LWMEM_DMA_CACHE_INVALIDATE(ptr, (len == 0 || len > block_len) ? block_len : len);
+        }
+    }
+    (void)len;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_RESERVE_EN || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory with permission to use the emergency reserve
+ *
+ * Regular allocations stop before eating into the reserve of
+ * \ref LWMEM_CFG_EMERGENCY_RESERVE_SIZE bytes; this function may consume it,
+ * guaranteeing small allocations (failure logging and similar critical paths)
+ * even when the heap is otherwise exhausted
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_critical_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size) {
+    void* ptr;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    lwobj->reserve_bypass = 1;
+    ptr = prv_alloc(lwobj, region, LWMEM_RZ_INFLATE(size));
+    lwobj->reserve_bypass = 0;
+    LWMEM_UNPROTECT(lwobj);
+    return LWMEM_RZ_FINISH(ptr);
+}
+
+#endif /* LWMEM_RESERVE_EN || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_TAGS_EN) || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory tagged with an allocation site
+ *
+ * Tag is stored in the block header and live bytes/counts are aggregated
+ * per site. Use \ref LWMEM_MALLOC_TAGGED to capture file and line automatically
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       tag: Site tag, must point to storage valid for application lifetime
+ *                      (string literal or static identifier)
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_tagged_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t size, const char* tag) {
+    void* ptr = lwmem_malloc_ex(lwobj, region, size);
+
+    if (ptr != NULL && tag != NULL) {
+        lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(LWMEM_RZ_RAW(ptr));
+
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        block->tag = tag;
+        prv_tag_update(tag, 1, (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE);
+        LWMEM_UNPROTECT(lwobj);
+    }
+    return ptr;
+}
+
+/**
+ * \brief           Report per-site allocation accounting through a callback
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       callback: Function called once per known allocation site
+ * \param[in]       user: User argument passed to the callback
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_tag_report_ex(lwmem_t* lwobj, lwmem_tag_report_fn callback, void* user) {
+    if (callback != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        for (size_t idx = 0; idx < LWMEM_CFG_ALLOC_TAGS_MAX_SITES; ++idx) {
+            if (tag_sites[idx].tag != NULL) {
+                callback(tag_sites[idx].tag, tag_sites[idx].live_bytes, tag_sites[idx].live_count,
+                         tag_sites[idx].total_count, user);
+            }
+        }
+        LWMEM_UNPROTECT(lwobj);
+    }
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_TAGS_EN) || __DOXYGEN__ */
+
+#if LWMEM_CFG_PROFILING || __DOXYGEN__
+
+/**
+ * \brief           Read latency profiles of allocator operations
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in,out]   profile: Pointer to \ref lwmem_profile_t to store result
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_get_profile_ex(lwmem_t* lwobj, lwmem_profile_t* profile) {
+    if (profile != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        *profile = lwobj->profile;
+        LWMEM_UNPROTECT(lwobj);
+    }
+}
+
+#endif /* LWMEM_CFG_PROFILING || __DOXYGEN__ */
+
+#if LWMEM_REDZONE_EN || __DOXYGEN__
+
+/**
+ * \brief           Incrementally verify guard zones of allocated blocks
+ *
+ * Walks up to `max_blocks` allocated blocks per call, so full-heap
+ * verification can be spread over idle iterations. Blocks whose front zone
+ * does not carry the magic (allocations from specialty paths without zones)
+ * are skipped. Detected violations are counted on the instance
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       max_blocks: Maximal number of blocks to verify, `0` for no limit
+ * \return          Number of violations detected in this call
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_redzone_check_ex(lwmem_t* lwobj, size_t max_blocks) {
+    size_t violations = 0, budget = max_blocks > 0 ? max_blocks : (size_t)-1;
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         budget > 0 && region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        for (lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA); budget > 0;) {
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+            if (block_size == 0) {
+                break;
+            }
+            if (LWMEM_BLOCK_IS_ALLOC(block)
+                && *(const uint32_t*)(const void*)LWMEM_TO_BYTE_PTR(LWMEM_GET_PTR_FROM_BLOCK(block))
+                       == LWMEM_REDZONE_MAGIC) {
+                --budget;
+                if (!prv_redzone_verify(block)) {
+                    ++violations;
+                    ++lwobj->redzone_violations;
+                }
+            }
+            block = (void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return violations;
+}
+
+/**
+ * \brief           Get number of guard zone violations detected so far
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \return          Violation counter of the instance
+ */
+uint32_t
+lwmem_redzone_violations_ex(lwmem_t* lwobj) {
+    return LWMEM_GET_LWOBJ(lwobj)->redzone_violations;
+}
+
+#endif /* LWMEM_REDZONE_EN || __DOXYGEN__ */
+
+#if LWMEM_CFG_PER_INSTANCE_ALIGN || __DOXYGEN__
+
+/**
+ * \brief           Configure instance specific alignment
+ *
+ * Must be called before region assignment. Region bases and block sizes
+ * of the instance are then aligned to the value, so returned pointers meet
+ * it natively (e.g. a 32-byte aligned DMA heap in a default-aligned build)
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       align: Requested alignment in bytes: power of `2`,
+ *                      at least \ref LWMEM_CFG_ALIGN_NUM. `0` restores default
+ * \return          `1` on success, `0` on invalid alignment or already assigned instance
+ */
+uint8_t
+lwmem_set_instance_align_ex(lwmem_t* lwobj, size_t align) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    if ((align != 0 && ((align & (align - 1)) > 0 || align < (size_t)LWMEM_CFG_ALIGN_NUM))
+        || lwobj->regions_list != NULL) {
+        return 0;
+    }
+    lwobj->instance_align = align;
+    return 1;
+}
+
+#endif /* LWMEM_CFG_PER_INSTANCE_ALIGN || __DOXYGEN__ */
+
+#if LWMEM_CFG_REALLOC_GROWTH || __DOXYGEN__
+
+/**
+ * \brief           Configure growth headroom of relocating reallocations
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       growth_pct: Capacity percentage to reserve on relocation
+ *                      (e.g. `150` allocates 1.5x of the requested size).
+ *                      Values up to `100` disable the headroom
+ */
+void
+lwmem_set_realloc_growth_ex(lwmem_t* lwobj, uint16_t growth_pct) {
+    LWMEM_GET_LWOBJ(lwobj)->realloc_growth_pct = growth_pct;
+}
+
+#endif /* LWMEM_CFG_REALLOC_GROWTH || __DOXYGEN__ */
+
+#if LWMEM_POLICY_EN || __DOXYGEN__
+
+/**
+ * \brief           Switch allocation policy of a quiesced instance at runtime
+ *
+ * Fit mode takes effect on the next allocation; deferred-free and split
+ * threshold parts are applied when the respective compile options are
+ * enabled. Call when no allocation is in flight
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       policy: Policy to apply
+ * \return          `1` on success, `0` when policy requests unavailable features
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_set_policy_ex(lwmem_t* lwobj, const lwmem_policy_t* policy) {
+    uint8_t success = 1;
+
+    if (policy == NULL || policy->fit_mode > (uint8_t)LWMEM_FIT_NEXT) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    lwobj->policy_fit = policy->fit_mode;
+    lwobj->policy_rover = NULL;
+#if LWMEM_DEFERRED_EN
+    lwobj->policy_defer = policy->defer_free;
+    if (!policy->defer_free && lwobj->deferred_free != NULL) {
+        prv_coalesce_deferred(lwobj); /* Leaving lazy mode flushes outstanding work */
+    }
+#else  /* LWMEM_DEFERRED_EN */
+    if (policy->defer_free) {
+        success = 0; /* Deferred coalescing is not compiled in */
+    }
+#endif /* !LWMEM_DEFERRED_EN */
+#if LWMEM_CFG_CONFIGURABLE_SPLIT
+    lwobj->min_split_remainder = policy->min_split_remainder;
+#else  /* LWMEM_CFG_CONFIGURABLE_SPLIT */
+    if (policy->min_split_remainder > 0) {
+        success = 0; /* Runtime split threshold is not compiled in */
+    }
+#endif /* !LWMEM_CFG_CONFIGURABLE_SPLIT */
+    LWMEM_UNPROTECT(lwobj);
+    return success;
+}
+
+#endif /* LWMEM_POLICY_EN || __DOXYGEN__ */
+
+#if LWMEM_CFG_CONFIGURABLE_SPLIT || __DOXYGEN__
+
+/**
+ * \brief           Configure minimal split remainder of the instance
+ *
+ * Remainders below the value stay attached to allocated blocks as slack
+ * (visible through \ref lwmem_get_capacity_ex) instead of polluting the
+ * free list with tiny fragments
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       min_remainder: Minimal remainder worth splitting, in units of bytes.
+ *                      `0` restores default behavior
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_set_split_threshold_ex(lwmem_t* lwobj, size_t min_remainder) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    lwobj->min_split_remainder = min_remainder;
+    LWMEM_UNPROTECT(lwobj);
+}
+
+#endif /* LWMEM_CFG_CONFIGURABLE_SPLIT || __DOXYGEN__ */
+
+#if LWMEM_CFG_FAULT_INJECT || __DOXYGEN__
+
+/**
+ * \brief           Configure allocation fault injection
+ *
+ * Any combination of injectors may be active; passing all zeros disables
+ * injection. Probabilistic failures use a deterministic seeded generator,
+ * so runs are reproducible
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       fail_nth: Fail the Nth next allocation, `0` disables
+ * \param[in]       fail_above_size: Fail allocations above this size, `0` disables
+ * \param[in]       fail_permille: Fail with this probability in permille, `0` disables
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_fault_inject_ex(lwmem_t* lwobj, uint32_t fail_nth, size_t fail_above_size, uint16_t fail_permille) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    lwobj->fi_countdown = fail_nth;
+    lwobj->fi_above_size = fail_above_size;
+    lwobj->fi_permille = fail_permille;
+    if (lwobj->fi_rng == 0) {
+        lwobj->fi_rng = 0x12345678U;
+    }
+    LWMEM_UNPROTECT(lwobj);
+}
+
+#endif /* LWMEM_CFG_FAULT_INJECT || __DOXYGEN__ */
+
+#if LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__
+
+/**
+ * \brief           Configure memory pressure watermarks and callback
+ *
+ * Callback fires once when available memory drops below `low`, and once
+ * again when it recovers above `high` (hysteresis)
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       low: Available-bytes threshold firing the pressure callback
+ * \param[in]       high: Available-bytes threshold firing the recovery callback
+ * \param[in]       callback: Callback to fire, `NULL` disables watermarks
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_set_watermarks_ex(lwmem_t* lwobj, size_t low, size_t high, lwmem_watermark_fn callback) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    lwobj->wm_low = low;
+    lwobj->wm_high = high;
+    lwobj->wm_callback = callback;
+    lwobj->wm_below = 0;
+    LWMEM_UNPROTECT(lwobj);
+}
+
+#endif /* LWMEM_CFG_WATERMARK_HOOKS || __DOXYGEN__ */
+
+#if (LWMEM_CFG_EVENT_HOOKS && LWMEM_CFG_EVENT_STREAM) || __DOXYGEN__
+
+/**
+ * \brief           Binary event stream state, one stream per firmware image
+ */
+static struct {
+    uint8_t* ring;      /*!< User ring buffer */
+    size_t len;         /*!< Ring length, multiple of record size */
+    size_t head;        /*!< Write offset of next record */
+    uintptr_t last_ptr; /*!< Previous event address for delta encoding */
+} event_stream;
+
+/**
+ * \brief           Event hook encoding 12-byte records into the attached ring
+ */
+static void
+prv_stream_hook(struct lwmem* lwobj, lwmem_evt_type_t evt_type, void* ptr, size_t size) {
+    uint8_t* rec;
+    uint32_t word;
+
+    (void)lwobj;
+    if (event_stream.ring == NULL) {
+        return;
+    }
+    rec = &event_stream.ring[event_stream.head];
+
+    /* Record: op (1), size (3), address delta (4), cycle timestamp (4) */
+    rec[0] = (uint8_t)evt_type;
+    word = (uint32_t)(size & 0xFFFFFFU);
+    rec[1] = (uint8_t)(word & 0xFFU);
+    rec[2] = (uint8_t)((word >> 8) & 0xFFU);
+    rec[3] = (uint8_t)((word >> 16) & 0xFFU);
+    word = (uint32_t)((uintptr_t)ptr - event_stream.last_ptr);
+    event_stream.last_ptr = (uintptr_t)ptr;
+    LWMEM_MEMCPY(&rec[4], &word, sizeof(word));
+    word = (uint32_t)LWMEM_GET_CYCLES();
+    LWMEM_MEMCPY(&rec[8], &word, sizeof(word));
+
+    event_stream.head += 12;
+    if ((event_stream.head + 12) > event_stream.len) {
+        event_stream.head = 0; /* Continuous ring, host side drains via head offset */
+    }
+}
+
+/**
+ * \brief           Attach binary event stream to a ring buffer
+ *
+ * Installs the streaming encoder into the event-hook slot of the instance.
+ * Host tooling (RTT/ITM) drains the ring using \ref lwmem_stream_head
+ *
+ * \param[in]       lwobj: LwMEM instance to stream events of, `NULL` for default one
+ * \param[in]       ring: Ring buffer storage, e.g. an RTT up-buffer
+ * \param[in]       len: Ring length in bytes, at least two 12-byte records
+ * \return          `1` on success, `0` on invalid arguments
+ */
+uint8_t
+lwmem_stream_attach_ex(lwmem_t* lwobj, uint8_t* ring, size_t len) {
+    if (ring == NULL || len < 24) {
+        return 0;
+    }
+    event_stream.ring = ring;
+    event_stream.len = len;
+    event_stream.head = 0;
+    event_stream.last_ptr = 0;
+    lwmem_set_event_hook_ex(lwobj, prv_stream_hook);
+    return 1;
+}
+
+/**
+ * \brief           Get current write offset of the event stream ring
+ * \return          Offset of the next record to be written
+ */
+size_t
+lwmem_stream_head(void) {
+    return event_stream.head;
+}
+
+#endif /* (LWMEM_CFG_EVENT_HOOKS && LWMEM_CFG_EVENT_STREAM) || __DOXYGEN__ */
+
+#if LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__
+
+/**
+ * \brief           Register allocation event hook for the instance
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       hook: Hook to call on allocation events.
+ *                      Set to `NULL` to remove previously registered hook
+ */
+void
+lwmem_set_event_hook_ex(lwmem_t* lwobj, lwmem_event_fn hook) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    lwobj->event_hook = hook;
+}
+
+#endif /* LWMEM_CFG_EVENT_HOOKS || __DOXYGEN__ */
+
+#if LWMEM_CFG_OOM_HANDLER || __DOXYGEN__
+
+/**
+ * \brief           Register out-of-memory handler for the instance
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       handler: Handler to call on failed allocations.
+ *                      Set to `NULL` to remove previously registered handler
+ */
+void
+lwmem_set_oom_handler_ex(lwmem_t* lwobj, lwmem_oom_handler_fn handler) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    lwobj->oom_handler = handler;
+}
+
+#endif /* LWMEM_CFG_OOM_HANDLER || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Allocate several equally sized blocks in one pass
+ *
+ * Lock is taken once for the complete batch. When a single free block can
+ * hold the whole batch, it is carved sequentially into `count` blocks without
+ * repeated free-list walks, which also gives the blocks contiguous addresses
+ * (useful for descriptor rings). Otherwise blocks are allocated one by one;
+ * on failure already allocated blocks are freed again and `0` is returned
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       size: Number of bytes to allocate per block
+ * \param[out]      out_ptrs: Array to store `count` allocated pointers to
+ * \param[in]       count: Number of blocks to allocate
+ * \return          `1` when all blocks are allocated, `0` otherwise (no memory is kept allocated)
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_malloc_many_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, void** out_ptrs, size_t count) {
+    size_t done = 0;
+
+    if (out_ptrs == NULL || count == 0) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+
+    LWMEM_PROTECT(lwobj);
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+    {
+        size_t each_size =
+            LWMEM_BLOCK_SIZE_ALIGN(LWMEM_ALIGN(LWMEM_RZ_INFLATE(size)) + LWMEM_BLOCK_META_SIZE + LWMEM_BT_EXTRA);
+
+#if LWMEM_BINS_EN || LWMEM_SKIP_EN
+        if (each_size < LWMEM_BLOCK_MIN_SIZE) {
+            each_size = LWMEM_BLOCK_MIN_SIZE;
+        }
+#endif /* LWMEM_BINS_EN || LWMEM_SKIP_EN */
+
+        /* Try to carve whole batch out of one large block, in one free-list pass */
+        if (size > 0 && ((each_size * count) & LWMEM_ALLOC_BIT) == 0) {
+            void* batch_ptr = prv_alloc(lwobj, region, each_size * count - LWMEM_BLOCK_META_SIZE);
+            lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(batch_ptr);
+
+            if (block != NULL) {
+                const size_t total_size = block->size & ~LWMEM_ALLOC_BIT;
+
+                /* Subdivide sequentially, any slack of the carved block goes to the last one */
+                for (done = 0; done < count; ++done) {
+                    lwmem_block_t* sub = (void*)(LWMEM_TO_BYTE_PTR(block) + done * each_size);
+
+                    sub->size = done == (count - 1) ? (total_size - done * each_size) : each_size;
+                    prv_block_set_alloc(sub);
+                    out_ptrs[done] = LWMEM_RZ_FINISH(LWMEM_GET_PTR_FROM_BLOCK(sub));
+                    if (done > 0) {
+                        LWMEM_STATS_CNT_ALLOC(lwobj); /* First block is counted by allocation itself */
+                        LWMEM_REGION_COUNT(lwobj, sub, 1);
+                    }
+                }
+                LWMEM_UNPROTECT(lwobj);
+                return 1;
+            }
+        }
+    }
+#endif /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+
+    /* Fall back to one-by-one allocation under the same lock hold */
+    for (done = 0; done < count; ++done) {
+        out_ptrs[done] = LWMEM_RZ_FINISH(prv_alloc(lwobj, region, LWMEM_RZ_INFLATE(size)));
+        if (out_ptrs[done] == NULL) {
+            while (done-- > 0) { /* Do not keep partial batch allocated */
+                prv_free(lwobj, LWMEM_RZ_RAW(out_ptrs[done]));
+                out_ptrs[done] = NULL;
+            }
+            LWMEM_UNPROTECT(lwobj);
+            return 0;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return 1;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Free many pointers in one pass
+ *
+ * Pointers are sorted by address in place, then merged into the free list in
+ * a single linear walk under one lock hold: position search of every next
+ * pointer resumes where the previous one ended, instead of re-walking the
+ * list from its beginning for each free operation
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in,out]   ptrs: Array of pointers to free. Entries are reordered by the call,
+ *                      `NULL` entries are valid and skipped
+ * \param[in]       count: Number of entries in the array
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_free_many_ex(lwmem_t* lwobj, void** ptrs, size_t count) {
+    if (ptrs == NULL || count == 0) {
+        return;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+
+    /* Sort pointers by increasing address (insertion sort, arrays are typically short) */
+    for (size_t i = 1; i < count; ++i) {
+        void* key = ptrs[i];
+        size_t j = i;
+
+        for (; j > 0 && ptrs[j - 1] > key; --j) {
+            ptrs[j] = ptrs[j - 1];
+        }
+        ptrs[j] = key;
+    }
+
+    LWMEM_PROTECT(lwobj);
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN && !LWMEM_DEFERRED_EN && !LWMEM_GEN_EN      \
+    && !LWMEM_TAGS_EN && !LWMEM_PER_REGION_EN && !LWMEM_AUDIT_EN && !LWMEM_WAL_EN && !LWMEM_SCRUB_EN                   \
+    && !LWMEM_EXACT_EN && !LWMEM_CHK_EN && !LWMEM_CFG_HOST_SANITIZERS
+    {
+        lwmem_block_t* hint = NULL;
+
+        for (size_t i = 0; i < count; ++i) {
+            lwmem_block_t* block;
+
+#if LWMEM_CFG_CONST_TIME_POOL
+            if (ptrs[i] != NULL && LWMEM_CT_OWNS(lwobj, ptrs[i])) {
+                lwmem_pool_free(lwobj->ct_pool, ptrs[i]); /* Headerless pool block goes back to its pool */
+                continue;
+            }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+            block = LWMEM_GET_BLOCK_FROM_PTR(LWMEM_RZ_RAW(ptrs[i]));
+            if (LWMEM_BLOCK_IS_ALLOC(block)) {
+                LWMEM_EVICTABLE_FORGET(lwobj, LWMEM_RZ_RAW(ptrs[i])); /* Registry must not outlive the block */
+                block->size &= ~LWMEM_ALLOC_BIT;
+                lwobj->mem_available_bytes += block->size;
+
+                /* Resulting (possibly merged) block is a valid resume point for next pointer */
+                hint = prv_insert_free_block(lwobj, block, hint);
+                LWMEM_STATS_CNT_FREE(lwobj);
+            }
+        }
+    }
+#else  /* fast path exclusions */
+    for (size_t i = 0; i < count; ++i) {
+#if LWMEM_CFG_CONST_TIME_POOL
+        if (ptrs[i] != NULL && LWMEM_CT_OWNS(lwobj, ptrs[i])) {
+            lwmem_pool_free(lwobj->ct_pool, ptrs[i]); /* Headerless pool block goes back to its pool */
+            continue;
+        }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+        prv_free(lwobj, LWMEM_RZ_RAW(ptrs[i])); /* Engine (or active feature) needs the full per-block free path */
+    }
+#endif /* !fast path exclusions */
+    LWMEM_UNPROTECT(lwobj);
+    for (size_t i = 0; i < count; ++i) {
+        if (ptrs[i] != NULL) { /* Batch frees feed the journal and event hooks like single frees do */
+            LWMEM_JOURNAL_OP(lwobj, LWMEM_JOURNAL_OP_FREE, LWMEM_RZ_RAW(ptrs[i]), 0, LWMEM_RETURN_ADDR());
+            LWMEM_EVENT(lwobj, LWMEM_EVT_FREE, LWMEM_RZ_RAW(ptrs[i]), 0);
+        }
+    }
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory with custom alignment of returned pointer
+ *
+ * Alignments above \ref LWMEM_CFG_ALIGN_NUM (DMA or cache-line buffers)
+ * are served natively: block is over-allocated, header is placed right below
+ * the aligned address and the unused front part is split off back to the free
+ * list, so \ref lwmem_free_ex works unchanged on the returned pointer
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       align: Requested pointer alignment in bytes, must be a power of `2`
+ * \return          Pointer to allocated memory with requested alignment, `NULL` otherwise
+ * \note            Not supported with buddy strategy or compact headers
+ *                      (requests above default alignment return `NULL` there).
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_aligned_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, const size_t align) {
+    void* ptr = NULL;
+
+    if (size == 0 || align == 0 || (align & (align - 1)) != 0) {
+        return NULL;
+    }
+    if (align <= ((size_t)LWMEM_CFG_ALIGN_NUM)) {
+        return lwmem_malloc_ex(lwobj, region, size); /* Default alignment is already sufficient */
+    }
+
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    {
+        size_t keep_size =
+            LWMEM_BLOCK_SIZE_ALIGN(LWMEM_ALIGN(LWMEM_RZ_INFLATE(size)) + LWMEM_BLOCK_META_SIZE + LWMEM_BT_EXTRA);
+        void* raw;
+
+#if LWMEM_BINS_EN || LWMEM_SKIP_EN
+        if (keep_size < LWMEM_BLOCK_MIN_SIZE) {
+            keep_size = LWMEM_BLOCK_MIN_SIZE; /* Block must be able to hold free links once freed */
+        }
+#endif /* LWMEM_BINS_EN || LWMEM_SKIP_EN */
+
+        /*
+         * Over-allocate, so an aligned address with space for front split always exists.
+         * Front gap may grow up to LWMEM_BLOCK_MIN_SIZE + align bytes in the worst case
+         */
+        raw = prv_alloc(lwobj, region, (keep_size - LWMEM_BLOCK_META_SIZE) + align + LWMEM_BLOCK_MIN_SIZE);
+
+        if (raw != NULL) {
+            /* Alignment applies to the application pointer, which sits past the front guard zone */
+            uint8_t* aligned_addr =
+                (void*)((((size_t)LWMEM_TO_BYTE_PTR(raw) + LWMEM_CFG_REDZONE_SIZE + align - 1) & ~(align - 1))
+                        - LWMEM_CFG_REDZONE_SIZE);
+
+            /* Gap in front of aligned address must be zero or a standalone-capable block */
+            while (aligned_addr != LWMEM_TO_BYTE_PTR(raw)
+                   && (size_t)(aligned_addr - LWMEM_TO_BYTE_PTR(raw)) < LWMEM_BLOCK_MIN_SIZE) {
+                aligned_addr += align;
+            }
+
+            if (aligned_addr == LWMEM_TO_BYTE_PTR(raw)) {
+                ptr = raw; /* Already aligned, whole block is used as-is */
+            } else {
+                lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(raw);
+                lwmem_block_t* aligned_block = LWMEM_GET_BLOCK_FROM_PTR(aligned_addr);
+                const size_t front_size = (size_t)(aligned_addr - LWMEM_TO_BYTE_PTR(raw));
+                const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+                /* Front part becomes independent free block, reusing original header */
+                aligned_block->size = block_size - front_size;
+                prv_block_set_alloc(aligned_block);
+
+                block->size = front_size;
+                lwobj->mem_available_bytes += front_size;
+                prv_insert_free_block(lwobj, block, NULL);
+
+                ptr = aligned_addr;
+            }
+
+            /* Give unused tail back to the free list */
+            prv_split_too_big_block(lwobj, LWMEM_GET_BLOCK_FROM_PTR(ptr), keep_size);
+            ptr = LWMEM_RZ_FINISH(ptr); /* Guard zones filled, application pointer past the front zone */
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+    (void)lwobj;
+    (void)region;
+#endif /* LWMEM_BUDDY_EN || LWMEM_COMPACT_EN || LWMEM_OOB_EN || LWMEM_SO_EN */
+    return ptr;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory with bounded wait for the instance lock
+ *
+ * When the lock cannot be acquired within the timeout, function returns
+ * `NULL` immediately, so deadline-critical callers can fall back to a
+ * static buffer instead of blocking for unbounded time
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       timeout_ms: Maximal lock wait time, in units of milliseconds.
+ *                      Value `0` only tries to acquire the lock without waiting.
+ *                      Not used when \ref LWMEM_CFG_OS is disabled
+ * \return          Pointer to allocated memory on success,
+ *                      `NULL` on timeout or when no memory is available
+ */
+void*
+lwmem_malloc_try_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size, uint32_t timeout_ms) {
+    void* ptr = NULL;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+
+#if LWMEM_CFG_OS
+    if (!lwmem_sys_mutex_wait_timeout(&(lwobj->mutex), timeout_ms)) {
+        return NULL; /* Lock is contended, let the caller recover instead of blocking */
+    }
+#else  /* LWMEM_CFG_OS */
+    (void)timeout_ms;
+#endif /* !LWMEM_CFG_OS */
+
+#if LWMEM_CFG_FULL
+    ptr = prv_alloc(lwobj, region, LWMEM_RZ_INFLATE(size));
+#else  /* LWMEM_CFG_FULL */
+    ptr = prv_alloc_simple(lwobj, region, LWMEM_RZ_INFLATE(size));
+#endif /* !LWMEM_CFG_FULL */
+    LWMEM_UNPROTECT(lwobj);
+    return LWMEM_RZ_FINISH(ptr);
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT || __DOXYGEN__ */
+
+/**
+ * \brief           Allocate contiguous block of memory for requested number of items and its size
+ *                  in specific lwmem instance and region.
+ *
+ * It resets allocated block of memory to zero if allocation is successful
+ *
+ * \note            This is an extended calloc version function declaration to support advanced features
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       nitems: Number of elements to be allocated
+ * \param[in]       size: Size of each element, in units of bytes
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_calloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t nitems, const size_t size) {
+    void* ptr = NULL;
+    size_t alloc_size;
+
+    /* Item count and size must not overflow the total */
+#if defined(__GNUC__) || defined(__clang__)
+    if (__builtin_mul_overflow(nitems, size, &alloc_size)) {
+        return NULL;
+    }
+#else  /* defined(__GNUC__) || defined(__clang__) */
+    alloc_size = nitems * size;
+    if (nitems > 0 && (alloc_size / nitems) != size) {
+        return NULL;
+    }
+#endif /* !(defined(__GNUC__) || defined(__clang__)) */
+#if LWMEM_CFG_FULL && LWMEM_ZERO_TRACK_EN
+    uint8_t* watermark_before = NULL;
+#endif /* LWMEM_CFG_FULL && LWMEM_ZERO_TRACK_EN */
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+
+#if LWMEM_CFG_FULL
+#if LWMEM_CFG_OOM_HANDLER
+    do {
+#endif /* LWMEM_CFG_OOM_HANDLER */
+        LWMEM_PROTECT(lwobj);
+        LWMEM_HISTOGRAM_COUNT(lwobj, alloc_size);
+#if LWMEM_ZERO_TRACK_EN
+        watermark_before = lwobj->alloc_watermark;
+#endif /* LWMEM_ZERO_TRACK_EN */
+        ptr = prv_alloc(lwobj, region, LWMEM_RZ_INFLATE(alloc_size));
+        LWMEM_UNPROTECT(lwobj);
+#if LWMEM_CFG_OOM_HANDLER
+    } while (ptr == NULL && alloc_size > 0 && lwobj->oom_handler != NULL && lwobj->oom_handler(lwobj, alloc_size));
+#endif /* LWMEM_CFG_OOM_HANDLER */
+#elif LWMEM_CFG_ATOMIC_SIMPLE_ALLOC
+    ptr = prv_alloc_simple(lwobj, region, LWMEM_RZ_INFLATE(alloc_size)); /* Lock-free, no mutex required */
+#else  /* LWMEM_CFG_FULL */
+    LWMEM_PROTECT(lwobj);
+    ptr = prv_alloc_simple(lwobj, region, LWMEM_RZ_INFLATE(alloc_size));
+    LWMEM_UNPROTECT(lwobj);
+#endif /* LWMEM_CFG_FULL */
+    ptr = LWMEM_RZ_FINISH(ptr); /* Guard zones filled, application pointer past the front zone */
+
+    if (ptr != NULL) {
+#if LWMEM_CFG_FULL && LWMEM_ZERO_TRACK_EN
+        /* Blocks carved entirely from fresh (never handed out) memory are known to read as zero */
+        if (LWMEM_TO_BYTE_PTR(ptr) < watermark_before) {
+            LWMEM_MEMSET(ptr, 0x00, alloc_size);
+        }
+#else  /* LWMEM_CFG_FULL && LWMEM_ZERO_TRACK_EN */
+        LWMEM_MEMSET(ptr, 0x00, alloc_size);
+#endif /* !(LWMEM_CFG_FULL && LWMEM_ZERO_TRACK_EN) */
+    }
+    return ptr;
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC) || __DOXYGEN__
+
+/**
+ * \brief           Reallocates already allocated memory with new size in specific lwmem instance and region.
+ *
+ * \note            This function may only be used with allocations returned by any of `_from` API functions
+ *
+ * Function behaves differently, depends on input parameter of `ptr` and `size`:
+ *
+ *  - `ptr == NULL; size == 0`: Function returns `NULL`, no memory is allocated or freed
+ *  - `ptr == NULL; size > 0`: Function tries to allocate new block of memory with `size` length, equivalent to `malloc(region, size)`
+ *  - `ptr != NULL; size == 0`: Function frees memory, equivalent to `free(ptr)`
+ *  - `ptr != NULL; size > 0`: Function tries to allocate new memory of copy content before returning pointer on success
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from.
+ *                      Set to `NULL` to use any region within LwMEM instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_realloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, void* const ptr, const size_t size) {
+    void* p;
+    void* raw_ptr = LWMEM_RZ_RAW(ptr);               /* Engine works on the raw (zoned) block */
+    const size_t alloc_size = LWMEM_RZ_INFLATE(size); /* Guarded request carries both zones */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+#if LWMEM_CFG_CONST_TIME_POOL
+    /* Pool blocks carry no header, regular realloc must never touch them.
+       Snapshot the routing decision under the lock, then act on locals */
+    if (raw_ptr != NULL && lwobj->ct_pool != NULL) {
+        size_t ct_max = 0;
+        uint8_t ct_owned;
+
+        LWMEM_PROTECT(lwobj);
+        ct_owned = LWMEM_CT_OWNS(lwobj, raw_ptr);
+        if (ct_owned) {
+            ct_max = lwobj->ct_max_size;
+        }
+        LWMEM_UNPROTECT(lwobj);
+        if (ct_owned) {
+            if (alloc_size == 0) {
+                lwmem_free_ex(lwobj, raw_ptr);
+                return NULL;
+            }
+            if (alloc_size <= ct_max) {
+                return raw_ptr; /* Every pool slot already holds the full routed alloc_size band */
+            }
+            p = lwmem_malloc_ex(lwobj, region, alloc_size); /* Leaves the constant-time band, move to heap */
+            if (p != NULL) {
+                LWMEM_MEMCPY(p, raw_ptr, ct_max);
+                lwmem_free_ex(lwobj, raw_ptr);
+            }
+            return p;
+        }
+    }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+    LWMEM_PROF_START();
+#if LWMEM_CFG_OOM_HANDLER
+    do {
+#endif /* LWMEM_CFG_OOM_HANDLER */
+        LWMEM_PROTECT(lwobj);
+        p = prv_realloc(lwobj, region, raw_ptr, alloc_size, 1, 1);
+        LWMEM_UNPROTECT(lwobj);
+#if LWMEM_CFG_OOM_HANDLER
+    } while (p == NULL && alloc_size > 0 && lwobj->oom_handler != NULL && lwobj->oom_handler(lwobj, alloc_size));
+#endif /* LWMEM_CFG_OOM_HANDLER */
+    LWMEM_PROF_END(lwobj, realloc_op);
+    p = LWMEM_RZ_FINISH(p); /* Rear zone moved with the new block size */
+    if (p != NULL) {
+        LWMEM_SAN_EXPOSE(p, size); /* In-place growth may cover formerly hidden memory */
+    }
+    LWMEM_JOURNAL_OP(lwobj, p != NULL ? LWMEM_JOURNAL_OP_REALLOC : LWMEM_JOURNAL_OP_ALLOC_FAIL, p, size,
+                     LWMEM_RETURN_ADDR());
+    LWMEM_EVENT(lwobj, p != NULL ? LWMEM_EVT_REALLOC : LWMEM_EVT_ALLOC_FAIL, p, size);
+    return p;
+}
+
+/**
+ * \brief           Reallocate block without preserving its content
+ *
+ * Same relocation logic as \ref lwmem_realloc_ex - in-place grow and shrink
+ * are still preferred and the old block stays valid when reallocation
+ * fails - but all data copying is skipped. For the resize-then-regenerate
+ * pattern (codec frame buffers, scratch staging), this removes the full-size
+ * memmove/memcpy the caller would immediately overwrite anyway.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
+ *                      Set to `NULL` to use any region within LwMEM instance
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise.
+ *                      Content of the returned block is undefined
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_realloc_nopreserve_ex(lwmem_t* lwobj, const lwmem_region_t* region, void* const ptr, const size_t size) {
+    void* p;
+    void* raw_ptr = LWMEM_RZ_RAW(ptr);               /* Engine works on the raw (zoned) block */
+    const size_t alloc_size = LWMEM_RZ_INFLATE(size); /* Guarded request carries both zones */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+#if LWMEM_CFG_CONST_TIME_POOL
+    /* Pool blocks carry no header, regular realloc must never touch them */
+    if (raw_ptr != NULL && lwobj->ct_pool != NULL) {
+        size_t ct_max = 0;
+        uint8_t ct_owned;
+
+        LWMEM_PROTECT(lwobj);
+        ct_owned = LWMEM_CT_OWNS(lwobj, raw_ptr);
+        if (ct_owned) {
+            ct_max = lwobj->ct_max_size;
+        }
+        LWMEM_UNPROTECT(lwobj);
+        if (ct_owned) {
+            if (alloc_size == 0) {
+                lwmem_free_ex(lwobj, raw_ptr);
+                return NULL;
+            }
+            if (alloc_size <= ct_max) {
+                return raw_ptr; /* Every pool slot already holds the full routed alloc_size band */
+            }
+            p = lwmem_malloc_ex(lwobj, region, alloc_size); /* Leaves the constant-time band, nothing to copy */
+            if (p != NULL) {
+                lwmem_free_ex(lwobj, raw_ptr);
+            }
+            return p;
+        }
+    }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+    LWMEM_PROF_START();
+    LWMEM_PROTECT(lwobj);
+    p = prv_realloc(lwobj, region, raw_ptr, alloc_size, 1, 0);
+    LWMEM_UNPROTECT(lwobj);
+    LWMEM_PROF_END(lwobj, realloc_op);
+    p = LWMEM_RZ_FINISH(p); /* Rear zone moved with the new block size */
+    if (p != NULL) {
+        LWMEM_SAN_EXPOSE(p, size); /* Relocation may land on formerly hidden memory */
+    }
+    LWMEM_JOURNAL_OP(lwobj, p != NULL ? LWMEM_JOURNAL_OP_REALLOC : LWMEM_JOURNAL_OP_ALLOC_FAIL, p, size,
+                     LWMEM_RETURN_ADDR());
+    LWMEM_EVENT(lwobj, p != NULL ? LWMEM_EVT_REALLOC : LWMEM_EVT_ALLOC_FAIL, p, size);
+    return p;
+}
+
+/**
+ * \brief           Safe version of realloc_ex function.
+ *
+ * After memory is reallocated, input pointer automatically points to new memory
+ * to prevent use of dangling pointers. When reallocation is not successful,
+ * original pointer is not modified and application still has control of it.
+ *
+ * It is advised to use this function when reallocating memory.
+ *
+ * Function behaves differently, depends on input parameter of `ptr` and `size`:
+ *
+ *  - `ptr == NULL`: Invalid input, function returns `0`
+ *  - `*ptr == NULL; size == 0`: Function returns `0`, no memory is allocated or freed
+ *  - `*ptr == NULL; size > 0`: Function tries to allocate new block of memory with `size` length, equivalent to `malloc(size)`
+ *  - `*ptr != NULL; size == 0`: Function frees memory, equivalent to `free(ptr)`, sets input pointer pointing to `NULL`
+ *  - `*ptr != NULL; size > 0`: Function tries to reallocate existing pointer with new size and copy content to new block
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Pointer to region to allocate from.
+ *                      Set to `NULL` to use any region within LwMEM instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Pointer to pointer to allocated memory. Must not be set to `NULL`.
+ *                      If reallocation is successful, it modifies pointer's pointing address,
+ *                      or sets it to `NULL` in case of `free` operation
+ * \param[in]       size: New requested size in bytes
+ * \return          `1` if successfully reallocated, `0` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+int
+lwmem_realloc_s_ex(lwmem_t* lwobj, const lwmem_region_t* region, void** const ptr, const size_t size) {
+    void* new_ptr;
+
+    /*
+     * Input pointer must not be NULL otherwise,
+     * in case of successful allocation, we have memory leakage
+     * aka. allocated memory where noone is pointing to it
+     */
+    if (ptr == NULL) {
+        return 0;
+    }
+
+    new_ptr = lwmem_realloc_ex(lwobj, region, *ptr, size); /* Try to reallocate existing pointer */
+    if (new_ptr != NULL) {
+        *ptr = new_ptr;
+    } else if (size == 0) { /* size == 0 means free input memory */
+        *ptr = NULL;
+        return 1;
+    }
+    return new_ptr != NULL;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC) || __DOXYGEN__ */
+
+/**
+ * \brief           Shrink allocated memory in place, never moving data
+ *
+ * Tail remainder is split off back to the free list only when it is at least
+ * \ref LWMEM_CFG_SHRINK_SPLIT_THRESHOLD bytes, so trimming buffers does not
+ * generate tiny free fragments that slow down later allocation scans.
+ * Smaller remainders stay attached to the block as extra capacity
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \param[in]       size: New requested size in bytes, must not exceed current block capacity
+ * \return          Input pointer on success, `NULL` otherwise (pointer stays valid)
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_shrink_ex(lwmem_t* lwobj, void* const ptr, const size_t size) {
+    void* retval = NULL;
+    void* const raw_ptr = LWMEM_RZ_RAW(ptr);          /* Engine works on the raw (zoned) block */
+    const size_t alloc_size = LWMEM_RZ_INFLATE(size); /* Guarded request carries both zones */
+
+    if (raw_ptr == NULL || alloc_size == 0) {
+        return NULL;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    {
+#if LWMEM_COMPACT_EN
+        lwmem_compact_block_t* block = (void*)(LWMEM_TO_BYTE_PTR(raw_ptr) - LWMEM_COMPACT_META_SIZE);
+        const size_t final_size = LWMEM_ALIGN(alloc_size) + LWMEM_COMPACT_META_SIZE;
+
+        if (LWMEM_COMPACT_IS_ALLOC(block) && final_size <= (size_t)(block->size & ~LWMEM_COMPACT_ALLOC_BIT)) {
+            const size_t block_size = block->size & ~LWMEM_COMPACT_ALLOC_BIT;
+
+            if ((block_size - final_size) >= LWMEM_CFG_SHRINK_SPLIT_THRESHOLD
+                && (block_size - final_size) >= LWMEM_COMPACT_META_SIZE) {
+                lwmem_compact_block_t* next_blk = (void*)(LWMEM_TO_BYTE_PTR(block) + final_size);
+
+                next_blk->size = (lwmem_compact_off_t)(block_size - final_size);
+                block->size = (lwmem_compact_off_t)final_size | LWMEM_COMPACT_ALLOC_BIT;
+                lwobj->mem_available_bytes += next_blk->size;
+                prv_compact_insert(lwobj, next_blk);
+            }
+            retval = raw_ptr;
+        }
+#elif LWMEM_OOB_EN
+        retval = prv_realloc(lwobj, NULL, raw_ptr, alloc_size, 0, 1); /* Engine shrinks in place, never moves */
+#elif LWMEM_SO_EN
+        /* Blocks keep their capacity, shrink is a capacity check only */
+        {
+            lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+
+            if (LWMEM_BLOCK_IS_ALLOC(block)
+                && (LWMEM_ALIGN(alloc_size) + LWMEM_BLOCK_META_SIZE + LWMEM_SO_FOOTER_SIZE)
+                       <= (block->size & ~LWMEM_ALLOC_BIT)) {
+                retval = raw_ptr;
+            }
+        }
+#elif LWMEM_BUDDY_EN
+        lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+
+        /* Buddy blocks keep their power-of-two class, shrink is capacity check only */
+        if (LWMEM_BLOCK_IS_ALLOC(block)
+            && (LWMEM_ALIGN(alloc_size) + LWMEM_BLOCK_META_SIZE) <= (block->size & ~LWMEM_ALLOC_BIT)) {
+            retval = raw_ptr;
+        }
+#else  /* LWMEM_BUDDY_EN */
+        lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+        size_t final_size =
+            LWMEM_INSTANCE_SIZE_ALIGN(lwobj, LWMEM_BLOCK_SIZE_ALIGN(LWMEM_ALIGN(alloc_size) + LWMEM_BLOCK_META_SIZE + LWMEM_BT_EXTRA));
+
+#if LWMEM_BINS_EN || LWMEM_SKIP_EN
+        if (final_size < LWMEM_BLOCK_MIN_SIZE) {
+            final_size = LWMEM_BLOCK_MIN_SIZE; /* Block must be able to hold free links once it gets freed */
+        }
+#endif /* LWMEM_BINS_EN || LWMEM_SKIP_EN */
+
+        if (LWMEM_BLOCK_IS_ALLOC(block) && final_size <= (block->size & ~LWMEM_ALLOC_BIT)) {
+            if (((block->size & ~LWMEM_ALLOC_BIT) - final_size) >= LWMEM_CFG_SHRINK_SPLIT_THRESHOLD) {
+                prv_split_too_big_block(lwobj, block, final_size); /* Split tail if threshold is met */
+            }
+            retval = raw_ptr;
+        }
+#endif /* !LWMEM_BUDDY_EN && !LWMEM_OOB_EN */
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return LWMEM_RZ_FINISH(retval); /* Rear zone moved with the new block size */
+}
+
+/**
+ * \brief           Shrink allocated memory in place in default LwMEM instance
+ *
+ * This is a wrapper for \ref lwmem_shrink_ex function
+ *
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \param[in]       size: New requested size in bytes
+ * \return          Input pointer on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_shrink(void* const ptr, const size_t size) {
+    return lwmem_shrink_ex(NULL, ptr, size);
+}
+
+#if LWMEM_CFG_SUPPORT_REALLOC
+
+/**
+ * \brief           Grow or shrink allocated memory without full copy to a new block
+ *
+ * Performs only the in-place paths of reallocation: shrink, expansion into
+ * the adjacent next free block, or shift into the adjacent previous free
+ * block (which moves content by the small overlap only). When none of them
+ * can satisfy the request, function fails cleanly with `NULL` and input
+ * pointer remains valid and untouched, so the caller can pick a cheaper
+ * recovery than a full copy.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
+ *                      Must not be `NULL`
+ * \param[in]       size: New requested size in bytes. Must not be `0`
+ * \return          Pointer to memory of new size on success (may differ from input
+ *                      when previous-block shift was used), `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_expand_ex(lwmem_t* lwobj, void* const ptr, const size_t size) {
+    void* p;
+
+    if (ptr == NULL || size == 0) {
+        return NULL; /* Expansion never allocates fresh block nor frees memory */
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    p = prv_realloc(lwobj, NULL, LWMEM_RZ_RAW(ptr), LWMEM_RZ_INFLATE(size), 0, 1);
+    LWMEM_UNPROTECT(lwobj);
+    return LWMEM_RZ_FINISH(p); /* Rear zone moved with the new block size */
+}
+
+/**
+ * \brief           Grow or shrink allocated memory in default LwMEM instance, without full copy
+ *
+ * This is a wrapper for \ref lwmem_expand_ex function
+ *
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \param[in]       size: New requested size in bytes
+ * \return          Pointer to memory of new size on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_expand(void* const ptr, const size_t size) {
+    return lwmem_expand_ex(NULL, ptr, size);
+}
+
+#endif /* LWMEM_CFG_SUPPORT_REALLOC */
+
+/**
+ * \brief           Free previously allocated memory using one of allocation functions
+ *                  in specific lwmem instance.
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \note            This is an extended free version function declaration to support advanced features
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_free_ex(lwmem_t* lwobj, void* const ptr) {
+    void* raw_ptr = LWMEM_RZ_RAW(ptr); /* Engine works on the raw (zoned) block */
+#if LWMEM_REDZONE_EN
+    if (raw_ptr != NULL) {
+        lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+
+        if (LWMEM_BLOCK_IS_ALLOC(block) && !prv_redzone_verify(block)) {
+            ++LWMEM_GET_LWOBJ(lwobj)->redzone_violations; /* Overflow detected before block re-enters free list */
+        }
+    }
+#endif /* LWMEM_REDZONE_EN */
+#if LWMEM_CFG_CONST_TIME_POOL
+    if (raw_ptr != NULL) {
+        lwmem_t* ct_obj = LWMEM_GET_LWOBJ(lwobj);
+
+        if (ct_obj->ct_pool != NULL) {
+            uint8_t ct_routed = 0;
+
+            LWMEM_PROTECT(ct_obj); /* Ownership test and push under one lock, attach may run concurrently */
+            if (LWMEM_CT_OWNS(ct_obj, raw_ptr)) {
+                lwmem_pool_free(ct_obj->ct_pool, raw_ptr);
+                ct_routed = 1;
+            }
+            LWMEM_UNPROTECT(ct_obj);
+            if (ct_routed) {
+                return;
+            }
+        }
+    }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+#if LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE
+    /* Try to keep small default-instance blocks in this CPU's cache */
+    if (lwobj == NULL && raw_ptr != NULL) {
+        const lwmem_block_t* cc_block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+
+        if (LWMEM_BLOCK_IS_ALLOC(cc_block)) {
+            const size_t cc_user = (cc_block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+
+            if (cc_user >= sizeof(void*) && cc_user <= LWMEM_CFG_CPU_CACHE_MAX_SIZE) {
+                const size_t cc_idx = cc_user / LWMEM_CFG_ALIGN_NUM - 1;
+                uint8_t cc_cached = 0;
+
+                LWMEM_CPU_LOCK();
+                {
+                    const size_t cpu = (size_t)LWMEM_GET_CPU_ID() % LWMEM_CFG_CPU_COUNT;
+
+                    if (cpu_caches[cpu].counts[cc_idx] < LWMEM_CFG_CPU_CACHE_DEPTH) {
+                        *(void**)raw_ptr = cpu_caches[cpu].heads[cc_idx];
+                        cpu_caches[cpu].heads[cc_idx] = raw_ptr;
+                        ++cpu_caches[cpu].counts[cc_idx];
+                        cc_cached = 1;
+                    }
+                }
+                LWMEM_CPU_UNLOCK();
+                if (cc_cached) {
+                    return; /* Full magazines spill through the regular path below */
+                }
+            }
+        }
+    }
+#endif /* LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE */
+
+#if LWMEM_CFG_FULL && LWMEM_TCACHE_EN
+    /* Try to keep small default-instance blocks in thread cache, without touching the lock */
+    if (lwobj == NULL && raw_ptr != NULL) {
+        const lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(raw_ptr);
+
+        if (LWMEM_BLOCK_IS_ALLOC(block)) {
+            const size_t user_size = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+
+            if (LWMEM_TCACHE_FITS(user_size)) {
+                const size_t idx = LWMEM_TCACHE_IDX(user_size);
+
+                if (thread_cache.counts[idx] < LWMEM_CFG_THREAD_CACHE_DEPTH) {
+                    *(void**)raw_ptr = thread_cache.heads[idx];
+                    thread_cache.heads[idx] = raw_ptr;
+                    ++thread_cache.counts[idx];
+                    return;
+                }
+            }
+        }
+    }
+#endif /* LWMEM_CFG_FULL && LWMEM_TCACHE_EN */
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROF_START();
+    LWMEM_PROTECT(lwobj);
+    prv_free(lwobj, raw_ptr);
+    LWMEM_UNPROTECT(lwobj);
+    LWMEM_PROF_END(lwobj, free_op);
+    LWMEM_JOURNAL_OP(lwobj, LWMEM_JOURNAL_OP_FREE, raw_ptr, 0, LWMEM_RETURN_ADDR());
+    LWMEM_EVENT(lwobj, LWMEM_EVT_FREE, raw_ptr, 0);
+}
+
+/**
+ * \brief           Free previously allocated memory with cheap validation gate
+ *
+ * Pointer is rejected (and nothing freed) unless it lies inside a region of
+ * the instance, is aligned like a block payload and its header carries the
+ * allocation mark - catching double frees and pointers into the middle of
+ * blocks in O(regions) before they can corrupt the free list. The classic
+ * \ref lwmem_free_ex stays unchanged for hot release paths
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Memory to free
+ * \return          `1` when pointer was valid and has been freed, `0` when rejected
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_free_checked_ex(lwmem_t* lwobj, void* const in_ptr) {
+    uint8_t valid = 0;
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    void* const ptr = LWMEM_RZ_RAW(in_ptr); /* Validation and free run on the raw (zoned) block */
+
+    if (ptr == NULL) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+#if LWMEM_CFG_CONST_TIME_POOL
+    if (LWMEM_CT_OWNS(lwobj, ptr)) { /* Pool-served pointer is valid, route it back to its pool */
+        lwmem_pool_free(lwobj->ct_pool, ptr);
+        LWMEM_UNPROTECT(lwobj);
+        return 1;
+    }
+#endif /* LWMEM_CFG_CONST_TIME_POOL */
+#if LWMEM_OOB_EN
+    if (LWMEM_TO_BYTE_PTR(ptr) >= lwobj->oob_base
+        && LWMEM_TO_BYTE_PTR(ptr) < (lwobj->oob_base + lwobj->oob_data_size)) {
+        uint32_t idx = prv_oob_find(lwobj, (uint32_t)(LWMEM_TO_BYTE_PTR(ptr) - lwobj->oob_base), &valid);
+
+        (void)idx;
+        (void)mem_start_addr;
+        (void)mem_size;
+    }
+#elif LWMEM_COMPACT_EN
+    {
+        const lwmem_compact_block_t* block = (const void*)(LWMEM_TO_BYTE_PTR(ptr) - LWMEM_COMPACT_META_SIZE);
+
+        valid = LWMEM_TO_BYTE_PTR(ptr) > lwobj->compact_base && LWMEM_COMPACT_IS_ALLOC(block);
+        (void)mem_start_addr;
+        (void)mem_size;
+    }
+#else  /* LWMEM_COMPACT_EN */
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         !valid && region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        if (LWMEM_TO_BYTE_PTR(ptr) > mem_start_addr && LWMEM_TO_BYTE_PTR(ptr) < (mem_start_addr + mem_size)
+            && (((size_t)(LWMEM_TO_BYTE_PTR(ptr) - mem_start_addr)) & LWMEM_ALIGN_BITS) == 0) {
+            const lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+            /* Header must carry the allocation mark and block must stay within the region */
+            valid = LWMEM_BLOCK_IS_ALLOC(block)
+                    && (LWMEM_TO_BYTE_PTR(block) + block_size) <= (mem_start_addr + mem_size);
+        }
+    }
+#endif /* !LWMEM_COMPACT_EN */
+    if (valid) {
+        prv_free(lwobj, ptr);
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return valid;
+}
+
+/**
+ * \brief           Free memory with caller-provided size, matching C23 `free_sized` semantics
+ *
+ * The trusted size drives the cache fast paths without any header read;
+ * development builds (`LWMEM_DEV`) verify the claim against block metadata.
+ * Behavior is undefined when the size does not match the allocation
+ * (same contract as the C23 counterpart)
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
+ * \param[in]       size: Size used at allocation time
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_free_sized_ex(lwmem_t* lwobj, void* const ptr, const size_t size) {
+#if defined(LWMEM_DEV)
+    if (ptr != NULL && lwmem_get_size_ex(lwobj, ptr) < size) {
+        lwmem_free_ex(lwobj, ptr); /* Size claim does not match the allocation, take the safe path */
+        return;
+    }
+#endif /* defined(LWMEM_DEV) */
+
+#if LWMEM_CFG_FULL && LWMEM_TCACHE_EN
+    /* Size is trusted, cache push happens without touching block metadata */
+    if (lwobj == NULL && ptr != NULL && size > 0) {
+        const size_t aligned_size = LWMEM_ALIGN(size);
+
+        if (LWMEM_TCACHE_FITS(aligned_size)) {
+            const size_t idx = LWMEM_TCACHE_IDX(aligned_size);
+
+            if (thread_cache.counts[idx] < LWMEM_CFG_THREAD_CACHE_DEPTH) {
+                *(void**)ptr = thread_cache.heads[idx];
+                thread_cache.heads[idx] = ptr;
+                ++thread_cache.counts[idx];
+                return;
+            }
+        }
+    }
+#else  /* LWMEM_CFG_FULL && LWMEM_TCACHE_EN */
+    (void)size;
+#endif /* !(LWMEM_CFG_FULL && LWMEM_TCACHE_EN) */
+    lwmem_free_ex(lwobj, ptr);
+}
+
+/**
+ * \brief           Safe version of free function
+ *
+ * After memory is freed, input pointer is safely set to `NULL`
+ * to prevent use of dangling pointers.
+ *
+ * It is advised to use this function when freeing memory.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Pointer to pointer to allocated memory.
+ *                  When set to non `NULL`, pointer is freed and set to `NULL`
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_free_s_ex(lwmem_t* lwobj, void** const ptr) {
+    if (ptr != NULL && *ptr != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        prv_free(lwobj, *ptr);
+        LWMEM_UNPROTECT(lwobj);
+        *ptr = NULL;
+    }
+}
+
+/**
+ * \brief           Get user size of allocated memory
+ *
+ * Constant time operation: size is read from block metadata
+ * (out-of-band configurations use a logarithmic table lookup)
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Pointer to allocated memory
+ * \return          Block size for user in units of bytes
+ */
+/**
+ * \brief           Get application size of allocated pointer, for any active engine
+ *
+ * Must be called with instance protected (mutex taken)
+ *
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in]       ptr: Raw pointer to allocated memory (without guard zone adjustment)
+ * \return          Application size in units of bytes, `0` for invalid pointers
+ */
+static size_t
+prv_ptr_user_size(lwmem_t* lwobj, void* ptr) {
+    size_t len = 0;
+
+#if LWMEM_OOB_EN
+    {
+        uint8_t found = 0;
+        uint32_t idx = prv_oob_find(lwobj, (uint32_t)(LWMEM_TO_BYTE_PTR(ptr) - lwobj->oob_base), &found);
+
+        if (found) {
+            len = LWMEM_OOB_TABLE(lwobj)[idx].size;
+        }
+    }
+#elif LWMEM_COMPACT_EN
+    lwmem_compact_block_t* cblock = (void*)(LWMEM_TO_BYTE_PTR(ptr) - LWMEM_COMPACT_META_SIZE);
+
+    (void)lwobj;
+    if (LWMEM_COMPACT_IS_ALLOC(cblock)) {
+        len = (size_t)((cblock->size & ~LWMEM_COMPACT_ALLOC_BIT) - LWMEM_COMPACT_META_SIZE);
+    }
+#else /* LWMEM_COMPACT_EN */
+    lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+
+    (void)lwobj;
+    if (LWMEM_BLOCK_IS_ALLOC(block)) {
+        len = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+#if LWMEM_SO_EN
+        len -= LWMEM_SO_FOOTER_SIZE; /* Boundary tag is not part of application capacity */
+#endif /* LWMEM_SO_EN */
+#if LWMEM_BT_EN
+        len -= LWMEM_BT_WORD; /* Boundary tag is not part of application capacity */
+#endif /* LWMEM_BT_EN */
+#if LWMEM_REDZONE_EN
+        len -= 2 * LWMEM_CFG_REDZONE_SIZE; /* Zones are not part of application capacity */
+#endif /* LWMEM_REDZONE_EN */
+    }
+#endif /* !LWMEM_COMPACT_EN */
+    return len;
+}
+
+size_t
+lwmem_get_size_ex(lwmem_t* lwobj, void* ptr) {
+    size_t len = 0;
+
+#if LWMEM_REDZONE_EN
+    if (ptr != NULL) {
+        ptr = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_CFG_REDZONE_SIZE; /* Header sits below the front zone */
+    }
+#endif /* LWMEM_REDZONE_EN */
+    if (ptr != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        len = prv_ptr_user_size(lwobj, ptr);
+        LWMEM_UNPROTECT(lwobj);
+    }
+    return len;
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Perform bounded defragmentation work for movable blocks
+ *
+ * Walks the heap and relocates application-approved blocks towards lower
+ * addresses (standard allocate-copy-free through the regular engine), merging
+ * the vacated space with neighboring free blocks. At most `budget_bytes` of
+ * content is moved per call, so the function fits an RTOS idle hook donation
+ * instead of a stop-the-world pass. Callback fixes up the owner's pointer
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       budget_bytes: Maximal number of content bytes to move in this call
+ * \param[in]       move_cb: Relocation approval and pointer fix-up callback
+ * \param[in]       user: User argument passed to the callback
+ * \return          Number of bytes moved
+ * \note            Only supported by list-based allocation strategies.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_defrag_step_ex(lwmem_t* lwobj, size_t budget_bytes, lwmem_move_fn move_cb, void* user) {
+    size_t moved = 0;
+
+#if !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    uint8_t hole_seen = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+#if LWMEM_PIN_EN
+    if (move_cb == NULL) {
+        move_cb = lwobj->move_handler; /* Fall back to registered relocation protocol handler */
+        user = move_cb != NULL ? lwobj->move_handler_user : user;
+    }
+#endif /* LWMEM_PIN_EN */
+    if (move_cb == NULL || budget_bytes == 0) {
+        return 0;
+    }
+    LWMEM_PROTECT(lwobj);
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         moved < budget_bytes && region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        for (lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA); moved < budget_bytes;) {
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+            lwmem_block_t* next_block;
+
+            if (block_size == 0) { /* End of region indicator */
+                break;
+            }
+            next_block = (void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+            if (!LWMEM_BLOCK_IS_ALLOC(block)) {
+                hole_seen = 1; /* Blocks above this one may profit from relocation */
+            } else if (hole_seen && (block_size - LWMEM_BLOCK_META_SIZE) <= (budget_bytes - moved)
+#if LWMEM_PIN_EN
+                       && block->pin_cnt == 0 /* Pinned blocks never move */
+#endif /* LWMEM_PIN_EN */
+            ) {
+                const size_t user_size = block_size - LWMEM_BLOCK_META_SIZE;
+                void* old_ptr = LWMEM_GET_PTR_FROM_BLOCK(block);
+                void* new_ptr = prv_alloc(lwobj, NULL, user_size);
+
+                if (new_ptr != NULL && LWMEM_TO_BYTE_PTR(new_ptr) < LWMEM_TO_BYTE_PTR(old_ptr)) {
+                    LWMEM_MEMCPY(new_ptr, old_ptr, user_size);
+                    if (move_cb(old_ptr, new_ptr, user_size, user)) {
+                        prv_free(lwobj, old_ptr);
+                        moved += user_size;
+                    } else {
+                        prv_free(lwobj, new_ptr); /* Owner refused, leave block in place */
+                    }
+                } else if (new_ptr != NULL) {
+                    prv_free(lwobj, new_ptr); /* No improvement possible for this block */
+                }
+            }
+            block = next_block;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+    (void)lwobj;
+    (void)budget_bytes;
+    (void)move_cb;
+    (void)user;
+#endif /* LWMEM_BUDDY_EN || LWMEM_COMPACT_EN || LWMEM_OOB_EN || LWMEM_SO_EN */
+    return moved;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Query pending heap maintenance work
+ *
+ * Lets the application integrate heap housekeeping (deferred coalescing,
+ * background scrubbing, interrupt free-queue draining) with its power
+ * manager: run maintenance only when the core is awake anyway, instead of
+ * waking a tickless system from an idle hook
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in,out]   info: Summary output. `pending == 0` means the core may sleep
+ *                      without any heap deadline
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_maint_info_ex(lwmem_t* lwobj, lwmem_maint_info_t* info) {
+    if (info == NULL) {
+        return;
+    }
+    info->pending = 0;
+    info->scrub_bytes = 0;
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+#if LWMEM_DEFERRED_EN
+    if (lwobj->deferred_free != NULL) {
+        info->pending |= LWMEM_MAINT_COALESCE;
+    }
+#endif /* LWMEM_DEFERRED_EN */
+#if LWMEM_SCRUB_EN
+    for (const lwmem_block_t* block = lwobj->scrub_pending; block != NULL; block = block->next) {
+        info->scrub_bytes += block->size - LWMEM_BLOCK_META_SIZE;
+    }
+    if (lwobj->scrub_pending != NULL) {
+        info->scrub_bytes -= lwobj->scrub_done;
+        info->pending |= LWMEM_MAINT_SCRUB;
+    }
+#endif /* LWMEM_SCRUB_EN */
+#if LWMEM_ISR_FREE_EN
+    if (atomic_load(&(lwobj->isr_free_head)) != NULL) {
+        info->pending |= LWMEM_MAINT_ISR_QUEUE;
+    }
+#endif /* LWMEM_ISR_FREE_EN */
+    LWMEM_UNPROTECT(lwobj);
+}
+
+/**
+ * \brief           Run one bounded slice of pending heap maintenance
+ *
+ * Cheap constant-cost work (interrupt queue drain, deferred coalescing) runs
+ * completely; byte-budgeted work (scrubbing) consumes at most `budget_bytes`
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       budget_bytes: Budget for byte-bounded maintenance, `0` for no limit
+ * \return          `1` when more maintenance is still pending, `0` when done
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_maint_run_ex(lwmem_t* lwobj, size_t budget_bytes) {
+    lwmem_maint_info_t info;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+#if LWMEM_ISR_FREE_EN
+    if (atomic_load(&(lwobj->isr_free_head)) != NULL) {
+        prv_isr_free_drain(lwobj);
+    }
+#endif /* LWMEM_ISR_FREE_EN */
+#if LWMEM_DEFERRED_EN
+    if (lwobj->deferred_free != NULL) {
+        prv_coalesce_deferred(lwobj);
+    }
+#endif /* LWMEM_DEFERRED_EN */
+#if LWMEM_SCRUB_EN
+    prv_scrub_step(lwobj, budget_bytes);
+#endif /* LWMEM_SCRUB_EN */
+    LWMEM_UNPROTECT(lwobj);
+    (void)budget_bytes;
+
+    lwmem_maint_info_ex(lwobj == &lwmem_default ? NULL : lwobj, &info);
+    return info.pending != 0;
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BOUNDED_LOCK) || __DOXYGEN__
+
+/**
+ * \brief           Read number of allocations failed by the critical-section walk bound
+ *
+ * A rising value means the free list regularly exceeds
+ * \ref LWMEM_CFG_BOUNDED_LOCK_MAX_WALK blocks; drain it with
+ * \ref lwmem_coalesce_step_ex or raise the bound
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \return          Abort counter value
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint32_t
+lwmem_bound_aborts_ex(lwmem_t* lwobj) {
+    uint32_t res;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    res = lwobj->bound_alloc_aborts;
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Coalesce deferred blocks in preemptible stages
+ *
+ * Takes and releases the instance lock once per block, so interrupts
+ * (or higher priority tasks) preempt between every merge. Call from
+ * thread context or an idle hook until `0` is returned
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       max_blocks: Maximal number of blocks to return to the free list,
+ *                      `0` to drain everything (still one block per lock take)
+ * \return          Number of blocks still waiting on the deferred list
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_coalesce_step_ex(lwmem_t* lwobj, size_t max_blocks) {
+    size_t budget = max_blocks > 0 ? max_blocks : (size_t)-1;
+    size_t remaining = 0;
+    uint8_t more = 1;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    while (more && budget-- > 0) {
+        LWMEM_PROTECT(lwobj);
+        {
+            lwmem_block_t* block = lwobj->deferred_free;
+
+            if (block != NULL) {
+                lwobj->deferred_free = block->next;
+                prv_insert_free_block(lwobj, block, NULL);
+            }
+            more = lwobj->deferred_free != NULL;
+        }
+        LWMEM_UNPROTECT(lwobj);
+    }
+    if (more) { /* Count what is left for the caller's scheduling decision */
+        LWMEM_PROTECT(lwobj);
+        for (const lwmem_block_t* block = lwobj->deferred_free; block != NULL; block = block->next) {
+            ++remaining;
+        }
+        LWMEM_UNPROTECT(lwobj);
+    }
+    return remaining;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BOUNDED_LOCK) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_RT_EN) || __DOXYGEN__
+
+/**
+ * \brief           Reserve guaranteed blocks of one size class
+ *
+ * Blocks are pre-split off the free list and kept allocated-marked on the
+ * class stack, so best-effort traffic can never consume them: the guarantee
+ * holds by construction, no admission check on the hot allocation path.
+ * Call once per class at system init, while the heap is still unfragmented
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       size: Largest request size the class must guarantee, in units of bytes
+ * \param[in]       count: Number of blocks to guarantee
+ * \return          `1` on success, `0` when classes are exhausted, class sizes
+ *                      would be ambiguous, or memory does not suffice
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_rt_reserve_ex(lwmem_t* lwobj, size_t size, size_t count) {
+    size_t cls, idx = LWMEM_CFG_RT_TIER_CLASSES;
+    uint8_t res = 1;
+    const size_t expected_size = LWMEM_INSTANCE_SIZE_ALIGN(
+        LWMEM_GET_LWOBJ(lwobj),
+        LWMEM_BLOCK_SIZE_ALIGN(LWMEM_ALIGN(LWMEM_ROUND_SIZE(size)) + LWMEM_BLOCK_META_SIZE + LWMEM_BT_EXTRA));
+
+    if (size == 0 || count == 0 || count > (uint16_t)~(uint16_t)0) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (cls = 0; cls < LWMEM_CFG_RT_TIER_CLASSES; ++cls) {
+        if (lwobj->rt_classes[cls].block_size == 0) {
+            if (idx >= LWMEM_CFG_RT_TIER_CLASSES) {
+                idx = cls; /* First unused entry takes the new class */
+            }
+        } else if ((lwobj->rt_classes[cls].block_size >= expected_size
+                        ? lwobj->rt_classes[cls].block_size - expected_size
+                        : expected_size - lwobj->rt_classes[cls].block_size)
+                   < LWMEM_BLOCK_MIN_SIZE) {
+            res = 0; /* Size windows would overlap, class-by-size lookup at free would be ambiguous */
+        }
+    }
+    if (res == 0 || idx >= LWMEM_CFG_RT_TIER_CLASSES) {
+        LWMEM_UNPROTECT(lwobj);
+        return 0;
+    }
+    lwobj->rt_classes[idx].block_size = expected_size;
+    for (size_t blk_idx = 0; blk_idx < count; ++blk_idx) {
+        void* ptr = prv_alloc(lwobj, NULL, size);
+
+        if (ptr == NULL) {
+            res = 0; /* Not enough memory for full guarantee, partial reservation stands down */
+            break;
+        }
+        *(void**)ptr = lwobj->rt_classes[idx].head; /* Push to class stack, link in user area */
+        lwobj->rt_classes[idx].head = ptr;
+        ++lwobj->rt_classes[idx].total;
+        ++lwobj->rt_classes[idx].avail;
+    }
+    if (res == 0) { /* Roll partial reservation back to the free list */
+        while (lwobj->rt_classes[idx].head != NULL) {
+            void* ptr = lwobj->rt_classes[idx].head;
+
+            lwobj->rt_classes[idx].head = *(void**)ptr;
+            prv_free(lwobj, ptr);
+        }
+        lwobj->rt_classes[idx].block_size = 0;
+        lwobj->rt_classes[idx].total = 0;
+        lwobj->rt_classes[idx].avail = 0;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Allocate against the guaranteed tier
+ *
+ * Single stack pop from the smallest class guaranteeing the size - O(1)
+ * with contractual latency, independent of heap fragmentation and of
+ * concurrent best-effort traffic
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory, `NULL` when the matching guarantee is exhausted
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_rt_ex(lwmem_t* lwobj, size_t size) {
+    void* ptr = NULL;
+    size_t best = LWMEM_CFG_RT_TIER_CLASSES;
+    const size_t needed = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE;
+
+    if (size == 0) {
+        return NULL;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (size_t cls = 0; cls < LWMEM_CFG_RT_TIER_CLASSES; ++cls) {
+        if (lwobj->rt_classes[cls].avail > 0 && lwobj->rt_classes[cls].block_size >= needed
+            && (best >= LWMEM_CFG_RT_TIER_CLASSES
+                || lwobj->rt_classes[cls].block_size < lwobj->rt_classes[best].block_size)) {
+            best = cls;
+        }
+    }
+    if (best < LWMEM_CFG_RT_TIER_CLASSES) {
+        ptr = lwobj->rt_classes[best].head;
+        lwobj->rt_classes[best].head = *(void**)ptr;
+        --lwobj->rt_classes[best].avail;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return ptr;
+}
+
+/**
+ * \brief           Return guaranteed-tier block back to its class
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously obtained with \ref lwmem_malloc_rt_ex
+ * \return          `1` on success, `0` when pointer matches no reserved class
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_free_rt_ex(lwmem_t* lwobj, void* ptr) {
+    uint8_t res = 0;
+
+    if (ptr == NULL) {
+        return 0;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    {
+        const lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+        const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+        for (size_t cls = 0; cls < LWMEM_CFG_RT_TIER_CLASSES; ++cls) {
+            /* Class windows do not overlap (enforced at reserve), size identifies the class.
+               Window absorbs the sub-minimum split slack some reserved blocks carry */
+            if (lwobj->rt_classes[cls].block_size > 0 && block_size >= lwobj->rt_classes[cls].block_size
+                && (block_size - lwobj->rt_classes[cls].block_size) < LWMEM_BLOCK_MIN_SIZE
+                && lwobj->rt_classes[cls].avail < lwobj->rt_classes[cls].total) {
+                *(void**)ptr = lwobj->rt_classes[cls].head;
+                lwobj->rt_classes[cls].head = ptr;
+                ++lwobj->rt_classes[cls].avail;
+                res = 1;
+                break;
+            }
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Read number of currently available guaranteed blocks for the size
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       size: Request size to check guarantees for
+ * \return          Number of immediately available guaranteed blocks
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_rt_avail_ex(lwmem_t* lwobj, size_t size) {
+    size_t avail = 0;
+    const size_t needed = LWMEM_ALIGN(size) + LWMEM_BLOCK_META_SIZE;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (size_t cls = 0; cls < LWMEM_CFG_RT_TIER_CLASSES; ++cls) {
+        if (lwobj->rt_classes[cls].block_size >= needed && lwobj->rt_classes[cls].block_size > 0) {
+            avail += lwobj->rt_classes[cls].avail;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return avail;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_RT_EN) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_GENERATION) || __DOXYGEN__
+
+/**
+ * \brief           Take generation-validated reference of an allocated block
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \return          Reference valid until the block is freed.
+ *                      `ptr` member is `NULL` when input is not an allocated block
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+lwmem_ref_t
+lwmem_ref_make_ex(lwmem_t* lwobj, void* ptr) {
+    lwmem_ref_t ref = {NULL, 0};
+    lwmem_block_t* block;
+
+    if (ptr == NULL) {
+        return ref;
+    }
+#if LWMEM_REDZONE_EN
+    ptr = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_CFG_REDZONE_SIZE; /* Header sits below the front zone */
+#endif /* LWMEM_REDZONE_EN */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (LWMEM_BLOCK_IS_ALLOC(block)) {
+        ref.ptr = ptr;
+        ref.gen = block->gen;
+    }
+    LWMEM_UNPROTECT(lwobj);
+#if LWMEM_REDZONE_EN
+    if (ref.ptr != NULL) {
+        ref.ptr = LWMEM_TO_BYTE_PTR(ref.ptr) + LWMEM_CFG_REDZONE_SIZE; /* Hand application pointer back out */
+    }
+#endif /* LWMEM_REDZONE_EN */
+    return ref;
+}
+
+/**
+ * \brief           Resolve generation-validated reference in O(1)
+ *
+ * Stale references - block freed, or freed and reallocated at the same
+ * address since the reference was taken - resolve to `NULL` instead of
+ * aliasing whatever lives there now (the ABA hazard of raw pointers)
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ref: Reference previously taken with \ref lwmem_ref_make_ex
+ * \return          Block address when reference is still current, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_ref_resolve_ex(lwmem_t* lwobj, lwmem_ref_t ref) {
+    lwmem_block_t* block;
+    void* res = NULL;
+    void* ptr = ref.ptr;
+
+    if (ptr == NULL) {
+        return NULL;
+    }
+#if LWMEM_REDZONE_EN
+    ptr = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_CFG_REDZONE_SIZE; /* Header sits below the front zone */
+#endif /* LWMEM_REDZONE_EN */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (LWMEM_BLOCK_IS_ALLOC(block) && block->gen == ref.gen) {
+        res = ref.ptr; /* Reference is current, hand the application pointer back */
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_GENERATION) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_UDATA) || __DOXYGEN__
+
+/**
+ * \brief           Store application metadata word of the block
+ *
+ * One inline word of ownership/type information per buffer,
+ * kept through in-place reallocations of the block
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \param[in]       udata: Metadata word to store
+ * \return          `1` on success, `0` when pointer is not an allocated block
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_set_udata_ex(lwmem_t* lwobj, void* ptr, size_t udata) {
+    lwmem_block_t* block;
+    uint8_t res = 0;
+
+    if (ptr == NULL) {
+        return 0;
+    }
+#if LWMEM_REDZONE_EN
+    ptr = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_CFG_REDZONE_SIZE; /* Header sits below the front zone */
+#endif /* LWMEM_REDZONE_EN */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (LWMEM_BLOCK_IS_ALLOC(block)) {
+        block->udata = udata;
+        res = 1;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Read application metadata word of the block
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \return          Stored metadata word, `0` when pointer is not an allocated block
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_get_udata_ex(lwmem_t* lwobj, void* ptr) {
+    lwmem_block_t* block;
+    size_t udata = 0;
+
+    if (ptr == NULL) {
+        return 0;
+    }
+#if LWMEM_REDZONE_EN
+    ptr = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_CFG_REDZONE_SIZE; /* Header sits below the front zone */
+#endif /* LWMEM_REDZONE_EN */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    if (LWMEM_BLOCK_IS_ALLOC(block)) {
+        udata = block->udata;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return udata;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_UDATA) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_PINNING) || __DOXYGEN__
+
+/**
+ * \brief           Resolve allocated block header from application pointer
+ * \param[in]       ptr: Application pointer as returned by allocation functions
+ * \return          Block header, `NULL` when pointer is not an allocated block
+ */
+static lwmem_block_t*
+prv_pin_block(void* ptr) {
+    lwmem_block_t* block;
+
+    if (ptr == NULL) {
+        return NULL;
+    }
+#if LWMEM_REDZONE_EN
+    ptr = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_CFG_REDZONE_SIZE; /* Header sits below the front zone */
+#endif /* LWMEM_REDZONE_EN */
+    block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
+    return LWMEM_BLOCK_IS_ALLOC(block) ? block : NULL;
+}
+
+/**
+ * \brief           Pin block against relocation
+ *
+ * Pins nest: block becomes movable again once every pin
+ * has been released with \ref lwmem_unpin_ex
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \return          `1` on success, `0` when pointer is invalid or pin count saturated
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_pin_ex(lwmem_t* lwobj, void* ptr) {
+    lwmem_block_t* block;
+    uint8_t res = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = prv_pin_block(ptr);
+    if (block != NULL && block->pin_cnt < (uint16_t)~(uint16_t)0) {
+        ++block->pin_cnt;
+        res = 1;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Release one pin of the block
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously pinned with \ref lwmem_pin_ex
+ * \return          `1` on success, `0` when pointer is invalid or block is not pinned
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_unpin_ex(lwmem_t* lwobj, void* ptr) {
+    lwmem_block_t* block;
+    uint8_t res = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = prv_pin_block(ptr);
+    if (block != NULL && block->pin_cnt > 0) {
+        --block->pin_cnt;
+        res = 1;
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Check if block is currently pinned
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Memory block previously allocated with one of allocation functions
+ * \return          `1` when block is pinned, `0` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_is_pinned_ex(lwmem_t* lwobj, void* ptr) {
+    lwmem_block_t* block;
+    uint8_t res = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    block = prv_pin_block(ptr);
+    res = block != NULL && block->pin_cnt > 0;
+    LWMEM_UNPROTECT(lwobj);
+    return res;
+}
+
+/**
+ * \brief           Register default relocation fix-up handler of the instance
+ *
+ * Handler is consulted for every proposed block move when no per-call
+ * callback is given - one owner-side protocol shared by the defragmenter
+ * and future relocating features, instead of per-feature conventions
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       move_cb: Relocation approval and pointer fix-up callback,
+ *                      or `NULL` to unregister
+ * \param[in]       user: User argument passed to the callback
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_set_move_handler_ex(lwmem_t* lwobj, lwmem_move_fn move_cb, void* user) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    lwobj->move_handler = move_cb;
+    lwobj->move_handler_user = user;
+    LWMEM_UNPROTECT(lwobj);
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_PINNING) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_CHECKSUM) || __DOXYGEN__
+
+/**
+ * \brief           Read header corruption counters
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[out]      detected: Optional output for unrecoverable corruption count
+ * \param[out]      repaired: Optional output for count of links repaired from shadow copies
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_chk_stats_ex(lwmem_t* lwobj, uint32_t* detected, uint32_t* repaired) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    if (detected != NULL) {
+        *detected = lwobj->chk_detected;
+    }
+    if (repaired != NULL) {
+        *repaired = lwobj->chk_repaired;
+    }
+    LWMEM_UNPROTECT(lwobj);
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_BLOCK_CHECKSUM) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_CONST_TIME_POOL) || __DOXYGEN__
+
+/**
+ * \brief           Attach constant-time pool for a security-sensitive size band
+ *
+ * Allocations of `1` to `max_size` bytes on the instance are then served
+ * from the pool with data-independent cycle count (single free-stack pop),
+ * frees of pool blocks route back the same way. Pool exhaustion fails the
+ * allocation, a timing-dependent fallback to the regular free list would
+ * reopen the side channel - size the pool for the peak concurrent count.
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       pool: Pool previously initialized with \ref lwmem_pool_init,
+ *                      or `NULL` to detach
+ * \param[in]       region: The same region the pool was carved from, for free routing
+ * \param[in]       max_size: Largest request size routed to the pool.
+ *                      Must not exceed pool block size
+ * \return          `1` on success, `0` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+uint8_t
+lwmem_ct_attach_ex(lwmem_t* lwobj, struct lwmem_pool* pool, const lwmem_region_t* region, size_t max_size) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    if (pool != NULL && (region == NULL || max_size == 0 || max_size > pool->block_size)) {
+        return 0;
+    }
+    LWMEM_PROTECT(lwobj);
+    lwobj->ct_pool = pool;
+    lwobj->ct_base = pool != NULL ? LWMEM_TO_BYTE_PTR(region->start_addr) : NULL;
+    lwobj->ct_range = pool != NULL ? region->size : 0;
+    lwobj->ct_max_size = pool != NULL ? max_size : 0;
+    LWMEM_UNPROTECT(lwobj);
+    return 1;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_CONST_TIME_POOL) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_OP_JOURNAL) || __DOXYGEN__
+
+/**
+ * \brief           Attach (and reset) noinit journal record to the instance
+ *
+ * Decode any previous-boot content with \ref lwmem_journal_valid and
+ * \ref lwmem_journal_read before this call, record is cleared here
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       journal: Journal record in noinit RAM, or `NULL` to detach
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_journal_attach_ex(lwmem_t* lwobj, lwmem_journal_t* journal) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    if (journal != NULL) {
+        journal->magic = LWMEM_JOURNAL_MAGIC;
+        journal->depth = LWMEM_CFG_OP_JOURNAL_DEPTH;
+        journal->head = 0;
+        journal->available_bytes = (uint32_t)lwobj->mem_available_bytes;
+    }
+    lwobj->journal = journal;
+    LWMEM_UNPROTECT(lwobj);
+}
+
+/**
+ * \brief           Check if journal record carries valid previous-boot content
+ * \param[in]       journal: Journal record in noinit RAM
+ * \return          `1` when record is decodable, `0` otherwise
+ */
+uint8_t
+lwmem_journal_valid(const lwmem_journal_t* journal) {
+    return journal != NULL && journal->magic == LWMEM_JOURNAL_MAGIC && journal->depth == LWMEM_CFG_OP_JOURNAL_DEPTH;
+}
+
+/**
+ * \brief           Read journaled operation, newest first
+ * \param[in]       journal: Journal record to decode
+ * \param[in]       back_idx: Distance from the newest operation, `0` is the most recent one
+ * \param[out]      entry: Output entry copy
+ * \return          `1` when entry is available, `0` otherwise
+ */
+uint8_t
+lwmem_journal_read(const lwmem_journal_t* journal, uint32_t back_idx, lwmem_journal_entry_t* entry) {
+    if (!lwmem_journal_valid(journal) || entry == NULL || back_idx >= journal->head
+        || back_idx >= LWMEM_CFG_OP_JOURNAL_DEPTH) {
+        return 0;
+    }
+    *entry = journal->entries[(journal->head - 1 - back_idx) & (LWMEM_CFG_OP_JOURNAL_DEPTH - 1)];
+    return 1;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_OP_JOURNAL) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_AUDIT_EN) || __DOXYGEN__
+
+/**
+ * \brief           Read free-to-reuse audit statistics
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in,out]   audit: Output structure for the audit results
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_audit_stats_ex(lwmem_t* lwobj, lwmem_audit_t* audit) {
+    if (audit != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        audit->reuse_ewma_ticks = lwobj->audit_reuse_ewma;
+        audit->exact_hits = lwobj->audit_exact_hits;
+        audit->samples = lwobj->audit_samples;
+        LWMEM_UNPROTECT(lwobj);
+    }
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_AUDIT_EN) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_AGE_EN) || __DOXYGEN__
+
+/**
+ * \brief           Report live blocks older than the given age
+ *
+ * Walks the physical layout and invokes the callback for every allocated
+ * block whose age exceeds the threshold, with its site tag when tagging is
+ * enabled - the slow-leak report for returned units
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       min_age: Minimal age in ticks for a block to be reported
+ * \param[in]       report_fn: Called once per stale block, may be `NULL` to only count
+ * \param[in]       user: User argument passed to the callback
+ * \return          Number of stale blocks
+ * \note            Only supported by list-based allocation strategies.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_report_stale_ex(lwmem_t* lwobj, uint32_t min_age, lwmem_stale_report_fn report_fn, void* user) {
+    size_t count = 0;
+
+#if !LWMEM_BUDDY_EN
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+    const uint32_t now = (uint32_t)LWMEM_GET_TICK();
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        for (lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA);;) {
+            const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+            if (block_size == 0) {
+                break;
+            }
+            if (LWMEM_BLOCK_IS_ALLOC(block) && (now - block->birth_tick) >= min_age) {
+                ++count;
+                if (report_fn != NULL) {
+                    const char* tag = NULL;
+
+#if LWMEM_TAGS_EN
+                    tag = block->tag;
+#endif /* LWMEM_TAGS_EN */
+                    report_fn(LWMEM_GET_PTR_FROM_BLOCK(block), block_size - LWMEM_BLOCK_META_SIZE,
+                              now - block->birth_tick, tag, user);
+                }
+            }
+            block = (void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN */
+    (void)lwobj;
+    (void)min_age;
+    (void)report_fn;
+    (void)user;
+#endif /* LWMEM_BUDDY_EN */
+    return count;
+}
+
+#endif /* (LWMEM_CFG_FULL && LWMEM_AGE_EN) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_OWNER_EN) || __DOXYGEN__
 
-        /*
-         * Merge blocks together by increasing current block with size of next free one
-         * and remove next free from list of free blocks
-         */
-        lwobj->mem_available_bytes -= prev->next->size; /* For now decrease effective available bytes */
-        LWMEM_UPDATE_MIN_FREE(lwobj);
-        block->size = block_size + prev->next->size; /* Increase effective size of new block */
-        prev->next = prev->next->next;               /* Set next to next's next,
-                                                            effectively remove expanded block from free list */
+/**
+ * \brief           Free every block owned by the given task in one locked sweep
+ *
+ * Intended for task deletion hooks, reclaiming everything a worker task
+ * left behind without per-pointer bookkeeping
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       task: Task handle recorded at allocation time
+ * \return          Number of reclaimed blocks
+ * \note            Only supported by list-based allocation strategies.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_free_all_owned_by_ex(lwmem_t* lwobj, void* task) {
+    size_t count = 0;
 
-        prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
-        prv_block_set_alloc(block);                        /* Set block as allocated */
-        return ptr;                                        /* Return existing pointer */
+#if !LWMEM_BUDDY_EN
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (const lwmem_region_t* region = lwobj->regions_list;
+         region != NULL && region->size > 0 && region->start_addr != NULL; ++region) {
+        uint8_t restart = 1;
+
+        if (!prv_get_region_addr_size(region, &mem_start_addr, &mem_size)) {
+            continue;
+        }
+        while (restart) { /* Physical layout changes below the walk on every free -> restart region */
+            restart = 0;
+            for (lwmem_block_t* block = (void*)(mem_start_addr + LWMEM_BT_EXTRA);;) {
+                const size_t block_size = block->size & ~LWMEM_ALLOC_BIT;
+
+                if (block_size == 0) {
+                    break;
+                }
+                if (LWMEM_BLOCK_IS_ALLOC(block) && block->owner == task) {
+                    prv_free(lwobj, LWMEM_GET_PTR_FROM_BLOCK(block));
+                    ++count;
+                    restart = 1;
+                    break;
+                }
+                block = (void*)(LWMEM_TO_BYTE_PTR(block) + block_size);
+            }
+        }
     }
+    LWMEM_UNPROTECT(lwobj);
+#else  /* !LWMEM_BUDDY_EN */
+    (void)lwobj;
+    (void)task;
+#endif /* LWMEM_BUDDY_EN */
+    return count;
+}
 
-    /*
-     * Check if "block" and last free before "prev" create contiguous memory with size of at least new requested size.
-     *
-     * It is necessary to make a memory move and shift content up as new return pointer is now upper on address space
-     */
-    if ((LWMEM_TO_BYTE_PTR(prev) + prev->size) == LWMEM_TO_BYTE_PTR(block) && (prev->size + block_size) >= final_size) {
-        /* Move memory from block to block previous to current */
-        void* const old_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(block);
-        void* const new_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(prev);
+#endif /* (LWMEM_CFG_FULL && LWMEM_OWNER_EN) || __DOXYGEN__ */
 
-        /*
-         * If memmove overwrites metadata of current block (when shifting content up),
-         * it is not an issue as we know its size (block_size) and next is already NULL.
-         *
-         * Memmove must be used to guarantee move of data as addresses + their sizes may overlap
-         *
-         * Metadata of "prev" are not modified during memmove
-         */
-        LWMEM_MEMMOVE(new_data_ptr, old_data_ptr, block_size);
+#if (LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE) || __DOXYGEN__
 
-        lwobj->mem_available_bytes -= prev->size; /* For now decrease effective available bytes */
-        LWMEM_UPDATE_MIN_FREE(lwobj);
-        prev->size += block_size;    /* Increase size of input block size */
-        prevprev->next = prev->next; /* Remove prev from free list as it is now being used
-                                                for allocation together with existing block */
-        block = prev;                /* Move block pointer to previous one */
+/**
+ * \brief           Allocate discardable memory with an eviction callback
+ *
+ * Block may be reclaimed by the allocator whenever a regular allocation
+ * would otherwise fail, in least-recently-touched order. Owner is notified
+ * through the callback right before the block is freed
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       size: Number of bytes to allocate
+ * \param[in]       evict_cb: Owner notification fired on eviction
+ * \param[in]       user: User argument passed to the callback
+ * \return          Pointer to allocated memory, `NULL` when heap and registry are exhausted
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_evictable_ex(lwmem_t* lwobj, size_t size, lwmem_evict_fn evict_cb, void* user) {
+    void* ptr = NULL;
+    size_t idx;
 
-        prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
-        prv_block_set_alloc(block);                        /* Set block as allocated */
-        return new_data_ptr;                               /* Return new data ptr */
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (idx = 0; idx < LWMEM_CFG_EVICTABLE_MAX && lwobj->evictable[idx].ptr != NULL; ++idx) {}
+    if (idx < LWMEM_CFG_EVICTABLE_MAX) {
+        ptr = prv_alloc(lwobj, NULL, size);
+        if (ptr != NULL) {
+            lwobj->evictable[idx].ptr = ptr;
+            lwobj->evictable[idx].evict_cb = evict_cb;
+            lwobj->evictable[idx].user = user;
+            lwobj->evictable[idx].tick = ++lwobj->evict_tick;
+        }
     }
+    LWMEM_UNPROTECT(lwobj);
+    return ptr;
+}
 
-    /*
-     * At this point, it was not possible to expand existing block with free before or free after due to:
-     * - Input block & next free block do not create contiguous block or its new size is too small
-     * - Previous free block & input block do not create contiguous block or its new size is too small
-     *
-     * Last option is to check if previous free block "prev", input block "block" and next free block "prev->next" create contiguous block
-     * and size of new block (from 3 contiguous blocks) together is big enough
-     */
-    if ((LWMEM_TO_BYTE_PTR(prev) + prev->size) == LWMEM_TO_BYTE_PTR(block)
-        && (LWMEM_TO_BYTE_PTR(block) + block_size) == LWMEM_TO_BYTE_PTR(prev->next)
-        && (prev->size + block_size + prev->next->size) >= final_size) {
+/**
+ * \brief           Mark discardable block as recently used, protecting it from near-term eviction
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Block previously allocated with \ref lwmem_malloc_evictable_ex
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_evictable_touch_ex(lwmem_t* lwobj, void* ptr) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    for (size_t idx = 0; idx < LWMEM_CFG_EVICTABLE_MAX; ++idx) {
+        if (lwobj->evictable[idx].ptr == ptr) {
+            lwobj->evictable[idx].tick = ++lwobj->evict_tick;
+            break;
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+}
 
-        /* Move memory from block to block previous to current */
-        void* const old_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(block);
-        void* const new_data_ptr = LWMEM_GET_PTR_FROM_BLOCK(prev);
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_EVICTABLE) || __DOXYGEN__ */
 
-        /*
-         * If memmove overwrites metadata of current block (when shifting content up),
-         * it is not an issue as we know its size (block_size) and next is already NULL.
-         *
-         * Memmove must be used to guarantee move of data as addresses and their sizes may overlap
-         *
-         * Metadata of "prev" are not modified during memmove
-         */
-        LWMEM_MEMMOVE(new_data_ptr, old_data_ptr, block_size);
+#if LWMEM_CFG_FULL || __DOXYGEN__
 
-        /* Decrease effective available bytes for free blocks before and after input block */
-        lwobj->mem_available_bytes -= prev->size + prev->next->size;
-        LWMEM_UPDATE_MIN_FREE(lwobj);
-        prev->size += block_size + prev->next->size; /* Increase size of new block by size of 2 free blocks */
+/**
+ * \brief           Begin allocation transaction on an instance
+ *
+ * Allocations made with \ref lwmem_txn_malloc belong to the transaction
+ * until \ref lwmem_txn_commit detaches them, or \ref lwmem_txn_abort frees
+ * them all in one bulk pass - replacing per-allocation unwind code in
+ * mid-construction failure paths
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       txn: Transaction object to initialize
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_txn_begin_ex(lwmem_t* lwobj, lwmem_txn_t* txn) {
+    if (txn == NULL) {
+        return 0;
+    }
+    txn->lwobj = lwobj;
+    txn->count = 0;
+    return 1;
+}
 
-        /* Remove free block before current one and block after current one from linked list (remove 2) */
-        prevprev->next = prev->next->next;
-        block = prev; /* Previous block is now current */
+/**
+ * \brief           Allocate memory belonging to the transaction
+ * \param[in]       txn: Transaction previously started with \ref lwmem_txn_begin_ex
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory, `NULL` when heap or
+ *                      transaction capacity is exhausted
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_txn_malloc(lwmem_txn_t* txn, size_t size) {
+    void* ptr = NULL;
 
-        prv_split_too_big_block(lwobj, block, final_size); /* Split block if it is too big */
-        prv_block_set_alloc(block);                        /* Set block as allocated */
-        return new_data_ptr;                               /* Return new data ptr */
+    if (txn != NULL && txn->count < LWMEM_CFG_TXN_MAX_ALLOCS) {
+        ptr = lwmem_malloc_ex(txn->lwobj, NULL, size);
+        if (ptr != NULL) {
+            txn->ptrs[txn->count++] = ptr;
+        }
     }
+    return ptr;
+}
 
-    /*
-     * If application reaches this point, it means:
-     * - New requested size is greater than input block size
-     * - Input block & next free block do not create contiguous block or its new size is too small
-     * - Last free block & input block do not create contiguous block or its new size is too small
-     * - Last free block & input block & next free block do not create contiguous block or its size is too small
-     *
-     * Final solution is to find completely new empty block of sufficient size and copy content from old one to new one
-     */
-    retval = prv_alloc(lwobj, region, size); /* Try to allocate new block */
-    if (retval != NULL) {
-        /* Get application size from input pointer, then copy content to new block */
-        block_size = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
-        LWMEM_MEMCPY(retval, ptr, size > block_size ? block_size : size);
-        prv_free(lwobj, ptr); /* Free old block */
+/**
+ * \brief           Commit transaction, detaching its allocations
+ *
+ * Allocations stay alive and are from now on owned (and individually
+ * freed) by the application
+ *
+ * \param[in]       txn: Transaction to commit
+ */
+void
+lwmem_txn_commit(lwmem_txn_t* txn) {
+    if (txn != NULL) {
+        txn->count = 0;
     }
-    return retval;
 }
 
 /**
- * \brief           Assign the memory structure for advanced memory allocation system
- * 
- * \param           lwobj 
- * \param           regions 
- * \return          size_t 
+ * \brief           Abort transaction, bulk-freeing all its allocations
+ *
+ * All allocations are returned in a single lock hold with one
+ * coalescing pass, see \ref lwmem_free_many_ex
+ *
+ * \param[in]       txn: Transaction to abort
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-static size_t
-prv_assignmem(lwmem_t* lwobj, const lwmem_region_t* regions) {
-    uint8_t* mem_start_addr = NULL;
-    size_t mem_size = 0;
-    lwmem_block_t *first_block = NULL, *prev_end_block = NULL;
+void
+lwmem_txn_abort(lwmem_txn_t* txn) {
+    if (txn != NULL && txn->count > 0) {
+        lwmem_free_many_ex(txn->lwobj, txn->ptrs, txn->count);
+        txn->count = 0;
+    }
+}
 
-    for (size_t idx = 0; regions->size > 0 && regions->start_addr != NULL; ++idx, ++regions) {
-        /* Get region start address and size, stop on failure */
-        if (!prv_get_region_addr_size(regions, &mem_start_addr, &mem_size)) {
-            continue;
-        }
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
-        /*
-         * If end_block == NULL, this indicates first iteration.
-         * In first indication application shall set start_block and never again
-         * end_block value holds
-         */
-        if (lwobj->end_block == NULL) {
-            /*
-             * Next entry of start block is first region
-             * It points to beginning of region data
-             * In the later step(s) first block is manually set on top of memory region
-             */
-            lwobj->start_block.next = (void*)mem_start_addr;
-            lwobj->start_block.size = 0; /* Size of dummy start block is zero */
+#if (LWMEM_CFG_FULL && LWMEM_CFG_QUOTA_GROUPS) || __DOXYGEN__
+
+/**
+ * \brief           Allocate memory charged against a quota group
+ *
+ * Group budget is checked and charged (with the actual block capacity)
+ * within the same lock hold as the allocation itself, so concurrent tenants
+ * cannot overshoot their budget
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       group: Quota group to charge, with `limit` configured by the application
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory, `NULL` when heap or group budget is exhausted
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_malloc_quota_ex(lwmem_t* lwobj, lwmem_quota_t* group, size_t size) {
+    void* ptr = NULL;
+
+    if (group == NULL) {
+        return NULL;
+    }
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    if ((group->used + size) >= group->used && (group->used + size) <= group->limit) {
+        ptr = prv_alloc(lwobj, NULL, LWMEM_RZ_INFLATE(size));
+        if (ptr != NULL) {
+            group->used += prv_ptr_user_size(lwobj, ptr); /* Charge real capacity, including slack */
         }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    return LWMEM_RZ_FINISH(ptr);
+}
 
-        /* Save current end block status as it is used later for linked list insertion */
-        prev_end_block = lwobj->end_block;
+/**
+ * \brief           Free memory and return its charge to the quota group
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       group: Quota group the allocation was charged to
+ * \param[in]       ptr: Memory previously allocated with \ref lwmem_malloc_quota_ex.
+ *                      `NULL` pointer is valid input
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_free_quota_ex(lwmem_t* lwobj, lwmem_quota_t* group, void* ptr) {
+    if (ptr != NULL && group != NULL) {
+        size_t charged;
 
-        /* Put end block to the end of the region with size = 0 */
-        lwobj->end_block = (void*)(mem_start_addr + mem_size - LWMEM_BLOCK_META_SIZE);
-        lwobj->end_block->next = NULL; /* End block in region does not have next entry */
-        lwobj->end_block->size = 0;    /* Size of end block is zero */
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        charged = prv_ptr_user_size(lwobj, LWMEM_RZ_RAW(ptr));
+        group->used -= charged < group->used ? charged : group->used;
+        prv_free(lwobj, LWMEM_RZ_RAW(ptr));
+        LWMEM_UNPROTECT(lwobj);
+    }
+}
 
-        /*
-         * Create memory region first block.
-         *
-         * First block meta size includes size of metadata too
-         * Subtract MEM_BLOCK_META_SIZE as there is one more block (end_block) at the end of region
-         *
-         * Actual maximal available size for application in the region is mem_size - 2 * MEM_BLOCK_META_SIZE
-         */
-        first_block = (void*)mem_start_addr;
-        first_block->next = lwobj->end_block; /* Next block of first is last block */
-        first_block->size = mem_size - LWMEM_BLOCK_META_SIZE;
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_QUOTA_GROUPS) || __DOXYGEN__ */
 
-        /* Check if previous regions exist by checking previous end block state */
-        if (prev_end_block != NULL) {
-            prev_end_block->next = first_block; /* End block of previous region now points to start of current region */
-        }
+#if (LWMEM_CFG_FULL && LWMEM_CFG_REF_BUFFERS) || __DOXYGEN__
+
+/**
+ * \brief           Size of the reference counter slot in front of user data
+ */
+#define LWMEM_REF_HDR_SIZE LWMEM_ALIGN(sizeof(size_t))
+
+/**
+ * \brief           Allocate reference-counted buffer with initial count of `1`
+ *
+ * Counter is stored in front of user data within the very same block,
+ * so no extra header allocation exists. Buffer is released to the heap
+ * when the count reaches zero in \ref lwmem_ref_release_ex
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       region: Optional region instance within LwMEM instance to force allocation from
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_ref_alloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, size_t size) {
+    uint8_t* raw;
 
-        lwobj->mem_available_bytes += first_block->size; /* Increase number of available bytes */
-        ++lwobj->mem_regions_count;                      /* Increase number of used regions */
+    if (size == 0 || size >= ((size_t)-1 - LWMEM_REF_HDR_SIZE)) {
+        return NULL;
     }
+    raw = lwmem_malloc_ex(lwobj, region, size + LWMEM_REF_HDR_SIZE);
+    if (raw == NULL) {
+        return NULL;
+    }
+    *(size_t*)(void*)raw = 1; /* Creator holds the first reference */
+    return raw + LWMEM_REF_HDR_SIZE;
+}
 
-#if defined(LWMEM_DEV)
-    /* Copy default state of start block */
-    LWMEM_MEMCPY(&lwmem_default.start_block_first_use, &lwmem_default.start_block, sizeof(lwmem_default.start_block));
-#endif /* defined(LWMEM_DEV) */
-#if LWMEM_CFG_ENABLE_STATS
-    lwobj->stats.mem_size_bytes = lwobj->mem_available_bytes;
-    lwobj->stats.minimum_ever_mem_available_bytes = lwobj->mem_available_bytes;
-#endif
+/**
+ * \brief           Take an additional reference on the buffer
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Buffer previously allocated with \ref lwmem_ref_alloc_ex
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_ref_acquire_ex(lwmem_t* lwobj, void* ptr) {
+    if (ptr != NULL) {
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        ++(*(size_t*)(void*)(LWMEM_TO_BYTE_PTR(ptr) - LWMEM_REF_HDR_SIZE));
+        LWMEM_UNPROTECT(lwobj);
+    }
+}
 
-    return lwobj->mem_regions_count; /* Return number of regions used by manager */
+/**
+ * \brief           Drop a reference, freeing the buffer when the last one is gone
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Buffer previously allocated with \ref lwmem_ref_alloc_ex.
+ *                      `NULL` pointer is valid input
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_ref_release_ex(lwmem_t* lwobj, void* ptr) {
+    if (ptr != NULL) {
+        uint8_t* raw = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_REF_HDR_SIZE;
+        uint8_t last = 0;
+
+        lwobj = LWMEM_GET_LWOBJ(lwobj);
+        LWMEM_PROTECT(lwobj);
+        last = --(*(size_t*)(void*)raw) == 0;
+        LWMEM_UNPROTECT(lwobj);
+        if (last) {
+            lwmem_free_ex(lwobj == &lwmem_default ? NULL : lwobj, raw);
+        }
+    }
 }
 
-#else /* LWMEM_CFG_FULL */
+/**
+ * \brief           Clone reference-counted buffer without copying (copy-on-write share)
+ *
+ * Underlying block is shared; actual copy is deferred to
+ * \ref lwmem_cow_make_unique_ex, which performs it only when a writer
+ * still shares the buffer - eliminating the memcpy for read-only consumers
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Buffer previously allocated with \ref lwmem_ref_alloc_ex
+ * \return          Shared buffer pointer (same as input)
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void*
+lwmem_cow_clone_ex(lwmem_t* lwobj, void* ptr) {
+    lwmem_ref_acquire_ex(lwobj, ptr);
+    return ptr;
+}
 
 /**
- * \brief           Assign the regions for simple algorithm
- * 
- *                  At this point, regions check has been performed, so we assume
- *                  everything is ready to proceed
- * 
- * \param           lwobj: LwMEM object
- * \param           regions: List of regions to assign
- * \return          Number of regions used
+ * \brief           Obtain exclusively owned copy of a (possibly shared) buffer before writing
+ *
+ * When the caller holds the only reference, the buffer is returned as-is and
+ * no copy happens. Otherwise a private copy is allocated, content duplicated
+ * and the shared reference dropped
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ptr: Buffer previously obtained from \ref lwmem_ref_alloc_ex
+ *                      or \ref lwmem_cow_clone_ex
+ * \return          Writable buffer owned exclusively by the caller,
+ *                      `NULL` when a required copy could not be allocated
+ *                      (input reference is then left untouched)
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-static size_t
-prv_assignmem_simple(lwmem_t* const lwobj, const lwmem_region_t* regions) {
-    uint8_t* mem_start_addr = regions[0].start_addr;
-    size_t mem_size = regions[0].size;
+void*
+lwmem_cow_make_unique_ex(lwmem_t* lwobj, void* ptr) {
+    uint8_t* raw;
+    size_t user_size;
+    uint8_t shared;
+    void* copy;
 
-    /* Adjust alignment data */
-    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) {
-        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
-        mem_size -= (size_t)(mem_start_addr - LWMEM_TO_BYTE_PTR(regions[0].start_addr));
+    if (ptr == NULL) {
+        return NULL;
+    }
+    raw = LWMEM_TO_BYTE_PTR(ptr) - LWMEM_REF_HDR_SIZE;
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    shared = *(size_t*)(void*)raw > 1;
+    user_size = prv_ptr_user_size(lwobj, raw) - LWMEM_REF_HDR_SIZE;
+    LWMEM_UNPROTECT(lwobj);
+    if (!shared) {
+        return ptr; /* Sole owner, write in place */
     }
 
-    /* Align mem to alignment*/
-    mem_size = mem_size & ~LWMEM_ALIGN_BITS;
-
-    /* Store the available information */
-    lwobj->mem_available_bytes = mem_size;
-    lwobj->mem_next_available_ptr = mem_start_addr;
-    lwobj->is_initialized = 1;
-    return 1; /* One region is being used only for now */
+    copy = lwmem_ref_alloc_ex(lwobj == &lwmem_default ? NULL : lwobj, NULL, user_size);
+    if (copy != NULL) {
+        LWMEM_MEMCPY(copy, ptr, user_size);
+        lwmem_ref_release_ex(lwobj == &lwmem_default ? NULL : lwobj, ptr);
+    }
+    return copy;
 }
 
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_REF_BUFFERS) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_ISR_FREE_EN) || __DOXYGEN__
+
 /**
- * \brief           Simple allocation algorithm, that can only allocate memory,
- *                  but it does not support free.
- * 
- *                  It uses simple first-in-first-serve concept,
- *                  where memory grows upward gradually, up until it reaches the end
- *                  of memory area
- * 
- * \param           lwobj: LwMEM object
- * \param           region: Selected region. Not used in the current revision,
- *                      but footprint remains the same if one day library will support it
- * \param           size: Requested allocation size
- * \return          `NULL` on failure, or pointer to allocated memory
+ * \brief           Free previously allocated memory from interrupt context
+ *
+ * Pointer is pushed onto a lock-free queue with a single compare-and-swap
+ * loop and without taking the system mutex, making the call safe from
+ * interrupt service routines. Memory is returned to the free list on the
+ * next task-context allocation or with \ref lwmem_free_from_isr_drain_ex
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
+ *                      Instance must be the same as used during allocation procedure
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
  */
-static void*
-prv_alloc_simple(lwmem_t* const lwobj, const lwmem_region_t* region, const size_t size) {
-    void* retval = NULL;
-    const size_t alloc_size = LWMEM_ALIGN(size);
+void
+lwmem_free_from_isr_ex(lwmem_t* lwobj, void* const ptr) {
+    lwmem_block_t* block = LWMEM_GET_BLOCK_FROM_PTR(LWMEM_RZ_RAW(ptr));
 
-    if (alloc_size <= lwobj->mem_available_bytes) {
-        retval = lwobj->mem_next_available_ptr;
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    if (LWMEM_BLOCK_IS_ALLOC(block)) {
+        void* old_head = atomic_load(&(lwobj->isr_free_head));
 
-        /* Get ready for next iteration */
-        lwobj->mem_next_available_ptr += alloc_size;
-        lwobj->mem_available_bytes -= alloc_size;
+        /* Allocation mark in next is replaced by queue link, drain restores it */
+        do {
+            block->next = old_head;
+        } while (!atomic_compare_exchange_weak(&(lwobj->isr_free_head), &old_head, (void*)block));
     }
-    (void)region;
-    return retval;
 }
 
-#endif /* LWMEM_CFG_FULL */
+/**
+ * \brief           Free previously allocated memory from interrupt context in default LwMEM instance
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
+ */
+void
+lwmem_free_from_isr(void* const ptr) {
+    lwmem_free_from_isr_ex(NULL, ptr);
+}
 
 /**
- * \brief           Initializes and assigns user regions for memory used by allocator algorithm
+ * \brief           Drain queue of interrupt-freed blocks back to the free list
+ *
+ * Must be called from task (thread) context, typically from idle time
+ *
  * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       regions: Pointer to array of regions with address and respective size.
- *                      Regions must be in increasing order (start address) and must not overlap in-between.
- *                      Last region entry must have address `NULL` and size set to `0`
- * \code{.c}
-//Example definition
-lwmem_region_t regions[] = {
-    { (void *)0x10000000, 0x1000 }, //Region starts at address 0x10000000 and is 0x1000 bytes long
-    { (void *)0x20000000, 0x2000 }, //Region starts at address 0x20000000 and is 0x2000 bytes long
-    { (void *)0x30000000, 0x3000 }, //Region starts at address 0x30000000 and is 0x3000 bytes long
-    { NULL, 0 }                     //Array termination indicator
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_free_from_isr_drain_ex(lwmem_t* lwobj) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    prv_isr_free_drain(lwobj);
+    LWMEM_UNPROTECT(lwobj);
 }
-\endcode
- * \return          `0` on failure, number of final regions used for memory manager on success
- * \note            This function is not thread safe when used with operating system.
- *                      It must be called only once to setup memory regions
+
+/**
+ * \brief           Drain queue of interrupt-freed blocks in default LwMEM instance
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-size_t
-lwmem_assignmem_ex(lwmem_t* lwobj, const lwmem_region_t* regions) {
-    uint8_t* mem_start_addr = NULL;
-    size_t mem_size = 0, len = 0;
+void
+lwmem_free_from_isr_drain(void) {
+    lwmem_free_from_isr_drain_ex(NULL);
+}
 
-    lwobj = LWMEM_GET_LWOBJ(lwobj);
+#endif /* (LWMEM_CFG_FULL && LWMEM_ISR_FREE_EN) || __DOXYGEN__ */
 
-    /* Check first things first */
-    if (regions == NULL
-#if LWMEM_CFG_FULL
-        || lwobj->end_block != NULL /* Init function may only be called once per lwmem instance */
-#else
-        || lwobj->is_initialized /* Already initialized? */
-#endif /* LWMEM_CFG_FULL */
-    ) {
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Pre-split hot allocation sizes into the fast caches during idle time
+ *
+ * Feed the profile measured with \ref lwmem_get_histogram_ex: for every hot
+ * size, blocks are carved from the heap and parked in the thread/per-CPU
+ * magazines, so steady-state allocations hit exact-fit cached blocks first
+ * try instead of repeatedly splitting large blocks on the hot path.
+ *
+ * Populating the magazines (rather than pre-splitting the free list) is
+ * deliberate: immediately coalescing frees would merge adjacent pre-split
+ * free blocks right back together
+ *
+ * \param[in]       lwobj: LwMEM instance. Only the default instance (`NULL`)
+ *                      benefits from cache parking; other instances are warmed
+ *                      for locality only
+ * \param[in]       sizes: Array of hot allocation sizes
+ * \param[in]       counts: Number of blocks to prepare per size
+ * \param[in]       n: Number of entries in both arrays
+ * \return          Number of blocks successfully prepared
+ * \note            Effective together with \ref LWMEM_CFG_THREAD_CACHE or
+ *                      \ref LWMEM_CFG_CPU_CACHE.
+ *                      This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_prewarm_ex(lwmem_t* lwobj, const size_t* sizes, const uint32_t* counts, size_t n) {
+    size_t prepared = 0;
+    void* batch[32];
+
+    if (sizes == NULL || counts == NULL) {
         return 0;
     }
-
-    /* Check values entered by application */
-    mem_start_addr = (void*)0;
-    mem_size = 0;
-    for (size_t idx = 0;; ++idx) {
-        /*
-         * Check for valid entry or end of array descriptor
-         * Invalid entry is considered as "end-of-region" indicator
-         */
-        if (regions[idx].size == 0 && regions[idx].start_addr == NULL) {
-            len = idx;
-            if (len == 0) {
-                return 0;
+    for (size_t idx = 0; idx < n; ++idx) {
+        uint32_t todo = counts[idx];
+
+        while (todo > 0) {
+            const uint32_t chunk = todo > (uint32_t)LWMEM_ARRAYSIZE(batch) ? (uint32_t)LWMEM_ARRAYSIZE(batch) : todo;
+            uint32_t got = 0;
+
+            for (; got < chunk; ++got) {
+                batch[got] = lwmem_malloc_ex(lwobj, NULL, sizes[idx]);
+                if (batch[got] == NULL) {
+                    break;
+                }
             }
-            break;
+            for (uint32_t i = 0; i < got; ++i) { /* Frees land in the fast caches first */
+                lwmem_free_ex(lwobj, batch[i]);
+            }
+            prepared += got;
+            if (got < chunk) {
+                break; /* Heap exhausted for this size */
+            }
+            todo -= chunk;
         }
+    }
+    return prepared;
+}
 
-#if !LWMEM_CFG_FULL
-        /*
-         * In case of simple allocation algorithm, we (for now!) only allow one region.
-         * Return zero value if user passed more than one region in a sequence.
-         */
-        else if (idx > 0) {
-            return 0;
-        }
-#endif /* LWMEM_CFG_FULL */
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
-        /* New region(s) must be higher (in address space) than previous one */
-        if ((mem_start_addr + mem_size) > LWMEM_TO_BYTE_PTR(regions[idx].start_addr)) {
-            return 0;
-        }
+#if (LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE) || __DOXYGEN__
 
-        /* Save new values for next round */
-        mem_start_addr = regions[idx].start_addr;
-        mem_size = regions[idx].size;
-    }
+/**
+ * \brief           Return all per-CPU cached blocks back to the heap
+ *
+ * Typically called from a periodic spill point or before heap-wide
+ * operations that must see every block
+ *
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_cpu_cache_flush(void) {
+    lwmem_t* lwobj = LWMEM_GET_LWOBJ(NULL);
 
-    /* Final init and check before initializing the regions */
-    if (len == 0
-#if LWMEM_CFG_OS
-        || lwmem_sys_mutex_isvalid(&(lwobj->mutex)) /* Check if mutex valid already = must not be */
-        || !lwmem_sys_mutex_create(&(lwobj->mutex)) /* Final step = try to create mutex for new instance */
-#endif                                              /* LWMEM_CFG_OS */
-    ) {
-        return 0;
-    }
+    LWMEM_PROTECT(lwobj);
+    LWMEM_CPU_LOCK();
+    for (size_t cpu = 0; cpu < LWMEM_CFG_CPU_COUNT; ++cpu) {
+        for (size_t idx = 0; idx < LWMEM_CPU_CACHE_CLASSES; ++idx) {
+            void* ptr = cpu_caches[cpu].heads[idx];
 
-#if LWMEM_CFG_FULL
-    return prv_assignmem(lwobj, regions);
-#else  /* LWMEM_CFG_FULL */
-    return prv_assignmem_simple(lwobj, regions);
-#endif /* LWMEM_CFG_FULL */
+            while (ptr != NULL) {
+                void* next_ptr = *(void**)ptr;
+
+                prv_free(lwobj, ptr);
+                ptr = next_ptr;
+            }
+            cpu_caches[cpu].heads[idx] = NULL;
+            cpu_caches[cpu].counts[idx] = 0;
+        }
+    }
+    LWMEM_CPU_UNLOCK();
+    LWMEM_UNPROTECT(lwobj);
 }
 
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_CPU_CACHE) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_TCACHE_EN) || __DOXYGEN__
+
 /**
- * \brief           Allocate memory of requested size in specific lwmem instance and optional region.
- * \note            This is an extended malloc version function declaration to support advanced features
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
- *                      Set to `NULL` to use any region within LwMEM instance
- * \param[in]       size: Number of bytes to allocate
- * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \brief           Return all blocks cached by calling thread back to the heap
+ *
+ * Must be called from the thread owning the cache, typically
+ * before thread (task) is deleted, to avoid leaking cached blocks
+ *
  * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-void*
-lwmem_malloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t size) {
-    void* ptr = NULL;
-
-    lwobj = LWMEM_GET_LWOBJ(lwobj);
+void
+lwmem_thread_cache_flush(void) {
+    lwmem_t* lwobj = LWMEM_GET_LWOBJ(NULL);
 
     LWMEM_PROTECT(lwobj);
-#if LWMEM_CFG_FULL
-    ptr = prv_alloc(lwobj, region, size);
-#else  /* LWMEM_CFG_FULL */
-    ptr = prv_alloc_simple(lwobj, region, size);
-#endif /* LWMEM_CFG_FULL */
+    for (size_t idx = 0; idx < LWMEM_TCACHE_CLASSES; ++idx) {
+        void* ptr = thread_cache.heads[idx];
+
+        while (ptr != NULL) {
+            void* next_ptr = *(void**)ptr;
+
+            prv_free(lwobj, ptr);
+            ptr = next_ptr;
+        }
+        thread_cache.heads[idx] = NULL;
+        thread_cache.counts[idx] = 0;
+    }
     LWMEM_UNPROTECT(lwobj);
-    return ptr;
 }
 
+#endif /* (LWMEM_CFG_FULL && LWMEM_TCACHE_EN) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_CLEAN_MEMORY_DEFERRED) || __DOXYGEN__
+
 /**
- * \brief           Allocate contiguous block of memory for requested number of items and its size
- *                  in specific lwmem instance and region.
+ * \brief           Scrub (zero) dirty freed blocks with a byte budget
  *
- * It resets allocated block of memory to zero if allocation is successful
+ * Intended to be called from idle time. Fully scrubbed blocks
+ * are returned to the free list
  *
- * \note            This is an extended calloc version function declaration to support advanced features
  * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       region: Optional region instance within LwMEM instance to force allocation from.
- *                      Set to `NULL` to use any region within LwMEM instance
- * \param[in]       nitems: Number of elements to be allocated
- * \param[in]       size: Size of each element, in units of bytes
- * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \param[in]       max_bytes: Maximal number of bytes to zero in this step, `0` for no limit
+ * \return          Number of bytes still waiting to be scrubbed
  * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-void*
-lwmem_calloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, const size_t nitems, const size_t size) {
-    void* ptr = NULL;
-    const size_t alloc_size = size * nitems;
+size_t
+lwmem_scrub_step_ex(lwmem_t* lwobj, size_t max_bytes) {
+    size_t remaining;
 
     lwobj = LWMEM_GET_LWOBJ(lwobj);
-
     LWMEM_PROTECT(lwobj);
-#if LWMEM_CFG_FULL
-    ptr = prv_alloc(lwobj, region, alloc_size);
-#else  /* LWMEM_CFG_FULL */
-    ptr = prv_alloc_simple(lwobj, region, alloc_size);
-#endif /* LWMEM_CFG_FULL */
+    remaining = prv_scrub_step(lwobj, max_bytes);
     LWMEM_UNPROTECT(lwobj);
+    return remaining;
+}
 
-    if (ptr != NULL) {
-        LWMEM_MEMSET(ptr, 0x00, alloc_size);
-    }
-    return ptr;
+/**
+ * \brief           Scrub (zero) dirty freed blocks of default LwMEM instance
+ * \param[in]       max_bytes: Maximal number of bytes to zero in this step, `0` for no limit
+ * \return          Number of bytes still waiting to be scrubbed
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_scrub_step(size_t max_bytes) {
+    return lwmem_scrub_step_ex(NULL, max_bytes);
 }
 
-#if LWMEM_CFG_FULL || __DOXYGEN__
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_CLEAN_MEMORY_DEFERRED) || __DOXYGEN__ */
+
+#if (LWMEM_CFG_FULL && LWMEM_CFG_DEFERRED_COALESCING) || __DOXYGEN__
 
 /**
- * \brief           Reallocates already allocated memory with new size in specific lwmem instance and region.
- *
- * \note            This function may only be used with allocations returned by any of `_from` API functions
- *
- * Function behaves differently, depends on input parameter of `ptr` and `size`:
+ * \brief           Coalesce all deferred free blocks back to the list of free blocks
  *
- *  - `ptr == NULL; size == 0`: Function returns `NULL`, no memory is allocated or freed
- *  - `ptr == NULL; size > 0`: Function tries to allocate new block of memory with `size` length, equivalent to `malloc(region, size)`
- *  - `ptr != NULL; size == 0`: Function frees memory, equivalent to `free(ptr)`
- *  - `ptr != NULL; size > 0`: Function tries to allocate new memory of copy content before returning pointer on success
+ * Intended to be called from idle time, so allocations do not pay
+ * the merge price after burst frees
  *
  * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       region: Pointer to region to allocate from.
- *                      Set to `NULL` to use any region within LwMEM instance.
- *                      Instance must be the same as used during allocation procedure
- * \param[in]       ptr: Memory block previously allocated with one of allocation functions.
- *                      It may be set to `NULL` to create new clean allocation
- * \param[in]       size: Size of new memory to reallocate
- * \return          Pointer to allocated memory on success, `NULL` otherwise
  * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-void*
-lwmem_realloc_ex(lwmem_t* lwobj, const lwmem_region_t* region, void* const ptr, const size_t size) {
-    void* p;
+void
+lwmem_coalesce_ex(lwmem_t* lwobj) {
     lwobj = LWMEM_GET_LWOBJ(lwobj);
     LWMEM_PROTECT(lwobj);
-    p = prv_realloc(lwobj, region, ptr, size);
+    prv_coalesce_deferred(lwobj);
     LWMEM_UNPROTECT(lwobj);
-    return p;
 }
 
 /**
- * \brief           Safe version of realloc_ex function.
- *
- * After memory is reallocated, input pointer automatically points to new memory
- * to prevent use of dangling pointers. When reallocation is not successful,
- * original pointer is not modified and application still has control of it.
- *
- * It is advised to use this function when reallocating memory.
- *
- * Function behaves differently, depends on input parameter of `ptr` and `size`:
- *
- *  - `ptr == NULL`: Invalid input, function returns `0`
- *  - `*ptr == NULL; size == 0`: Function returns `0`, no memory is allocated or freed
- *  - `*ptr == NULL; size > 0`: Function tries to allocate new block of memory with `size` length, equivalent to `malloc(size)`
- *  - `*ptr != NULL; size == 0`: Function frees memory, equivalent to `free(ptr)`, sets input pointer pointing to `NULL`
- *  - `*ptr != NULL; size > 0`: Function tries to reallocate existing pointer with new size and copy content to new block
- *
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
- * \param[in]       region: Pointer to region to allocate from.
- *                      Set to `NULL` to use any region within LwMEM instance.
- *                      Instance must be the same as used during allocation procedure
- * \param[in]       ptr: Pointer to pointer to allocated memory. Must not be set to `NULL`.
- *                      If reallocation is successful, it modifies pointer's pointing address,
- *                      or sets it to `NULL` in case of `free` operation
- * \param[in]       size: New requested size in bytes
- * \return          `1` if successfully reallocated, `0` otherwise
+ * \brief           Coalesce all deferred free blocks in default LwMEM instance
  * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-int
-lwmem_realloc_s_ex(lwmem_t* lwobj, const lwmem_region_t* region, void** const ptr, const size_t size) {
-    void* new_ptr;
+void
+lwmem_coalesce(void) {
+    lwmem_coalesce_ex(NULL);
+}
 
-    /*
-     * Input pointer must not be NULL otherwise,
-     * in case of successful allocation, we have memory leakage
-     * aka. allocated memory where noone is pointing to it
-     */
-    if (ptr == NULL) {
-        return 0;
-    }
+#endif /* (LWMEM_CFG_FULL && LWMEM_CFG_DEFERRED_COALESCING) || __DOXYGEN__ */
 
-    new_ptr = lwmem_realloc_ex(lwobj, region, *ptr, size); /* Try to reallocate existing pointer */
-    if (new_ptr != NULL) {
-        *ptr = new_ptr;
-    } else if (size == 0) { /* size == 0 means free input memory */
-        *ptr = NULL;
-        return 1;
-    }
-    return new_ptr != NULL;
-}
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+
+#if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
 
 /**
- * \brief           Free previously allocated memory using one of allocation functions
- *                  in specific lwmem instance.
+ * \brief           Get statistics of a LwMEM instance
  * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
  *                      Instance must be the same as used during allocation procedure
- * \note            This is an extended free version function declaration to support advanced features
- * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
- * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ * \param[in,out]   stats: Pointer to \ref lwmem_stats_t to store result
  */
-void
-lwmem_free_ex(lwmem_t* lwobj, void* const ptr) {
-    lwobj = LWMEM_GET_LWOBJ(lwobj);
-    LWMEM_PROTECT(lwobj);
-    prv_free(lwobj, ptr);
-    LWMEM_UNPROTECT(lwobj);
-}
+#if LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
 
 /**
- * \brief           Safe version of free function
- *
- * After memory is freed, input pointer is safely set to `NULL`
- * to prevent use of dangling pointers.
+ * \brief           Fill fragmentation metrics by walking the list of free blocks
  *
- * It is advised to use this function when freeing memory.
+ * Must be called with instance protected (mutex taken)
  *
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
- *                      Instance must be the same as used during allocation procedure
- * \param[in]       ptr: Pointer to pointer to allocated memory.
- *                  When set to non `NULL`, pointer is freed and set to `NULL`
- * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ * \param[in]       lwobj: LwMEM instance
+ * \param[in,out]   stats: Statistics structure to fill metrics into
  */
+static void
+prv_fill_frag_stats(const lwmem_t* lwobj, lwmem_stats_t* stats) {
+    uint32_t count = 0, largest = 0;
+    size_t total = 0;
+
+    for (const lwmem_block_t* block = lwobj->start_block.next; block != NULL; block = block->next) {
+        if (block->size > 0) { /* Skip end of region indicators */
+            ++count;
+            total += block->size;
+            if (block->size > largest) {
+                largest = (uint32_t)block->size;
+            }
+        }
+    }
+    stats->free_block_count = count;
+    stats->largest_free_block_bytes = largest;
+    stats->fragmentation_pct = total > 0 ? (uint32_t)(100 - (100 * (uint64_t)largest) / total) : 0;
+}
+
+#endif /* LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+
 void
-lwmem_free_s_ex(lwmem_t* lwobj, void** const ptr) {
-    if (ptr != NULL && *ptr != NULL) {
+lwmem_get_stats_ex(lwmem_t* lwobj, lwmem_stats_t* stats) {
+    if (stats != NULL) {
         lwobj = LWMEM_GET_LWOBJ(lwobj);
+#if LWMEM_CFG_ENABLE_STATS_ATOMIC
+        /* Counters are atomic, snapshot is taken without lengthening the critical section */
+        stats->mem_size_bytes = lwobj->stats.mem_size_bytes;
+        stats->minimum_ever_mem_available_bytes = lwobj->stats.minimum_ever_mem_available_bytes;
+        stats->nr_alloc = lwobj->stats.nr_alloc;
+        stats->nr_free = lwobj->stats.nr_free;
+        stats->mem_available_bytes = lwobj->mem_available_bytes;
+#if LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
         LWMEM_PROTECT(lwobj);
-        prv_free(lwobj, *ptr);
+        prv_fill_frag_stats(lwobj, stats);
         LWMEM_UNPROTECT(lwobj);
-        *ptr = NULL;
+#endif /* LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+#else  /* LWMEM_CFG_ENABLE_STATS_ATOMIC */
+        LWMEM_PROTECT(lwobj);
+        *stats = lwobj->stats;
+        stats->mem_available_bytes = lwobj->mem_available_bytes;
+#if LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN
+        prv_fill_frag_stats(lwobj, stats);
+#endif /* LWMEM_CFG_FULL && !LWMEM_BUDDY_EN && !LWMEM_COMPACT_EN && !LWMEM_OOB_EN && !LWMEM_SO_EN */
+        LWMEM_UNPROTECT(lwobj);
+#endif /* !LWMEM_CFG_ENABLE_STATS_ATOMIC */
     }
 }
 
 /**
- * \brief           Get user size of allocated memory
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
- *                      Instance must be the same as used during allocation procedure
- * \param[in]       ptr: Pointer to allocated memory
- * \return          Block size for user in units of bytes
+ * \brief           Compute composite heap health score
+ *
+ * One number per device for fleet telemetry: `100` is a fresh healthy heap,
+ * degrading with shrinking headroom, rising fragmentation and a low
+ * minimum-ever watermark. Cheap enough to sample every minute; flag units
+ * trending downward weeks before allocation failures start
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \return          Health score between `0` (critical) and `100` (healthy)
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
-size_t
-lwmem_get_size_ex(lwmem_t* lwobj, void* ptr) {
-    lwmem_block_t* block;
-    uint32_t len = 0;
+uint8_t
+lwmem_health_ex(lwmem_t* lwobj) {
+    lwmem_stats_t stats;
+    uint32_t headroom_pct, minever_pct, defrag_pct, score;
 
-    if (ptr != NULL) {
-        lwobj = LWMEM_GET_LWOBJ(lwobj);
-        LWMEM_PROTECT(lwobj);
-        block = LWMEM_GET_BLOCK_FROM_PTR(ptr);
-        if (LWMEM_BLOCK_IS_ALLOC(block)) {
-            len = (block->size & ~LWMEM_ALLOC_BIT) - LWMEM_BLOCK_META_SIZE;
+    lwmem_get_stats_ex(lwobj, &stats);
+    if (stats.mem_size_bytes == 0) {
+        return 0; /* Uninitialized instance is not healthy */
+    }
+    headroom_pct = (uint32_t)(((uint64_t)stats.mem_available_bytes * 100) / stats.mem_size_bytes);
+    minever_pct = (uint32_t)(((uint64_t)stats.minimum_ever_mem_available_bytes * 100) / stats.mem_size_bytes);
+    defrag_pct = 100 - (stats.fragmentation_pct > 100 ? 100 : stats.fragmentation_pct);
+
+    /* Current headroom dominates, worst-case history and fragmentation refine */
+    score = (headroom_pct * 40 + minever_pct * 30 + defrag_pct * 30) / 100;
+    return (uint8_t)(score > 100 ? 100 : score);
+}
+
+/**
+ * \brief           Append single CBOR unsigned-argument item to the buffer
+ * \param[in,out]   buf: Output buffer
+ * \param[in]       len: Output buffer length
+ * \param[in,out]   pos: Current write position, advanced by item length.
+ *                      Position beyond buffer length indicates overflow
+ * \param[in]       major: CBOR major type of the item, already shifted to upper `3` bits
+ * \param[in]       value: Unsigned argument of the item
+ */
+static void
+prv_cbor_head(uint8_t* buf, size_t len, size_t* pos, uint8_t major, uint32_t value) {
+    uint8_t bytes = value < 24 ? 0 : (value <= 0xFFUL ? 1 : (value <= 0xFFFFUL ? 2 : 4));
+
+    if ((*pos + 1 + bytes) <= len) {
+        if (bytes == 0) {
+            buf[*pos] = major | (uint8_t)value;
+        } else {
+            buf[*pos] = major | (uint8_t)(23 + (bytes == 4 ? 3 : bytes)); /* 24, 25 or 26 */
+            for (uint8_t i = 0; i < bytes; ++i) {
+                buf[*pos + 1 + i] = (uint8_t)(value >> (8 * (bytes - 1 - i)));
+            }
         }
-        LWMEM_UNPROTECT(lwobj);
     }
-    return len;
+    *pos += 1 + bytes;
 }
 
-#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
+/**
+ * \brief           Append CBOR map key and unsigned value pair
+ */
+#define LWMEM_CBOR_KV(buf, len, pos, key, value)                                                                       \
+    do {                                                                                                               \
+        prv_cbor_head((buf), (len), (pos), 0x00, (key));                                                               \
+        prv_cbor_head((buf), (len), (pos), 0x00, (uint32_t)(value));                                                   \
+    } while (0)
 
-#if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
+/**
+ * \brief           Export statistics as compact self-describing CBOR map
+ *
+ * Stable fleet telemetry schema, one map with integer keys:
+ * `0` schema version (currently `1`), `1` total size, `2` available bytes,
+ * `3` minimum ever available, `4` allocation count, `5` free count,
+ * `6` free block count, `7` largest free block, `8` fragmentation percent,
+ * `9` health score and - when \ref LWMEM_CFG_ALLOC_HISTOGRAM is enabled -
+ * `10` array of log2-bucket counters. New fields only ever append new keys,
+ * decoders skip unknown keys, so firmware and backend can upgrade separately.
+ * Typical encoded size is below `60` bytes, fitting single BLE or MQTT packet
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[out]      buf: Output buffer for encoded message
+ * \param[in]       len: Length of output buffer in bytes
+ * \return          Number of bytes written, `0` when buffer is too small
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+size_t
+lwmem_stats_export_cbor_ex(lwmem_t* lwobj, uint8_t* buf, size_t len) {
+    lwmem_stats_t stats;
+    size_t pos = 0;
+
+    if (buf == NULL || len == 0) {
+        return 0;
+    }
+    lwmem_get_stats_ex(lwobj, &stats);
+#if LWMEM_CFG_ALLOC_HISTOGRAM
+    prv_cbor_head(buf, len, &pos, 0xA0, 12); /* Map of 12 pairs */
+#else  /* LWMEM_CFG_ALLOC_HISTOGRAM */
+    prv_cbor_head(buf, len, &pos, 0xA0, 11); /* Map of 11 pairs */
+#endif /* !LWMEM_CFG_ALLOC_HISTOGRAM */
+    LWMEM_CBOR_KV(buf, len, &pos, 0, 1); /* Schema version */
+    LWMEM_CBOR_KV(buf, len, &pos, 1, stats.mem_size_bytes);
+    LWMEM_CBOR_KV(buf, len, &pos, 2, stats.mem_available_bytes);
+    LWMEM_CBOR_KV(buf, len, &pos, 3, stats.minimum_ever_mem_available_bytes);
+    LWMEM_CBOR_KV(buf, len, &pos, 4, stats.nr_alloc);
+    LWMEM_CBOR_KV(buf, len, &pos, 5, stats.nr_free);
+    LWMEM_CBOR_KV(buf, len, &pos, 6, stats.free_block_count);
+    LWMEM_CBOR_KV(buf, len, &pos, 7, stats.largest_free_block_bytes);
+    LWMEM_CBOR_KV(buf, len, &pos, 8, stats.fragmentation_pct);
+    LWMEM_CBOR_KV(buf, len, &pos, 9, lwmem_health_ex(lwobj));
+#if LWMEM_CFG_ALLOC_HISTOGRAM
+    prv_cbor_head(buf, len, &pos, 0x00, 10);                               /* Histogram key */
+    prv_cbor_head(buf, len, &pos, 0x80, LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS); /* Array of buckets */
+    for (size_t i = 0; i < LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS; ++i) {
+        prv_cbor_head(buf, len, &pos, 0x00, LWMEM_GET_LWOBJ(lwobj)->alloc_histogram[i]);
+    }
+#endif /* LWMEM_CFG_ALLOC_HISTOGRAM */
+    {
+        lwmem_advice_t advice;
+
+        lwmem_advise_ex(lwobj, &advice);
+        prv_cbor_head(buf, len, &pos, 0x00, 11); /* Advisor key */
+        prv_cbor_head(buf, len, &pos, 0x80, 3);  /* Array of flags, pool size, pool share */
+        prv_cbor_head(buf, len, &pos, 0x00, advice.flags);
+        prv_cbor_head(buf, len, &pos, 0x00, advice.pool_block_size);
+        prv_cbor_head(buf, len, &pos, 0x00, advice.pool_share_pct);
+    }
+    return pos <= len ? pos : 0;
+}
 
 /**
- * \brief           Get statistics of a LwMEM instance
- * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance.
- *                      Instance must be the same as used during allocation procedure
- * \param[in,out]   stats: Pointer to \ref lwmem_stats_t to store result
+ * \brief           Derive configuration recommendations from collected metrics
+ *
+ * Institutionalizes the tuning methodology: fragmentation, headroom,
+ * histogram and (when enabled) reuse-audit metrics are condensed into
+ * concrete `LWMEM_ADVICE_xxx` recommendations - which strategy to build
+ * with, whether a pool (and of which block size) would absorb the dominant
+ * size class, whether alignment or the split threshold wastes memory.
+ * Sample after the device has run a representative workload; the report is
+ * also exported with the CBOR telemetry (key `11`) for fleet-wide analysis
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in,out]   advice: Output report
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
 void
-lwmem_get_stats_ex(lwmem_t* lwobj, lwmem_stats_t* stats) {
-    if (stats != NULL) {
-        lwobj = LWMEM_GET_LWOBJ(lwobj);
-        LWMEM_PROTECT(lwobj);
-        *stats = lwobj->stats;
-        stats->mem_available_bytes = lwobj->mem_available_bytes;
-        LWMEM_UNPROTECT(lwobj);
+lwmem_advise_ex(lwmem_t* lwobj, lwmem_advice_t* advice) {
+    lwmem_stats_t stats;
+
+    if (advice == NULL) {
+        return;
+    }
+    advice->flags = 0;
+    advice->pool_block_size = 0;
+    advice->pool_share_pct = 0;
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    lwmem_get_stats_ex(lwobj, &stats);
+    advice->health = lwmem_health_ex(lwobj);
+    if (stats.mem_size_bytes == 0) {
+        return; /* Nothing measured yet, no advice to give */
+    }
+
+    if (stats.fragmentation_pct > 40) {
+        advice->flags |= LWMEM_ADVICE_BEST_FIT; /* First-fit churn is shredding the free space */
+    }
+    if (stats.minimum_ever_mem_available_bytes < (stats.mem_size_bytes / 10)) {
+        advice->flags |= LWMEM_ADVICE_GROW_HEAP; /* Worst case came within 10% of exhaustion */
+    }
+    if (stats.free_block_count > 8
+        && stats.mem_available_bytes / stats.free_block_count < 4 * sizeof(lwmem_block_t)) {
+        advice->flags |= LWMEM_ADVICE_SPLIT_THRESH; /* Free space shredded into header-sized crumbs */
+    }
+
+#if LWMEM_CFG_ALLOC_HISTOGRAM
+    {
+        uint32_t buckets[LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS];
+        uint64_t total = 0, small = 0;
+        size_t top = 0;
+
+        lwmem_get_histogram_ex(lwobj, buckets, LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS);
+        for (size_t idx = 0; idx < LWMEM_CFG_ALLOC_HISTOGRAM_BUCKETS; ++idx) {
+            total += buckets[idx];
+            if (buckets[idx] > buckets[top]) {
+                top = idx;
+            }
+            if (idx < 4) {
+                small += buckets[idx]; /* Requests of up to 16 bytes */
+            }
+        }
+        if (total > 0) {
+            const uint32_t share = (uint32_t)((buckets[top] * 100U) / total);
+
+            if (share >= 50) {
+                /* One log2 class dominates: a pool of its upper bound absorbs it */
+                advice->flags |= LWMEM_ADVICE_ADD_POOL;
+                advice->pool_block_size = (uint32_t)1 << (top + 1);
+                advice->pool_share_pct = share;
+            }
+            if (LWMEM_CFG_ALIGN_NUM > 4 && ((small * 100U) / total) >= 60) {
+                advice->flags |= LWMEM_ADVICE_LOWER_ALIGN; /* Padding dominates tiny requests */
+            }
+        }
+    }
+#endif /* LWMEM_CFG_ALLOC_HISTOGRAM */
+#if LWMEM_AUDIT_EN
+    if (lwobj->audit_samples > 100 && (lwobj->audit_exact_hits * 100U) / lwobj->audit_samples >= 60) {
+        advice->flags |= LWMEM_ADVICE_EXACT_CACHE; /* Freed sizes come right back, cache them */
     }
+#endif /* LWMEM_AUDIT_EN */
 }
 
 /**
  * \brief           Get statistics of a default LwMEM instance
  * \param[in,out]   stats: Pointer to \ref lwmem_stats_t to store result
  */
-size_t
-lwmem_get_size(lwmem_stats_t* stats) {
+void
+lwmem_get_stats(lwmem_stats_t* stats) {
     lwmem_get_stats_ex(NULL, stats);
 }
 
+#if (LWMEM_CFG_ENABLE_STATS && LWMEM_CFG_BATCHED_STATS) || __DOXYGEN__
+
+/**
+ * \brief           Fold the calling thread's statistics scratch into the default instance
+ *
+ * Call periodically from every allocating thread; counters read through
+ * \ref lwmem_get_stats_ex are exact up to the latest folds
+ *
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_stats_flush(void) {
+    lwmem_t* lwobj = LWMEM_GET_LWOBJ(NULL);
+
+    LWMEM_PROTECT(lwobj);
+    lwobj->stats.nr_alloc += stats_scratch.nr_alloc;
+    lwobj->stats.nr_free += stats_scratch.nr_free;
+    LWMEM_UNPROTECT(lwobj);
+    stats_scratch.nr_alloc = 0;
+    stats_scratch.nr_free = 0;
+}
+
+#endif /* (LWMEM_CFG_ENABLE_STATS && LWMEM_CFG_BATCHED_STATS) || __DOXYGEN__ */
+
+#if LWMEM_CFG_WINDOWED_STATS || __DOXYGEN__
+
+/**
+ * \brief           Read statistics of the current window and start a new one
+ *
+ * Output carries minimum available bytes and alloc/free counts observed
+ * since the previous epoch call, building a time series for capacity planning
+ *
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[in,out]   window: Pointer to \ref lwmem_stats_t to store window result.
+ *                      `mem_available_bytes` holds current value,
+ *                      `minimum_ever_mem_available_bytes` the window minimum,
+ *                      `nr_alloc`/`nr_free` the window counts. May be `NULL` to only rotate
+ * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
+ */
+void
+lwmem_stats_epoch_ex(lwmem_t* lwobj, lwmem_stats_t* window) {
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    if (window != NULL) {
+        LWMEM_MEMSET(window, 0x00, sizeof(*window));
+        window->mem_size_bytes = lwobj->stats.mem_size_bytes;
+        window->mem_available_bytes = (uint32_t)lwobj->mem_available_bytes;
+        window->minimum_ever_mem_available_bytes = lwobj->win_min_avail;
+        window->nr_alloc = lwobj->stats.nr_alloc - lwobj->win_alloc_snap;
+        window->nr_free = lwobj->stats.nr_free - lwobj->win_free_snap;
+    }
+    lwobj->win_min_avail = (uint32_t)lwobj->mem_available_bytes;
+    lwobj->win_alloc_snap = lwobj->stats.nr_alloc;
+    lwobj->win_free_snap = lwobj->stats.nr_free;
+    LWMEM_UNPROTECT(lwobj);
+}
+
+#endif /* LWMEM_CFG_WINDOWED_STATS || __DOXYGEN__ */
+
 #endif /* LWMEM_CFG_ENABLE_STATS || __DOXYGEN__ */
 
 /**
@@ -1228,6 +10306,8 @@ lwmem_calloc(size_t nitems, size_t size) {
  * \return          Pointer to allocated memory on success, `NULL` otherwise
  * \note            This function is thread safe when \ref LWMEM_CFG_OS is enabled
  */
+#if LWMEM_CFG_SUPPORT_REALLOC
+
 void*
 lwmem_realloc(void* ptr, size_t size) {
     return lwmem_realloc_ex(NULL, NULL, ptr, size);
@@ -1248,6 +10328,8 @@ lwmem_realloc_s(void** ptr2ptr, size_t size) {
     return lwmem_realloc_s_ex(NULL, NULL, ptr2ptr, size);
 }
 
+#endif /* LWMEM_CFG_SUPPORT_REALLOC */
+
 /**
  * \note            This is a wrapper for \ref lwmem_free_ex function.
  *                      It operates in default LwMEM instance and uses first available region for memory operations
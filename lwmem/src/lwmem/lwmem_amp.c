@@ -0,0 +1,171 @@
+/**
+ * \file            lwmem_amp.c
+ * \brief           Dual-core remote heap service over shared memory (AMP)
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_amp.h"
+#include <string.h>
+
+/**
+ * \brief           Initialize shared command ring, call once before both cores use it
+ * \param[in]       ring: Ring structure in memory visible to both cores
+ */
+void
+lwmem_amp_ring_init(lwmem_amp_ring_t* ring) {
+    if (ring != NULL) {
+        memset(ring, 0x00, sizeof(*ring));
+    }
+}
+
+/**
+ * \brief           Allocate from the remote (owning) core's heap
+ *
+ * Exact-size hits in the local reuse cache complete without any cross-core
+ * round-trip; misses post a command slot and busy-wait for the owning core
+ * to service it with \ref lwmem_amp_service_ex
+ *
+ * \param[in]       ring: Shared command ring
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer into the owner-managed memory, `NULL` on failure
+ * \note            Call from the remote core only
+ */
+void*
+lwmem_amp_alloc(lwmem_amp_ring_t* ring, size_t size) {
+    void* ptr = NULL;
+    size_t slot_idx = LWMEM_CFG_AMP_SLOTS;
+
+    if (ring == NULL || size == 0) {
+        return NULL;
+    }
+
+    /* Repeat allocations complete from the local cache, no round-trip */
+    for (size_t idx = 0; idx < LWMEM_CFG_AMP_CACHE; ++idx) {
+        if (ring->cache[idx].ptr != NULL && ring->cache[idx].size == (uint32_t)size) {
+            ptr = ring->cache[idx].ptr;
+            ring->cache[idx].ptr = NULL;
+            return ptr;
+        }
+    }
+
+    for (size_t idx = 0; idx < LWMEM_CFG_AMP_SLOTS; ++idx) {
+        if (ring->slots[idx].state == LWMEM_AMP_SLOT_FREE) {
+            slot_idx = idx;
+            break;
+        }
+    }
+    if (slot_idx >= LWMEM_CFG_AMP_SLOTS) {
+        return NULL; /* All slots busy */
+    }
+
+    ring->slots[slot_idx].size = (uint32_t)size;
+    LWMEM_AMP_BARRIER();
+    ring->slots[slot_idx].state = LWMEM_AMP_SLOT_REQ_ALLOC;
+    while (ring->slots[slot_idx].state != LWMEM_AMP_SLOT_DONE) {} /* Owner services in its own context */
+    LWMEM_AMP_BARRIER();
+    ptr = ring->slots[slot_idx].ptr;
+    ring->slots[slot_idx].state = LWMEM_AMP_SLOT_FREE;
+    return ptr;
+}
+
+/**
+ * \brief           Return remote-allocated memory
+ *
+ * Block first lands in the local reuse cache; when the cache is full,
+ * a free command is posted for the owning core (fire and forget)
+ *
+ * \param[in]       ring: Shared command ring
+ * \param[in]       ptr: Memory previously obtained with \ref lwmem_amp_alloc
+ * \param[in]       size: Size used at allocation time (cache reuse key)
+ * \note            Call from the remote core only
+ */
+void
+lwmem_amp_free(lwmem_amp_ring_t* ring, void* ptr, size_t size) {
+    if (ring == NULL || ptr == NULL) {
+        return;
+    }
+    for (size_t idx = 0; idx < LWMEM_CFG_AMP_CACHE; ++idx) {
+        if (ring->cache[idx].ptr == NULL) {
+            ring->cache[idx].ptr = ptr;
+            ring->cache[idx].size = (uint32_t)size;
+            return;
+        }
+    }
+    for (;;) { /* Block must not be dropped: wait for a slot, owner keeps servicing */
+        for (size_t idx = 0; idx < LWMEM_CFG_AMP_SLOTS; ++idx) {
+            if (ring->slots[idx].state == LWMEM_AMP_SLOT_FREE) {
+                ring->slots[idx].ptr = ptr;
+                LWMEM_AMP_BARRIER();
+                ring->slots[idx].state = LWMEM_AMP_SLOT_REQ_FREE;
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Service pending remote commands in batch
+ *
+ * Call periodically (or from the mailbox interrupt) on the core owning
+ * the instance; allocation and free commands of all pending slots are
+ * executed within this core's regular locking
+ *
+ * \param[in]       lwobj: Owner LwMEM instance. Set to `NULL` to use default instance
+ * \param[in]       ring: Shared command ring
+ * \return          Number of serviced commands
+ * \note            Call from the owning core only
+ */
+size_t
+lwmem_amp_service_ex(lwmem_t* lwobj, lwmem_amp_ring_t* ring) {
+    size_t serviced = 0;
+
+    if (ring == NULL) {
+        return 0;
+    }
+    for (size_t idx = 0; idx < LWMEM_CFG_AMP_SLOTS; ++idx) {
+        switch (ring->slots[idx].state) {
+            case LWMEM_AMP_SLOT_REQ_ALLOC:
+                ring->slots[idx].ptr = lwmem_malloc_ex(lwobj, NULL, ring->slots[idx].size);
+                LWMEM_AMP_BARRIER();
+                ring->slots[idx].state = LWMEM_AMP_SLOT_DONE;
+                ++serviced;
+                break;
+            case LWMEM_AMP_SLOT_REQ_FREE:
+                lwmem_free_ex(lwobj, ring->slots[idx].ptr);
+                LWMEM_AMP_BARRIER();
+                ring->slots[idx].state = LWMEM_AMP_SLOT_FREE;
+                ++serviced;
+                break;
+            default:
+                break;
+        }
+    }
+    return serviced;
+}
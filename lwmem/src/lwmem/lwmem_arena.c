@@ -0,0 +1,152 @@
+/**
+ * \file            lwmem_arena.c
+ * \brief           Arena allocator with mark and release support
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_arena.h"
+#include <string.h>
+
+/**
+ * \brief           Transform alignment number (power of `2`) to bits
+ */
+#define LWMEM_ALIGN_BITS ((size_t)(((size_t)LWMEM_CFG_ALIGN_NUM) - 1))
+
+/**
+ * \brief           Aligns input value to next alignment bits
+ */
+#define LWMEM_ALIGN(x)   (((x) + (LWMEM_ALIGN_BITS)) & ~(LWMEM_ALIGN_BITS))
+
+/**
+ * \brief           Create arena with backing buffer allocated from LwMEM instance
+ *
+ * Arena provides grow-only bump allocation, same concept as the simple
+ * allocation algorithm, but nested inside a full heap. All arena allocations
+ * are returned at once with \ref lwmem_arena_release or \ref lwmem_arena_reset,
+ * which are simple pointer resets
+ *
+ * \param[in]       lwobj: LwMEM instance to allocate backing buffer from.
+ *                      Set to `NULL` to use default instance
+ * \param[in]       arena: Arena instance to initialize
+ * \param[in]       size: Arena size in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_arena_create_ex(lwmem_t* lwobj, lwmem_arena_t* arena, size_t size) {
+    if (arena == NULL || size == 0) {
+        return 0;
+    }
+    arena->buff = lwmem_malloc_ex(lwobj, NULL, size);
+    if (arena->buff == NULL) {
+        return 0;
+    }
+    arena->lwobj = lwobj;
+    arena->size = size;
+    arena->offset = 0;
+    return 1;
+}
+
+/**
+ * \brief           Create arena from default LwMEM instance
+ * \param[in]       arena: Arena instance to initialize
+ * \param[in]       size: Arena size in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_arena_create(lwmem_arena_t* arena, size_t size) {
+    return lwmem_arena_create_ex(NULL, arena, size);
+}
+
+/**
+ * \brief           Allocate memory from arena by advancing the bump pointer
+ * \param[in]       arena: Arena instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory, `NULL` when arena is full
+ */
+void*
+lwmem_arena_alloc(lwmem_arena_t* arena, size_t size) {
+    void* retval = NULL;
+    const size_t alloc_size = LWMEM_ALIGN(size);
+
+    if (arena != NULL && size > 0 && alloc_size <= (arena->size - arena->offset)) {
+        retval = &arena->buff[arena->offset];
+        arena->offset += alloc_size;
+    }
+    return retval;
+}
+
+/**
+ * \brief           Get current arena position to be used with \ref lwmem_arena_release
+ * \param[in]       arena: Arena instance
+ * \return          Opaque mark of current arena state
+ */
+size_t
+lwmem_arena_mark(const lwmem_arena_t* arena) {
+    return arena != NULL ? arena->offset : 0;
+}
+
+/**
+ * \brief           Release all allocations made after input mark was taken
+ * \param[in]       arena: Arena instance
+ * \param[in]       mark: Mark previously returned by \ref lwmem_arena_mark
+ */
+void
+lwmem_arena_release(lwmem_arena_t* arena, size_t mark) {
+    if (arena != NULL && mark <= arena->offset) {
+        arena->offset = mark;
+    }
+}
+
+/**
+ * \brief           Release all arena allocations at once
+ * \param[in]       arena: Arena instance
+ */
+void
+lwmem_arena_reset(lwmem_arena_t* arena) {
+    lwmem_arena_release(arena, 0);
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Destroy arena and return backing buffer to the LwMEM instance
+ * \param[in]       arena: Arena instance. Must not be used after this call
+ */
+void
+lwmem_arena_destroy(lwmem_arena_t* arena) {
+    if (arena != NULL && arena->buff != NULL) {
+        lwmem_free_ex(arena->lwobj, arena->buff);
+        arena->buff = NULL;
+        arena->size = 0;
+        arena->offset = 0;
+    }
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
@@ -0,0 +1,154 @@
+/**
+ * \file            lwmem_cli.c
+ * \brief           Runtime diagnostics shell
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_cli.h"
+#include <string.h>
+
+/* Local print helpers, no printf dependency on the target */
+static void
+prv_puts(lwmem_cli_out_fn out, void* user, const char* str) {
+    while (*str != '\0') {
+        out(*str++, user);
+    }
+}
+
+static void
+prv_putnum(lwmem_cli_out_fn out, void* user, size_t num) {
+    char digits[20];
+    size_t len = 0;
+
+    do {
+        digits[len++] = (char)('0' + (num % 10));
+        num /= 10;
+    } while (num > 0);
+    while (len > 0) {
+        out(digits[--len], user);
+    }
+}
+
+#if LWMEM_CFG_FULL
+
+/**
+ * \brief           Walk context carrying the output sink
+ */
+typedef struct {
+    lwmem_cli_out_fn out; /*!< Character output callback */
+    void* user;           /*!< User argument of the callback */
+} cli_walk_ctx_t;
+
+static uint8_t
+prv_walk_cb(struct lwmem* lwobj, void* addr, size_t size, uint8_t is_free, void* user) {
+    cli_walk_ctx_t* ctx = user;
+
+    (void)lwobj;
+    prv_puts(ctx->out, ctx->user, is_free ? "  free " : "  used ");
+    prv_putnum(ctx->out, ctx->user, (size_t)addr);
+    prv_puts(ctx->out, ctx->user, " size ");
+    prv_putnum(ctx->out, ctx->user, size);
+    prv_puts(ctx->out, ctx->user, "\r\n");
+    return 1;
+}
+
+#endif /* LWMEM_CFG_FULL */
+
+/**
+ * \brief           Execute one diagnostics command and print its output
+ *
+ * Supported commands: `stats`, `walk`, `validate`, `help`.
+ * Wire to any console transport by feeding received lines and
+ * providing a character output (putchar-style) callback
+ *
+ * \param[in]       lwobj: LwMEM instance to inspect, `NULL` for default one
+ * \param[in]       cmd: Command string, as received from the console
+ * \param[in]       out: Character output callback
+ * \param[in]       user: User argument passed to the output callback
+ * \return          `1` when command was recognized, `0` otherwise
+ */
+uint8_t
+lwmem_cli_process(lwmem_t* lwobj, const char* cmd, lwmem_cli_out_fn out, void* user) {
+    if (cmd == NULL || out == NULL) {
+        return 0;
+    }
+    while (*cmd == ' ') {
+        ++cmd;
+    }
+
+#if LWMEM_CFG_ENABLE_STATS
+    if (strncmp(cmd, "stats", 5) == 0) {
+        lwmem_stats_t stats;
+
+        lwmem_get_stats_ex(lwobj, &stats);
+        prv_puts(out, user, "total ");
+        prv_putnum(out, user, stats.mem_size_bytes);
+        prv_puts(out, user, " free ");
+        prv_putnum(out, user, stats.mem_available_bytes);
+        prv_puts(out, user, " min-free ");
+        prv_putnum(out, user, stats.minimum_ever_mem_available_bytes);
+        prv_puts(out, user, " allocs ");
+        prv_putnum(out, user, stats.nr_alloc);
+        prv_puts(out, user, " frees ");
+        prv_putnum(out, user, stats.nr_free);
+        prv_puts(out, user, " frag% ");
+        prv_putnum(out, user, stats.fragmentation_pct);
+        prv_puts(out, user, "\r\n");
+        return 1;
+    }
+#endif /* LWMEM_CFG_ENABLE_STATS */
+#if LWMEM_CFG_FULL
+    if (strncmp(cmd, "walk", 4) == 0) {
+        cli_walk_ctx_t ctx = {out, user};
+
+        lwmem_walk_ex(lwobj, prv_walk_cb, &ctx);
+        return 1;
+    }
+    if (strncmp(cmd, "validate", 8) == 0) {
+        void* fault = NULL;
+        lwmem_validate_res_t res = lwmem_validate_ex(lwobj, 0, &fault);
+
+        prv_puts(out, user, res == LWMEM_VALIDATE_OK ? "heap OK" : "heap CORRUPT code ");
+        if (res != LWMEM_VALIDATE_OK) {
+            prv_putnum(out, user, (size_t)res);
+            prv_puts(out, user, " at ");
+            prv_putnum(out, user, (size_t)fault);
+        }
+        prv_puts(out, user, "\r\n");
+        return 1;
+    }
+#endif /* LWMEM_CFG_FULL */
+    if (strncmp(cmd, "help", 4) == 0) {
+        prv_puts(out, user, "commands: stats walk validate help\r\n");
+        return 1;
+    }
+    prv_puts(out, user, "unknown command\r\n");
+    return 0;
+}
@@ -0,0 +1,218 @@
+/**
+ * \file            lwmem_handle.c
+ * \brief           Handle-based compacting heap
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_handle.h"
+#include <string.h>
+
+/**
+ * \brief           Transform alignment number (power of `2`) to bits
+ */
+#define LWMEM_ALIGN_BITS ((size_t)(((size_t)LWMEM_CFG_ALIGN_NUM) - 1))
+
+/**
+ * \brief           Aligns input value to next alignment bits
+ */
+#define LWMEM_ALIGN(x)   (((x) + (LWMEM_ALIGN_BITS)) & ~(LWMEM_ALIGN_BITS))
+
+/**
+ * \brief           Initializes handle heap over user provided region
+ *
+ * Handle table is carved from the region head, remaining memory forms
+ * the data area. Allocations return stable handles; \ref lwmem_compact_ex
+ * slides unpinned blocks together, so long-uptime fragmentation is
+ * fully recoverable at the cost of handle indirection
+ *
+ * \param[in]       hheap: Handle heap instance to initialize
+ * \param[in]       region: Region with address and size to build the heap in
+ * \param[in]       max_handles: Maximal number of live allocations
+ * \return          `1` on success, `0` otherwise
+ * \note            Functions are not thread safe, protect calls
+ *                      when used from multiple contexts
+ */
+uint8_t
+lwmem_hheap_init(lwmem_hheap_t* hheap, const lwmem_region_t* region, size_t max_handles) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0, table_bytes;
+
+    if (hheap == NULL || region == NULL || max_handles == 0) {
+        return 0;
+    }
+    mem_start_addr = region->start_addr;
+    mem_size = region->size;
+    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) {
+        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
+        mem_size -= (size_t)(mem_start_addr - (uint8_t*)region->start_addr);
+    }
+    mem_size &= ~LWMEM_ALIGN_BITS;
+
+    table_bytes = LWMEM_ALIGN(max_handles * sizeof(lwmem_handle_entry_t));
+    if (mem_size <= (table_bytes + LWMEM_CFG_ALIGN_NUM)) {
+        return 0;
+    }
+    hheap->table = (void*)mem_start_addr;
+    hheap->capacity = max_handles;
+    memset(hheap->table, 0x00, table_bytes);
+    hheap->base = mem_start_addr + table_bytes;
+    hheap->size = mem_size - table_bytes;
+    hheap->brk = 0;
+    return 1;
+}
+
+/**
+ * \brief           Allocate block and return its stable handle
+ *
+ * Allocation bumps the top of allocated space; when the request does not
+ * fit, the heap is compacted once and the allocation retried
+ *
+ * \param[in]       hheap: Handle heap instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Handle of allocation, `0` on failure
+ */
+lwmem_handle_t
+lwmem_hheap_alloc(lwmem_hheap_t* hheap, size_t size) {
+    const size_t need = LWMEM_ALIGN(size);
+    size_t idx;
+
+    if (hheap == NULL || size == 0) {
+        return 0;
+    }
+    for (idx = 0; idx < hheap->capacity && hheap->table[idx].used; ++idx) {}
+    if (idx >= hheap->capacity) {
+        return 0; /* Handle table exhausted */
+    }
+    if (need > (hheap->size - hheap->brk)) {
+        lwmem_compact_ex(hheap); /* Try to rebuild one large free block at the top */
+        if (need > (hheap->size - hheap->brk)) {
+            return 0;
+        }
+    }
+
+    hheap->table[idx].ptr = hheap->base + hheap->brk;
+    hheap->table[idx].size = (uint32_t)need;
+    hheap->table[idx].lock_cnt = 0;
+    hheap->table[idx].used = 1;
+    hheap->brk += need;
+    return idx + 1; /* Handle 0 stays invalid */
+}
+
+/**
+ * \brief           Pin handle and get its current address
+ *
+ * Block is not relocated while at least one lock is outstanding
+ *
+ * \param[in]       hheap: Handle heap instance
+ * \param[in]       handle: Handle to lock
+ * \return          Current block address, `NULL` on invalid handle
+ */
+void*
+lwmem_hheap_lock(lwmem_hheap_t* hheap, lwmem_handle_t handle) {
+    if (hheap == NULL || handle == 0 || handle > hheap->capacity || !hheap->table[handle - 1].used) {
+        return NULL;
+    }
+    ++hheap->table[handle - 1].lock_cnt;
+    return hheap->table[handle - 1].ptr;
+}
+
+/**
+ * \brief           Unpin handle, making its block relocatable again
+ * \param[in]       hheap: Handle heap instance
+ * \param[in]       handle: Handle to unlock
+ */
+void
+lwmem_hheap_unlock(lwmem_hheap_t* hheap, lwmem_handle_t handle) {
+    if (hheap != NULL && handle > 0 && handle <= hheap->capacity && hheap->table[handle - 1].lock_cnt > 0) {
+        --hheap->table[handle - 1].lock_cnt;
+    }
+}
+
+/**
+ * \brief           Free handle and its block
+ * \param[in]       hheap: Handle heap instance
+ * \param[in]       handle: Handle to free. `0` is valid input
+ */
+void
+lwmem_hheap_free(lwmem_hheap_t* hheap, lwmem_handle_t handle) {
+    if (hheap != NULL && handle > 0 && handle <= hheap->capacity) {
+        hheap->table[handle - 1].used = 0;
+        hheap->table[handle - 1].lock_cnt = 0;
+    }
+}
+
+/**
+ * \brief           Compact the heap by sliding unpinned blocks together
+ *
+ * Blocks are moved with \ref LWMEM_MEMMOVE in address order towards the
+ * bottom; pinned (locked) blocks stay in place and compaction continues
+ * above them. Handle table addresses are updated in place
+ *
+ * \param[in]       hheap: Handle heap instance
+ * \return          Number of bytes reclaimed at the top of the heap
+ */
+size_t
+lwmem_compact_ex(lwmem_hheap_t* hheap) {
+    size_t dest, old_brk;
+
+    if (hheap == NULL) {
+        return 0;
+    }
+    dest = 0;
+    old_brk = hheap->brk;
+
+    /* Process live blocks in address order; entries are few, linear selection is fine */
+    for (;;) {
+        lwmem_handle_entry_t* lowest = NULL;
+
+        for (size_t idx = 0; idx < hheap->capacity; ++idx) {
+            lwmem_handle_entry_t* entry = &hheap->table[idx];
+
+            if (entry->used && (size_t)(entry->ptr - hheap->base) >= dest
+                && (lowest == NULL || entry->ptr < lowest->ptr)) {
+                lowest = entry;
+            }
+        }
+        if (lowest == NULL) {
+            break;
+        }
+        if (lowest->lock_cnt > 0) { /* Pinned block is a barrier, continue above it */
+            dest = (size_t)(lowest->ptr - hheap->base) + lowest->size;
+            continue;
+        }
+        if ((size_t)(lowest->ptr - hheap->base) != dest) {
+            LWMEM_MEMMOVE(hheap->base + dest, lowest->ptr, lowest->size);
+            lowest->ptr = hheap->base + dest;
+        }
+        dest += lowest->size;
+    }
+    hheap->brk = dest;
+    return old_brk - dest;
+}
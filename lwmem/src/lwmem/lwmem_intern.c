@@ -0,0 +1,163 @@
+/**
+ * \file            lwmem_intern.c
+ * \brief           String/blob interning service
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_intern.h"
+#include <string.h>
+
+/**
+ * \brief           FNV-1a hash over payload bytes
+ * \param[in]       bytes: Payload
+ * \param[in]       len: Payload length
+ * \return          32-bit hash value
+ */
+static uint32_t
+prv_hash(const void* bytes, size_t len) {
+    const uint8_t* data = bytes;
+    uint32_t hash = 2166136261U;
+
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ data[i]) * 16777619U;
+    }
+    return hash;
+}
+
+/**
+ * \brief           Initialize interning service with table allocated from the instance
+ *
+ * Identical payloads interned through the service share one canonical
+ * refcounted copy, collapsing duplicate strings/blobs into hash hits
+ *
+ * \param[in]       lwobj: LwMEM instance for table and payload storage,
+ *                      `NULL` for default instance (e.g. one over a dedicated region)
+ * \param[in]       intern: Interning instance to initialize
+ * \param[in]       capacity: Hash table capacity. Keep roughly twice
+ *                      the expected number of distinct payloads
+ * \return          `1` on success, `0` otherwise
+ * \note            Functions are not thread safe, protect calls when shared
+ */
+uint8_t
+lwmem_intern_init_ex(lwmem_t* lwobj, lwmem_intern_t* intern, size_t capacity) {
+    if (intern == NULL || capacity == 0) {
+        return 0;
+    }
+    intern->table = lwmem_calloc_ex(lwobj, NULL, capacity, sizeof(*intern->table));
+    if (intern->table == NULL) {
+        return 0;
+    }
+    intern->lwobj = lwobj;
+    intern->capacity = capacity;
+    return 1;
+}
+
+/**
+ * \brief           Intern payload and get its canonical pointer
+ *
+ * Existing identical payload is reference-counted and returned without any
+ * allocation; new payloads are copied into canonical storage once
+ *
+ * \param[in]       intern: Interning instance
+ * \param[in]       bytes: Payload bytes
+ * \param[in]       len: Payload length in units of bytes
+ * \return          Canonical payload pointer, `NULL` when table or heap is exhausted
+ */
+const void*
+lwmem_intern(lwmem_intern_t* intern, const void* bytes, size_t len) {
+    uint32_t hash;
+    size_t idx, free_idx;
+
+    if (intern == NULL || bytes == NULL || len == 0) {
+        return NULL;
+    }
+    hash = prv_hash(bytes, len);
+    free_idx = intern->capacity;
+    idx = hash % intern->capacity;
+    for (size_t probe = 0; probe < intern->capacity; ++probe, idx = (idx + 1) % intern->capacity) {
+        lwmem_intern_entry_t* entry = &intern->table[idx];
+
+        if (entry->ptr == NULL) {
+            if (free_idx >= intern->capacity) {
+                free_idx = idx; /* Reusable slot: never used, or tombstone of a released entry */
+            }
+            if (entry->len == 0) {
+                break; /* Probe chain ends at first never-used entry, tombstones keep it alive */
+            }
+            continue;
+        }
+        if (entry->hash == hash && entry->len == len && memcmp(entry->ptr, bytes, len) == 0) {
+            ++entry->refs; /* Hash hit -> share canonical copy */
+            return entry->ptr;
+        }
+    }
+    if (free_idx >= intern->capacity) {
+        return NULL; /* Table full */
+    }
+
+    intern->table[free_idx].ptr = lwmem_malloc_ex(intern->lwobj, NULL, len);
+    if (intern->table[free_idx].ptr == NULL) {
+        return NULL;
+    }
+    memcpy(intern->table[free_idx].ptr, bytes, len);
+    intern->table[free_idx].hash = hash;
+    intern->table[free_idx].len = (uint32_t)len;
+    intern->table[free_idx].refs = 1;
+    return intern->table[free_idx].ptr;
+}
+
+/**
+ * \brief           Release one reference of a canonical payload
+ *
+ * Storage is freed when the last reference is gone
+ *
+ * \param[in]       intern: Interning instance
+ * \param[in]       ptr: Canonical pointer previously returned by \ref lwmem_intern.
+ *                      `NULL` pointer is valid input
+ */
+void
+lwmem_intern_release(lwmem_intern_t* intern, const void* ptr) {
+    if (intern == NULL || ptr == NULL) {
+        return;
+    }
+    for (size_t idx = 0; idx < intern->capacity; ++idx) {
+        lwmem_intern_entry_t* entry = &intern->table[idx];
+
+        if (entry->ptr == ptr) {
+            if (--entry->refs == 0) {
+#if LWMEM_CFG_FULL
+                lwmem_free_ex(intern->lwobj, entry->ptr);
+#endif /* LWMEM_CFG_FULL */
+                entry->ptr = NULL; /* len stays set as a tombstone, keeping probe chains intact */
+            }
+            return;
+        }
+    }
+}
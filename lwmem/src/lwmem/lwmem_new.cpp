@@ -0,0 +1,154 @@
+/**
+ * \file            lwmem_new.cpp
+ * \brief           Global operator new/delete overrides routed to LwMEM
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+/*
+ * Optional translation unit. Compile it into the application (or enable the
+ * LWMEM_OPERATOR_NEW CMake option) to route every C++ allocation - including
+ * third-party code - onto the default LwMEM instance, gaining its statistics
+ * and deterministic behavior. Sized deallocation variants forward directly,
+ * so delete does not need a block-size lookup when the compiler provides it.
+ */
+#include <new>
+#include "lwmem/lwmem.h"
+
+#if !LWMEM_CFG_FULL
+#error "lwmem_new.cpp requires LWMEM_CFG_FULL, operator delete must be able to free"
+#endif
+
+static void*
+prv_new(size_t size) {
+    /* Zero-size new must return a unique pointer */
+    void* ptr = lwmem_malloc(size > 0 ? size : 1);
+
+#if defined(__cpp_exceptions)
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+#endif /* defined(__cpp_exceptions) */
+    return ptr;
+}
+
+void*
+operator new(size_t size) {
+    return prv_new(size);
+}
+
+void*
+operator new[](size_t size) {
+    return prv_new(size);
+}
+
+void*
+operator new(size_t size, const std::nothrow_t&) noexcept {
+    return lwmem_malloc(size > 0 ? size : 1);
+}
+
+void*
+operator new[](size_t size, const std::nothrow_t&) noexcept {
+    return lwmem_malloc(size > 0 ? size : 1);
+}
+
+void
+operator delete(void* ptr) noexcept {
+    lwmem_free(ptr);
+}
+
+void
+operator delete[](void* ptr) noexcept {
+    lwmem_free(ptr);
+}
+
+void
+operator delete(void* ptr, const std::nothrow_t&) noexcept {
+    lwmem_free(ptr);
+}
+
+void
+operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+    lwmem_free(ptr);
+}
+
+#if defined(__cpp_sized_deallocation)
+
+void
+operator delete(void* ptr, size_t) noexcept {
+    lwmem_free(ptr); /* Block carries its own size, compiler-provided size needs no lookup */
+}
+
+void
+operator delete[](void* ptr, size_t) noexcept {
+    lwmem_free(ptr);
+}
+
+#endif /* defined(__cpp_sized_deallocation) */
+
+#if defined(__cpp_aligned_new)
+
+void*
+operator new(size_t size, std::align_val_t align) {
+    void* ptr = lwmem_malloc_aligned_ex(NULL, NULL, size > 0 ? size : 1, (size_t)align);
+
+#if defined(__cpp_exceptions)
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+#endif /* defined(__cpp_exceptions) */
+    return ptr;
+}
+
+void*
+operator new[](size_t size, std::align_val_t align) {
+    return operator new(size, align);
+}
+
+void
+operator delete(void* ptr, std::align_val_t) noexcept {
+    lwmem_free(ptr);
+}
+
+void
+operator delete[](void* ptr, std::align_val_t) noexcept {
+    lwmem_free(ptr);
+}
+
+void
+operator delete(void* ptr, size_t, std::align_val_t) noexcept {
+    lwmem_free(ptr);
+}
+
+void
+operator delete[](void* ptr, size_t, std::align_val_t) noexcept {
+    lwmem_free(ptr);
+}
+
+#endif /* defined(__cpp_aligned_new) */
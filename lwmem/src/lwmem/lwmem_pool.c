@@ -0,0 +1,126 @@
+/**
+ * \file            lwmem_pool.c
+ * \brief           Fixed-size block pool allocator
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_pool.h"
+#include <string.h>
+
+/**
+ * \brief           Transform alignment number (power of `2`) to bits
+ */
+#define LWMEM_ALIGN_BITS ((size_t)(((size_t)LWMEM_CFG_ALIGN_NUM) - 1))
+
+/**
+ * \brief           Aligns input value to next alignment bits
+ */
+#define LWMEM_ALIGN(x)   (((x) + (LWMEM_ALIGN_BITS)) & ~(LWMEM_ALIGN_BITS))
+
+/**
+ * \brief           Initializes pool of fixed-size blocks, carved out of user provided region
+ *
+ * Pool blocks have no metadata overhead. All blocks are linked
+ * into a singly-linked free stack, making alloc and free constant time operations
+ *
+ * \param[in]       pool: Pool instance to initialize
+ * \param[in]       region: Region with address and size to carve blocks from.
+ *                      Memory must not be used by another pool or LwMEM instance
+ * \param[in]       block_size: Size of single block, in units of bytes.
+ *                      Internally aligned up, must be at least size of a pointer
+ * \param[in]       count: Number of blocks in the pool
+ * \return          `1` on success, `0` otherwise
+ * \note            Functions are not thread safe. Protect calls or use one pool per task
+ *                      when used with operating system
+ */
+uint8_t
+lwmem_pool_init(lwmem_pool_t* pool, const lwmem_region_t* region, size_t block_size, size_t count) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    if (pool == NULL || region == NULL || block_size == 0 || count == 0) {
+        return 0;
+    }
+
+    /* Align region start address and effective size to configuration */
+    mem_start_addr = region->start_addr;
+    mem_size = region->size;
+    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) { /* Check alignment boundary */
+        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
+        mem_size -= (size_t)(mem_start_addr - (uint8_t*)region->start_addr);
+    }
+
+    /* Block must be able to hold free stack link */
+    block_size = LWMEM_ALIGN(block_size);
+    if (block_size < sizeof(void*) || mem_size < (block_size * count)) {
+        return 0;
+    }
+    pool->block_size = block_size;
+    pool->count = count;
+
+    /* Link all blocks into free stack */
+    pool->free_head = NULL;
+    for (size_t idx = 0; idx < count; ++idx) {
+        void* block = (void*)(mem_start_addr + idx * block_size);
+
+        *(void**)block = pool->free_head;
+        pool->free_head = block;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Allocate single block from the pool
+ * \param[in]       pool: Pool instance, previously initialized with \ref lwmem_pool_init
+ * \return          Pointer to block memory on success, `NULL` when pool is empty
+ */
+void*
+lwmem_pool_alloc(lwmem_pool_t* pool) {
+    void* block = NULL;
+
+    if (pool != NULL && pool->free_head != NULL) {
+        block = pool->free_head;
+        pool->free_head = *(void**)block;
+    }
+    return block;
+}
+
+/**
+ * \brief           Return previously allocated block back to the pool
+ * \param[in]       pool: Pool instance, the same as used during allocation
+ * \param[in]       ptr: Block to return. `NULL` pointer is valid input
+ */
+void
+lwmem_pool_free(lwmem_pool_t* pool, void* ptr) {
+    if (pool != NULL && ptr != NULL) {
+        *(void**)ptr = pool->free_head;
+        pool->free_head = ptr;
+    }
+}
@@ -0,0 +1,172 @@
+/**
+ * \file            lwmem_ring.c
+ * \brief           Ring allocator for FIFO buffer lifetimes
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_ring.h"
+
+/**
+ * \brief           Transform alignment number (power of `2`) to bits
+ */
+#define LWMEM_ALIGN_BITS  ((size_t)(((size_t)LWMEM_CFG_ALIGN_NUM) - 1))
+
+/**
+ * \brief           Aligns input value to next alignment bits
+ */
+#define LWMEM_ALIGN(x)    (((x) + (LWMEM_ALIGN_BITS)) & ~(LWMEM_ALIGN_BITS))
+
+/**
+ * \brief           Size of record header in front of every ring allocation
+ */
+#define RING_HDR_SIZE     LWMEM_ALIGN(sizeof(size_t))
+
+/**
+ * \brief           Header value marking wrap to the beginning of the ring
+ */
+#define RING_WRAP_MARK    ((size_t)~(size_t)0)
+
+/**
+ * \brief           Initializes ring allocator over user provided region
+ *
+ * Allocations are freed strictly in allocation order: alloc bumps the head,
+ * free advances the tail over the oldest record - both O(1), with zero
+ * fragmentation for FIFO workloads such as telemetry queues
+ *
+ * \param[in]       ring: Ring instance to initialize
+ * \param[in]       region: Region with address and size to use as ring memory
+ * \return          `1` on success, `0` otherwise
+ * \note            Functions are not thread safe, protect calls when
+ *                      producer and consumer run in different contexts
+ */
+uint8_t
+lwmem_ring_init(lwmem_ring_t* ring, const lwmem_region_t* region) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    if (ring == NULL || region == NULL) {
+        return 0;
+    }
+
+    /* Align region start address and effective size to configuration */
+    mem_start_addr = region->start_addr;
+    mem_size = region->size;
+    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) {
+        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
+        mem_size -= (size_t)(mem_start_addr - (uint8_t*)region->start_addr);
+    }
+    mem_size &= ~LWMEM_ALIGN_BITS;
+    if (mem_size < (4 * RING_HDR_SIZE)) {
+        return 0;
+    }
+
+    ring->base = mem_start_addr;
+    ring->size = mem_size;
+    ring->head = 0;
+    ring->tail = 0;
+    ring->used = 0;
+    return 1;
+}
+
+/**
+ * \brief           Allocate buffer from the ring by bumping the head
+ * \param[in]       ring: Ring instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory, `NULL` when ring is full
+ */
+void*
+lwmem_ring_alloc(lwmem_ring_t* ring, size_t size) {
+    size_t need;
+
+    if (ring == NULL || size == 0) {
+        return NULL;
+    }
+    need = RING_HDR_SIZE + LWMEM_ALIGN(size);
+    if (need > (ring->size - ring->used)) {
+        return NULL;
+    }
+
+    /* Record must be contiguous: wrap the head early when tail room allows it */
+    if ((ring->head + need) > ring->size) {
+        const size_t wrap_waste = ring->size - ring->head;
+
+        if ((ring->used + wrap_waste + need) > ring->size || ring->tail < need) {
+            return NULL; /* Not enough contiguous space at the beginning either */
+        }
+        if (wrap_waste >= RING_HDR_SIZE) {
+            *(size_t*)(void*)(ring->base + ring->head) = RING_WRAP_MARK;
+        }
+        ring->used += wrap_waste;
+        ring->head = 0;
+    }
+
+    *(size_t*)(void*)(ring->base + ring->head) = need;
+    ring->head += need;
+    if (ring->head == ring->size) {
+        ring->head = 0;
+    }
+    ring->used += need;
+    return ring->base + (ring->head - need + ring->size) % ring->size + RING_HDR_SIZE;
+}
+
+/**
+ * \brief           Free oldest allocation and advance the tail
+ * \param[in]       ring: Ring instance
+ * \param[in]       ptr: Pointer previously returned by \ref lwmem_ring_alloc.
+ *                      Must be the oldest live allocation (FIFO order is enforced)
+ * \return          `1` on success, `0` when pointer is not the current tail record
+ */
+uint8_t
+lwmem_ring_free(lwmem_ring_t* ring, void* ptr) {
+    size_t rec_size;
+
+    if (ring == NULL || ptr == NULL || ring->used == 0) {
+        return 0;
+    }
+
+    /* Skip wrap marker (or implicit wrap without room for a marker) */
+    rec_size = (ring->size - ring->tail) >= RING_HDR_SIZE ? *(size_t*)(void*)(ring->base + ring->tail)
+                                                          : RING_WRAP_MARK;
+    if (rec_size == RING_WRAP_MARK) {
+        ring->used -= ring->size - ring->tail;
+        ring->tail = 0;
+        rec_size = *(size_t*)(void*)(ring->base + ring->tail);
+    }
+
+    if ((ring->base + ring->tail + RING_HDR_SIZE) != (uint8_t*)ptr) {
+        return 0; /* FIFO order violated */
+    }
+    ring->tail += rec_size;
+    if (ring->tail == ring->size) {
+        ring->tail = 0;
+    }
+    ring->used -= rec_size;
+    return 1;
+}
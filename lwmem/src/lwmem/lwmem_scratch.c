@@ -0,0 +1,155 @@
+/**
+ * \file            lwmem_scratch.c
+ * \brief           Thread-local scratch buffer allocation
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_scratch.h"
+
+/*
+ * Short-lived working buffers are the most frequent malloc/free pairs in many
+ * profiles, yet the memory is always returned moments later. Scratch buffers
+ * convert those pairs into pointer handoffs: each thread keeps a few buffers
+ * alive between uses, grown geometrically to the high-water size, so steady
+ * state acquire/release never reaches the heap (and its lock) at all.
+ *
+ * Buffers come from the default LwMEM instance. Nested acquires use separate
+ * slots, supporting the common helper-calls-helper pattern up to the
+ * configured depth; deeper nesting falls back to plain heap allocation.
+ */
+
+/**
+ * \brief           Number of scratch buffers retained per thread.
+ *                      Also the supported depth of nested acquires
+ */
+#ifndef LWMEM_SCRATCH_DEPTH
+#define LWMEM_SCRATCH_DEPTH    4
+#endif
+
+/**
+ * \brief           Smallest buffer size kept, growth starts here
+ */
+#ifndef LWMEM_SCRATCH_MIN_SIZE
+#define LWMEM_SCRATCH_MIN_SIZE 64
+#endif
+
+/**
+ * \brief           Single retained scratch buffer
+ */
+typedef struct {
+    void* buff;     /*!< Retained buffer memory, `NULL` when never used */
+    size_t size;    /*!< Current buffer capacity in units of bytes */
+    uint8_t in_use; /*!< Set to `1` between acquire and release */
+} lwmem_scratch_slot_t;
+
+/* One slot set per thread, no locking needed on the fast path */
+static LWMEM_CFG_THREAD_LOCAL lwmem_scratch_slot_t scratch_slots[LWMEM_SCRATCH_DEPTH];
+
+/**
+ * \brief           Acquire scratch buffer of at least requested size
+ *
+ * Steady-state calls are pointer handoffs: buffer is retained from previous
+ * use and only reallocated when the request exceeds its capacity, growing
+ * geometrically so repeated slightly-larger requests settle quickly
+ *
+ * \param[in]       size: Minimal buffer size in units of bytes
+ * \return          Buffer address on success, `NULL` otherwise
+ * \note            Release with \ref lwmem_scratch_release from the same thread,
+ *                      in reverse acquire order when acquires are nested
+ */
+void*
+lwmem_scratch_acquire(size_t size) {
+    if (size == 0) {
+        return NULL;
+    }
+    for (size_t idx = 0; idx < LWMEM_SCRATCH_DEPTH; ++idx) {
+        lwmem_scratch_slot_t* slot = &scratch_slots[idx];
+
+        if (slot->in_use) {
+            continue;
+        }
+        if (slot->size < size) {
+            /* Grow geometrically, old content is scratch and never preserved */
+            size_t new_size = slot->size > 0 ? slot->size : LWMEM_SCRATCH_MIN_SIZE;
+
+            while (new_size < size) {
+                new_size += new_size / 2 + 1;
+            }
+            lwmem_free(slot->buff);
+            slot->buff = lwmem_malloc(new_size);
+            slot->size = slot->buff != NULL ? new_size : 0;
+            if (slot->buff == NULL) {
+                return NULL;
+            }
+        }
+        slot->in_use = 1;
+        return slot->buff;
+    }
+    return lwmem_malloc(size); /* All slots busy, fall back to plain heap allocation */
+}
+
+/**
+ * \brief           Release previously acquired scratch buffer
+ *
+ * Buffer stays retained for the next acquire on this thread
+ *
+ * \param[in]       ptr: Buffer returned by \ref lwmem_scratch_acquire.
+ *                      `NULL` pointer is valid input
+ */
+void
+lwmem_scratch_release(void* ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    for (size_t idx = 0; idx < LWMEM_SCRATCH_DEPTH; ++idx) {
+        if (scratch_slots[idx].buff == ptr && scratch_slots[idx].in_use) {
+            scratch_slots[idx].in_use = 0;
+            return;
+        }
+    }
+    lwmem_free(ptr); /* Overflow allocation from busy-slots fallback */
+}
+
+/**
+ * \brief           Return all retained buffers of this thread back to the heap
+ *
+ * Call before thread termination, or when the thread is done
+ * with its scratch-heavy phase and memory should be reclaimed
+ */
+void
+lwmem_scratch_trim(void) {
+    for (size_t idx = 0; idx < LWMEM_SCRATCH_DEPTH; ++idx) {
+        if (!scratch_slots[idx].in_use) {
+            lwmem_free(scratch_slots[idx].buff);
+            scratch_slots[idx].buff = NULL;
+            scratch_slots[idx].size = 0;
+        }
+    }
+}
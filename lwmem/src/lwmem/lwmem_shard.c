@@ -0,0 +1,192 @@
+/**
+ * \file            lwmem_shard.c
+ * \brief           Sharded heap router for multi-core systems
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_shard.h"
+#include <string.h>
+
+/**
+ * \brief           Check if pointer belongs to any region of the shard
+ * \param[in]       shard: Shard to check
+ * \param[in]       ptr: Pointer to check
+ * \return          `1` when pointer is within shard regions, `0` otherwise
+ */
+static uint8_t
+prv_shard_owns(const lwmem_shard_t* shard, const void* ptr) {
+    for (const lwmem_region_t* region = shard->regions; region != NULL && region->size > 0 && region->start_addr != NULL;
+         ++region) {
+        if ((const uint8_t*)ptr >= (const uint8_t*)region->start_addr
+            && (const uint8_t*)ptr < ((const uint8_t*)region->start_addr + region->size)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \brief           Initialize router and assign regions of every shard
+ *
+ * Each shard must have its `regions` member set to its (NULL-terminated)
+ * regions array before the call. One LwMEM instance is initialized per shard,
+ * so cores (or tasks) routed to different shards never contend on a single lock
+ *
+ * \param[in]       router: Router instance to initialize
+ * \param[in]       shards: Array of shard entries with regions filled-in.
+ *                      Instances are zero-initialized by this function
+ * \param[in]       count: Number of shards in the array
+ * \param[in]       select_fn: Shard selection callback, called on every allocation.
+ *                      Set to `NULL` to always use first shard
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_shard_init(lwmem_shard_router_t* router, lwmem_shard_t* shards, size_t count, lwmem_shard_select_fn select_fn) {
+    if (router == NULL || shards == NULL || count == 0) {
+        return 0;
+    }
+    for (size_t idx = 0; idx < count; ++idx) {
+        if (shards[idx].regions == NULL) {
+            return 0;
+        }
+        memset(&shards[idx].lwobj, 0x00, sizeof(shards[idx].lwobj));
+        if (lwmem_assignmem_ex(&shards[idx].lwobj, shards[idx].regions) == 0) {
+            return 0;
+        }
+    }
+    router->shards = shards;
+    router->count = count;
+    router->select_fn = select_fn;
+    return 1;
+}
+
+/**
+ * \brief           Allocate memory from shard selected by the router callback
+ *
+ * When selected shard cannot satisfy the request,
+ * remaining shards are tried in round-robin manner
+ *
+ * \param[in]       router: Router instance
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+void*
+lwmem_shard_malloc(lwmem_shard_router_t* router, size_t size) {
+    void* ptr = NULL;
+    size_t start_idx;
+
+    if (router == NULL || router->count == 0) {
+        return NULL;
+    }
+    start_idx = router->select_fn != NULL ? (router->select_fn() % router->count) : 0;
+    for (size_t offset = 0; offset < router->count && ptr == NULL; ++offset) {
+        ptr = lwmem_malloc_ex(&router->shards[(start_idx + offset) % router->count].lwobj, NULL, size);
+    }
+    return ptr;
+}
+
+/**
+ * \brief           Allocate zero-initialized memory from shard selected by the router callback
+ * \param[in]       router: Router instance
+ * \param[in]       nitems: Number of elements to be allocated
+ * \param[in]       size: Size of each element, in units of bytes
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+void*
+lwmem_shard_calloc(lwmem_shard_router_t* router, size_t nitems, size_t size) {
+    void* ptr = lwmem_shard_malloc(router, nitems * size);
+
+    if (ptr != NULL) {
+        memset(ptr, 0x00, nitems * size);
+    }
+    return ptr;
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Find LwMEM instance owning the pointer, by address range of shard regions
+ *
+ * Makes cross-shard free possible: memory allocated on one core
+ * may be freed from another one
+ *
+ * \param[in]       router: Router instance
+ * \param[in]       ptr: Pointer to look up
+ * \return          Owning LwMEM instance, `NULL` when pointer belongs to no shard
+ */
+lwmem_t*
+lwmem_shard_find_owner(lwmem_shard_router_t* router, const void* ptr) {
+    if (router != NULL && ptr != NULL) {
+        for (size_t idx = 0; idx < router->count; ++idx) {
+            if (prv_shard_owns(&router->shards[idx], ptr)) {
+                return &router->shards[idx].lwobj;
+            }
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Reallocate memory in its owning shard
+ * \param[in]       router: Router instance
+ * \param[in]       ptr: Memory block previously allocated through the router.
+ *                      It may be set to `NULL` to create new clean allocation
+ * \param[in]       size: Size of new memory to reallocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ */
+void*
+lwmem_shard_realloc(lwmem_shard_router_t* router, void* ptr, size_t size) {
+    lwmem_t* owner;
+
+    if (ptr == NULL) {
+        return lwmem_shard_malloc(router, size);
+    }
+    owner = lwmem_shard_find_owner(router, ptr);
+    if (owner == NULL) {
+        return NULL;
+    }
+    return lwmem_realloc_ex(owner, NULL, ptr, size);
+}
+
+/**
+ * \brief           Free memory in its owning shard
+ * \param[in]       router: Router instance
+ * \param[in]       ptr: Memory to free. `NULL` pointer is valid input
+ */
+void
+lwmem_shard_free(lwmem_shard_router_t* router, void* ptr) {
+    lwmem_t* owner = lwmem_shard_find_owner(router, ptr);
+
+    if (owner != NULL) {
+        lwmem_free_ex(owner, ptr);
+    }
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
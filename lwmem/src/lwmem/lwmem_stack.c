@@ -0,0 +1,213 @@
+/**
+ * \file            lwmem_stack.c
+ * \brief           Stack allocator with LIFO free order
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "lwmem/lwmem_stack.h"
+
+/**
+ * \brief           Transform alignment number (power of `2`) to bits
+ */
+#define LWMEM_ALIGN_BITS ((size_t)(((size_t)LWMEM_CFG_ALIGN_NUM) - 1))
+
+/**
+ * \brief           Aligns input value to next alignment bits
+ */
+#define LWMEM_ALIGN(x)   (((x) + (LWMEM_ALIGN_BITS)) & ~(LWMEM_ALIGN_BITS))
+
+/*
+ * Workloads freeing in exact reverse allocation order (expression evaluators,
+ * recursive descent parsers) need none of the free list machinery: push is a
+ * watermark bump, pop rewinds the watermark to the popped pointer. Both are a
+ * couple of instructions with no metadata written to the managed memory.
+ *
+ * LIFO order is a contract of the caller. Development builds (LWMEM_DEV)
+ * track outstanding pushes and reject out-of-order pops, release builds
+ * trust the caller completely.
+ */
+
+/**
+ * \brief           Initialize stack allocator on top of user provided region
+ * \param[in]       stack: Stack instance to initialize
+ * \param[in]       region: Region with address and size for stack memory.
+ *                      Memory must not be used by another allocator
+ * \return          `1` on success, `0` otherwise
+ * \note            Functions are not thread safe. Protect calls or use one stack per task
+ *                      when used with operating system
+ */
+uint8_t
+lwmem_stack_init(lwmem_stack_t* stack, const lwmem_region_t* region) {
+    uint8_t* mem_start_addr = NULL;
+    size_t mem_size = 0;
+
+    if (stack == NULL || region == NULL || region->start_addr == NULL || region->size == 0) {
+        return 0;
+    }
+
+    /* Align region start address and effective size to configuration */
+    mem_start_addr = region->start_addr;
+    mem_size = region->size;
+    if (((size_t)mem_start_addr) & LWMEM_ALIGN_BITS) { /* Check alignment boundary */
+        mem_start_addr += ((size_t)LWMEM_CFG_ALIGN_NUM) - ((size_t)mem_start_addr & LWMEM_ALIGN_BITS);
+        mem_size -= (size_t)(mem_start_addr - (uint8_t*)region->start_addr);
+    }
+    stack->lwobj = NULL;
+    stack->buff = mem_start_addr;
+    stack->size = mem_size;
+    lwmem_stack_reset(stack);
+    return 1;
+}
+
+/**
+ * \brief           Create stack allocator with backing buffer carved from LwMEM instance
+ * \param[in]       lwobj: LwMEM instance to allocate backing buffer from.
+ *                      Set to `NULL` to use default instance
+ * \param[in]       stack: Stack instance to initialize
+ * \param[in]       size: Stack size in units of bytes
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_stack_create_ex(lwmem_t* lwobj, lwmem_stack_t* stack, size_t size) {
+    if (stack == NULL || size == 0) {
+        return 0;
+    }
+    stack->buff = lwmem_malloc_ex(lwobj, NULL, size);
+    if (stack->buff == NULL) {
+        return 0;
+    }
+    stack->lwobj = lwobj;
+    stack->size = size;
+    lwmem_stack_reset(stack);
+    return 1;
+}
+
+/**
+ * \brief           Push new allocation on top of the stack
+ * \param[in]       stack: Stack instance, previously initialized
+ * \param[in]       size: Number of bytes to allocate
+ * \return          Pointer to allocated memory on success, `NULL` otherwise
+ * \note            Pop allocations in exact reverse order of pushes
+ */
+void*
+lwmem_stack_push(lwmem_stack_t* stack, size_t size) {
+    void* ptr = NULL;
+    size_t final_size;
+
+    if (stack == NULL || size == 0) {
+        return NULL;
+    }
+    final_size = LWMEM_ALIGN(size);
+    if (final_size < size || final_size > (stack->size - stack->offset)) {
+        return NULL;
+    }
+    ptr = &stack->buff[stack->offset];
+#if defined(LWMEM_DEV)
+    if (stack->dbg_depth < LWMEM_STACK_DBG_DEPTH) {
+        stack->dbg_marks[stack->dbg_depth] = stack->offset;
+    } else {
+        stack->dbg_overflow = 1; /* Tracking exceeded, enforcement stops being exact */
+    }
+    ++stack->dbg_depth;
+#endif /* defined(LWMEM_DEV) */
+    stack->offset += final_size;
+    return ptr;
+}
+
+/**
+ * \brief           Pop allocation from top of the stack
+ *
+ * Watermark rewinds to the popped pointer,
+ * memory above it becomes available for next push
+ *
+ * \param[in]       stack: Stack instance, the same as used during push
+ * \param[in]       ptr: Most recently pushed (and not yet popped) pointer
+ * \return          `1` on success, `0` when pop is rejected
+ * \note            Development builds (`LWMEM_DEV`) reject pops violating LIFO order,
+ *                      release builds trust the caller
+ */
+uint8_t
+lwmem_stack_pop(lwmem_stack_t* stack, void* ptr) {
+    if (stack == NULL || ptr == NULL || (uint8_t*)ptr < stack->buff
+        || (uint8_t*)ptr >= &stack->buff[stack->size]) {
+        return 0;
+    }
+#if defined(LWMEM_DEV)
+    if (stack->dbg_depth == 0) {
+        return 0; /* Nothing outstanding, double pop */
+    }
+    if (stack->dbg_depth <= LWMEM_STACK_DBG_DEPTH && !stack->dbg_overflow
+        && &stack->buff[stack->dbg_marks[stack->dbg_depth - 1]] != (uint8_t*)ptr) {
+        return 0; /* Not the most recent push, LIFO contract violated */
+    }
+    --stack->dbg_depth;
+    if (stack->dbg_depth == 0) {
+        stack->dbg_overflow = 0; /* Empty stack tracks exactly again */
+    }
+#endif /* defined(LWMEM_DEV) */
+    stack->offset = (size_t)((uint8_t*)ptr - stack->buff);
+    return 1;
+}
+
+/**
+ * \brief           Pop all allocations at once
+ * \param[in]       stack: Stack instance to reset
+ */
+void
+lwmem_stack_reset(lwmem_stack_t* stack) {
+    if (stack != NULL) {
+        stack->offset = 0;
+#if defined(LWMEM_DEV)
+        stack->dbg_depth = 0;
+        stack->dbg_overflow = 0;
+#endif /* defined(LWMEM_DEV) */
+    }
+}
+
+#if LWMEM_CFG_FULL || __DOXYGEN__
+
+/**
+ * \brief           Destroy stack created with \ref lwmem_stack_create_ex
+ *                      and return backing buffer to the heap
+ * \param[in]       stack: Stack instance to destroy
+ */
+void
+lwmem_stack_destroy(lwmem_stack_t* stack) {
+    if (stack != NULL) {
+        if (stack->buff != NULL) {
+            lwmem_free_ex(stack->lwobj, stack->buff);
+        }
+        stack->buff = NULL;
+        stack->size = 0;
+        lwmem_stack_reset(stack);
+    }
+}
+
+#endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
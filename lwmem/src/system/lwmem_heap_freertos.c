@@ -0,0 +1,109 @@
+/**
+ * \file            lwmem_heap_freertos.c
+ * \brief           FreeRTOS heap port routed into LwMEM
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+/*
+ * Drop-in replacement for FreeRTOS heap_x.c memory implementations.
+ *
+ * Compile this file instead of heap_1..heap_5.c to route kernel
+ * pvPortMalloc/vPortFree calls into LwMEM, so kernel allocations benefit
+ * from LwMEM coalescing and allocation strategies. Heap memory itself is
+ * a static array of configTOTAL_HEAP_SIZE bytes, managed by a dedicated
+ * LwMEM instance, so the application default instance stays untouched.
+ */
+#include "lwmem/lwmem.h"
+
+/* Include FreeRTOS API module */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if !LWMEM_CFG_FULL
+#error "lwmem_heap_freertos.c requires LWMEM_CFG_FULL, kernel objects must support vPortFree"
+#endif
+
+/* Kernel heap memory and LwMEM instance managing it */
+static uint8_t kernel_heap[configTOTAL_HEAP_SIZE];
+static lwmem_t kernel_lwobj;
+
+/**
+ * \brief           Initialize LwMEM instance over the static kernel heap, on very first use
+ */
+static void
+prv_init_once(void) {
+    static uint8_t initialized = 0;
+
+    if (!initialized) {
+        static const lwmem_region_t regions[] = {
+            {kernel_heap, sizeof(kernel_heap)},
+            {NULL, 0},
+        };
+
+        initialized = lwmem_assignmem_ex(&kernel_lwobj, regions) > 0;
+    }
+}
+
+void*
+pvPortMalloc(size_t xWantedSize) {
+    void* ptr;
+
+    vTaskSuspendAll();
+    prv_init_once();
+    ptr = lwmem_malloc_ex(&kernel_lwobj, NULL, xWantedSize);
+    (void)xTaskResumeAll();
+
+#if (configUSE_MALLOC_FAILED_HOOK == 1)
+    if (ptr == NULL) {
+        extern void vApplicationMallocFailedHook(void);
+        vApplicationMallocFailedHook();
+    }
+#endif /* configUSE_MALLOC_FAILED_HOOK == 1 */
+    return ptr;
+}
+
+void
+vPortFree(void* pv) {
+    if (pv != NULL) {
+        vTaskSuspendAll();
+        lwmem_free_ex(&kernel_lwobj, pv);
+        (void)xTaskResumeAll();
+    }
+}
+
+size_t
+xPortGetFreeHeapSize(void) {
+    return kernel_lwobj.mem_available_bytes;
+}
+
+void
+vPortInitialiseBlocks(void) {
+    /* Nothing to do, instance is initialized on first allocation */
+}
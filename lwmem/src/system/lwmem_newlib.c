@@ -0,0 +1,95 @@
+/**
+ * \file            lwmem_newlib.c
+ * \brief           Newlib/picolibc malloc retargeting over LwMEM
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+/*
+ * Retargets the newlib (and picolibc) reentrant allocation entry points onto
+ * the default LwMEM instance, so printf and libc internals share the single
+ * audited heap - no more _sbrk dance and no second heap fighting over RAM,
+ * and libc allocations appear in LwMEM statistics and tracing.
+ *
+ * Compile this file instead of providing _sbrk (enable with the
+ * LWMEM_NEWLIB_RETARGET CMake option). Locking is delegated to the LwMEM
+ * instance itself, therefore the malloc-lock hooks are satisfied as no-ops.
+ */
+#include "lwmem/lwmem.h"
+
+#if defined(__NEWLIB__) || defined(__PICOLIBC__)
+
+#include <reent.h>
+
+void*
+_malloc_r(struct _reent* reent, size_t size) {
+    (void)reent;
+    return lwmem_malloc_ex(NULL, NULL, size);
+}
+
+void*
+_calloc_r(struct _reent* reent, size_t nitems, size_t size) {
+    (void)reent;
+    return lwmem_calloc_ex(NULL, NULL, nitems, size);
+}
+
+void*
+_realloc_r(struct _reent* reent, void* ptr, size_t size) {
+    (void)reent;
+#if LWMEM_CFG_FULL && LWMEM_CFG_SUPPORT_REALLOC
+    return lwmem_realloc_ex(NULL, NULL, ptr, size);
+#else
+    (void)ptr;
+    (void)size;
+    return NULL;
+#endif
+}
+
+void
+_free_r(struct _reent* reent, void* ptr) {
+    (void)reent;
+#if LWMEM_CFG_FULL
+    lwmem_free_ex(NULL, ptr);
+#else
+    (void)ptr;
+#endif
+}
+
+/* LwMEM locks internally, libc-level locking is redundant */
+void
+__malloc_lock(struct _reent* reent) {
+    (void)reent;
+}
+
+void
+__malloc_unlock(struct _reent* reent) {
+    (void)reent;
+}
+
+#endif /* defined(__NEWLIB__) || defined(__PICOLIBC__) */
@@ -0,0 +1,107 @@
+/**
+ * \file            lwmem_sys_baremetal.c
+ * \brief           System functions for OS-less builds with nestable interrupt masking
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "system/lwmem_sys.h"
+
+#if LWMEM_CFG_OS && !__DOXYGEN__
+
+/*
+ * Bare-metal "port": the mutex contract is implemented as nestable
+ * interrupt masking, making ISR-side allocation safe without an RTOS.
+ *
+ * Application provides the CPU specific mask/restore operations:
+ *
+ * #define LWMEM_SYS_IRQ_SAVE()         my_irq_save()       // returns previous state
+ * #define LWMEM_SYS_IRQ_RESTORE(s)     my_irq_restore(s)
+ *
+ * (PRIMASK read + cpsid on Cortex-M, gintsts on other cores, ...).
+ * Nesting depth and the outermost saved state live in the 64-bit handle:
+ *
+ * #define LWMEM_CFG_OS_MUTEX_HANDLE    uint64_t
+ */
+
+#if !defined(LWMEM_SYS_IRQ_SAVE) || !defined(LWMEM_SYS_IRQ_RESTORE)
+#error "Define LWMEM_SYS_IRQ_SAVE/LWMEM_SYS_IRQ_RESTORE to use the baremetal port"
+#endif
+
+uint8_t
+lwmem_sys_mutex_create(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    *m = 0;
+    return 1;
+}
+
+uint8_t
+lwmem_sys_mutex_isvalid(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    (void)m;
+    return 0; /* Nothing is ever created, handle is always ready */
+}
+
+uint8_t
+lwmem_sys_mutex_wait(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    uint32_t state = (uint32_t)LWMEM_SYS_IRQ_SAVE();
+    uint32_t depth = (uint32_t)(*m >> 32);
+
+    if (depth == 0) { /* Outermost entry remembers the previous interrupt state */
+        *m = ((uint64_t)1 << 32) | state;
+    } else {
+        *m = ((uint64_t)(depth + 1) << 32) | (uint32_t)*m;
+    }
+    return 1;
+}
+
+uint8_t
+lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    uint32_t depth = (uint32_t)(*m >> 32);
+
+    if (depth <= 1) { /* Outermost exit restores the saved interrupt state */
+        uint32_t state = (uint32_t)*m;
+
+        *m = 0;
+        LWMEM_SYS_IRQ_RESTORE(state);
+    } else {
+        *m = ((uint64_t)(depth - 1) << 32) | (uint32_t)*m;
+    }
+    return 1;
+}
+
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    (void)timeout_ms; /* Interrupt masking can always be entered immediately */
+    return lwmem_sys_mutex_wait(m);
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
+#endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
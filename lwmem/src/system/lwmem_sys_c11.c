@@ -0,0 +1,133 @@
+/**
+ * \file            lwmem_sys_c11.c
+ * \brief           System functions based on C11 atomics spinlock
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "system/lwmem_sys.h"
+
+#if LWMEM_CFG_OS && !__DOXYGEN__
+
+#include <stdatomic.h>
+
+/*
+ * Portable port for any toolchain with C11 <stdatomic.h> support,
+ * including bare-metal multi-core (AMP/SMP) systems without an RTOS.
+ *
+ * Lock is an atomic_flag based spinlock with exponential backoff,
+ * which keeps the inter-core cache-line ping-pong low under contention.
+ *
+ * To use this module, options must be defined as
+ *
+ * #define LWMEM_CFG_OS_MUTEX_HANDLE void*
+ */
+
+/**
+ * \brief           Maximal number of mutexes (LwMEM instances) supported by the port
+ */
+#ifndef LWMEM_SYS_C11_MAX_MUTEXES
+#define LWMEM_SYS_C11_MAX_MUTEXES 4
+#endif
+
+/**
+ * \brief           Upper bound of the exponential backoff spin count
+ */
+#ifndef LWMEM_SYS_C11_MAX_BACKOFF
+#define LWMEM_SYS_C11_MAX_BACKOFF 1024
+#endif
+
+/* Static pool of locks, one entry per created mutex */
+static atomic_flag lock_pool[LWMEM_SYS_C11_MAX_MUTEXES];
+static atomic_uint lock_pool_used;
+
+uint8_t
+lwmem_sys_mutex_create(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    unsigned int idx = atomic_fetch_add(&lock_pool_used, 1);
+
+    if (idx >= LWMEM_SYS_C11_MAX_MUTEXES) {
+        return 0;
+    }
+    atomic_flag_clear(&lock_pool[idx]);
+    *m = &lock_pool[idx];
+    return 1;
+}
+
+uint8_t
+lwmem_sys_mutex_isvalid(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    return *m != NULL;
+}
+
+uint8_t
+lwmem_sys_mutex_wait(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    atomic_flag* flag = *m;
+    uint32_t backoff = 1;
+
+    while (atomic_flag_test_and_set_explicit(flag, memory_order_acquire)) {
+        /* Busy wait with exponential backoff to reduce contention */
+        for (volatile uint32_t i = 0; i < backoff; ++i) {}
+        if (backoff < LWMEM_SYS_C11_MAX_BACKOFF) {
+            backoff <<= 1;
+        }
+    }
+    return 1;
+}
+
+uint8_t
+lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    atomic_flag_clear_explicit((atomic_flag*)*m, memory_order_release);
+    return 1;
+}
+
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    atomic_flag* flag = *m;
+    uint32_t backoff = 1;
+
+    /*
+     * Port has no time source, therefore timeout is approximated
+     * with a bounded number of spin rounds proportional to requested time
+     */
+    for (uint32_t round = 0; round <= timeout_ms * 1000; ++round) {
+        if (!atomic_flag_test_and_set_explicit(flag, memory_order_acquire)) {
+            return 1;
+        }
+        for (volatile uint32_t i = 0; i < backoff; ++i) {}
+        if (backoff < LWMEM_SYS_C11_MAX_BACKOFF) {
+            backoff <<= 1;
+        }
+    }
+    return 0;
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
+#endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
@@ -60,4 +60,13 @@ lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
     return osMutexRelease(*m) == osOK;
 }
 
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    return osMutexAcquire(*m, timeout_ms) == osOK;
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
 #endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
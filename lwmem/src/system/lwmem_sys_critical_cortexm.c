@@ -0,0 +1,110 @@
+/**
+ * \file            lwmem_sys_critical_cortexm.c
+ * \brief           System functions for Cortex-M critical section (IRQ masking)
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "system/lwmem_sys.h"
+
+#if LWMEM_CFG_OS && !__DOXYGEN__
+
+/*
+ * Alternative locking backend using a short critical section instead of an
+ * RTOS mutex. Suitable when allocations are sub-microsecond and mutex
+ * take/give would dominate the cost. Protection is implemented with PRIMASK
+ * masking by default, or BASEPRI when LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO
+ * is defined to a non-zero priority (not available on ARMv6-M cores).
+ *
+ * Define mutex handle type as 32-bit value, where saved interrupt state
+ * of the current critical section is stored:
+ *
+ * #define LWMEM_CFG_OS_MUTEX_HANDLE uint32_t
+ */
+
+#if !defined(__GNUC__) && !defined(__clang__)
+#error "lwmem_sys_critical_cortexm.c supports GCC-compatible inline assembly only"
+#endif
+
+uint8_t
+lwmem_sys_mutex_create(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    *m = 1; /* No object to create, mark handle as valid */
+    return 1;
+}
+
+uint8_t
+lwmem_sys_mutex_isvalid(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    return *m != 0;
+}
+
+uint8_t
+lwmem_sys_mutex_wait(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    uint32_t state;
+
+#if defined(LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO) && LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO > 0
+    uint32_t new_state = LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO;
+
+    __asm volatile("mrs %0, basepri" : "=r"(state)::"memory");
+    __asm volatile("msr basepri, %0" ::"r"(new_state) : "memory");
+#else  /* LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO */
+    __asm volatile("mrs %0, primask" : "=r"(state)::"memory");
+    __asm volatile("cpsid i" ::: "memory");
+#endif /* !LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO */
+
+    /* Keep valid bit and store saved interrupt state for release call */
+    *m = 0x01U | (state << 1);
+    return 1;
+}
+
+uint8_t
+lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    uint32_t state = *m >> 1;
+
+#if defined(LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO) && LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO > 0
+    __asm volatile("msr basepri, %0" ::"r"(state) : "memory");
+#else  /* LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO */
+    if (state == 0) {
+        __asm volatile("cpsie i" ::: "memory");
+    }
+#endif /* !LWMEM_CFG_CRITICAL_SECTION_BASEPRI_PRIO */
+    *m = 0x01U; /* Keep handle valid for next critical section */
+    return 1;
+}
+
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    (void)timeout_ms; /* Critical section can always be entered immediately */
+    return lwmem_sys_mutex_wait(m);
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
+#endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
@@ -0,0 +1,113 @@
+/**
+ * \file            lwmem_sys_posix.c
+ * \brief           System functions for POSIX threads
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwMEM - Lightweight dynamic memory manager library.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v2.2.1
+ */
+#include "system/lwmem_sys.h"
+
+#if LWMEM_CFG_OS && !__DOXYGEN__
+
+/*
+ * POSIX port for Linux-hosted simulators and hardware-in-the-loop rigs.
+ *
+ * Define LWMEM_SYS_POSIX_ADAPTIVE to use the glibc adaptive mutex type,
+ * which spins briefly before sleeping - a better fit for short contended
+ * allocation bursts than the default sleeping mutex.
+ *
+ * To use this module, options must be defined as
+ *
+ * #define LWMEM_CFG_OS_MUTEX_HANDLE        pthread_mutex_t
+ */
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+uint8_t
+lwmem_sys_mutex_create(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    pthread_mutexattr_t attr;
+
+    if (pthread_mutexattr_init(&attr) != 0) {
+        return 0;
+    }
+#if defined(LWMEM_SYS_POSIX_ADAPTIVE) && defined(PTHREAD_MUTEX_ADAPTIVE_NP)
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ADAPTIVE_NP);
+#else
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_NORMAL);
+#endif
+    return pthread_mutex_init(m, &attr) == 0;
+}
+
+uint8_t
+lwmem_sys_mutex_isvalid(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    /* Zero-initialized instance memory means mutex has not been created yet */
+    static const pthread_mutex_t zero_mutex;
+
+    return memcmp(m, &zero_mutex, sizeof(zero_mutex)) != 0;
+}
+
+uint8_t
+lwmem_sys_mutex_wait(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    return pthread_mutex_lock(m) == 0;
+}
+
+uint8_t
+lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
+    return pthread_mutex_unlock(m) == 0;
+}
+
+#if LWMEM_CFG_TASK_OWNERSHIP
+
+void*
+lwmem_sys_get_current_task(void) {
+    return (void*)pthread_self();
+}
+
+#endif /* LWMEM_CFG_TASK_OWNERSHIP */
+
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (long)(timeout_ms % 1000) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_nsec -= 1000000000L;
+        ++ts.tv_sec;
+    }
+    return pthread_mutex_timedlock(m, &ts) == 0;
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
+#endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
@@ -39,8 +39,20 @@
  * To use this module, options must be defined as
  *
  * #define LWMEM_CFG_OS_MUTEX_HANDLE        TX_MUTEX
+ *
+ * Priority inheritance is enabled by default, preventing a low-priority
+ * lock holder from blocking deadline threads - the classic heap-lock
+ * priority inversion, which on ThreadX SMP additionally shows up as a
+ * spinning high-priority thread starving the holder on another core.
+ * Define LWMEM_SYS_THREADX_INHERIT to TX_NO_INHERIT (or a ceiling-based
+ * wrapper of your kernel) when the inheritance bookkeeping cost is not
+ * wanted on uncontended single-core builds.
  */
 
+#ifndef LWMEM_SYS_THREADX_INHERIT
+#define LWMEM_SYS_THREADX_INHERIT TX_INHERIT
+#endif
+
 /* Include ThreadX API module */
 #include "tx_api.h"
 #include "tx_mutex.h"
@@ -48,7 +60,7 @@
 uint8_t
 lwmem_sys_mutex_create(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
     static char name[] = "lwmem_mutex";
-    return tx_mutex_create(m, name, TX_INHERIT) == TX_SUCCESS;
+    return tx_mutex_create(m, name, LWMEM_SYS_THREADX_INHERIT) == TX_SUCCESS;
 }
 
 uint8_t
@@ -66,4 +78,13 @@ lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
     return tx_mutex_put(m) == TX_SUCCESS;
 }
 
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    return tx_mutex_get(m, (ULONG)((timeout_ms * TX_TIMER_TICKS_PER_SECOND) / 1000)) == TX_SUCCESS;
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
 #endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
@@ -59,4 +59,13 @@ lwmem_sys_mutex_release(LWMEM_CFG_OS_MUTEX_HANDLE* m) {
     return 1;
 }
 
+#if LWMEM_CFG_OS_MUTEX_TIMEOUT
+
+uint8_t
+lwmem_sys_mutex_wait_timeout(LWMEM_CFG_OS_MUTEX_HANDLE* m, uint32_t timeout_ms) {
+    return WaitForSingleObject(*m, timeout_ms) == WAIT_OBJECT_0;
+}
+
+#endif /* LWMEM_CFG_OS_MUTEX_TIMEOUT */
+
 #endif /* LWMEM_CFG_OS && !__DOXYGEN__ */
@@ -0,0 +1,53 @@
+/**
+ * \file            FreeRTOS.h
+ * \brief           Minimal host-build shim for benchmarking bundled FreeRTOS heap_x.c files
+ *
+ * Provides just enough of the kernel configuration and portable macros for
+ * examples/lib/FreeRTOS/portable/MemMang/heap_2/4/5.c to compile on a host,
+ * so their allocators can be benchmarked head-to-head against LwMEM without
+ * pulling in the full kernel.
+ */
+#ifndef FREERTOS_BENCH_SHIM_H
+#define FREERTOS_BENCH_SHIM_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configTOTAL_HEAP_SIZE            (256 * 1024)
+#define configAPPLICATION_ALLOCATED_HEAP 0
+#define configUSE_MALLOC_FAILED_HOOK     0
+#define configASSERT(x)                  assert(x)
+
+#define portBYTE_ALIGNMENT               8
+#define portBYTE_ALIGNMENT_MASK          (portBYTE_ALIGNMENT - 1)
+#define portPOINTER_SIZE_TYPE            size_t
+#define portMAX_DELAY                    (~(size_t)0)
+
+#define PRIVILEGED_FUNCTION
+#define PRIVILEGED_DATA
+
+#define traceMALLOC(ptr, size)
+#define traceFREE(ptr, size)
+#define mtCOVERAGE_TEST_MARKER()
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+#define pdTRUE  1
+#define pdFALSE 0
+
+/* Used by heap_5.c multi-region setup */
+typedef struct HeapRegion {
+    uint8_t* pucStartAddress;
+    size_t xSizeInBytes;
+} HeapRegion_t;
+
+void* pvPortMalloc(size_t xWantedSize);
+void vPortFree(void* pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+void vPortInitialiseBlocks(void);
+void vPortDefineHeapRegions(const HeapRegion_t* pxHeapRegions);
+
+#endif /* FREERTOS_BENCH_SHIM_H */
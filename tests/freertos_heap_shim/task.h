@@ -0,0 +1,17 @@
+/**
+ * \file            task.h
+ * \brief           Minimal host-build shim for benchmarking bundled FreeRTOS heap_x.c files
+ */
+#ifndef FREERTOS_BENCH_SHIM_TASK_H
+#define FREERTOS_BENCH_SHIM_TASK_H
+
+/* Scheduler suspension is meaningless in the single-threaded host benchmark */
+static inline void
+vTaskSuspendAll(void) {}
+
+static inline long
+xTaskResumeAll(void) {
+    return 0;
+}
+
+#endif /* FREERTOS_BENCH_SHIM_TASK_H */
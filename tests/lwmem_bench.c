@@ -0,0 +1,179 @@
+/**
+ * \file            lwmem_bench.c
+ * \brief           Benchmark suite with canonical allocation workloads
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwmem/lwmem.h"
+#include "lwmem_workload.h"
+
+/* Heap under test */
+#define BENCH_HEAP_SIZE (256 * 1024)
+#define BENCH_SLOTS     256
+#define BENCH_OPS       200000
+
+static unsigned char bench_heap[BENCH_HEAP_SIZE];
+static lwmem_region_t bench_regions[] = {
+    {bench_heap, sizeof(bench_heap)},
+    {NULL, 0},
+};
+
+static void* slots[BENCH_SLOTS];
+static uint64_t samples[BENCH_OPS];
+static lwmem_wl_t workload;
+
+static uint64_t
+prv_now_ns(void) {
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+    return (uint64_t)clock() * (1000000000ULL / CLOCKS_PER_SEC);
+#endif
+}
+
+static int
+prv_cmp_u64(const void* in_a, const void* in_b) {
+    const uint64_t a = *(const uint64_t*)in_a, b = *(const uint64_t*)in_b;
+
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static void
+prv_report(const char* name, size_t count, uint64_t total_ns) {
+    qsort(samples, count, sizeof(samples[0]), prv_cmp_u64);
+    printf("%-20s %10.0f ops/s   p50 %6llu ns   p99 %6llu ns   worst %8llu ns\n", name,
+           count / (total_ns / 1e9), (unsigned long long)samples[count / 2],
+           (unsigned long long)samples[(count * 99) / 100], (unsigned long long)samples[count - 1]);
+}
+
+static void
+prv_drain(void) {
+    for (size_t i = 0; i < BENCH_SLOTS; ++i) {
+        if (slots[i] != NULL) {
+            lwmem_free(slots[i]);
+            slots[i] = NULL;
+        }
+    }
+}
+
+/* Workload: uniform small allocations with random frees */
+static void
+bench_uniform_small(void) {
+    uint64_t total = 0;
+    size_t count = 0;
+
+    lwmem_wl_init(&workload, LWMEM_WL_FIXED, 0x1234567, 32, 32);
+    for (size_t op = 0; op < BENCH_OPS; ++op) {
+        const size_t idx = lwmem_wl_rand(&workload) % BENCH_SLOTS;
+        const uint64_t start = prv_now_ns();
+
+        if (slots[idx] == NULL) {
+            slots[idx] = lwmem_malloc(lwmem_wl_next_size(&workload));
+        } else {
+            lwmem_free(slots[idx]);
+            slots[idx] = NULL;
+        }
+        samples[count] = prv_now_ns() - start;
+        total += samples[count++];
+    }
+    prv_drain();
+    prv_report("uniform-small", count, total);
+}
+
+/* Workload: mixed sizes from 16 bytes to 4 kB */
+static void
+bench_mixed_sizes(void) {
+    uint64_t total = 0;
+    size_t count = 0;
+
+    lwmem_wl_init(&workload, LWMEM_WL_UNIFORM, 0x89ABCDEF, 16, 4096);
+    for (size_t op = 0; op < BENCH_OPS; ++op) {
+        const size_t idx = lwmem_wl_rand(&workload) % BENCH_SLOTS;
+        const size_t size = lwmem_wl_next_size(&workload);
+        const uint64_t start = prv_now_ns();
+
+        if (slots[idx] == NULL) {
+            slots[idx] = lwmem_malloc(size);
+        } else {
+            lwmem_free(slots[idx]);
+            slots[idx] = NULL;
+        }
+        samples[count] = prv_now_ns() - start;
+        total += samples[count++];
+    }
+    prv_drain();
+    prv_report("mixed-sizes", count, total);
+}
+
+/* Workload: producer/consumer churn, FIFO lifetime of fixed batches */
+static void
+bench_churn(void) {
+    uint64_t total = 0;
+    size_t count = 0, head = 0, tail = 0;
+
+    lwmem_wl_init(&workload, LWMEM_WL_UNIFORM, 0x2468ACE, 64, 256);
+    for (size_t op = 0; op < BENCH_OPS; ++op) {
+        const uint64_t start = prv_now_ns();
+
+        if (((head + 1) % BENCH_SLOTS) != tail) { /* Produce */
+            slots[head] = lwmem_malloc(lwmem_wl_next_size(&workload));
+            head = (head + 1) % BENCH_SLOTS;
+        }
+        if ((op % 2) == 0 && head != tail) { /* Consume every other round */
+            lwmem_free(slots[tail]);
+            slots[tail] = NULL;
+            tail = (tail + 1) % BENCH_SLOTS;
+        }
+        samples[count] = prv_now_ns() - start;
+        total += samples[count++];
+    }
+    prv_drain();
+    prv_report("churn-fifo", count, total);
+}
+
+/* Workload: realloc-grow chains, as produced by string/buffer builders */
+static void
+bench_realloc_grow(void) {
+    uint64_t total = 0;
+    size_t count = 0;
+    void* buf = NULL;
+    size_t size = 16;
+
+    for (size_t op = 0; op < BENCH_OPS; ++op) {
+        const uint64_t start = prv_now_ns();
+
+        buf = lwmem_realloc(buf, size);
+        samples[count] = prv_now_ns() - start;
+        total += samples[count++];
+
+        size += 16 + (size / 8); /* Geometric-ish growth */
+        if (buf == NULL || size > 32768) {
+            lwmem_free(buf);
+            buf = NULL;
+            size = 16;
+        }
+    }
+    lwmem_free(buf);
+    prv_report("realloc-grow", count, total);
+}
+
+int
+main(void) {
+    if (lwmem_assignmem(bench_regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        return 1;
+    }
+    printf("lwmem_bench: heap %u kB, %u ops per workload, strategy %d\n\n", (unsigned)(BENCH_HEAP_SIZE / 1024),
+           (unsigned)BENCH_OPS, (int)LWMEM_CFG_ALLOC_STRATEGY);
+    bench_uniform_small();
+    bench_mixed_sizes();
+    bench_churn();
+    bench_realloc_grow();
+    return 0;
+}
@@ -0,0 +1,117 @@
+/**
+ * \file            lwmem_contention.c
+ * \brief           Multithreaded contention benchmark for the locked allocation path
+ *
+ * Spawns N threads hammering a single instance through the LWMEM_CFG_OS
+ * locking path and reports aggregate throughput and per-thread latency
+ * distribution versus thread count, so locking-scheme scaling regressions
+ * are visible before release. Uses the portable C11 spinlock port.
+ */
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwmem/lwmem.h"
+
+#define HEAP_SIZE       (512 * 1024)
+#define OPS_PER_THREAD  100000
+#define MAX_THREADS     16
+#define SLOTS_PER_TH    64
+
+static unsigned char heap_mem[HEAP_SIZE];
+static lwmem_region_t regions[] = {
+    {heap_mem, sizeof(heap_mem)},
+    {NULL, 0},
+};
+
+static uint64_t samples[MAX_THREADS][OPS_PER_THREAD];
+
+static uint64_t
+prv_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int
+prv_cmp_u64(const void* in_a, const void* in_b) {
+    const uint64_t a = *(const uint64_t*)in_a, b = *(const uint64_t*)in_b;
+
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+static void*
+prv_worker(void* arg) {
+    const size_t tid = (size_t)(uintptr_t)arg;
+    void* slots[SLOTS_PER_TH] = {0};
+    uint32_t rng = 0x1234567 + (uint32_t)tid;
+
+    for (size_t op = 0; op < OPS_PER_THREAD; ++op) {
+        const uint64_t start = prv_now_ns();
+        size_t idx;
+
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        idx = rng % SLOTS_PER_TH;
+        if (slots[idx] == NULL) {
+            slots[idx] = lwmem_malloc(16 + (rng % 240));
+        } else {
+            lwmem_free(slots[idx]);
+            slots[idx] = NULL;
+        }
+        samples[tid][op] = prv_now_ns() - start;
+    }
+    for (size_t i = 0; i < SLOTS_PER_TH; ++i) {
+        lwmem_free(slots[i]);
+    }
+    return NULL;
+}
+
+static void
+prv_run(size_t nthreads) {
+    pthread_t threads[MAX_THREADS];
+    uint64_t start, total_ns;
+
+    start = prv_now_ns();
+    for (size_t i = 0; i < nthreads; ++i) {
+        pthread_create(&threads[i], NULL, prv_worker, (void*)(uintptr_t)i);
+    }
+    for (size_t i = 0; i < nthreads; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+    total_ns = prv_now_ns() - start;
+
+    printf("%2zu threads: %10.0f ops/s aggregate", nthreads, (nthreads * (double)OPS_PER_THREAD) / (total_ns / 1e9));
+    for (size_t i = 0; i < nthreads; ++i) {
+        qsort(samples[i], OPS_PER_THREAD, sizeof(samples[0][0]), prv_cmp_u64);
+    }
+    printf("   t0: p50 %llu ns p99 %llu ns worst %llu ns\n", (unsigned long long)samples[0][OPS_PER_THREAD / 2],
+           (unsigned long long)samples[0][(OPS_PER_THREAD * 99) / 100],
+           (unsigned long long)samples[0][OPS_PER_THREAD - 1]);
+}
+
+int
+main(int argc, char** argv) {
+    if (lwmem_assignmem(regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        return 1;
+    }
+    if (argc > 1) {
+        size_t nthreads = (size_t)atoi(argv[1]);
+
+        if (nthreads == 0 || nthreads > MAX_THREADS) {
+            fprintf(stderr, "thread count must be 1..%d\n", MAX_THREADS);
+            return 1;
+        }
+        prv_run(nthreads);
+    } else {
+        for (size_t nthreads = 1; nthreads <= 8; nthreads *= 2) {
+            prv_run(nthreads);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**
+ * \file            lwmem_frag_stress.c
+ * \brief           Adversarial fragmentation stress generator with measurable outcome
+ *
+ * Drives the heap through interleaved alloc/free patterns known to shred
+ * first-fit heaps (sawtooth sizes, checkerboard frees, split-remainder
+ * pathologies) and periodically reports free bytes, largest free block and
+ * the resulting fragmentation ratio, so allocation policies can be compared
+ * with reproducible numbers before field deployment.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "lwmem/lwmem.h"
+#include "lwmem_workload.h"
+
+#define HEAP_SIZE (128 * 1024)
+#define SLOTS     512
+#define ROUNDS    200
+
+static unsigned char heap_mem[HEAP_SIZE];
+static lwmem_region_t regions[] = {
+    {heap_mem, sizeof(heap_mem)},
+    {NULL, 0},
+};
+static void* slots[SLOTS];
+static lwmem_wl_t workload;
+
+static void
+prv_report(const char* phase, int round) {
+    lwmem_stats_t stats;
+
+    lwmem_get_stats_ex(NULL, &stats);
+    printf("%s,%d,%u,%u,%u\n", phase, round, (unsigned)stats.mem_available_bytes,
+           (unsigned)stats.largest_free_block_bytes, (unsigned)stats.fragmentation_pct);
+}
+
+static void
+prv_free_all(void) {
+    for (size_t i = 0; i < SLOTS; ++i) {
+        if (slots[i] != NULL) {
+            lwmem_free(slots[i]);
+            slots[i] = NULL;
+        }
+    }
+}
+
+/* Sawtooth: rising sizes allocated, every other one freed, repeat shifted */
+static void
+phase_sawtooth(void) {
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < SLOTS; ++i) {
+            if (slots[i] == NULL) {
+                slots[i] = lwmem_malloc(16 + (i % 64) * 8);
+            }
+        }
+        for (size_t i = round % 2; i < SLOTS; i += 2) {
+            lwmem_free(slots[i]);
+            slots[i] = NULL;
+        }
+        if ((round % 50) == 0) {
+            prv_report("sawtooth", round);
+        }
+    }
+    prv_free_all();
+    prv_report("sawtooth-end", ROUNDS);
+}
+
+/* Split pathology: large blocks trimmed down so remainders barely split */
+static void
+phase_split_churn(void) {
+    for (int round = 0; round < ROUNDS; ++round) {
+        for (size_t i = 0; i < SLOTS / 2; ++i) {
+            if (slots[i] == NULL) {
+                slots[i] = lwmem_malloc(512 + (lwmem_wl_rand(&workload) % 64));
+            }
+        }
+        /* Free in random order, re-allocate slightly smaller to force splits */
+        for (size_t i = 0; i < SLOTS / 2; ++i) {
+            size_t idx = lwmem_wl_rand(&workload) % (SLOTS / 2);
+
+            if (slots[idx] != NULL) {
+                lwmem_free(slots[idx]);
+                slots[idx] = lwmem_malloc(480 - (lwmem_wl_rand(&workload) % 440));
+            }
+        }
+        if ((round % 50) == 0) {
+            prv_report("split-churn", round);
+        }
+    }
+    prv_free_all();
+    prv_report("split-churn-end", ROUNDS);
+}
+
+/* Random mixed load as baseline */
+static void
+phase_random(void) {
+    for (int round = 0; round < ROUNDS * 100; ++round) {
+        size_t idx = lwmem_wl_rand(&workload) % SLOTS;
+
+        if (slots[idx] == NULL) {
+            slots[idx] = lwmem_malloc(16 + (lwmem_wl_rand(&workload) % 1024));
+        } else {
+            lwmem_free(slots[idx]);
+            slots[idx] = NULL;
+        }
+        if ((round % 5000) == 0) {
+            prv_report("random", round);
+        }
+    }
+    prv_free_all();
+    prv_report("random-end", ROUNDS * 100);
+}
+
+int
+main(void) {
+    if (lwmem_assignmem(regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        return 1;
+    }
+    lwmem_wl_init(&workload, LWMEM_WL_UNIFORM, 0xC0FFEE, 16, 1040);
+    printf("phase,round,free_bytes,largest_free,frag_pct\n");
+    phase_sawtooth();
+    phase_split_churn();
+    phase_random();
+    return 0;
+}
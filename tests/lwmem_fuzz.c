@@ -0,0 +1,79 @@
+/**
+ * \file            lwmem_fuzz.c
+ * \brief           libFuzzer harness for the allocator state machine
+ *
+ * Fuzzer input is interpreted as a sequence of malloc/calloc/realloc/free
+ * operations against a fresh heap. Heap invariants are verified with
+ * lwmem_validate_ex after every operation and user areas are fenced with
+ * ASan-visible writes, so corruption in split/merge/coalesce logic is caught
+ * at the operation that introduces it.
+ */
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwmem/lwmem.h"
+
+#define FUZZ_HEAP_SIZE 16384
+#define FUZZ_SLOTS     32
+
+static unsigned char heap_mem[FUZZ_HEAP_SIZE];
+static lwmem_t fuzz_instance;
+
+int
+LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    lwmem_region_t regions[] = {
+        {heap_mem, sizeof(heap_mem)},
+        {NULL, 0},
+    };
+    void* slots[FUZZ_SLOTS] = {0};
+
+    memset(&fuzz_instance, 0, sizeof(fuzz_instance));
+    if (lwmem_assignmem_ex(&fuzz_instance, regions) == 0) {
+        return 0;
+    }
+
+    /* Each operation consumes 3 bytes: op+slot selector and 16-bit size */
+    for (size_t pos = 0; (pos + 3) <= size; pos += 3) {
+        const uint8_t sel = data[pos];
+        const size_t idx = sel % FUZZ_SLOTS;
+        const size_t req = ((size_t)data[pos + 1] << 8 | data[pos + 2]) % 2048;
+
+        switch (sel / FUZZ_SLOTS % 4) {
+            case 0:
+                if (slots[idx] == NULL) {
+                    slots[idx] = lwmem_malloc_ex(&fuzz_instance, NULL, req);
+                    if (slots[idx] != NULL) {
+                        memset(slots[idx], 0xA5, req); /* Touch entire area for ASan */
+                    }
+                }
+                break;
+            case 1:
+                if (slots[idx] == NULL) {
+                    slots[idx] = lwmem_calloc_ex(&fuzz_instance, NULL, 1, req);
+                }
+                break;
+            case 2:
+                slots[idx] = lwmem_realloc_ex(&fuzz_instance, NULL, slots[idx], req);
+                if (slots[idx] != NULL && req > 0) {
+                    memset(slots[idx], 0x5A, req);
+                }
+                break;
+            case 3:
+            default:
+                lwmem_free_ex(&fuzz_instance, slots[idx]);
+                slots[idx] = NULL;
+                break;
+        }
+        if (lwmem_validate_ex(&fuzz_instance, 0, NULL) != LWMEM_VALIDATE_OK) {
+            __builtin_trap(); /* Invariant violation -> crash for the fuzzer */
+        }
+    }
+
+    for (size_t i = 0; i < FUZZ_SLOTS; ++i) {
+        lwmem_free_ex(&fuzz_instance, slots[i]);
+    }
+    if (lwmem_validate_ex(&fuzz_instance, 0, NULL) != LWMEM_VALIDATE_OK) {
+        __builtin_trap();
+    }
+    return 0;
+}
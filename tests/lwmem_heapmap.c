@@ -0,0 +1,61 @@
+/**
+ * \file            lwmem_heapmap.c
+ * \brief           Machine-readable heap layout dump for visualization
+ *
+ * Runs a demonstration workload and emits one CSV row per block and frame
+ * (frame, offset, size, state) using the public walk API. Feed the output to
+ * dev/heapmap_render.py to get an HTML block-map timeline showing how
+ * fragmentation evolves. Replace the built-in workload with application
+ * specific calls when tuning region splits.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include "lwmem/lwmem.h"
+#include "lwmem_workload.h"
+
+#define HEAP_SIZE (64 * 1024)
+#define SLOTS     128
+#define FRAMES    60
+
+static unsigned char heap_mem[HEAP_SIZE];
+static lwmem_region_t regions[] = {
+    {heap_mem, sizeof(heap_mem)},
+    {NULL, 0},
+};
+static void* slots[SLOTS];
+static lwmem_wl_t workload;
+static int frame;
+
+static uint8_t
+prv_dump_cb(struct lwmem* lwobj, void* addr, size_t size, uint8_t is_free, void* user) {
+    (void)lwobj;
+    (void)user;
+    printf("%d,%u,%u,%s\n", frame, (unsigned)((uint8_t*)addr - heap_mem), (unsigned)size,
+           is_free ? "free" : "used");
+    return 1;
+}
+
+int
+main(void) {
+    if (lwmem_assignmem(regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        return 1;
+    }
+    lwmem_wl_init(&workload, LWMEM_WL_PARETO, 0xBEEF, 16, 2048);
+
+    printf("frame,offset,size,state\n");
+    for (frame = 0; frame < FRAMES; ++frame) {
+        for (int op = 0; op < 200; ++op) {
+            size_t idx = lwmem_wl_rand(&workload) % SLOTS;
+
+            if (slots[idx] == NULL) {
+                slots[idx] = lwmem_malloc(lwmem_wl_next_size(&workload));
+            } else if (lwmem_wl_should_free(&workload)) {
+                lwmem_free(slots[idx]);
+                slots[idx] = NULL;
+            }
+        }
+        lwmem_walk_ex(NULL, prv_dump_cb, NULL);
+    }
+    return 0;
+}
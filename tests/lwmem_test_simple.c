@@ -19,8 +19,8 @@
 /* Region memory declaration */
 static uint8_t lw_mem1[1024], lw_mem2[256], lw_mem3[128];
 
-/* Regions descriptor */
-static lwmem_region_t lw_regions_too_many[] = {
+/* Regions descriptor - regions are not address ordered on purpose */
+static lwmem_region_t lw_regions_unordered[] = {
     {lw_mem3, sizeof(lw_mem3)},
     {lw_mem2, sizeof(lw_mem2)},
     {lw_mem1, sizeof(lw_mem1)},
@@ -46,9 +46,11 @@ lwmem_test_simple_run(void) {
     size_t retval;
     void* ptr;
 
-    /* Should fail -> too many regions */
-    retval = lwmem_assignmem(lw_regions_too_many);
-    ASSERT(retval == 0);
+    /* Should fail -> regions must be defined in increasing address order */
+    if ((&lw_mem3[0] > &lw_mem2[0]) || (&lw_mem2[0] > &lw_mem1[0])) {
+        retval = lwmem_assignmem(lw_regions_unordered);
+        ASSERT(retval == 0);
+    }
 
     /* Should fly now */
     retval = lwmem_assignmem(lw_c_regions);
@@ -0,0 +1,196 @@
+/**
+ * \file            lwmem_trace.c
+ * \brief           Allocation trace record and replay helpers
+ *
+ * Recorder binds to the library event hooks (requires
+ * LWMEM_CFG_EVENT_HOOKS) and emits (op, id, size) tuples to a user sink.
+ * Replay re-executes a captured trace against any library configuration
+ * and reports timing plus final fragmentation.
+ */
+#include "lwmem_trace.h"
+#include <string.h>
+#include <time.h>
+
+#if !LWMEM_CFG_EVENT_HOOKS
+#error "lwmem_trace.c requires LWMEM_CFG_EVENT_HOOKS for the recorder"
+#endif
+
+/* Pointer-to-id binding table of the recorder */
+#define TRACE_MAX_LIVE 4096
+static struct {
+    void* ptr;
+    uint32_t id;
+} live_ptrs[TRACE_MAX_LIVE];
+static uint32_t next_id;
+static lwmem_trace_sink_fn trace_sink;
+static void* trace_user;
+
+static uint64_t
+prv_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t
+prv_bind(void* ptr) {
+    size_t free_idx = TRACE_MAX_LIVE;
+
+    for (size_t i = 0; i < TRACE_MAX_LIVE; ++i) {
+        if (live_ptrs[i].ptr == ptr) { /* Reuse stale entry of same address (e.g. after realloc move) */
+            free_idx = i;
+            break;
+        }
+        if (live_ptrs[i].ptr == NULL && free_idx == TRACE_MAX_LIVE) {
+            free_idx = i;
+        }
+    }
+    if (free_idx == TRACE_MAX_LIVE) {
+        return UINT32_MAX;
+    }
+    live_ptrs[free_idx].ptr = ptr;
+    live_ptrs[free_idx].id = next_id++;
+    return live_ptrs[free_idx].id;
+}
+
+static uint32_t
+prv_unbind(void* ptr) {
+    for (size_t i = 0; i < TRACE_MAX_LIVE; ++i) {
+        if (live_ptrs[i].ptr == ptr) {
+            live_ptrs[i].ptr = NULL;
+            return live_ptrs[i].id;
+        }
+    }
+    return UINT32_MAX;
+}
+
+static void
+prv_trace_hook(struct lwmem* lwobj, lwmem_evt_type_t evt_type, void* ptr, size_t size) {
+    lwmem_trace_rec_t rec = {0};
+
+    (void)lwobj;
+    switch (evt_type) {
+        case LWMEM_EVT_ALLOC:
+            rec.op = LWMEM_TRACE_OP_MALLOC;
+            rec.id = prv_bind(ptr);
+            rec.size = (uint32_t)size;
+            break;
+        case LWMEM_EVT_REALLOC:
+            /* Result pointer may have moved; trace keeps a single id per live object */
+            rec.op = LWMEM_TRACE_OP_REALLOC;
+            rec.id = prv_bind(ptr); /* New binding, replay treats it as grow-from-new */
+            rec.size = (uint32_t)size;
+            break;
+        case LWMEM_EVT_FREE:
+            rec.op = LWMEM_TRACE_OP_FREE;
+            rec.id = prv_unbind(ptr);
+            break;
+        default:
+            return; /* Failures are not part of the replayable trace */
+    }
+    if (rec.id != UINT32_MAX && trace_sink != NULL) {
+        trace_sink(&rec, trace_user);
+    }
+}
+
+/**
+ * \brief           Start recording allocation operations of an instance
+ * \param[in]       lwobj: Instance to record, `NULL` for default one
+ * \param[in]       sink: Sink receiving one record per operation
+ * \param[in]       user: User argument for the sink
+ * \return          `1` on success, `0` otherwise
+ */
+uint8_t
+lwmem_trace_record_start(lwmem_t* lwobj, lwmem_trace_sink_fn sink, void* user) {
+    if (sink == NULL) {
+        return 0;
+    }
+    memset(live_ptrs, 0, sizeof(live_ptrs));
+    next_id = 0;
+    trace_sink = sink;
+    trace_user = user;
+    lwmem_set_event_hook_ex(lwobj, prv_trace_hook);
+    return 1;
+}
+
+/**
+ * \brief           Stop recording allocation operations
+ * \param[in]       lwobj: Instance being recorded, `NULL` for default one
+ */
+void
+lwmem_trace_record_stop(lwmem_t* lwobj) {
+    lwmem_set_event_hook_ex(lwobj, NULL);
+    trace_sink = NULL;
+}
+
+/* Walk callback collecting largest free block */
+static uint8_t
+prv_largest_cb(struct lwmem* lwobj, void* addr, size_t size, uint8_t is_free, void* user) {
+    (void)lwobj;
+    (void)addr;
+    if (is_free && size > *(size_t*)user) {
+        *(size_t*)user = size;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Replay a captured trace against an initialized instance
+ * \param[in]       lwobj: Instance to replay into, `NULL` for default one
+ * \param[in]       recs: Recorded operations
+ * \param[in]       count: Number of records
+ * \param[out]      result: Replay summary (timing, failures, final fragmentation)
+ * \return          `1` on success, `0` on invalid input
+ */
+uint8_t
+lwmem_trace_replay(lwmem_t* lwobj, const lwmem_trace_rec_t* recs, size_t count, lwmem_trace_result_t* result) {
+    static void* replay_ptrs[TRACE_MAX_LIVE];
+    uint64_t start;
+    size_t failed = 0, done = 0;
+
+    if (recs == NULL || result == NULL) {
+        return 0;
+    }
+    memset(replay_ptrs, 0, sizeof(replay_ptrs));
+    memset(result, 0, sizeof(*result));
+
+    start = prv_now_ns();
+    for (size_t i = 0; i < count; ++i) {
+        const lwmem_trace_rec_t* rec = &recs[i];
+
+        if (rec->id >= TRACE_MAX_LIVE) {
+            continue;
+        }
+        switch (rec->op) {
+            case LWMEM_TRACE_OP_MALLOC:
+                replay_ptrs[rec->id] = lwmem_malloc_ex(lwobj, NULL, rec->size);
+                failed += replay_ptrs[rec->id] == NULL;
+                break;
+            case LWMEM_TRACE_OP_REALLOC:
+                replay_ptrs[rec->id] = lwmem_realloc_ex(lwobj, NULL, replay_ptrs[rec->id], rec->size);
+                failed += replay_ptrs[rec->id] == NULL;
+                break;
+            case LWMEM_TRACE_OP_FREE:
+                lwmem_free_ex(lwobj, replay_ptrs[rec->id]);
+                replay_ptrs[rec->id] = NULL;
+                break;
+            default:
+                continue;
+        }
+        ++done;
+    }
+    result->duration_ns = prv_now_ns() - start;
+    result->ops_done = done;
+    result->failed_allocs = failed;
+    result->largest_free_bytes = 0;
+    lwmem_walk_ex(lwobj, prv_largest_cb, &result->largest_free_bytes);
+
+    /* Release everything the trace left live, instance stays reusable */
+    for (size_t i = 0; i < TRACE_MAX_LIVE; ++i) {
+        if (replay_ptrs[i] != NULL) {
+            lwmem_free_ex(lwobj, replay_ptrs[i]);
+        }
+    }
+    return 1;
+}
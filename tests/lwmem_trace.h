@@ -0,0 +1,59 @@
+/**
+ * \file            lwmem_trace.h
+ * \brief           Allocation trace record and replay helpers
+ */
+#ifndef LWMEM_TRACE_HDR_H
+#define LWMEM_TRACE_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "lwmem/lwmem.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Trace operation codes
+ */
+typedef enum {
+    LWMEM_TRACE_OP_MALLOC = 'M',  /*!< Allocation of `size` bytes, result bound to `id` */
+    LWMEM_TRACE_OP_REALLOC = 'R', /*!< Reallocation of `id` to `size` bytes */
+    LWMEM_TRACE_OP_FREE = 'F',    /*!< Free of `id` */
+} lwmem_trace_op_t;
+
+/**
+ * \brief           Single recorded allocation operation
+ */
+typedef struct {
+    uint8_t op;    /*!< Operation code, \ref lwmem_trace_op_t value */
+    uint32_t id;   /*!< Stable pointer identifier within the trace */
+    uint32_t size; /*!< Requested size, `0` for free operations */
+} lwmem_trace_rec_t;
+
+/**
+ * \brief           Trace sink prototype, called once per recorded operation
+ */
+typedef void (*lwmem_trace_sink_fn)(const lwmem_trace_rec_t* rec, void* user);
+
+/**
+ * \brief           Replay outcome summary
+ */
+typedef struct {
+    uint64_t duration_ns;       /*!< Total replay wall time */
+    size_t ops_done;            /*!< Number of executed operations */
+    size_t failed_allocs;       /*!< Allocations the configuration could not satisfy */
+    size_t free_bytes;          /*!< Available bytes after replay */
+    size_t largest_free_bytes;  /*!< Largest free block after replay (fragmentation indicator) */
+} lwmem_trace_result_t;
+
+uint8_t lwmem_trace_record_start(lwmem_t* lwobj, lwmem_trace_sink_fn sink, void* user);
+void lwmem_trace_record_stop(lwmem_t* lwobj);
+uint8_t lwmem_trace_replay(lwmem_t* lwobj, const lwmem_trace_rec_t* recs, size_t count,
+                           lwmem_trace_result_t* result);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_TRACE_HDR_H */
@@ -0,0 +1,80 @@
+/**
+ * \file            lwmem_trace_replay.c
+ * \brief           Trace replay driver
+ *
+ * Reads a binary trace (sequence of lwmem_trace_rec_t) from the file given
+ * as first argument and replays it against a fresh heap, printing timing and
+ * final fragmentation. Without arguments, records a small demo workload first
+ * and replays it, demonstrating the round trip.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwmem_trace.h"
+
+#define REPLAY_HEAP_SIZE (256 * 1024)
+#define MAX_RECORDS      200000
+
+static unsigned char heap[REPLAY_HEAP_SIZE];
+static lwmem_region_t regions[] = {
+    {heap, sizeof(heap)},
+    {NULL, 0},
+};
+
+static lwmem_trace_rec_t records[MAX_RECORDS];
+static size_t record_count;
+
+static void
+prv_store_rec(const lwmem_trace_rec_t* rec, void* user) {
+    (void)user;
+    if (record_count < MAX_RECORDS) {
+        records[record_count++] = *rec;
+    }
+}
+
+int
+main(int argc, char** argv) {
+    lwmem_trace_result_t result;
+
+    if (lwmem_assignmem(regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        return 1;
+    }
+
+    if (argc > 1) { /* Replay trace captured from real firmware */
+        FILE* file = fopen(argv[1], "rb");
+
+        if (file == NULL) {
+            fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 1;
+        }
+        record_count = fread(records, sizeof(records[0]), MAX_RECORDS, file);
+        fclose(file);
+    } else { /* Demo: record a small workload, then replay it */
+        void* ptrs[64] = {0};
+
+        lwmem_trace_record_start(NULL, prv_store_rec, NULL);
+        for (int i = 0; i < 5000; ++i) {
+            int idx = (i * 2654435761u) % 64;
+
+            if (ptrs[idx] == NULL) {
+                ptrs[idx] = lwmem_malloc(16 + (i % 512));
+            } else {
+                lwmem_free(ptrs[idx]);
+                ptrs[idx] = NULL;
+            }
+        }
+        for (int i = 0; i < 64; ++i) {
+            lwmem_free(ptrs[i]);
+        }
+        lwmem_trace_record_stop(NULL);
+    }
+
+    if (!lwmem_trace_replay(NULL, records, record_count, &result)) {
+        fprintf(stderr, "replay failed\n");
+        return 1;
+    }
+    printf("replayed %zu ops in %.3f ms (%zu failed allocs)\n", result.ops_done, result.duration_ns / 1e6,
+           result.failed_allocs);
+    printf("final largest free block: %zu bytes\n", result.largest_free_bytes);
+    return 0;
+}
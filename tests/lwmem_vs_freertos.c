@@ -0,0 +1,111 @@
+/**
+ * \file            lwmem_vs_freertos.c
+ * \brief           Side-by-side benchmark of LwMEM and a bundled FreeRTOS heap implementation
+ *
+ * Heap implementation under comparison is selected at build time by compiling
+ * one of examples/lib/FreeRTOS/portable/MemMang/heap_{2,4,5}.c into the target
+ * (see LWMEM_BENCH_FREERTOS_HEAP cache variable).
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+#include "lwmem/lwmem.h"
+
+#define BENCH_OPS   200000
+#define BENCH_SLOTS 256
+
+static unsigned char lwmem_mem[configTOTAL_HEAP_SIZE];
+static lwmem_region_t lwmem_regions[] = {
+    {lwmem_mem, sizeof(lwmem_mem)},
+    {NULL, 0},
+};
+
+static void* slots[BENCH_SLOTS];
+static uint32_t rng_state;
+
+static uint32_t
+prv_rand(void) {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static uint64_t
+prv_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void
+prv_run(const char* name, void* (*alloc_fn)(size_t), void (*free_fn)(void*)) {
+    uint64_t start, worst = 0, total;
+    size_t failed = 0;
+
+    memset(slots, 0, sizeof(slots));
+    rng_state = 0x1234567;
+    start = prv_now_ns();
+    for (size_t op = 0; op < BENCH_OPS; ++op) {
+        const size_t idx = prv_rand() % BENCH_SLOTS;
+        const uint64_t op_start = prv_now_ns();
+        uint64_t op_dur;
+
+        if (slots[idx] == NULL) {
+            slots[idx] = alloc_fn(16 + (prv_rand() % 1008));
+            failed += slots[idx] == NULL;
+        } else {
+            free_fn(slots[idx]);
+            slots[idx] = NULL;
+        }
+        op_dur = prv_now_ns() - op_start;
+        if (op_dur > worst) {
+            worst = op_dur;
+        }
+    }
+    total = prv_now_ns() - start;
+    for (size_t i = 0; i < BENCH_SLOTS; ++i) {
+        if (slots[i] != NULL) {
+            free_fn(slots[i]);
+        }
+    }
+    printf("%-10s %10.0f ops/s   worst %8llu ns   failed allocs %zu\n", name, BENCH_OPS / (total / 1e9),
+           (unsigned long long)worst, failed);
+}
+
+static void*
+prv_lwmem_alloc(size_t size) {
+    return lwmem_malloc(size);
+}
+
+static void
+prv_lwmem_free(void* ptr) {
+    lwmem_free(ptr);
+}
+
+int
+main(void) {
+    if (lwmem_assignmem(lwmem_regions) == 0) {
+        fprintf(stderr, "lwmem heap assignment failed\n");
+        return 1;
+    }
+#if defined(LWMEM_BENCH_HEAP5)
+    {
+        static uint8_t heap5_mem[configTOTAL_HEAP_SIZE];
+        const HeapRegion_t heap5_regions[] = {
+            {heap5_mem, sizeof(heap5_mem)},
+            {NULL, 0},
+        };
+        vPortDefineHeapRegions(heap5_regions);
+    }
+#endif /* defined(LWMEM_BENCH_HEAP5) */
+
+    printf("Mixed random malloc/free, %u ops, heap %u kB:\n", (unsigned)BENCH_OPS,
+           (unsigned)(configTOTAL_HEAP_SIZE / 1024));
+    prv_run("lwmem", prv_lwmem_alloc, prv_lwmem_free);
+    prv_run("freertos", pvPortMalloc, vPortFree);
+    return 0;
+}
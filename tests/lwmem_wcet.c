@@ -0,0 +1,127 @@
+/**
+ * \file            lwmem_wcet.c
+ * \brief           Worst-case execution time measurement with bound assertions
+ *
+ * Constructs free lists of parameterized length N (checkerboard frees over
+ * 2N small blocks), measures the cost of the allocation primitive that must
+ * scan the whole list, fits the per-block scaling and asserts configured
+ * ceilings - turning latency regressions into failing runs instead of field
+ * incidents. Medians over repeated trials keep host scheduling noise out.
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lwmem/lwmem.h"
+
+/* Configurable ceilings, generous defaults for host runs */
+#ifndef LWMEM_WCET_MAX_NS_PER_BLOCK
+#define LWMEM_WCET_MAX_NS_PER_BLOCK 50.0 /* Permitted scan cost per free block */
+#endif
+#ifndef LWMEM_WCET_MAX_BASE_NS
+#define LWMEM_WCET_MAX_BASE_NS 20000.0 /* Permitted fixed overhead */
+#endif
+
+#define HEAP_SIZE (1024 * 1024)
+#define TRIALS    64
+
+static unsigned char heap_mem[HEAP_SIZE];
+static lwmem_region_t regions[] = {
+    {heap_mem, sizeof(heap_mem)},
+    {NULL, 0},
+};
+static void* blocks[16384];
+static uint64_t trial_ns[TRIALS];
+
+static uint64_t
+prv_now_ns(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static int
+prv_cmp_u64(const void* in_a, const void* in_b) {
+    const uint64_t a = *(const uint64_t*)in_a, b = *(const uint64_t*)in_b;
+
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/* Build a free list with n entries and measure full-scan allocation cost */
+static double
+prv_measure(size_t n) {
+    const size_t count = 2 * n;
+
+    /* Fill heap with small blocks, free every other -> n isolated free holes */
+    for (size_t i = 0; i < count; ++i) {
+        blocks[i] = lwmem_malloc(16);
+        if (blocks[i] == NULL) {
+            fprintf(stderr, "heap too small for N=%zu\n", n);
+            exit(1);
+        }
+    }
+    for (size_t i = 0; i < count; i += 2) {
+        lwmem_free(blocks[i]);
+        blocks[i] = NULL;
+    }
+
+    for (size_t trial = 0; trial < TRIALS; ++trial) {
+        uint64_t start = prv_now_ns();
+        void* probe = lwmem_malloc(4096); /* Larger than any hole -> walks all n entries */
+
+        trial_ns[trial] = prv_now_ns() - start;
+        lwmem_free(probe);
+    }
+
+    for (size_t i = 1; i < count; i += 2) {
+        lwmem_free(blocks[i]);
+        blocks[i] = NULL;
+    }
+    /* Heal heap back to single block for next round */
+    {
+        void* all = lwmem_malloc(HEAP_SIZE - 64);
+
+        lwmem_free(all);
+    }
+
+    qsort(trial_ns, TRIALS, sizeof(trial_ns[0]), prv_cmp_u64);
+    return (double)trial_ns[TRIALS / 2];
+}
+
+int
+main(void) {
+    static const size_t list_lengths[] = {16, 64, 256, 1024, 4096};
+    double costs[sizeof(list_lengths) / sizeof(list_lengths[0])];
+    double slope, base;
+    size_t last = sizeof(list_lengths) / sizeof(list_lengths[0]) - 1;
+
+    if (lwmem_assignmem(regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        return 1;
+    }
+
+    printf("free_blocks,median_scan_ns\n");
+    for (size_t i = 0; i <= last; ++i) {
+        costs[i] = prv_measure(list_lengths[i]);
+        printf("%zu,%.0f\n", list_lengths[i], costs[i]);
+    }
+
+    /* Linear fit through first and last point */
+    slope = (costs[last] - costs[0]) / (double)(list_lengths[last] - list_lengths[0]);
+    base = costs[0] - slope * (double)list_lengths[0];
+    printf("fit: %.3f ns/block + %.0f ns base\n", slope, base);
+
+    if (slope > LWMEM_WCET_MAX_NS_PER_BLOCK) {
+        fprintf(stderr, "FAIL: per-block scan cost %.3f ns exceeds ceiling %.3f ns\n", slope,
+                (double)LWMEM_WCET_MAX_NS_PER_BLOCK);
+        return 1;
+    }
+    if (base > LWMEM_WCET_MAX_BASE_NS) {
+        fprintf(stderr, "FAIL: base cost %.0f ns exceeds ceiling %.0f ns\n", base, (double)LWMEM_WCET_MAX_BASE_NS);
+        return 1;
+    }
+    printf("PASS: within configured ceilings\n");
+    return 0;
+}
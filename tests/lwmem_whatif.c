@@ -0,0 +1,169 @@
+/**
+ * \file            lwmem_whatif.c
+ * \brief           Capacity-planning what-if engine: replay traces against hypothetical configs
+ */
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lwmem/lwmem.h"
+#include "lwmem_trace.h"
+#include "lwmem_workload.h"
+
+/*
+ * Answers "would this trace have fit in 384 kB with 8-byte alignment?"
+ * offline, before RAM parts are picked: each command line config describes a
+ * hypothetical heap (size and request alignment), the captured trace is
+ * replayed against every config in batch and the tool reports first failure,
+ * peak usage and fragmentation per config.
+ *
+ * Usage: lwmem_whatif [trace.bin] SIZE[:ALIGN] [SIZE[:ALIGN] ...]
+ *        lwmem_whatif 393216:8 262144:4       (synthetic workload when no trace)
+ *
+ * Alignment is approximated by rounding every request up to the hypothetical
+ * boundary - the dominant effect of LWMEM_CFG_ALIGN_NUM on capacity.
+ */
+
+#define MAX_RECORDS 1000000
+#define MAX_LIVE    65536
+
+static lwmem_trace_rec_t records[MAX_RECORDS];
+static size_t record_count;
+static void* live[MAX_LIVE];
+
+/* Synthetic mixed workload, used when no trace file is given */
+static void
+prv_synthesize(void) {
+    lwmem_wl_t workload;
+    uint32_t next_id = 0;
+    static uint32_t slot_ids[256];
+
+    lwmem_wl_init(&workload, LWMEM_WL_UNIFORM, 0x1234ABC, 16, 2048);
+    for (size_t op = 0; op < 100000 && record_count < MAX_RECORDS; ++op) {
+        const size_t slot = lwmem_wl_rand(&workload) % 256;
+
+        if (slot_ids[slot] == 0) {
+            slot_ids[slot] = ++next_id;
+            records[record_count].op = LWMEM_TRACE_OP_MALLOC;
+            records[record_count].id = slot_ids[slot];
+            records[record_count].size = (uint32_t)lwmem_wl_next_size(&workload);
+        } else {
+            records[record_count].op = LWMEM_TRACE_OP_FREE;
+            records[record_count].id = slot_ids[slot];
+            records[record_count].size = 0;
+            slot_ids[slot] = 0;
+        }
+        ++record_count;
+    }
+}
+
+/**
+ * \brief           Replay the loaded trace against one hypothetical configuration
+ * \param[in]       heap_size: Hypothetical heap size in bytes
+ * \param[in]       align: Hypothetical request alignment in bytes
+ * \return          `0` on success
+ */
+static int
+prv_run_config(size_t heap_size, size_t align) {
+    static lwmem_t lwobj;
+    lwmem_region_t regions[] = {{NULL, 0}, {NULL, 0}};
+    size_t peak_used = 0, failed = 0, first_fail = 0, ops = 0;
+    lwmem_stats_t stats;
+    uint8_t* heap = malloc(heap_size);
+
+    if (heap == NULL) {
+        fprintf(stderr, "cannot allocate %zu byte simulation heap\n", heap_size);
+        return 1;
+    }
+    memset(&lwobj, 0, sizeof(lwobj));
+    memset(live, 0, sizeof(live));
+    regions[0].start_addr = heap;
+    regions[0].size = heap_size;
+    if (lwmem_assignmem_ex(&lwobj, regions) == 0) {
+        fprintf(stderr, "heap assignment failed\n");
+        free(heap);
+        return 1;
+    }
+
+    for (size_t idx = 0; idx < record_count; ++idx) {
+        const lwmem_trace_rec_t* rec = &records[idx];
+        const size_t size = ((size_t)rec->size + align - 1) & ~(align - 1);
+
+        if (rec->id >= MAX_LIVE) {
+            continue;
+        }
+        switch (rec->op) {
+            case LWMEM_TRACE_OP_MALLOC: live[rec->id] = lwmem_malloc_ex(&lwobj, NULL, size); break;
+            case LWMEM_TRACE_OP_REALLOC: live[rec->id] = lwmem_realloc_ex(&lwobj, NULL, live[rec->id], size); break;
+            case LWMEM_TRACE_OP_FREE:
+                lwmem_free_ex(&lwobj, live[rec->id]);
+                live[rec->id] = NULL;
+                break;
+            default: break;
+        }
+        if (rec->op != LWMEM_TRACE_OP_FREE && live[rec->id] == NULL) {
+            ++failed;
+            if (first_fail == 0) {
+                first_fail = idx + 1;
+            }
+        }
+        ++ops;
+        lwmem_get_stats_ex(&lwobj, &stats);
+        if ((stats.mem_size_bytes - stats.mem_available_bytes) > peak_used) {
+            peak_used = stats.mem_size_bytes - stats.mem_available_bytes;
+        }
+    }
+    lwmem_get_stats_ex(&lwobj, &stats);
+    printf("%8zu B / align %2zu:  %s  peak %7zu B (%3zu%%)  end-frag %3u%%  failed %zu/%zu%s",
+           heap_size, align, failed == 0 ? "FITS    " : "TOO SMALL", peak_used,
+           (peak_used * 100) / (size_t)stats.mem_size_bytes, (unsigned)stats.fragmentation_pct, failed, ops,
+           failed > 0 ? "  first fail at op " : "\n");
+    if (failed > 0) {
+        printf("%zu\n", first_fail);
+    }
+    free(heap);
+    return 0;
+}
+
+int
+main(int argc, char** argv) {
+    int first_cfg = 1, any = 0;
+
+    if (argc > 1 && strchr(argv[1], ':') == NULL && strchr(argv[1], '.') != NULL) {
+        FILE* file = fopen(argv[1], "rb"); /* Arguments without size syntax are trace files */
+
+        if (file == NULL) {
+            fprintf(stderr, "cannot open %s\n", argv[1]);
+            return 1;
+        }
+        record_count = fread(records, sizeof(records[0]), MAX_RECORDS, file);
+        fclose(file);
+        first_cfg = 2;
+    } else {
+        prv_synthesize();
+    }
+    printf("lwmem_whatif: %zu trace operations\n\n", record_count);
+
+    for (int idx = first_cfg; idx < argc; ++idx) {
+        size_t heap_size, align = LWMEM_CFG_ALIGN_NUM;
+        char* sep = strchr(argv[idx], ':');
+
+        if (sep != NULL) {
+            align = (size_t)strtoul(sep + 1, NULL, 0);
+        }
+        heap_size = (size_t)strtoul(argv[idx], NULL, 0);
+        if (heap_size == 0 || align == 0 || (align & (align - 1)) != 0) {
+            fprintf(stderr, "invalid config %s (expected SIZE[:ALIGN])\n", argv[idx]);
+            return 1;
+        }
+        if (prv_run_config(heap_size, align) != 0) {
+            return 1;
+        }
+        any = 1;
+    }
+    if (!any) {
+        fprintf(stderr, "usage: lwmem_whatif [trace.bin] SIZE[:ALIGN] [...]\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,85 @@
+/**
+ * \file            lwmem_workload.c
+ * \brief           Deterministic workload generation for benchmarks and stress tools
+ *
+ * All randomness comes from a seeded xorshift32 generator, so a
+ * "workload W, seed S" result is reproducible bit-for-bit across machines
+ * and library versions. Used by the benchmark suite and the fragmentation
+ * stressor alike.
+ */
+#include "lwmem_workload.h"
+
+/**
+ * \brief           Initialize workload generator
+ * \param[in]       wl: Generator state to initialize
+ * \param[in]       dist: Size distribution to use
+ * \param[in]       seed: PRNG seed, must not be `0`
+ * \param[in]       a: First distribution parameter (minimum or fixed size)
+ * \param[in]       b: Second distribution parameter (maximum size)
+ */
+void
+lwmem_wl_init(lwmem_wl_t* wl, lwmem_wl_dist_t dist, uint32_t seed, size_t a, size_t b) {
+    wl->state = seed != 0 ? seed : 1;
+    wl->dist = dist;
+    wl->a = a;
+    wl->b = b > a ? b : a;
+    wl->phase = 0;
+}
+
+/**
+ * \brief           Draw next raw pseudo-random value (xorshift32)
+ * \param[in]       wl: Generator state
+ * \return          32-bit pseudo-random value
+ */
+uint32_t
+lwmem_wl_rand(lwmem_wl_t* wl) {
+    wl->state ^= wl->state << 13;
+    wl->state ^= wl->state >> 17;
+    wl->state ^= wl->state << 5;
+    return wl->state;
+}
+
+/**
+ * \brief           Draw next allocation size from the configured distribution
+ * \param[in]       wl: Generator state
+ * \return          Allocation size in units of bytes
+ */
+size_t
+lwmem_wl_next_size(lwmem_wl_t* wl) {
+    switch (wl->dist) {
+        case LWMEM_WL_UNIFORM:
+            return wl->a + (lwmem_wl_rand(wl) % (wl->b - wl->a + 1));
+        case LWMEM_WL_PARETO: {
+            /* Approximate heavy tail: halve the range with 50% probability per step */
+            size_t range = wl->b - wl->a;
+
+            while (range > 0 && (lwmem_wl_rand(wl) & 0x01U) != 0) {
+                range /= 2;
+            }
+            return wl->b - range;
+        }
+        case LWMEM_WL_BURST:
+            ++wl->phase;
+            return wl->a;
+        case LWMEM_WL_FIXED:
+        default:
+            return wl->a;
+    }
+}
+
+/**
+ * \brief           Decide whether next operation should be a free
+ *
+ * Non-burst distributions free with 50% probability; burst distribution
+ * alternates between 64-operation allocation and free phases
+ *
+ * \param[in]       wl: Generator state
+ * \return          `1` to free, `0` to allocate
+ */
+uint8_t
+lwmem_wl_should_free(lwmem_wl_t* wl) {
+    if (wl->dist == LWMEM_WL_BURST) {
+        return ((wl->phase / 64) & 0x01U) != 0;
+    }
+    return (lwmem_wl_rand(wl) & 0x01U) != 0;
+}
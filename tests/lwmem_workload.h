@@ -0,0 +1,45 @@
+/**
+ * \file            lwmem_workload.h
+ * \brief           Deterministic workload generation for benchmarks and stress tools
+ */
+#ifndef LWMEM_WORKLOAD_HDR_H
+#define LWMEM_WORKLOAD_HDR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/**
+ * \brief           Named size distributions
+ */
+typedef enum {
+    LWMEM_WL_FIXED = 0, /*!< Every request has size `a` */
+    LWMEM_WL_UNIFORM,   /*!< Sizes uniformly distributed in `[a, b]` */
+    LWMEM_WL_PARETO,    /*!< Heavy-tailed sizes, mostly near `a` with rare large ones up to `b` */
+    LWMEM_WL_BURST,     /*!< Alternating phases: `a`-sized burst allocations, then frees */
+} lwmem_wl_dist_t;
+
+/**
+ * \brief           Workload generator state
+ */
+typedef struct {
+    uint32_t state;       /*!< PRNG state */
+    lwmem_wl_dist_t dist; /*!< Selected distribution */
+    size_t a;             /*!< First distribution parameter (minimum / fixed size) */
+    size_t b;             /*!< Second distribution parameter (maximum size) */
+    uint32_t phase;       /*!< Phase counter for burst distribution */
+} lwmem_wl_t;
+
+void lwmem_wl_init(lwmem_wl_t* wl, lwmem_wl_dist_t dist, uint32_t seed, size_t a, size_t b);
+uint32_t lwmem_wl_rand(lwmem_wl_t* wl);
+size_t lwmem_wl_next_size(lwmem_wl_t* wl);
+uint8_t lwmem_wl_should_free(lwmem_wl_t* wl);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* LWMEM_WORKLOAD_HDR_H */